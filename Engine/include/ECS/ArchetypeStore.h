@@ -20,6 +20,7 @@
 #include <variant>
 #include <limits>
 #include <functional>
+#include <type_traits>
 #include "ECS/Components.h"
 #include "ECS/Entity.h"
 
@@ -70,6 +71,8 @@ namespace Engine::ECS
                 m_teams.emplace_back(Team{});
             if (hasAttackCooldown())
                 m_attackCooldowns.emplace_back(AttackCooldown{});
+            if (hasSimLod())
+                m_simLods.emplace_back(SimLod{});
 
             return row;
         }
@@ -129,6 +132,8 @@ namespace Engine::ECS
                 swapErase(m_teams);
             if (hasAttackCooldown())
                 swapErase(m_attackCooldowns);
+            if (hasSimLod())
+                swapErase(m_simLods);
 
             return moved;
         }
@@ -213,6 +218,10 @@ namespace Engine::ECS
                 {
                     m_attackCooldowns[row] = std::get<AttackCooldown>(kv.second);
                 }
+                else if (std::holds_alternative<SimLod>(kv.second) && hasSimLod())
+                {
+                    m_simLods[row] = std::get<SimLod>(kv.second);
+                }
             }
         }
 
@@ -270,6 +279,9 @@ namespace Engine::ECS
         std::vector<AttackCooldown> &attackCooldowns() { return m_attackCooldowns; }
         const std::vector<AttackCooldown> &attackCooldowns() const { return m_attackCooldowns; }
 
+        std::vector<SimLod> &simLods() { return m_simLods; }
+        const std::vector<SimLod> &simLods() const { return m_simLods; }
+
         // Helpers
         bool hasPosition() const { return m_hasPosition; }
         bool hasVelocity() const { return m_hasVelocity; }
@@ -288,6 +300,19 @@ namespace Engine::ECS
         bool hasPosePalette() const { return m_hasPosePalette; }
         bool hasTeam() const { return m_hasTeam; }
         bool hasAttackCooldown() const { return m_hasAttackCooldown; }
+        bool hasSimLod() const { return m_hasSimLod; }
+
+        // Bytes reserved by the SoA columns (capacity, not size). Heap data owned by
+        // elements (e.g. PosePalette matrices) is not included.
+        size_t memoryBytes() const
+        {
+            auto bytes = [](const auto &vec) { return vec.capacity() * sizeof(typename std::decay_t<decltype(vec)>::value_type); };
+            return bytes(m_entities) + bytes(m_positions) + bytes(m_velocities) + bytes(m_healths) +
+                   bytes(m_moveTargets) + bytes(m_moveSpeeds) + bytes(m_radii) + bytes(m_separations) +
+                   bytes(m_avoidanceParams) + bytes(m_renderModels) + bytes(m_renderAnimations) +
+                   bytes(m_facings) + bytes(m_obstacleRadii) + bytes(m_paths) + bytes(m_posePalettes) +
+                   bytes(m_teams) + bytes(m_attackCooldowns) + bytes(m_simLods);
+        }
 
         // Resolve which known components are present in signature; enables arrays accordingly.
         void resolveKnownComponents(ComponentRegistry &registry)
@@ -327,6 +352,9 @@ namespace Engine::ECS
             const uint32_t ackId = registry.ensureId("AttackCooldown");
             m_hasTeam = m_signature.has(teamId);
             m_hasAttackCooldown = m_signature.has(ackId);
+
+            const uint32_t lodId = registry.ensureId("SimLod");
+            m_hasSimLod = m_signature.has(lodId);
         }
 
     private:
@@ -350,6 +378,7 @@ namespace Engine::ECS
         std::vector<PosePalette> m_posePalettes;
         std::vector<Team> m_teams;
         std::vector<AttackCooldown> m_attackCooldowns;
+        std::vector<SimLod> m_simLods;
 
         // Flags indicating which arrays are active.
         bool m_hasPosition = false;
@@ -369,6 +398,7 @@ namespace Engine::ECS
         bool m_hasPosePalette = false;
         bool m_hasTeam = false;
         bool m_hasAttackCooldown = false;
+        bool m_hasSimLod = false;
     };
 
     class ArchetypeStoreManager
@@ -406,6 +436,18 @@ namespace Engine::ECS
 
         const std::vector<std::unique_ptr<ArchetypeStore>> &stores() const { return m_stores; }
 
+        // Total column bytes across all stores (see ArchetypeStore::memoryBytes).
+        size_t memoryBytes() const
+        {
+            size_t total = 0;
+            for (const auto &ptr : m_stores)
+            {
+                if (ptr)
+                    total += ptr->memoryBytes();
+            }
+            return total;
+        }
+
     private:
         std::vector<std::unique_ptr<ArchetypeStore>> m_stores;
         std::function<void(uint32_t archetypeId, const ComponentMask &signature)> m_onStoreCreated;
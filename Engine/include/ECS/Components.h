@@ -21,6 +21,9 @@
 #include <unordered_map>
 #include <variant>
 #include <assets/Handles.h>
+#include <assets/AnimationCursor.h>
+#include <assets/PaletteMatrix.h>
+#include <ECS/PathPool.h>
 #include <glm/glm.hpp>
 
 namespace Engine::ECS
@@ -83,9 +86,10 @@ namespace Engine::ECS
     // Tunables for local avoidance
     struct AvoidanceParams
     {
-        float strength = 1.0f; // separation strength
-        float maxAccel = 0.9f; // clamp acceleration (units/s^2)
-        float blend = 0.55f;   // velocity smoothing
+        float strength = 1.0f;    // separation strength
+        float maxAccel = 0.9f;    // clamp acceleration (units/s^2)
+        float blend = 0.55f;      // velocity smoothing
+        float timeHorizon = 1.5f; // seconds of look-ahead (reciprocal avoidance mode)
     };
 
     // Row-level tag used by selection (no per-row storage; stored in row masks).
@@ -93,6 +97,11 @@ namespace Engine::ECS
     {
     };
 
+    // Tag for idle units put to sleep by the activity tracker; simulation systems skip them.
+    struct Sleeping
+    {
+    };
+
     // -----------------------
     // Obstacle Components
     // -----------------------
@@ -112,13 +121,14 @@ namespace Engine::ECS
     // Pathfinding Components
     // -----------------------
 
-    // Waypoint buffer for A* pathfinding
+    // A* path state. Waypoints live in ECSContext::pathPool (interleaved x,z floats);
+    // the component only keeps the pool handle, so rows stay small and identical
+    // paths can share one span.
     struct Path
     {
         static constexpr uint32_t MAX_WAYPOINTS = 64;
 
-        float waypointsX[MAX_WAYPOINTS];
-        float waypointsZ[MAX_WAYPOINTS];
+        PathHandle handle;    // PathPool handle (PathPool::InvalidHandle = none)
         uint32_t count = 0;   // how many waypoints are valid
         uint32_t current = 0; // index of the next waypoint to walk toward
         bool valid = false;   // was a path successfully found?
@@ -149,12 +159,20 @@ namespace Engine::ECS
     // Cached pose palettes computed by PoseUpdateSystem.
     // nodePalette: one matrix per node in the model.
     // jointPalette: one matrix per joint across all skins in the model (flattened).
+    // Both hold affine rows (Engine::PaletteMatrix, 48 bytes), the layout the GPU reads.
+    // sharedSlot: when pose sharing is on, the palettes live in a slot shared with every unit
+    // in the same (model, clip, time bucket) and the vectors here stay empty; the counts are
+    // still set. UINT32_MAX = the entity owns its palettes.
+    // keyCursor: last keyframe per channel from this entity's previous live evaluation, so the
+    // next one resumes from there instead of searching the key times.
     struct PosePalette
     {
-        std::vector<glm::mat4> nodePalette;
-        std::vector<glm::mat4> jointPalette;
+        std::vector<Engine::PaletteMatrix> nodePalette;
+        std::vector<Engine::PaletteMatrix> jointPalette;
         uint32_t nodeCount = 0;
         uint32_t jointCount = 0;
+        uint32_t sharedSlot = UINT32_MAX;
+        Engine::AnimationCursor keyCursor;
     };
 
     // -----------------------
@@ -174,8 +192,23 @@ namespace Engine::ECS
         float interval = 1.5f;   // time between attacks (seconds)
     };
 
+    // -----------------------
+    // Simulation LOD
+    // -----------------------
+
+    // Update rate for distance-throttled systems (written by SimLodSystem each frame).
+    // Throttled systems only touch the row on frames where `due` is set, and then
+    // integrate `stepDt` (the frame times accumulated since its last update).
+    struct SimLod
+    {
+        uint8_t level = 0;      // update every (1 << level) frames
+        bool due = true;        // row is updated this frame
+        float pendingDt = 0.0f; // time accumulated since the last due frame
+        float stepDt = 0.0f;    // time to integrate on a due frame
+    };
+
     // Typed defaults per component ID (used by Prefabs/Stores).
-    using DefaultValue = std::variant<Position, Velocity, Health, MoveTarget, MoveSpeed, Radius, Separation, AvoidanceParams, RenderModel, RenderAnimation, Facing, ObstacleRadius, Path, PosePalette, Team, AttackCooldown>;
+    using DefaultValue = std::variant<Position, Velocity, Health, MoveTarget, MoveSpeed, Radius, Separation, AvoidanceParams, RenderModel, RenderAnimation, Facing, ObstacleRadius, Path, PosePalette, Team, AttackCooldown, SimLod>;
     // -----------------------
     // Component Registry
     // -----------------------
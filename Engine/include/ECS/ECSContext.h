@@ -12,6 +12,7 @@
 //   - ArchetypeStoreManager: lazily created SoA stores per archetype.
 //   - EntitiesRecord: control-plane mapping of entity handle -> (archetypeId, row).
 //   - PrefabManager: dictionary of prefabs keyed by name (SampleApp loads JSON and fills it).
+//   - PathPool: shared waypoint storage referenced by Path::handle.
 //
 // Notes:
 //   - Engine/Application owns lifetime of ECSContext.
@@ -24,6 +25,8 @@
 #include "ECS/Entity.h"           // EntitiesRecord
 #include "ECS/Prefab.h"           // PrefabManager
 #include "ECS/QueryManager.h"     // QueryManager
+#include "ECS/PathPool.h"         // PathPool
+#include <utility>
 #include <vector>
 
 namespace Engine::ECS
@@ -37,6 +40,7 @@ namespace Engine::ECS
         EntitiesRecord entities;
         PrefabManager prefabs;
         QueryManager queries;
+        PathPool pathPool;
 
         // Call once to keep QueryManager updated as new stores are created.
         void WireQueryManager()
@@ -100,6 +104,25 @@ namespace Engine::ECS
                 dstStore->renderAnimations()[dstRow] = srcStore->renderAnimations()[srcRow];
             if (srcStore->hasFacing() && dstStore->hasFacing())
                 dstStore->facings()[dstRow] = srcStore->facings()[srcRow];
+            if (srcStore->hasObstacleRadius() && dstStore->hasObstacleRadius())
+                dstStore->obstacleRadii()[dstRow] = srcStore->obstacleRadii()[srcRow];
+            if (srcStore->hasPosePalette() && dstStore->hasPosePalette())
+                dstStore->posePalettes()[dstRow] = std::move(srcStore->posePalettes()[srcRow]);
+            if (srcStore->hasTeam() && dstStore->hasTeam())
+                dstStore->teams()[dstRow] = srcStore->teams()[srcRow];
+            if (srcStore->hasAttackCooldown() && dstStore->hasAttackCooldown())
+                dstStore->attackCooldowns()[dstRow] = srcStore->attackCooldowns()[srcRow];
+            if (srcStore->hasSimLod() && dstStore->hasSimLod())
+                dstStore->simLods()[dstRow] = srcStore->simLods()[srcRow];
+            if (srcStore->hasPath())
+            {
+                // Ownership of the pooled waypoints moves with the row; drop it if the
+                // destination archetype has no Path.
+                if (dstStore->hasPath())
+                    dstStore->paths()[dstRow] = srcStore->paths()[srcRow];
+                else
+                    pathPool.release(srcStore->paths()[srcRow].handle);
+            }
 
             // Update mapping for moved entity first (so the source destroy can't leave it stale).
             entities.attach(e, dstArchetypeId, dstRow);
@@ -129,6 +152,15 @@ namespace Engine::ECS
             queries.markDirtyComponent(compId, archetypeId, row, store->size());
         }
 
+        // Mark many rows of one store dirty (one query lookup per store instead of per row).
+        void markDirtyRows(uint32_t compId, uint32_t archetypeId, const std::vector<uint32_t> &rows)
+        {
+            ArchetypeStore *store = stores.get(archetypeId);
+            if (!store)
+                return;
+            queries.markDirtyComponentRows(compId, archetypeId, rows.data(), rows.size(), store->size());
+        }
+
         // Mark dirty by entity handle.
         void markDirty(uint32_t compId, Entity e)
         {
@@ -0,0 +1,189 @@
+#pragma once
+/*
+  PathPool.h
+  ----------
+  Purpose:
+    - Shared arena for Path waypoints so the Path component only holds a handle + counters.
+    - Each path is a span of interleaved (x, z) floats sized to its waypoint count,
+      rounded up to a power-of-two bucket (4..64 waypoints) so freed spans are reused
+      without fragmenting the arena.
+    - Spans are reference counted: identical paths (e.g. a formation following one
+      leader route) can share a single span via addRef().
+
+  Usage:
+    - h = pool.allocate(n); write pool.data(h)[2*i + 0/1]; store h in Path::handle.
+    - pool.release(h) when the owning Path is replaced or its entity is destroyed.
+    - Handles are (slot index, generation) pairs, like ModelHandle: releasing the last
+      reference bumps the slot's generation, so a stale copy of a handle (e.g. a Path
+      that was not cleared, or a cached last plan) is rejected instead of reading whatever
+      path reused the slot. Every lookup validates it; InvalidHandle is safe everywhere.
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::ECS
+{
+    struct PathHandle
+    {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+        bool isValid() const { return index != UINT32_MAX; }
+    };
+
+    class PathPool
+    {
+    public:
+        static constexpr PathHandle InvalidHandle{};
+        static constexpr uint32_t kMinBucketWaypoints = 4;
+        static constexpr uint32_t kBucketCount = 5; // 4, 8, 16, 32, 64 waypoints
+        static constexpr uint32_t kMaxWaypoints = kMinBucketWaypoints << (kBucketCount - 1);
+
+        // Allocate a span for `count` waypoints with refcount 1.
+        // Returns InvalidHandle for count == 0; counts above kMaxWaypoints are clamped.
+        PathHandle allocate(uint32_t count)
+        {
+            if (count == 0)
+                return InvalidHandle;
+            if (count > kMaxWaypoints)
+                count = kMaxWaypoints;
+
+            const uint32_t bucket = bucketFor(count);
+            uint32_t offset = 0;
+            auto &freeSpans = m_freeSpans[bucket];
+            if (!freeSpans.empty())
+            {
+                offset = freeSpans.back();
+                freeSpans.pop_back();
+            }
+            else
+            {
+                offset = static_cast<uint32_t>(m_data.size());
+                m_data.resize(m_data.size() + 2u * bucketCapacity(bucket), 0.0f);
+            }
+
+            uint32_t index = 0;
+            if (!m_freeSlots.empty())
+            {
+                index = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(m_slots.size());
+                m_slots.emplace_back();
+            }
+
+            Slot &s = m_slots[index];
+            s.offset = offset;
+            s.count = count;
+            s.bucket = bucket;
+            s.refs = 1;
+
+            ++m_liveSpans;
+            m_liveWaypoints += count;
+            return PathHandle{index, s.generation};
+        }
+
+        // Share an existing span (e.g. give a formation member the leader's path).
+        PathHandle addRef(PathHandle handle)
+        {
+            if (!isLive(handle))
+                return InvalidHandle;
+            ++m_slots[handle.index].refs;
+            return handle;
+        }
+
+        void release(PathHandle handle)
+        {
+            if (!isLive(handle))
+                return;
+            Slot &s = m_slots[handle.index];
+            if (--s.refs != 0)
+                return;
+
+            m_freeSpans[s.bucket].push_back(s.offset);
+            m_freeSlots.push_back(handle.index);
+            --m_liveSpans;
+            m_liveWaypoints -= s.count;
+            s.count = 0;
+            ++s.generation; // outstanding copies of `handle` are stale from here on
+        }
+
+        bool isLive(PathHandle handle) const
+        {
+            return handle.index < m_slots.size() && m_slots[handle.index].refs != 0 &&
+                   m_slots[handle.index].generation == handle.generation;
+        }
+
+        uint32_t count(PathHandle handle) const
+        {
+            return isLive(handle) ? m_slots[handle.index].count : 0u;
+        }
+
+        uint32_t refCount(PathHandle handle) const
+        {
+            return isLive(handle) ? m_slots[handle.index].refs : 0u;
+        }
+
+        // Interleaved waypoints: [x0, z0, x1, z1, ...], nullptr for a stale / invalid handle.
+        // Pointer is invalidated by allocate().
+        float *data(PathHandle handle) { return isLive(handle) ? &m_data[m_slots[handle.index].offset] : nullptr; }
+        const float *data(PathHandle handle) const
+        {
+            return isLive(handle) ? &m_data[m_slots[handle.index].offset] : nullptr;
+        }
+
+        // Stats
+        uint32_t liveSpans() const { return m_liveSpans; }
+        uint32_t liveWaypoints() const { return m_liveWaypoints; }
+        size_t memoryBytes() const
+        {
+            size_t bytes = m_data.capacity() * sizeof(float) + m_slots.capacity() * sizeof(Slot) +
+                           m_freeSlots.capacity() * sizeof(uint32_t);
+            for (const auto &f : m_freeSpans)
+                bytes += f.capacity() * sizeof(uint32_t);
+            return bytes;
+        }
+
+        void clear()
+        {
+            m_data.clear();
+            m_slots.clear();
+            m_freeSlots.clear();
+            for (auto &f : m_freeSpans)
+                f.clear();
+            m_liveSpans = 0;
+            m_liveWaypoints = 0;
+        }
+
+    private:
+        struct Slot
+        {
+            uint32_t offset = 0; // float offset into m_data
+            uint32_t count = 0;  // waypoints in use
+            uint32_t bucket = 0; // capacity class (see bucketCapacity)
+            uint32_t refs = 0;   // 0 = slot is free
+            uint32_t generation = 0; // bumped when the slot is freed
+        };
+
+        static uint32_t bucketCapacity(uint32_t bucket) { return kMinBucketWaypoints << bucket; }
+
+        static uint32_t bucketFor(uint32_t count)
+        {
+            uint32_t b = 0;
+            while (bucketCapacity(b) < count)
+                ++b;
+            return b;
+        }
+
+        std::vector<float> m_data;
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        std::vector<uint32_t> m_freeSpans[kBucketCount];
+
+        uint32_t m_liveSpans = 0;
+        uint32_t m_liveWaypoints = 0;
+    };
+}
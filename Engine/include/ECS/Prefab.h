@@ -283,7 +283,7 @@ namespace Engine::ECS
 
         // Parse defaults: AvoidanceParams
         {
-            std::regex re_ap(R"("AvoidanceParams"\s*:\s*\{\s*"strength"\s*:\s*([-+]?\d*\.?\d+),\s*"maxAccel"\s*:\s*([-+]?\d*\.?\d+),\s*"blend"\s*:\s*([-+]?\d*\.?\d+)\s*\})");
+            std::regex re_ap(R"("AvoidanceParams"\s*:\s*\{\s*"strength"\s*:\s*([-+]?\d*\.?\d+),\s*"maxAccel"\s*:\s*([-+]?\d*\.?\d+),\s*"blend"\s*:\s*([-+]?\d*\.?\d+)(?:\s*,\s*"timeHorizon"\s*:\s*([-+]?\d*\.?\d+))?\s*\})");
             std::smatch m;
             if (std::regex_search(jsonText, m, re_ap))
             {
@@ -291,6 +291,8 @@ namespace Engine::ECS
                 ap.strength = std::stof(m[1].str());
                 ap.maxAccel = std::stof(m[2].str());
                 ap.blend = std::stof(m[3].str());
+                if (m[4].matched)
+                    ap.timeHorizon = std::stof(m[4].str());
                 uint32_t cid = registry.ensureId("AvoidanceParams");
                 p.defaults.emplace(cid, ap);
             }
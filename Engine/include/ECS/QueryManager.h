@@ -122,6 +122,29 @@ namespace Engine::ECS
             }
         }
 
+        // Batched markDirtyComponent: resolves each interested query once, then sets all bits.
+        void markDirtyComponentRows(uint32_t compId, uint32_t archetypeId, const uint32_t *rows, size_t count,
+                                    uint32_t storeSize)
+        {
+            if (count == 0)
+                return;
+            for (auto &q : m_queries)
+            {
+                if (!q.dirtyEnabled)
+                    continue;
+                if (!q.dirtyComponents.has(compId))
+                    continue;
+
+                auto it = q.archetypeToMatchIndex.find(archetypeId);
+                if (it == q.archetypeToMatchIndex.end())
+                    continue;
+                auto &bits = q.dirtyBits[it->second];
+                ensureBitsetSize(bits, storeSize);
+                for (size_t i = 0; i < count; ++i)
+                    setDirtyBit(bits, rows[i]);
+            }
+        }
+
         // Mark a row dirty for ALL dirty-enabled queries that match the store.
         void markRowDirtyAll(uint32_t archetypeId, uint32_t row, uint32_t storeSize)
         {
@@ -138,6 +161,23 @@ namespace Engine::ECS
             }
         }
 
+        // Mark a row dirty for one query only (e.g. to defer a consumed row to a later frame
+        // without waking every other system interested in the same components).
+        void markRowDirty(QueryId qid, uint32_t archetypeId, uint32_t row, uint32_t storeSize)
+        {
+            if (qid >= m_queries.size())
+                return;
+            Query &q = m_queries[qid];
+            if (!q.dirtyEnabled)
+                return;
+            auto it = q.archetypeToMatchIndex.find(archetypeId);
+            if (it == q.archetypeToMatchIndex.end())
+                return;
+            const uint32_t matchIdx = it->second;
+            ensureBitsetSize(q.dirtyBits[matchIdx], storeSize);
+            setDirtyBit(q.dirtyBits[matchIdx], row);
+        }
+
         // Consume and clear dirty rows for a given query+archetype.
         // Returns row indices in ascending order.
         std::vector<uint32_t> consumeDirtyRows(QueryId qid, uint32_t archetypeId)
@@ -175,7 +215,7 @@ namespace Engine::ECS
                 }
                 bits[w] = 0;
             }
-            std::sort(rows.begin(), rows.end());
+            // Words are scanned low to high and bits low to high, so rows are already ascending.
             return rows;
         }
 
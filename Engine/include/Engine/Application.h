@@ -29,12 +29,41 @@ namespace Engine
         // Start main loop (blocks)
         void Run();
 
-        // Called by engine each frame; override in your Sample game class
+        // Called by engine each frame on the main thread (input, camera, ECS edits from UI);
+        // override in your Sample game class
         virtual void OnUpdate(TimeStep) {}
 
+        /**
+         * @brief Heavy per-frame simulation (gameplay systems).
+         *
+         * Serial mode runs it on the main thread right after OnUpdate(). In pipelined mode
+         * (SetPipelinedSimulation) it runs on the simulation thread, overlapping OnRender() and
+         * Renderer::drawFrame() of the previous frame's state: it must not touch the window,
+         * ImGui, the renderer or anything OnRender() reads, only the ECS and sim-owned state.
+         */
+        virtual void OnSimulate(TimeStep) {}
+
+        /**
+         * @brief Copy what rendering needs out of the simulation (main thread).
+         *
+         * The only point where render-side state may read sim state: runs after OnSimulate()
+         * in serial mode, and in pipelined mode after the previous frame's simulation has
+         * finished and before the next one is started.
+         */
+        virtual void OnExtract() {}
+
         // Optional: called after render submission, for UI, etc.
         virtual void OnRender() {}
 
+        /**
+         * @brief Run OnSimulate() for frame N+1 on a dedicated thread while frame N renders.
+         *
+         * Adds one frame of latency between simulation and display; hides whichever of
+         * simulation or render recording is shorter. Takes effect at the next frame.
+         */
+        void SetPipelinedSimulation(bool enabled);
+        bool IsPipelinedSimulation() const;
+
         virtual void handleWindowEvent(const std::string &name);
 
         // Access to window
@@ -57,6 +86,9 @@ namespace Engine
         ImGuiLayer* GetImGuiLayer();
 
     private:
+        // Pipelined mode: block until the in-flight OnSimulate() (if any) has returned.
+        void waitForSimulation();
+
         struct Impl;
         std::unique_ptr<Impl> m_Impl;
     };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Engine
+{
+    /**
+     * @brief Accumulator that turns variable frame times into fixed simulation steps.
+     *
+     * Each frame, advance(frameSeconds) returns how many steps of stepSeconds() to simulate.
+     * The leftover time is exposed as alpha() in [0, 1): how far the display is between the
+     * last two simulated states, for render interpolation.
+     *
+     * At most maxStepsPerFrame() steps are returned per frame. When the simulation falls
+     * further behind (long hitch, breakpoint, sim slower than real time) the excess time is
+     * dropped instead of carried over, so a slow frame cannot snowball into ever longer ones.
+     */
+    class FixedTimestep
+    {
+    public:
+        static constexpr float kDefaultHz = 60.0f;
+        static constexpr uint32_t kDefaultMaxSteps = 4;
+
+        explicit FixedTimestep(float hz = kDefaultHz, uint32_t maxStepsPerFrame = kDefaultMaxSteps)
+        {
+            setRate(hz);
+            setMaxStepsPerFrame(maxStepsPerFrame);
+        }
+
+        /// Simulation rate in steps per second (clamped to [1, 1000]).
+        void setRate(float hz)
+        {
+            m_hz = std::clamp(hz, 1.0f, 1000.0f);
+            m_step = 1.0f / m_hz;
+            m_accumulator = std::min(m_accumulator, m_step);
+        }
+        float rate() const { return m_hz; }
+        float stepSeconds() const { return m_step; }
+
+        /// Catch-up limit per frame (at least 1).
+        void setMaxStepsPerFrame(uint32_t steps) { m_maxSteps = std::max(1u, steps); }
+        uint32_t maxStepsPerFrame() const { return m_maxSteps; }
+
+        /**
+         * @brief Add a frame's wall-clock time.
+         * @return Number of fixed steps to simulate this frame (0..maxStepsPerFrame()).
+         */
+        uint32_t advance(float frameSeconds)
+        {
+            if (frameSeconds > 0.0f)
+                m_accumulator += frameSeconds;
+
+            uint32_t steps = 0;
+            while (m_accumulator >= m_step && steps < m_maxSteps)
+            {
+                m_accumulator -= m_step;
+                ++steps;
+            }
+            if (m_accumulator >= m_step)
+            {
+                // Behind by more than the catch-up limit: drop whole steps, keep the phase.
+                const float behind = m_accumulator - m_step;
+                const uint32_t dropped = static_cast<uint32_t>(behind / m_step) + 1u;
+                m_droppedSteps += dropped;
+                m_accumulator -= static_cast<float>(dropped) * m_step;
+                m_accumulator = std::clamp(m_accumulator, 0.0f, m_step * 0.999f);
+            }
+            m_lastSteps = steps;
+            return steps;
+        }
+
+        /// Fraction of a step elapsed since the last simulated state, in [0, 1).
+        float alpha() const { return std::min(m_accumulator / m_step, 0.999f); }
+
+        /// Steps returned by the last advance().
+        uint32_t lastSteps() const { return m_lastSteps; }
+
+        /// Steps skipped so far because the catch-up limit was hit.
+        uint64_t droppedSteps() const { return m_droppedSteps; }
+
+        void reset()
+        {
+            m_accumulator = 0.0f;
+            m_lastSteps = 0;
+        }
+
+    private:
+        float m_hz = kDefaultHz;
+        float m_step = 1.0f / kDefaultHz;
+        float m_accumulator = 0.0f;
+        uint32_t m_maxSteps = kDefaultMaxSteps;
+        uint32_t m_lastSteps = 0;
+        uint64_t m_droppedSteps = 0;
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Engine/RenderSnapshot.h"
+#include "assets/GpuAnimationData.h"
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+    struct ModelAsset;
+
+    /**
+     * @brief Evaluates one model's poses in a compute dispatch (shaders/pose.comp).
+     *
+     * create() packs the model's animation tables (GpuAnimation::Build) into a device-local
+     * storage buffer once. Each frame the caller hands over one PoseRequest (clip, time) per
+     * pose and the buffers to fill; record() uploads only those 8 bytes per pose and records
+     * a dispatch that writes node globals ([pose][nodeCount]) and joint matrices
+     * ([pose][jointCount]) as PaletteMatrix rows, the layout smodel.vert reads, followed by a
+     * barrier for the vertex stage. Results match ModelAsset::evaluatePoseInto + buildJointPaletteInto up to
+     * float rounding; baked clips are not used.
+     *
+     * Request buffers, descriptor sets and timestamp queries are per frame slot, so a slot
+     * must not be recorded again before the GPU has finished its previous submission (the
+     * renderer's in-flight fence guarantees this).
+     */
+    class GpuPoseEvaluator
+    {
+    public:
+        static constexpr const char *kDefaultShaderPath = "shaders/pose.comp.spv";
+        static constexpr uint32_t kWorkgroupSize = 64; // local_size_x in pose.comp
+
+        GpuPoseEvaluator() = default;
+        ~GpuPoseEvaluator() { destroy(); }
+        GpuPoseEvaluator(const GpuPoseEvaluator &) = delete;
+        GpuPoseEvaluator &operator=(const GpuPoseEvaluator &) = delete;
+
+        /// Build the pipeline and upload `model`'s tables (blocking copy on `queue`). Returns
+        /// false, with nothing left allocated, when the shader cannot be loaded or the device
+        /// refuses a resource; callers fall back to CPU evaluation.
+        bool create(VkDevice device, VkPhysicalDevice physicalDevice, VkQueue queue, uint32_t queueFamilyIndex,
+                    const ModelAsset &model, uint32_t frameSlots, const std::string &shaderPath = kDefaultShaderPath);
+        void destroy();
+        bool valid() const { return m_pipeline != VK_NULL_HANDLE; }
+
+        /// Record the dispatch for `poseCount` requests into `cmd` (outside a render pass).
+        /// nodeOut must hold poseCount * nodeCount() PaletteMatrix entries and jointOut
+        /// poseCount * jointCount() (jointOut may be VK_NULL_HANDLE for unskinned models).
+        bool record(VkCommandBuffer cmd, uint32_t frameSlot, const PoseRequest *requests, uint32_t poseCount,
+                    VkBuffer nodeOut, VkDeviceSize nodeBytes, VkBuffer jointOut, VkDeviceSize jointBytes);
+
+        uint32_t nodeCount() const { return m_layout.nodeCount; }
+        uint32_t jointCount() const { return m_layout.jointCount; }
+        /// Size of the packed animation tables on the GPU.
+        size_t animationBytes() const { return size_t(m_layout.wordCount) * sizeof(uint32_t); }
+
+        /// GPU time of the most recent dispatch whose results are available (0 without
+        /// timestamp support).
+        float lastGpuMs() const { return m_lastGpuMs; }
+
+    private:
+        struct Slot
+        {
+            VkBuffer requestBuffer = VK_NULL_HANDLE;
+            VkDeviceMemory requestMemory = VK_NULL_HANDLE;
+            void *requestMapped = nullptr;
+            uint32_t requestCapacity = 0;
+
+            VkDescriptorSet set = VK_NULL_HANDLE;
+            VkBuffer boundRequests = VK_NULL_HANDLE; // what `set` currently points at
+            VkBuffer boundNodes = VK_NULL_HANDLE;
+            VkDeviceSize boundNodeBytes = 0;
+            VkBuffer boundJoints = VK_NULL_HANDLE;
+            VkDeviceSize boundJointBytes = 0;
+
+            bool queriesWritten = false;
+        };
+
+        struct PushConstants
+        {
+            uint32_t counts[4];  // poseCount, nodeCount, jointCount, clipCount
+            uint32_t tables[4];  // clips, channels, samplers, times
+            uint32_t tables2[4]; // values, rest, order, joints
+        };
+        static_assert(sizeof(PushConstants) == 48, "PushConstants must match pose.comp");
+
+        bool findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties, uint32_t &typeIndex) const;
+        bool createHostBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer, VkDeviceMemory &memory, void **mapped) const;
+        bool uploadAnimation(VkQueue queue, uint32_t queueFamilyIndex, const std::vector<uint32_t> &words);
+        bool ensureRequestCapacity(Slot &slot, uint32_t needed);
+        void readTimestamps(Slot &slot, uint32_t frameSlot);
+
+        VkDevice m_device = VK_NULL_HANDLE;
+        VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+
+        GpuAnimationLayout m_layout{};
+        VkBuffer m_animBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory m_animMemory = VK_NULL_HANDLE;
+
+        VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+        VkDescriptorPool m_pool = VK_NULL_HANDLE;
+        VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+        VkPipeline m_pipeline = VK_NULL_HANDLE;
+        std::vector<Slot> m_slots;
+
+        // Two timestamps per slot around the dispatch.
+        VkQueryPool m_queryPool = VK_NULL_HANDLE;
+        float m_timestampPeriod = 1.0f; // ns per tick
+        float m_lastGpuMs = 0.0f;
+    };
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Small fixed-size worker pool for data-parallel loops.
+     *
+     * parallelFor() splits [0, count) into chunks of `grain` items and runs them on the
+     * workers plus the calling thread, returning once every chunk has finished. Chunks are
+     * handed out dynamically, so which thread runs which chunk varies from call to call:
+     * callers that need deterministic results must make each item's output depend only on
+     * its inputs (read shared state, write only the item's own slot).
+     *
+     * Not re-entrant: do not call parallelFor() from inside a chunk.
+     */
+    class JobSystem
+    {
+    public:
+        /// Chunk callback: items [begin, end), run on thread `threadIndex` (< threadCount()).
+        using ChunkFn = std::function<void(uint32_t begin, uint32_t end, uint32_t threadIndex)>;
+
+        /**
+         * @brief Start the pool.
+         * @param workerCount Background threads to spawn; the caller is used as one more.
+         *                    Defaults to hardware_concurrency() - 1 (at least 0).
+         */
+        explicit JobSystem(uint32_t workerCount = defaultWorkerCount());
+        ~JobSystem();
+
+        JobSystem(const JobSystem &) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+
+        /**
+         * @brief Threads that may execute chunks (workers + the calling thread).
+         */
+        uint32_t threadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+        /**
+         * @brief Run `fn` over [0, count) in chunks of `grain` and wait for completion.
+         *
+         * Runs inline on the calling thread when there are no workers or a single chunk.
+         */
+        void parallelFor(uint32_t count, uint32_t grain, const ChunkFn &fn);
+
+        static uint32_t defaultWorkerCount();
+
+    private:
+        void workerLoop(uint32_t threadIndex);
+        void runChunks(uint32_t threadIndex);
+
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        uint64_t m_generation = 0; // bumped per parallelFor; workers wait for a new value
+        uint32_t m_busyWorkers = 0;
+        bool m_stop = false;
+
+        // Current job (valid while m_busyWorkers > 0 or the caller is in parallelFor).
+        const ChunkFn *m_fn = nullptr;
+        uint32_t m_count = 0;
+        uint32_t m_grain = 1;
+        std::atomic<uint32_t> m_nextChunk{0};
+    };
+}
@@ -4,6 +4,7 @@
 #include <deque>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Engine
 {
@@ -190,4 +191,33 @@ namespace Engine
         static uint32_t get();
     };
 
+    /**
+     * @brief Global named stats published by gameplay code (pathfinding, simulation, ...).
+     * Shown in the overlay's "Simulation" section in first-published order.
+     * Thread-safe; values persist until overwritten or removed.
+     */
+    class OverlayStats
+    {
+    public:
+        /**
+         * @brief Publish or update a stat.
+         * @param label Display label (also the key)
+         * @param value Current value
+         * @param format printf-style format for the value (single float argument)
+         */
+        static void set(const std::string& label, float value, const char* format = "%.0f");
+        static void remove(const std::string& label);
+        static void clear();
+
+        struct Entry
+        {
+            std::string label;
+            std::string text;
+        };
+        /**
+         * @brief Snapshot of all stats with values already formatted.
+         */
+        static std::vector<Entry> snapshot();
+    };
+
 } // namespace Engine
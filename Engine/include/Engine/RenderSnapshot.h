@@ -0,0 +1,159 @@
+#pragma once
+
+#include "assets/Handles.h"
+#include "assets/PaletteMatrix.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Engine
+{
+    /// One pose for the GPU pose path (GpuPoseEvaluator): clip index and playback time.
+    struct PoseRequest
+    {
+        uint32_t clip = 0;
+        float timeSec = 0.0f;
+    };
+    static_assert(sizeof(PoseRequest) == 8, "PoseRequest must match uvec2 in pose.comp");
+
+    /**
+     * @brief Instances of one model extracted for drawing.
+     *
+     * Palettes are flattened per pose: nodePalette is [pose][paletteNodeCount] and jointPalette
+     * is [pose][jointCount] (empty when the model is unskinned), both as PaletteMatrix rows,
+     * byte for byte what the palette SSBOs hold. paletteNodeCount equals nodeCount unless the
+     * extraction kept only the model's palette nodes (ModelAsset::paletteNodes, the nodes
+     * drawing unskinned primitives). Instances that share a pose point at the same entry
+     * through instancePoses, so poseCount can be far below instanceCount() in a crowd.
+     * GPU pose path: poseRequests holds one (clip, time) per pose instead, the palettes stay
+     * empty and the model's pass evaluates them in a compute dispatch before drawing.
+     * The vectors keep their capacity between frames; clear() only resets the sizes.
+     */
+    struct RenderBatch
+    {
+        ModelHandle model{};
+        std::vector<glm::mat4> instanceWorlds;
+        std::vector<uint32_t> instancePoses; // per instance: pose index into the palettes
+        std::vector<PaletteMatrix> nodePalette;
+        uint32_t nodeCount = 0;        // the model's nodes
+        uint32_t paletteNodeCount = 0; // nodePalette entries per pose
+        std::vector<PaletteMatrix> jointPalette;
+        uint32_t jointCount = 0;
+        std::vector<PoseRequest> poseRequests; // per pose, GPU pose path only
+        uint32_t poseCount = 0;
+
+        uint32_t instanceCount() const { return static_cast<uint32_t>(instanceWorlds.size()); }
+
+        void clear()
+        {
+            instanceWorlds.clear();
+            instancePoses.clear();
+            nodePalette.clear();
+            jointPalette.clear();
+            poseRequests.clear();
+            nodeCount = 0;
+            paletteNodeCount = 0;
+            jointCount = 0;
+            poseCount = 0;
+        }
+    };
+
+    /**
+     * @brief Everything the render passes need for one frame, copied out of gameplay state.
+     *
+     * Filled by an extraction stage on the game side, then read by render pass modules
+     * while recording. Nothing in it points back into ECS storage, so the simulation may
+     * mutate (or reallocate) its columns while a snapshot is being recorded.
+     */
+    struct RenderSnapshot
+    {
+        uint64_t frame = 0;
+
+        bool hasCamera = false;
+        glm::mat4 view{1.0f};
+        glm::mat4 proj{1.0f};
+
+        /// One batch per model. Only the first batchCount entries are valid this frame;
+        /// the rest are kept for their allocations.
+        std::vector<RenderBatch> batches;
+        uint32_t batchCount = 0;
+
+        uint32_t visibleInstances = 0;
+        uint32_t culledInstances = 0;
+        uint32_t uniquePoses = 0; // palette entries across all batches
+
+        /// Batch for `model`, or nullptr when the model has no instances this frame.
+        const RenderBatch *find(ModelHandle model) const
+        {
+            for (uint32_t i = 0; i < batchCount; ++i)
+            {
+                const RenderBatch &b = batches[i];
+                if (b.model.id == model.id && b.model.generation == model.generation)
+                    return b.instanceWorlds.empty() ? nullptr : &b;
+            }
+            return nullptr;
+        }
+    };
+
+    /**
+     * @brief Triple-buffered RenderSnapshot handoff between the extraction stage and the renderer.
+     *
+     * The writer fills beginWrite() and calls publish(); the reader takes the newest published
+     * snapshot with acquireRead() and may keep using it until its next acquireRead(). With three
+     * slots the writer never has to wait for, or overwrite, the snapshot being recorded.
+     *
+     * One writer thread and one reader thread at a time.
+     */
+    class RenderSnapshotBuffer
+    {
+    public:
+        static constexpr uint32_t kSlots = 3;
+
+        /// Slot to fill for the next frame (neither the one being read nor the latest published).
+        RenderSnapshot &beginWrite()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (uint32_t i = 0; i < kSlots; ++i)
+            {
+                if (i != m_reading && i != m_published)
+                {
+                    m_writing = i;
+                    break;
+                }
+            }
+            RenderSnapshot &snap = m_slots[m_writing];
+            snap.frame = ++m_frameCounter;
+            return snap;
+        }
+
+        /// Make the slot returned by beginWrite() the newest snapshot.
+        void publish()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_published = m_writing;
+            m_hasPublished = true;
+        }
+
+        /// Newest published snapshot, or nullptr before the first publish().
+        const RenderSnapshot *acquireRead()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_hasPublished)
+                return nullptr;
+            m_reading = m_published;
+            return &m_slots[m_reading];
+        }
+
+    private:
+        std::mutex m_mutex;
+        RenderSnapshot m_slots[kSlots];
+        uint32_t m_writing = 0;
+        uint32_t m_published = 1;
+        uint32_t m_reading = 2;
+        bool m_hasPublished = false;
+        uint64_t m_frameCounter = 0;
+    };
+}
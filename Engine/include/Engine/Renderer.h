@@ -5,6 +5,7 @@
 #include <memory>
 #include <functional>
 #include "Structs/FrameContextStruct.h"
+#include "Engine/RenderSnapshot.h"
 
 namespace Engine
 {
@@ -13,7 +14,8 @@ namespace Engine
     class RenderPassModule;
     // Renderer: owns the main on-screen VkRenderPass, per-swapchain VkFramebuffer objects,
     // and per-frame command pools/buffers and synchronization objects. It calls registered
-    // RenderPassModule::record() while the main render pass is active.
+    // RenderPassModule::recordPrePass() before the main render pass begins and
+    // RenderPassModule::record() while it is active.
 
     class Renderer
     {
@@ -52,6 +54,10 @@ namespace Engine
         // Get the last measured GPU frame time in milliseconds
         float getGpuTimeMs() const { return m_gpuTimeMs; }
 
+        // Render snapshots written by the game's extraction stage. drawFrame() acquires the
+        // newest one and hands it to the modules through FrameContext::snapshot.
+        RenderSnapshotBuffer &snapshots() { return m_snapshots; }
+
     private:
         VulkanContext *m_ctx = nullptr;
         SwapChain *m_swapchain = nullptr;
@@ -83,6 +89,8 @@ namespace Engine
         // Optional ImGui render callback
         ImGuiRenderCallback m_imguiRenderCallback;
 
+        RenderSnapshotBuffer m_snapshots;
+
         // GPU timestamp query support
         VkQueryPool m_timestampQueryPool = VK_NULL_HANDLE;
         float m_timestampPeriod = 1.0f;  // Nanoseconds per timestamp tick
@@ -120,6 +128,15 @@ namespace Engine
         // Called after the main render pass and framebuffers are created
         virtual void onCreate(VulkanContext &ctx, VkRenderPass pass, const std::vector<VkFramebuffer> &fbs) = 0;
 
+        // Record work that must happen outside the main render pass (compute dispatches whose
+        // results record() draws with). Called for every module, in registration order, before
+        // the render pass begins; frameCtx.snapshot is already set.
+        virtual void recordPrePass(FrameContext &frameCtx, VkCommandBuffer cmd)
+        {
+            (void)frameCtx;
+            (void)cmd;
+        }
+
         // Record drawing commands for this pass into the provided command buffer
         virtual void record(FrameContext &frameCtx, VkCommandBuffer cmd) = 0;
 
@@ -4,7 +4,10 @@
 #include "assets/AssetManager.h"
 #include "assets/TextureAsset.h"
 #include "Engine/Camera.h"
+#include "Engine/GpuPoseEvaluator.h"
 #include <vulkan/vulkan.h>
+#include <memory>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -38,8 +41,10 @@ namespace Engine
         // If not called (or count==0), the module defaults to drawing 1 instance at identity.
         void setInstances(const glm::mat4 *instanceWorlds, uint32_t count);
 
-        // Per-instance node global matrices, flattened as [instance][node].
-        // Must be called when using per-entity animation (palette indexed by gl_InstanceIndex).
+        // Per-instance node global matrices, flattened as [instance][node] (stored and uploaded
+        // as PaletteMatrix rows).
+        // Must be called when using per-entity animation (instance i draws with pose i; the
+        // snapshot path can share poses between instances, see RenderBatch::instancePoses).
         void setNodePalette(const glm::mat4 *nodeGlobals, uint32_t instanceCount, uint32_t nodeCount);
 
         // Per-instance joint matrices, flattened as [instance][joint].
@@ -47,6 +52,18 @@ namespace Engine
         // to offset into this global joint palette.
         void setJointPalette(const glm::mat4 *jointMatrices, uint32_t instanceCount, uint32_t jointCount);
 
+        // Draw from the renderer's RenderSnapshot (FrameContext::snapshot) instead of the
+        // set*() copies above: the batch for this module's model supplies instances and
+        // palettes (deduplicated poses + per-instance pose index), and the snapshot's view/proj
+        // replace the live camera. No batch => no draw.
+        void setUseSnapshot(bool use) { m_useSnapshot = use; }
+
+        // GPU pose path: when the snapshot batch carries poseRequests instead of palettes,
+        // recordPrePass() evaluates them with a GpuPoseEvaluator straight into this frame's
+        // palette buffers (created on first use; if pose.comp.spv cannot be loaded the module
+        // evaluates the requests on the CPU instead, once per pose).
+        void recordPrePass(FrameContext &frameCtx, VkCommandBuffer cmd) override;
+
         // Column-major 4x4 matrix (16 floats). Defaults to identity.
         void setModelMatrix(const float *m16);
 
@@ -56,13 +73,18 @@ namespace Engine
         void onDestroy(VulkanContext &ctx) override;
 
     private:
+        // Per-frame instance vertex buffer: `capacity` world matrices (binding 1) followed by
+        // `capacity` uint32 pose indices (binding 2, at poseIndexOffset()).
         struct InstanceFrame
         {
             VkBuffer buffer = VK_NULL_HANDLE;
             VkDeviceMemory memory = VK_NULL_HANDLE;
             void *mapped = nullptr;
             uint32_t capacity = 0;
+
+            VkDeviceSize poseIndexOffset() const { return static_cast<VkDeviceSize>(capacity) * sizeof(glm::mat4); }
         };
+        static constexpr VkDeviceSize kInstanceBytes = sizeof(glm::mat4) + sizeof(uint32_t);
 
         struct PushConstantsModel
         {
@@ -70,7 +92,8 @@ namespace Engine
             float baseColorFactor[4];
             float materialParams[4]; // x=alphaCutoff, y=alphaMode, z/w unused
 
-            // Which node is being drawn; vertex shader fetches from palette[gl_InstanceIndex][nodeIndex]
+            // Palette slot of the node being drawn and palette nodes per pose; the vertex shader
+            // fetches palette[poseIndex * nodeCount + nodeIndex]
             uint32_t nodeIndex = 0;
             uint32_t nodeCount = 0;
 
@@ -81,7 +104,7 @@ namespace Engine
             // Skinning info:
             // - skinBaseJoint: base offset into joint palette for this primitive's skin
             // - skinJointCount: number of joints in this skin (0 => unskinned)
-            // - jointPaletteStride: total joint count for this model (used to stride per instance)
+            // - jointPaletteStride: total joint count for this model (used to stride per pose)
             // - flags: reserved
             uint32_t skinBaseJoint = 0;
             uint32_t skinJointCount = 0;
@@ -131,11 +154,15 @@ namespace Engine
         void destroyMaterialResources();
         VkDescriptorSet getOrCreateMaterialSet(MaterialHandle h, const MaterialAsset *mat);
 
+        void evaluatePosesOnCpu(const ModelAsset &model, const RenderBatch &batch, CameraFrame &frame);
+
         VkPipelineColorBlendStateCreateInfo makeBlendState(bool enableBlend, VkPipelineColorBlendAttachmentState &outAttachment) const;
 
     private:
         VkDevice m_device = VK_NULL_HANDLE;
         VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+        VkQueue m_queue = VK_NULL_HANDLE;
+        uint32_t m_queueFamilyIndex = 0;
         VkExtent2D m_extent{};
 
         AssetManager *m_assets = nullptr;
@@ -143,6 +170,7 @@ namespace Engine
         Camera *m_camera = nullptr;
 
         bool m_enabled = true;
+        bool m_useSnapshot = false;
 
         VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
         Pipeline m_pipelineOpaque;
@@ -161,11 +189,23 @@ namespace Engine
         std::vector<glm::mat4> m_instanceWorlds;
 
         // Flattened node globals uploaded to a per-frame SSBO
-        std::vector<glm::mat4> m_nodePalette;
-        std::vector<glm::mat4> m_jointPalette;
+        std::vector<PaletteMatrix> m_nodePalette;
+        std::vector<PaletteMatrix> m_jointPalette;
         uint32_t m_jointPaletteJointCount = 0;
         uint32_t m_paletteInstanceCount = 0;
         uint32_t m_paletteNodeCount = 0;
+        std::string m_uploadStat; // overlay label for palette bytes uploaded per frame
+
+        // GPU pose path (recordPrePass). m_posesWritten: this frame's palettes are already in
+        // the buffers, record() must not overwrite them.
+        std::unique_ptr<GpuPoseEvaluator> m_gpuPoses;
+        bool m_gpuPosesFailed = false;
+        bool m_posesWritten = false;
+        std::string m_gpuPoseStat;
+        std::vector<ModelAsset::NodeTRS> m_cpuTrs;
+        std::vector<glm::mat4> m_cpuLocals;
+        std::vector<glm::mat4> m_cpuGlobals;
+        std::vector<PaletteMatrix> m_cpuJoints;
 
         TextureAsset m_fallbackWhiteTexture;
 
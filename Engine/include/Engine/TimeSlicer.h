@@ -0,0 +1,164 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Time budget handed to one step of a time-sliced job.
+     *
+     * Jobs do small units of work and check expired() between them (every item, or every few
+     * hundred cheap items), returning as soon as it reports true.
+     */
+    class TimeSlice
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit TimeSlice(Clock::time_point deadline) : m_deadline(deadline) {}
+
+        /// A slice that never expires (run a job to completion synchronously).
+        static TimeSlice unbounded() { return TimeSlice(Clock::time_point::max()); }
+
+        bool expired() const { return m_deadline != Clock::time_point::max() && Clock::now() >= m_deadline; }
+
+        /// Microseconds left (0 once expired; INT64_MAX when unbounded).
+        int64_t remainingUs() const
+        {
+            if (m_deadline == Clock::time_point::max())
+                return INT64_MAX;
+            const auto left = std::chrono::duration_cast<std::chrono::microseconds>(m_deadline - Clock::now()).count();
+            return left > 0 ? static_cast<int64_t>(left) : 0;
+        }
+
+    private:
+        Clock::time_point m_deadline;
+    };
+
+    /**
+     * @brief Runs resumable, non-urgent jobs within a per-frame microsecond budget.
+     *
+     * A job is a step function called once per run() slot with a TimeSlice; it works until
+     * the slice expires and returns true when finished, false to be resumed on a later run().
+     * All state needed to resume lives in the job (or the object it belongs to).
+     *
+     * run(budgetUs) steps pending jobs round-robin (a job that yields goes to the back of the
+     * queue) until the budget is used up. The first step of each run() always happens, even
+     * with a zero budget, so every job keeps making progress.
+     *
+     * Not thread-safe: submit(), cancel() and run() must be called from the same thread.
+     */
+    class TimeSlicer
+    {
+    public:
+        using JobId = uint32_t;
+        static constexpr JobId kInvalidJob = 0;
+
+        /// Step function: return true when the job is done.
+        using StepFn = std::function<bool(TimeSlice &)>;
+
+        JobId submit(std::string name, StepFn step)
+        {
+            Job job;
+            job.id = m_nextId++;
+            if (m_nextId == kInvalidJob)
+                m_nextId = 1;
+            job.name = std::move(name);
+            job.step = std::move(step);
+            m_jobs.push_back(std::move(job));
+            return m_jobs.back().id;
+        }
+
+        bool isPending(JobId id) const
+        {
+            if (id == kInvalidJob)
+                return false;
+            for (const Job &job : m_jobs)
+            {
+                if (job.id == id)
+                    return true;
+            }
+            return false;
+        }
+
+        /// Drop a pending job without running it again.
+        void cancel(JobId id)
+        {
+            for (size_t i = 0; i < m_jobs.size(); ++i)
+            {
+                if (m_jobs[i].id == id)
+                {
+                    m_jobs.erase(m_jobs.begin() + static_cast<std::ptrdiff_t>(i));
+                    return;
+                }
+            }
+        }
+
+        /**
+         * @brief Step pending jobs for up to budgetUs microseconds.
+         * @return Number of jobs that finished during this call.
+         */
+        uint32_t run(uint32_t budgetUs)
+        {
+            const TimeSlice::Clock::time_point start = TimeSlice::Clock::now();
+            const TimeSlice::Clock::time_point deadline = start + std::chrono::microseconds(budgetUs);
+
+            uint32_t finished = 0;
+            uint32_t steps = 0;
+            // Each job gets at most one step per run(), so a job that finishes early leaves
+            // the rest of the budget to the ones behind it without lapping them.
+            const size_t queued = m_jobs.size();
+            for (size_t i = 0; i < queued && !m_jobs.empty(); ++i)
+            {
+                if (steps > 0 && TimeSlice::Clock::now() >= deadline)
+                    break;
+
+                Job job = std::move(m_jobs.front());
+                m_jobs.erase(m_jobs.begin());
+
+                TimeSlice slice(deadline);
+                ++steps;
+                if (job.step(slice))
+                {
+                    ++finished;
+                    ++m_completed;
+                }
+                else
+                {
+                    m_jobs.push_back(std::move(job));
+                }
+            }
+
+            m_lastRunUs = std::chrono::duration<float, std::micro>(TimeSlice::Clock::now() - start).count();
+            m_lastSteps = steps;
+            return finished;
+        }
+
+        size_t pendingCount() const { return m_jobs.size(); }
+
+        /// Wall time spent in the last run(), in microseconds (can exceed the budget by one
+        /// job's check granularity).
+        float lastRunUs() const { return m_lastRunUs; }
+        uint32_t lastSteps() const { return m_lastSteps; }
+        uint64_t completedJobs() const { return m_completed; }
+
+    private:
+        struct Job
+        {
+            JobId id = kInvalidJob;
+            std::string name;
+            StepFn step;
+        };
+
+        std::vector<Job> m_jobs; // front = next to run
+        JobId m_nextId = 1;
+        float m_lastRunUs = 0.0f;
+        uint32_t m_lastSteps = 0;
+        uint64_t m_completed = 0;
+    };
+}
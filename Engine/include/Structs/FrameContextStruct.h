@@ -1,5 +1,11 @@
 #pragma once
 #include <vulkan/vulkan.h>
+
+namespace Engine
+{
+    struct RenderSnapshot;
+}
+
 // Per-frame resources (one slot per in-flight frame)
 struct FrameContext
 {
@@ -9,4 +15,7 @@ struct FrameContext
     VkSemaphore renderFinishedSemaphore = VK_NULL_HANDLE;
     VkFence inFlightFence = VK_NULL_HANDLE;
     uint32_t frameIndex = 0;
-};
\ No newline at end of file
+
+    // Newest published render snapshot (nullptr until the game publishes one).
+    const Engine::RenderSnapshot *snapshot = nullptr;
+};
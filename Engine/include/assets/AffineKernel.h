@@ -0,0 +1,88 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#if !defined(STRATO_AFFINE_SCALAR)
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define STRATO_AFFINE_SSE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define STRATO_AFFINE_NEON 1
+#endif
+#endif
+
+namespace Engine
+{
+    /**
+     * @brief Matrix products for node hierarchies (parent global * child local).
+     *
+     * Node locals composed from TRS are affine (last row 0, 0, 0, 1), so each output column is
+     * three scaled columns of `a` (plus a's translation for column 3), one vector register per
+     * column. Results match glm's operator* up to float rounding order.
+     * Define STRATO_AFFINE_SCALAR to force the scalar path.
+     */
+    namespace AffineKernel
+    {
+#if defined(STRATO_AFFINE_SSE)
+        constexpr const char *kIsaName = "SSE";
+#elif defined(STRATO_AFFINE_NEON)
+        constexpr const char *kIsaName = "NEON";
+#else
+        constexpr const char *kIsaName = "scalar";
+#endif
+
+        /// out = a * b for affine b (b's last row ignored and taken as 0, 0, 0, 1). `a` may be
+        /// any 4x4. `out` must not alias `a` or `b`.
+        inline void MulAffineScalar(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &out)
+        {
+            for (int c = 0; c < 3; ++c)
+                out[c] = a[0] * b[c][0] + a[1] * b[c][1] + a[2] * b[c][2];
+            out[3] = a[0] * b[3][0] + a[1] * b[3][1] + a[2] * b[3][2] + a[3];
+        }
+
+        inline void MulAffine(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &out)
+        {
+#if defined(STRATO_AFFINE_SSE)
+            const float *pa = glm::value_ptr(a);
+            const float *pb = glm::value_ptr(b);
+            float *po = glm::value_ptr(out);
+            const __m128 a0 = _mm_loadu_ps(pa + 0);
+            const __m128 a1 = _mm_loadu_ps(pa + 4);
+            const __m128 a2 = _mm_loadu_ps(pa + 8);
+            const __m128 a3 = _mm_loadu_ps(pa + 12);
+            for (int c = 0; c < 4; ++c)
+            {
+                const float *bc = pb + 4 * c;
+                __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(bc[0])),
+                                                 _mm_mul_ps(a1, _mm_set1_ps(bc[1]))),
+                                      _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+                if (c == 3)
+                    r = _mm_add_ps(r, a3);
+                _mm_storeu_ps(po + 4 * c, r);
+            }
+#elif defined(STRATO_AFFINE_NEON)
+            const float *pa = glm::value_ptr(a);
+            const float *pb = glm::value_ptr(b);
+            float *po = glm::value_ptr(out);
+            const float32x4_t a0 = vld1q_f32(pa + 0);
+            const float32x4_t a1 = vld1q_f32(pa + 4);
+            const float32x4_t a2 = vld1q_f32(pa + 8);
+            const float32x4_t a3 = vld1q_f32(pa + 12);
+            for (int c = 0; c < 4; ++c)
+            {
+                const float *bc = pb + 4 * c;
+                float32x4_t r = vmulq_n_f32(a0, bc[0]);
+                r = vmlaq_n_f32(r, a1, bc[1]);
+                r = vmlaq_n_f32(r, a2, bc[2]);
+                if (c == 3)
+                    r = vaddq_f32(r, a3);
+                vst1q_f32(po + 4 * c, r);
+            }
+#else
+            MulAffineScalar(a, b, out);
+#endif
+        }
+    }
+}
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "assets/AnimationQuantization.h"
+#include "assets/ModelAsset.h"
+#include "assets/model/SModelAnimationRecords.h"
+
+namespace Engine
+{
+    /**
+     * @brief Cook-time compression of .smodel animation tables (GltfToSmodel --compress-anim).
+     *
+     * Per channel, in order:
+     * - Constant channels collapse to one key. If that key equals the node's rest value, the
+     *   channel is dropped; the runtime starts every node from its rest TRS anyway.
+     * - Keyframe reduction: a key is dropped while interpolating between its kept neighbours
+     *   reproduces every dropped key within the tolerance. A reduced channel needs its own key
+     *   times, so the reduction is only kept when it beats the full key set, whose times are
+     *   shared.
+     * - Quantization of the remaining keys (see AnimQuant): 48-bit smallest-three
+     *   quaternions, and 16-bit translation / scale components over the sampler's own range.
+     * Identical key time arrays are stored once. Only linear samplers are compressed; step and
+     * cubic-spline samplers are copied unchanged.
+     */
+    namespace AnimCompression
+    {
+        struct Settings
+        {
+            float translationTolerance = 1e-4f; // model units
+            float rotationTolerance = 5e-4f;    // radians
+            float scaleTolerance = 1e-4f;
+            bool stripConstant = true; // collapse constant channels, drop those at rest
+            bool reduceKeys = true;
+            bool quantize = true;
+        };
+
+        /// The five animation tables of a .smodel / ModelAsset.
+        struct Tables
+        {
+            std::vector<smodel::SModelAnimationClipRecord> clips;
+            std::vector<smodel::SModelAnimationChannelRecord> channels;
+            std::vector<smodel::SModelAnimationSamplerRecord> samplers;
+            std::vector<float> times;
+            std::vector<float> values;
+
+            size_t bytes() const
+            {
+                return clips.size() * sizeof(clips[0]) + channels.size() * sizeof(channels[0]) +
+                       samplers.size() * sizeof(samplers[0]) + (times.size() + values.size()) * sizeof(float);
+            }
+        };
+
+        struct ClipReport
+        {
+            uint32_t channelsIn = 0;
+            uint32_t channelsOut = 0;
+            uint32_t keysIn = 0;
+            uint32_t keysOut = 0;
+            size_t bytesIn = 0;  // channel + sampler records, key times, values
+            size_t bytesOut = 0; // same; shared key times count for the first clip using them
+            float maxTranslationError = 0.0f;
+            float maxRotationError = 0.0f; // radians
+            float maxScaleError = 0.0f;
+        };
+
+        /// True when the times are evenly spaced from the first to the last key.
+        inline bool HasUniformTimes(const float *times, uint32_t count)
+        {
+            if (count < 2)
+                return false;
+            const double span = double(times[count - 1]) - double(times[0]);
+            if (span <= 1e-6)
+                return false;
+            const double step = span / double(count - 1);
+            for (uint32_t i = 1; i + 1 < count; ++i)
+            {
+                if (std::abs(double(times[i]) - (double(times[0]) + step * i)) > step * 1e-3)
+                    return false;
+            }
+            return true;
+        }
+
+        /// Angle between two rotations (radians, shortest arc).
+        inline float RotationAngle(const glm::quat &a, const glm::quat &b)
+        {
+            const glm::quat d = b * glm::conjugate(a);
+            return 2.0f * std::atan2(glm::length(glm::vec3(d.x, d.y, d.z)), std::fabs(d.w));
+        }
+
+        inline glm::quat SlerpShortest(const glm::quat &a, glm::quat b, float t)
+        {
+            if (glm::dot(a, b) < 0.0f)
+                b = -b;
+            return glm::normalize(glm::slerp(a, b, t));
+        }
+
+        // Indices of the keys to keep (first and last always kept).
+        template <typename V, typename Blend, typename Dist>
+        std::vector<uint32_t> ReduceKeys(const float *times, const std::vector<V> &keys, float tolerance,
+                                         Blend &&blend, Dist &&dist)
+        {
+            const uint32_t n = static_cast<uint32_t>(keys.size());
+            std::vector<uint32_t> kept;
+            if (n == 0)
+                return kept;
+            kept.push_back(0);
+            uint32_t a = 0;
+            for (uint32_t b = 2; b < n; ++b)
+            {
+                const float span = times[b] - times[a];
+                bool ok = span > 0.0f;
+                for (uint32_t k = a + 1; k < b && ok; ++k)
+                    ok = dist(blend(keys[a], keys[b], (times[k] - times[a]) / span), keys[k]) <= tolerance;
+                if (!ok)
+                {
+                    kept.push_back(b - 1);
+                    a = b - 1;
+                }
+            }
+            if (n > 1)
+                kept.push_back(n - 1);
+            return kept;
+        }
+
+        // Key times appended once per distinct array.
+        class TimeTable
+        {
+        public:
+            explicit TimeTable(std::vector<float> &times) : m_times(times) {}
+
+            /// Offset of `count` times equal to `src`; appended when new (added = true).
+            uint32_t add(const float *src, uint32_t count, bool &added)
+            {
+                uint64_t h = 1469598103934665603ull ^ count;
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    uint32_t bits;
+                    std::memcpy(&bits, &src[i], sizeof(bits));
+                    h = (h ^ bits) * 1099511628211ull;
+                }
+                auto &bucket = m_index[h];
+                for (const auto &entry : bucket)
+                {
+                    if (entry.second == count && std::memcmp(m_times.data() + entry.first, src, count * sizeof(float)) == 0)
+                    {
+                        added = false;
+                        return entry.first;
+                    }
+                }
+                const uint32_t first = static_cast<uint32_t>(m_times.size());
+                m_times.insert(m_times.end(), src, src + count);
+                bucket.emplace_back(first, count);
+                added = true;
+                return first;
+            }
+
+        private:
+            std::vector<float> &m_times;
+            std::unordered_map<uint64_t, std::vector<std::pair<uint32_t, uint32_t>>> m_index; // hash -> (first, count)
+        };
+
+        inline glm::vec3 RestVec3(const ModelAsset::NodeTRS &rest, uint16_t path)
+        {
+            return path == uint16_t(smodel::SModelAnimPath::Scale) ? rest.s : rest.t;
+        }
+
+        /// Max per-channel error of clip `clipIndex` of `out` against `in`, sampled at every key
+        /// time of the input channels and halfway between them. Channels missing from `out`
+        /// are compared against the rest pose.
+        inline void MeasureClipError(const Tables &in, const Tables &out, const std::vector<ModelAsset::NodeTRS> &rest,
+                                     uint32_t clipIndex, ClipReport &report)
+        {
+            const auto &clipIn = in.clips[clipIndex];
+            const auto &clipOut = out.clips[clipIndex];
+
+            std::unordered_map<uint64_t, uint32_t> outSampler; // (node, path) -> sampler
+            for (uint32_t c = 0; c < clipOut.channelCount; ++c)
+            {
+                const auto &ch = out.channels[clipOut.firstChannel + c];
+                outSampler[(uint64_t(ch.targetNode) << 16) | ch.path] = ch.samplerIndex;
+            }
+
+            for (uint32_t c = 0; c < clipIn.channelCount; ++c)
+            {
+                const auto &ch = in.channels[clipIn.firstChannel + c];
+                if (ch.targetNode >= rest.size())
+                    continue;
+                const auto &si = in.samplers[ch.samplerIndex];
+                const float *timesIn = in.times.data() + si.firstTime;
+                const float *valuesIn = in.values.data() + si.firstValue;
+                const bool quantIn = AnimQuant::IsQuantized(si);
+
+                auto found = outSampler.find((uint64_t(ch.targetNode) << 16) | ch.path);
+                const smodel::SModelAnimationSamplerRecord *so = found != outSampler.end() ? &out.samplers[found->second] : nullptr;
+
+                for (uint32_t k = 0; k < si.timeCount * 2 - 1; ++k)
+                {
+                    const float t = (k & 1u) ? 0.5f * (timesIn[k / 2] + timesIn[k / 2 + 1]) : timesIn[k / 2];
+                    if (ch.path == uint16_t(smodel::SModelAnimPath::Rotation))
+                    {
+                        const glm::quat a = ModelAsset::SampleQuat(timesIn, valuesIn, si.timeCount, t, quantIn);
+                        const glm::quat b = so ? ModelAsset::SampleQuat(out.times.data() + so->firstTime, out.values.data() + so->firstValue,
+                                                                        so->timeCount, t, AnimQuant::IsQuantized(*so))
+                                               : rest[ch.targetNode].r;
+                        report.maxRotationError = std::max(report.maxRotationError, RotationAngle(a, b));
+                    }
+                    else
+                    {
+                        const glm::vec3 a = ModelAsset::SampleVec3(timesIn, valuesIn, si.timeCount, t, quantIn);
+                        const glm::vec3 b = so ? ModelAsset::SampleVec3(out.times.data() + so->firstTime, out.values.data() + so->firstValue,
+                                                                        so->timeCount, t, AnimQuant::IsQuantized(*so))
+                                               : RestVec3(rest[ch.targetNode], ch.path);
+                        float &err = ch.path == uint16_t(smodel::SModelAnimPath::Scale) ? report.maxScaleError : report.maxTranslationError;
+                        err = std::max(err, glm::length(a - b));
+                    }
+                }
+            }
+        }
+
+        /// Compresses every clip of `in` into `out` (rest: node rest TRS, indexed by node).
+        /// reports (optional) gets one entry per clip, errors included.
+        inline void Compress(const Tables &in, const std::vector<ModelAsset::NodeTRS> &rest, const Settings &settings,
+                             Tables &out, std::vector<ClipReport> *reports = nullptr)
+        {
+            out = Tables{};
+            TimeTable timeTable(out.times);
+            if (reports)
+                reports->assign(in.clips.size(), ClipReport{});
+
+            std::vector<glm::vec3> vecKeys;
+            std::vector<glm::quat> quatKeys;
+            std::vector<float> keptTimes;
+            for (uint32_t ci = 0; ci < in.clips.size(); ++ci)
+            {
+                smodel::SModelAnimationClipRecord clip = in.clips[ci];
+                ClipReport report;
+                clip.firstChannel = static_cast<uint32_t>(out.channels.size());
+                clip.channelCount = 0;
+
+                for (uint32_t c = 0; c < in.clips[ci].channelCount; ++c)
+                {
+                    const uint32_t chIdx = in.clips[ci].firstChannel + c;
+                    if (chIdx >= in.channels.size())
+                        break;
+                    const auto &ch = in.channels[chIdx];
+                    if (ch.samplerIndex >= in.samplers.size())
+                        continue;
+                    const auto &s = in.samplers[ch.samplerIndex];
+                    if (s.timeCount == 0 || size_t(s.firstTime) + s.timeCount > in.times.size() ||
+                        size_t(s.firstValue) + s.valueCount > in.values.size())
+                        continue;
+                    const float *times = in.times.data() + s.firstTime;
+                    const float *values = in.values.data() + s.firstValue;
+                    ++report.channelsIn;
+                    report.keysIn += s.timeCount;
+                    report.bytesIn += sizeof(ch) + sizeof(s) + (size_t(s.timeCount) + s.valueCount) * sizeof(float);
+
+                    smodel::SModelAnimationSamplerRecord so = s;
+                    so.flags = 0;
+                    const bool isQuat = s.valueType == uint8_t(smodel::SModelAnimValueType::Quat);
+                    const bool quantIn = AnimQuant::IsQuantized(s);
+                    const bool linear = s.interpolation == uint8_t(smodel::SModelAnimInterpolation::Linear);
+                    const bool hasRest = ch.targetNode < rest.size();
+
+                    // Keys to keep, as indices into the source keys.
+                    auto allKeys = [&]()
+                    {
+                        std::vector<uint32_t> all(s.timeCount);
+                        for (uint32_t k = 0; k < s.timeCount; ++k)
+                            all[k] = k;
+                        return all;
+                    };
+                    std::vector<uint32_t> kept;
+                    if (!linear)
+                    {
+                        kept = allKeys();
+                    }
+                    else if (isQuat)
+                    {
+                        const float tol = settings.rotationTolerance;
+                        quatKeys.resize(s.timeCount);
+                        for (uint32_t k = 0; k < s.timeCount; ++k)
+                            quatKeys[k] = AnimQuant::LoadQuatKey(values, quantIn, k);
+                        bool constant = true;
+                        for (uint32_t k = 1; k < s.timeCount && constant; ++k)
+                            constant = RotationAngle(quatKeys[0], quatKeys[k]) <= tol;
+                        if (constant && settings.stripConstant && hasRest && RotationAngle(quatKeys[0], rest[ch.targetNode].r) <= tol)
+                            continue; // rest pose
+                        if (constant && settings.stripConstant)
+                            kept.push_back(0);
+                        else if (settings.reduceKeys)
+                            kept = ReduceKeys(times, quatKeys, tol, SlerpShortest, RotationAngle);
+                        else
+                            kept = allKeys();
+                    }
+                    else
+                    {
+                        const float tol = ch.path == uint16_t(smodel::SModelAnimPath::Scale) ? settings.scaleTolerance : settings.translationTolerance;
+                        vecKeys.resize(s.timeCount);
+                        for (uint32_t k = 0; k < s.timeCount; ++k)
+                            vecKeys[k] = AnimQuant::LoadVec3Key(values, quantIn, k);
+                        auto dist = [](const glm::vec3 &a, const glm::vec3 &b)
+                        { return glm::length(a - b); };
+                        bool constant = true;
+                        for (uint32_t k = 1; k < s.timeCount && constant; ++k)
+                            constant = dist(vecKeys[0], vecKeys[k]) <= tol;
+                        if (constant && settings.stripConstant && hasRest && dist(vecKeys[0], RestVec3(rest[ch.targetNode], ch.path)) <= tol)
+                            continue;
+                        if (constant && settings.stripConstant)
+                            kept.push_back(0);
+                        else if (settings.reduceKeys)
+                            kept = ReduceKeys(times, vecKeys, tol, [](const glm::vec3 &a, const glm::vec3 &b, float t)
+                                              { return glm::mix(a, b, t); }, dist);
+                        else
+                            kept = allKeys();
+                    }
+
+                    // A reduced channel needs its own key times, while the full key set usually
+                    // shares its times with the clip's other channels. Keep the reduction only
+                    // when it is smaller.
+                    if (linear && kept.size() > 1 && kept.size() < s.timeCount)
+                    {
+                        const size_t keyBytes = settings.quantize ? 6u : (isQuat ? 16u : 12u);
+                        if (kept.size() * (keyBytes + sizeof(float)) >= size_t(s.timeCount) * keyBytes)
+                            kept = allKeys();
+                    }
+
+                    // Times (shared when an identical array was already written).
+                    keptTimes.clear();
+                    for (uint32_t k : kept)
+                        keptTimes.push_back(times[k]);
+                    bool newTimes = false;
+                    so.timeCount = static_cast<uint32_t>(kept.size());
+                    so.firstTime = timeTable.add(keptTimes.data(), so.timeCount, newTimes);
+                    if (HasUniformTimes(keptTimes.data(), so.timeCount))
+                        so.flags |= smodel::SModelAnimSamplerFlag_UniformTimes;
+
+                    // Values.
+                    so.firstValue = static_cast<uint32_t>(out.values.size());
+                    if (!linear)
+                    {
+                        out.values.insert(out.values.end(), values, values + s.valueCount);
+                        if (quantIn)
+                            so.flags |= smodel::SModelAnimSamplerFlag_Quantized;
+                    }
+                    else if (settings.quantize && so.timeCount >= 2)
+                    {
+                        so.flags |= smodel::SModelAnimSamplerFlag_Quantized;
+                        if (isQuat)
+                        {
+                            std::vector<glm::quat> q;
+                            for (uint32_t k : kept)
+                                q.push_back(quatKeys[k]);
+                            AnimQuant::AppendQuantizedQuat(q, out.values);
+                        }
+                        else
+                        {
+                            std::vector<glm::vec3> v;
+                            for (uint32_t k : kept)
+                                v.push_back(vecKeys[k]);
+                            AnimQuant::AppendQuantizedVec3(v, out.values);
+                        }
+                    }
+                    else
+                    {
+                        for (uint32_t k : kept)
+                        {
+                            if (isQuat)
+                                out.values.insert(out.values.end(), {quatKeys[k].x, quatKeys[k].y, quatKeys[k].z, quatKeys[k].w});
+                            else
+                                out.values.insert(out.values.end(), {vecKeys[k].x, vecKeys[k].y, vecKeys[k].z});
+                        }
+                    }
+                    so.valueCount = static_cast<uint32_t>(out.values.size()) - so.firstValue;
+
+                    smodel::SModelAnimationChannelRecord co = ch;
+                    co.samplerIndex = static_cast<uint16_t>(out.samplers.size());
+                    out.samplers.push_back(so);
+                    out.channels.push_back(co);
+                    ++clip.channelCount;
+
+                    ++report.channelsOut;
+                    report.keysOut += so.timeCount;
+                    report.bytesOut += sizeof(co) + sizeof(so) + size_t(so.valueCount) * sizeof(float) +
+                                       (newTimes ? size_t(so.timeCount) * sizeof(float) : 0);
+                }
+
+                out.clips.push_back(clip);
+                if (reports)
+                {
+                    MeasureClipError(in, out, rest, ci, report);
+                    (*reports)[ci] = report;
+                }
+            }
+        }
+    }
+}
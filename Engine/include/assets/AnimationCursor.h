@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Last key interval used per channel of one clip, kept by whoever evaluates it.
+     *
+     * Playback time mostly moves forward by less than a key per evaluation, so starting the
+     * next key lookup from the previous one (ModelAsset::FindKeyIntervalFrom) finds it in a
+     * step or two instead of a binary search. Loops, seeks and clip switches just fall back
+     * to the search; a stale cursor never changes the result, only the cost.
+     */
+    struct AnimationCursor
+    {
+        static constexpr uint32_t kNoClip = UINT32_MAX;
+
+        uint32_t clip = kNoClip;
+        std::vector<uint32_t> keys; // per channel of `clip`
+
+        /// Point the cursor at clipIndex, restarting from the first keys when it changes.
+        void bind(uint32_t clipIndex, uint32_t channelCount)
+        {
+            if (clip == clipIndex && keys.size() == channelCount)
+                return;
+            clip = clipIndex;
+            keys.assign(channelCount, 0);
+        }
+
+        void reset()
+        {
+            clip = kNoClip;
+            keys.clear();
+        }
+    };
+}
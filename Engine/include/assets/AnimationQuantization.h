@@ -0,0 +1,171 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "assets/model/SModelAnimationRecords.h"
+
+namespace Engine
+{
+    /**
+     * @brief Key encoding of quantized animation samplers (SModelAnimSamplerFlag_Quantized).
+     *
+     * Quantized samplers keep their slice of the animation value table (animValues), but the
+     * 32-bit words hold 16-bit fields instead of one float per component:
+     * - Quat: 3 x uint16 per key, "smallest three". The largest component is dropped and
+     *   rebuilt from unit length; the other three are stored at 15 bits in
+     *   [-1/sqrt(2), 1/sqrt(2)]. The dropped component's index uses the top bits of words 0
+     *   and 1.
+     * - Vec3: 6 floats (min xyz, step xyz) for the sampler's range, then 3 x uint16 per key,
+     *   value = min + q * step.
+     * The key data is padded to whole words. It is read with memcpy, so it needs no alignment
+     * beyond the float table's own.
+     */
+    namespace AnimQuant
+    {
+        constexpr float kQuatRange = 0.70710678f; // |smallest three| <= 1/sqrt(2)
+        constexpr float kQuat15Max = 32767.0f;
+        constexpr uint32_t kVec3RangeFloats = 6;
+
+        inline bool IsQuantized(const smodel::SModelAnimationSamplerRecord &s)
+        {
+            return (s.flags & smodel::SModelAnimSamplerFlag_Quantized) != 0;
+        }
+
+        /// Words (floats) a quantized sampler of `keys` keys takes in animValues.
+        inline uint32_t PackedValueCount(smodel::SModelAnimValueType type, uint32_t keys)
+        {
+            const uint32_t keyWords = (keys * 3u + 1u) / 2u; // 3 x uint16 per key
+            return type == smodel::SModelAnimValueType::Vec3 ? kVec3RangeFloats + keyWords : keyWords;
+        }
+
+        inline void EncodeQuat48(const glm::quat &q, uint16_t out[3])
+        {
+            const glm::quat n = glm::normalize(q);
+            float c[4] = {n.x, n.y, n.z, n.w};
+            uint32_t largest = 0;
+            for (uint32_t i = 1; i < 4; ++i)
+            {
+                if (std::fabs(c[i]) > std::fabs(c[largest]))
+                    largest = i;
+            }
+            const float sign = c[largest] < 0.0f ? -1.0f : 1.0f; // q and -q are the same rotation
+            uint32_t k = 0;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                if (i == largest)
+                    continue;
+                const float v = std::min(std::max(sign * c[i] / kQuatRange, -1.0f), 1.0f);
+                out[k++] = static_cast<uint16_t>(std::lround((v * 0.5f + 0.5f) * kQuat15Max));
+            }
+            out[0] = static_cast<uint16_t>(out[0] | ((largest >> 1) << 15));
+            out[1] = static_cast<uint16_t>(out[1] | ((largest & 1u) << 15));
+        }
+
+        inline glm::quat DecodeQuat48(const uint16_t w[3])
+        {
+            const uint32_t largest = ((w[0] >> 15) << 1) | (w[1] >> 15);
+            float c[4];
+            float sum = 0.0f;
+            uint32_t k = 0;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                if (i == largest)
+                    continue;
+                const float v = (static_cast<float>(w[k++] & 0x7FFFu) / kQuat15Max * 2.0f - 1.0f) * kQuatRange;
+                c[i] = v;
+                sum += v * v;
+            }
+            c[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+            return glm::quat(c[3], c[0], c[1], c[2]);
+        }
+
+        // 16-bit fields of key `key`, counted from `words`.
+        inline void LoadKeyFields(const float *words, uint32_t key, uint16_t out[3])
+        {
+            std::memcpy(out, reinterpret_cast<const unsigned char *>(words) + size_t(key) * 6u, 6);
+        }
+
+        /// Key `key` of a Vec3 sampler's values (raw floats or quantized).
+        inline glm::vec3 LoadVec3Key(const float *values, bool quantized, uint32_t key)
+        {
+            if (!quantized)
+            {
+                const float *v = values + size_t(key) * 3u;
+                return glm::vec3(v[0], v[1], v[2]);
+            }
+            uint16_t q[3];
+            LoadKeyFields(values + kVec3RangeFloats, key, q);
+            return glm::vec3(values[0] + static_cast<float>(q[0]) * values[3],
+                             values[1] + static_cast<float>(q[1]) * values[4],
+                             values[2] + static_cast<float>(q[2]) * values[5]);
+        }
+
+        /// Key `key` of a Quat sampler's values (raw XYZW floats or quantized), normalized.
+        inline glm::quat LoadQuatKey(const float *values, bool quantized, uint32_t key)
+        {
+            if (!quantized)
+            {
+                const float *v = values + size_t(key) * 4u;
+                return glm::normalize(glm::quat(v[3], v[0], v[1], v[2])); // stored XYZW
+            }
+            uint16_t q[3];
+            LoadKeyFields(values, key, q);
+            return glm::normalize(DecodeQuat48(q));
+        }
+
+        // Appends 16-bit fields to a float table as whole words (zero padded).
+        inline void AppendFields(const std::vector<uint16_t> &fields, std::vector<float> &values)
+        {
+            const size_t words = (fields.size() + 1) / 2;
+            const size_t base = values.size();
+            values.resize(base + words, 0.0f);
+            if (!fields.empty())
+                std::memcpy(values.data() + base, fields.data(), fields.size() * sizeof(uint16_t));
+        }
+
+        /// Quantized values (range + fields) of a Vec3 key array into `values`.
+        inline void AppendQuantizedVec3(const std::vector<glm::vec3> &keys, std::vector<float> &values)
+        {
+            glm::vec3 lo(0.0f);
+            glm::vec3 hi(0.0f);
+            if (!keys.empty())
+            {
+                lo = hi = keys[0];
+                for (const glm::vec3 &k : keys)
+                {
+                    lo = glm::min(lo, k);
+                    hi = glm::max(hi, k);
+                }
+            }
+            const glm::vec3 step = (hi - lo) / 65535.0f;
+            values.insert(values.end(), {lo.x, lo.y, lo.z, step.x, step.y, step.z});
+
+            std::vector<uint16_t> fields;
+            fields.reserve(keys.size() * 3);
+            for (const glm::vec3 &k : keys)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    const float q = step[c] > 0.0f ? (k[c] - lo[c]) / step[c] : 0.0f;
+                    fields.push_back(static_cast<uint16_t>(std::min(std::max(std::lround(q), 0l), 65535l)));
+                }
+            }
+            AppendFields(fields, values);
+        }
+
+        inline void AppendQuantizedQuat(const std::vector<glm::quat> &keys, std::vector<float> &values)
+        {
+            std::vector<uint16_t> fields(keys.size() * 3);
+            for (size_t i = 0; i < keys.size(); ++i)
+                EncodeQuat48(keys[i], fields.data() + i * 3);
+            AppendFields(fields, values);
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "assets/Handles.h"
+#include "Engine/TimeSlicer.h"
 
 #include "assets/MeshFormats.h"
 #include "assets/MeshAsset.h"
@@ -50,6 +51,14 @@ namespace Engine
         void addRef(ModelHandle h);
         void release(ModelHandle h);
 
+        // Animation baking: pre-sample clips into pose tables (see AnimationBakeSettings).
+        // Re-bakes every loaded model with the new settings; models loaded later are baked
+        // as part of loadModel(). Disabled settings drop all baked data.
+        void setAnimationBaking(const AnimationBakeSettings &settings);
+        const AnimationBakeSettings &animationBaking() const { return m_bakeSettings; }
+        size_t bakedAnimationBytes() const { return m_bakedAnimBytes; }
+        uint32_t bakedClipCount() const { return m_bakedClipCount; }
+
         void addRef(MaterialHandle h);
         void release(MaterialHandle h);
 
@@ -59,11 +68,19 @@ namespace Engine
         // Collect all zero-ref assets (and clear caches)
         void garbageCollect();
 
+        // Resumable garbageCollect() for a TimeSlicer job: destroys zero-ref assets until the
+        // slice expires, returns true once a full pass has completed. Like garbageCollect(),
+        // only call it when no in-flight frame still uses the released assets.
+        bool garbageCollect(TimeSlice &slice);
+
     private:
         MeshHandle createMeshFromData_Internal(const MeshData &data, const std::string &path, uint32_t initialRef);
         TextureHandle createTexture_Internal(std::unique_ptr<TextureAsset> tex, uint32_t initialRef);
         MaterialHandle createMaterial_Internal(std::unique_ptr<MaterialAsset> mat, uint32_t initialRef);
         ModelHandle createModel_Internal(std::unique_ptr<ModelAsset> model, const std::string &path, uint32_t initialRef);
+        bool collectPhase(uint32_t phase, TimeSlice &slice);
+        void bakeModelAnimations(ModelAsset &model);
+        void dropModelAnimations(ModelAsset &model);
 
     private:
         VkDevice m_device = VK_NULL_HANDLE;
@@ -77,6 +94,13 @@ namespace Engine
         uint64_t m_nextMaterialID = 1;
         uint64_t m_nextModelID = 1;
 
+        // Phase the resumable garbageCollect(TimeSlice&) continues from (0 = models .. 3 = textures).
+        uint32_t m_gcPhase = 0;
+
+        AnimationBakeSettings m_bakeSettings;
+        size_t m_bakedAnimBytes = 0; // across all models, kept under m_bakeSettings.budgetBytes
+        uint32_t m_bakedClipCount = 0;
+
         // ---------------------------
         // Mesh entries
         // ---------------------------
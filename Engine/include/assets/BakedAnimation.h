@@ -0,0 +1,128 @@
+#pragma once
+
+#include "assets/PaletteMatrix.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief How animation clips are pre-sampled into pose tables (see BakedClip).
+     *
+     * Baking trades memory for CPU: a baked clip costs
+     * frames * (nodeCount + jointCount) * 48 bytes, where frames ~= duration * sampleHz + 1.
+     * Clips are baked in load order until budgetBytes is reached; the rest keep being
+     * sampled from keyframes.
+     */
+    struct AnimationBakeSettings
+    {
+        static constexpr float kDefaultSampleHz = 30.0f;
+        static constexpr size_t kDefaultBudgetBytes = size_t(64) << 20;
+
+        bool enabled = false;
+        float sampleHz = kDefaultSampleHz;
+        size_t budgetBytes = kDefaultBudgetBytes;
+
+        /// Blend the two nearest baked frames (true) or snap to the nearest one (false).
+        bool interpolate = true;
+    };
+
+    /**
+     * @brief One animation clip pre-sampled at a fixed rate.
+     *
+     * Frames are spaced uniformly over [0, duration] so the first and last frame land exactly
+     * on the clip ends. Each frame stores nodeCount global node matrices followed (in joints)
+     * by jointCount skinning matrices, as PaletteMatrix rows, with the inverse bind already
+     * applied, i.e. exactly what ECS::PosePalette holds for that time.
+     */
+    struct BakedClip
+    {
+        uint32_t frameCount = 0; // 0 = not baked
+        float frameStep = 0.0f;  // seconds between frames
+        float duration = 0.0f;
+        uint32_t nodeCount = 0;
+        uint32_t jointCount = 0;
+
+        std::vector<PaletteMatrix> nodeGlobals; // [frame][nodeCount]
+        std::vector<PaletteMatrix> joints;      // [frame][jointCount]
+
+        bool valid() const { return frameCount > 0; }
+
+        size_t bytes() const { return (nodeGlobals.size() + joints.size()) * sizeof(PaletteMatrix); }
+
+        /// Frames needed to cover `duration` seconds at `sampleHz` (at least 2 for a non-empty clip).
+        static uint32_t FrameCountFor(float duration, float sampleHz)
+        {
+            if (duration <= 1e-6f || sampleHz <= 0.0f)
+                return 1;
+            return std::max(2u, static_cast<uint32_t>(std::ceil(duration * sampleHz)) + 1u);
+        }
+
+        static size_t BytesFor(float duration, float sampleHz, uint32_t nodeCount, uint32_t jointCount)
+        {
+            return size_t(FrameCountFor(duration, sampleHz)) * (size_t(nodeCount) + jointCount) * sizeof(PaletteMatrix);
+        }
+
+        /// Pose at timeSec (clamped to the clip) into the palettes, resized to node/joint count.
+        void sampleInto(float timeSec, bool interpolate,
+                        std::vector<PaletteMatrix> &nodesOut,
+                        std::vector<PaletteMatrix> &jointsOut) const
+        {
+            nodesOut.resize(nodeCount);
+            jointsOut.resize(jointCount);
+            if (frameCount == 0)
+                return;
+
+            uint32_t f0 = 0;
+            uint32_t f1 = 0;
+            float alpha = 0.0f;
+            if (frameCount > 1 && frameStep > 0.0f)
+            {
+                const float t = std::min(std::max(timeSec, 0.0f), duration);
+                const float f = t / frameStep;
+                f0 = std::min(static_cast<uint32_t>(f), frameCount - 1);
+                f1 = std::min(f0 + 1, frameCount - 1);
+                alpha = f - static_cast<float>(f0);
+                if (!interpolate)
+                {
+                    if (alpha >= 0.5f)
+                        f0 = f1;
+                    alpha = 0.0f;
+                }
+            }
+
+            LerpRows(nodeGlobals.data() + size_t(f0) * nodeCount, nodeGlobals.data() + size_t(f1) * nodeCount,
+                     alpha, nodeCount, nodesOut.data());
+            if (jointCount > 0)
+            {
+                LerpRows(joints.data() + size_t(f0) * jointCount, joints.data() + size_t(f1) * jointCount,
+                         alpha, jointCount, jointsOut.data());
+            }
+        }
+
+    private:
+        // Component-wise blend of two matrix rows. Adjacent frames are 1/sampleHz apart, so the
+        // (unnormalized) rotation blend stays visually indistinguishable from a slerp.
+        static void LerpRows(const PaletteMatrix *a, const PaletteMatrix *b, float alpha, uint32_t count, PaletteMatrix *out)
+        {
+            if (alpha <= 0.0f || a == b)
+            {
+                std::copy(a, a + count, out);
+                return;
+            }
+            const float *fa = glm::value_ptr(a[0]);
+            const float *fb = glm::value_ptr(b[0]);
+            float *fo = glm::value_ptr(out[0]);
+            const size_t n = size_t(count) * 12u;
+            for (size_t i = 0; i < n; ++i)
+                fo[i] = fa[i] + (fb[i] - fa[i]) * alpha;
+        }
+    };
+}
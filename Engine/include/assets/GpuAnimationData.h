@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "assets/ModelAsset.h"
+
+namespace Engine
+{
+    /**
+     * @brief Word offsets of a model's animation tables inside the pose compute buffer.
+     *
+     * Every table is 32-bit words, mirrored by shaders/pose.comp:
+     * - clips: SModelAnimationClipRecord (4 words)
+     * - channels: SModelAnimationChannelRecord (2 words); channels that the CPU would skip
+     *   (bad sampler or node, sampler ranges outside the tables) get targetNode ~0u
+     * - samplers: SModelAnimationSamplerRecord (5 words), then animTimes and animValues
+     * - rest: per node t.xyz, r.xyzw, s.xyz (10 floats; identity TRS without restTRS)
+     * - order: per evaluation step (node, parent), parent ~0u for roots
+     * - joints: per joint palette entry (node, inverseBind column-major), node ~0u = identity
+     */
+    struct GpuAnimationLayout
+    {
+        uint32_t clipOffset = 0;
+        uint32_t channelOffset = 0;
+        uint32_t samplerOffset = 0;
+        uint32_t timeOffset = 0;
+        uint32_t valueOffset = 0;
+        uint32_t restOffset = 0;
+        uint32_t orderOffset = 0;
+        uint32_t jointOffset = 0;
+
+        uint32_t clipCount = 0;
+        uint32_t nodeCount = 0;  // palette stride per pose (same as the vertex shader's)
+        uint32_t jointCount = 0; // joint palette stride per pose (ModelAsset::totalJointCount)
+        uint32_t wordCount = 0;
+    };
+
+    namespace GpuAnimation
+    {
+        constexpr uint32_t kClipWords = 4;
+        constexpr uint32_t kChannelWords = 2;
+        constexpr uint32_t kSamplerWords = 5;
+        constexpr uint32_t kRestWords = 10;
+        constexpr uint32_t kOrderWords = 2;
+        constexpr uint32_t kJointWords = 17;
+
+        static_assert(sizeof(smodel::SModelAnimationClipRecord) == kClipWords * 4, "clip record must be whole words");
+        static_assert(sizeof(smodel::SModelAnimationChannelRecord) == kChannelWords * 4, "channel record must be whole words");
+        static_assert(sizeof(smodel::SModelAnimationSamplerRecord) == kSamplerWords * 4, "sampler record must be whole words");
+
+        inline uint32_t FloatWord(float f)
+        {
+            uint32_t w;
+            std::memcpy(&w, &f, sizeof(w));
+            return w;
+        }
+
+        template <typename T>
+        inline void AppendRecords(const std::vector<T> &records, std::vector<uint32_t> &words)
+        {
+            const size_t base = words.size();
+            words.resize(base + records.size() * sizeof(T) / 4);
+            if (!records.empty())
+                std::memcpy(words.data() + base, records.data(), records.size() * sizeof(T));
+        }
+
+        /// Pack `model`'s animation, rest pose, evaluation order and skins into `words`. Applies
+        /// the same validity checks ModelAsset::evaluatePoseInto does per channel, once, so the
+        /// shader only has to skip targetNode == ~0u.
+        inline void Build(const ModelAsset &model, std::vector<uint32_t> &words, GpuAnimationLayout &layout)
+        {
+            words.clear();
+            layout = GpuAnimationLayout{};
+            const uint32_t nodeCount = static_cast<uint32_t>(model.nodes.size());
+            layout.nodeCount = nodeCount > 0 ? nodeCount : 1u;
+            layout.jointCount = model.totalJointCount;
+
+            const bool animated = !model.animClips.empty() && !model.animChannels.empty() && !model.animSamplers.empty();
+            layout.clipCount = animated ? static_cast<uint32_t>(model.animClips.size()) : 0u;
+
+            // Channel ranges clamped to the table (the CPU stops at the end of animChannels).
+            layout.clipOffset = static_cast<uint32_t>(words.size());
+            if (animated)
+            {
+                const uint32_t channelTotal = static_cast<uint32_t>(model.animChannels.size());
+                for (smodel::SModelAnimationClipRecord clip : model.animClips)
+                {
+                    clip.firstChannel = std::min(clip.firstChannel, channelTotal);
+                    clip.channelCount = std::min(clip.channelCount, channelTotal - clip.firstChannel);
+                    uint32_t packed[kClipWords];
+                    std::memcpy(packed, &clip, sizeof(packed));
+                    words.insert(words.end(), packed, packed + kClipWords);
+                }
+            }
+
+            layout.channelOffset = static_cast<uint32_t>(words.size());
+            if (animated)
+            {
+                for (const smodel::SModelAnimationChannelRecord &ch : model.animChannels)
+                {
+                    smodel::SModelAnimationChannelRecord out = ch;
+                    bool valid = ch.samplerIndex < model.animSamplers.size() && ch.targetNode < nodeCount;
+                    if (valid)
+                    {
+                        const smodel::SModelAnimationSamplerRecord &s = model.animSamplers[ch.samplerIndex];
+                        valid = s.timeCount > 0 &&
+                                size_t(s.firstTime) + s.timeCount <= model.animTimes.size() &&
+                                size_t(s.firstValue) + s.valueCount <= model.animValues.size();
+                    }
+                    if (!valid)
+                        out.targetNode = ~0u;
+                    uint32_t packed[kChannelWords];
+                    std::memcpy(packed, &out, sizeof(packed));
+                    words.insert(words.end(), packed, packed + kChannelWords);
+                }
+            }
+
+            layout.samplerOffset = static_cast<uint32_t>(words.size());
+            if (animated)
+                AppendRecords(model.animSamplers, words);
+
+            layout.timeOffset = static_cast<uint32_t>(words.size());
+            if (animated)
+                AppendRecords(model.animTimes, words);
+
+            layout.valueOffset = static_cast<uint32_t>(words.size());
+            if (animated)
+                AppendRecords(model.animValues, words);
+
+            layout.restOffset = static_cast<uint32_t>(words.size());
+            const bool haveRest = model.restTRS.size() == model.nodes.size();
+            for (uint32_t n = 0; n < layout.nodeCount; ++n)
+            {
+                const ModelAsset::NodeTRS trs = (haveRest && n < nodeCount) ? model.restTRS[n] : ModelAsset::NodeTRS{};
+                const float f[kRestWords] = {trs.t.x, trs.t.y, trs.t.z,
+                                             trs.r.x, trs.r.y, trs.r.z, trs.r.w,
+                                             trs.s.x, trs.s.y, trs.s.z};
+                for (float v : f)
+                    words.push_back(FloatWord(v));
+            }
+
+            // Same order the CPU pass walks (nodeOrder, or index order with forward parents as roots).
+            layout.orderOffset = static_cast<uint32_t>(words.size());
+            const bool ordered = model.hasNodeOrder();
+            for (uint32_t k = 0; k < nodeCount; ++k)
+            {
+                const uint32_t node = ordered ? model.nodeOrder[k] : k;
+                uint32_t parent = ordered ? model.nodeOrderParents[k] : model.nodes[k].parentIndex;
+                if (!ordered && parent >= k)
+                    parent = ~0u;
+                words.push_back(node);
+                words.push_back(parent);
+            }
+            if (nodeCount == 0)
+            {
+                words.push_back(0u);
+                words.push_back(~0u);
+            }
+
+            // Flat joint table in palette order (skin.jointBase + j), like buildJointPaletteInto.
+            layout.jointOffset = static_cast<uint32_t>(words.size());
+            words.resize(words.size() + size_t(layout.jointCount) * kJointWords, 0u);
+            for (uint32_t j = 0; j < layout.jointCount; ++j)
+            {
+                uint32_t *dst = words.data() + layout.jointOffset + size_t(j) * kJointWords;
+                dst[0] = ~0u;
+                const glm::mat4 I(1.0f);
+                std::memcpy(dst + 1, &I[0][0], sizeof(glm::mat4));
+            }
+            for (const ModelAsset::ModelSkin &skin : model.skins)
+            {
+                for (uint32_t j = 0; j < skin.jointCount; ++j)
+                {
+                    if (j >= skin.jointNodeIndices.size() || j >= skin.inverseBind.size())
+                        continue;
+                    const uint32_t node = skin.jointNodeIndices[j];
+                    const uint32_t outIx = skin.jointBase + j;
+                    if (node >= nodeCount || outIx >= layout.jointCount)
+                        continue;
+                    uint32_t *dst = words.data() + layout.jointOffset + size_t(outIx) * kJointWords;
+                    dst[0] = node;
+                    std::memcpy(dst + 1, &skin.inverseBind[j][0][0], sizeof(glm::mat4));
+                }
+            }
+
+            layout.wordCount = static_cast<uint32_t>(words.size());
+        }
+    }
+}
@@ -3,12 +3,18 @@
 #include <cstdint>
 #include <cmath>
 #include <algorithm>
-#include <functional>
+#include <utility>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include "assets/AffineKernel.h"
+#include "assets/AnimationCursor.h"
+#include "assets/AnimationQuantization.h"
+#include "assets/BakedAnimation.h"
 #include "assets/Handles.h" // MeshHandle, MaterialHandle
+#include "assets/PaletteMatrix.h"
 #include "assets/model/SModelAnimationRecords.h"
+#include "assets/model/SModelNodeRecord.h"
 
 namespace Engine
 {
@@ -59,6 +65,7 @@ namespace Engine
 
             uint32_t firstPrimitiveIndex{0};
             uint32_t primitiveCount{0};
+            uint32_t flags{0}; // smodel::SModelNodeFlags
 
             glm::mat4 localMatrix{1.0f};
             glm::mat4 globalMatrix{1.0f};
@@ -71,6 +78,19 @@ namespace Engine
         std::vector<uint32_t> nodeChildIndices;
         uint32_t rootNodeIndex{0};
 
+        // Flat evaluation order (buildNodeOrder): node indices with every parent before its
+        // children, and each entry's parent (~0u = root) in the same order. Globals are one
+        // linear pass over these two arrays. Cooked files are already parent-first, so the
+        // order is the identity for them.
+        std::vector<uint32_t> nodeOrder;
+        std::vector<uint32_t> nodeOrderParents;
+
+        // Node palette compaction (buildPaletteNodes): the nodes flagged RigidPrimitives, in
+        // index order, and per node its slot among them (~0u = not in the palette). Poses only
+        // upload these nodes' globals; fully skinned models have none.
+        std::vector<uint32_t> paletteNodes;
+        std::vector<uint32_t> nodePaletteSlot;
+
         // ------------------------------------------------------------
         // Skinning (V4)
         // ------------------------------------------------------------
@@ -102,6 +122,14 @@ namespace Engine
         std::vector<float> animTimes;
         std::vector<float> animValues;
 
+        // Per sampler: keys per second when its key times are evenly spaced (flagged by the
+        // cooker or detected by buildSamplerKeyRates()), 0 otherwise. Lets sampling compute the
+        // key index instead of searching for it.
+        std::vector<float> samplerKeyRate;
+
+        // Pre-sampled poses, parallel to animClips once baked (invalid entries are sampled live).
+        std::vector<BakedClip> bakedClips;
+
         // Optional debug name (string table later)
         const char *debugName = "";
 
@@ -114,12 +142,15 @@ namespace Engine
         float center[3]{0.0f, 0.0f, 0.0f};
         float fitScale = 1.0f;
 
+        // T * R * S, built directly: rotation columns scaled by s, translation in column 3.
         static inline glm::mat4 ComposeTRS(const NodeTRS &x)
         {
-            glm::mat4 T = glm::translate(glm::mat4(1.0f), x.t);
-            glm::mat4 R = glm::mat4_cast(glm::normalize(x.r));
-            glm::mat4 S = glm::scale(glm::mat4(1.0f), x.s);
-            return T * R * S;
+            glm::mat4 m = glm::mat4_cast(glm::normalize(x.r));
+            m[0] *= x.s.x;
+            m[1] *= x.s.y;
+            m[2] *= x.s.z;
+            m[3] = glm::vec4(x.t, 1.0f);
+            return m;
         }
 
         static inline uint32_t FindKeyInterval(const float *times, uint32_t count, float t)
@@ -143,6 +174,36 @@ namespace Engine
             return lo;
         }
 
+        // Bounded forward scan from a guessed interval (a cursor's last key, or an index computed
+        // from a uniform key rate); anything further away falls back to the binary search.
+        // Returns exactly what FindKeyInterval returns for any hint.
+        static constexpr uint32_t kKeyHintMaxSteps = 4;
+
+        static inline uint32_t FindKeyIntervalFrom(const float *times, uint32_t count, float t, uint32_t hint)
+        {
+            if (count <= 1)
+                return 0;
+            if (t <= times[0])
+                return 0;
+            if (t >= times[count - 2])
+                return count - 2;
+
+            // Here times[0] < t < times[count - 2], so the scan never reads past the last key.
+            uint32_t i = std::min(hint, count - 2);
+            if (times[i] > t)
+            {
+                if (i > 0 && times[i - 1] <= t)
+                    return i - 1; // one key back (rounding of a computed index)
+                return FindKeyInterval(times, count, t);
+            }
+            for (uint32_t step = 0; step < kKeyHintMaxSteps; ++step, ++i)
+            {
+                if (t < times[i + 1])
+                    return i;
+            }
+            return FindKeyInterval(times, count, t);
+        }
+
         static inline float ComputeAlpha(float t0, float t1, float t)
         {
             float dt = t1 - t0;
@@ -156,49 +217,47 @@ namespace Engine
             return a;
         }
 
-        static inline glm::vec3 SampleVec3(const float *times, const float *values, uint32_t keyCount, float t)
+        // Sampler values at t. `quantized`: the values are SModelAnimSamplerFlag_Quantized keys
+        // (see AnimQuant), decoded on the fly.
+        static inline glm::vec3 SampleVec3(const float *times, const float *values, uint32_t keyCount, float t,
+                                           bool quantized = false)
+        {
+            return SampleVec3At(times, values, keyCount, t, FindKeyInterval(times, keyCount, t), quantized);
+        }
+
+        // Same as SampleVec3 with the key interval i already found.
+        static inline glm::vec3 SampleVec3At(const float *times, const float *values, uint32_t keyCount, float t, uint32_t i,
+                                             bool quantized = false)
         {
             if (keyCount == 0)
                 return glm::vec3(0.0f);
             if (keyCount == 1)
-                return glm::vec3(values[0], values[1], values[2]);
-
-            uint32_t i = FindKeyInterval(times, keyCount, t);
-            float t0 = times[i];
-            float t1 = times[i + 1];
-            float a = ComputeAlpha(t0, t1, t);
+                return AnimQuant::LoadVec3Key(values, quantized, 0);
 
-            const float *v0 = values + i * 3;
-            const float *v1 = values + (i + 1) * 3;
-            glm::vec3 p0(v0[0], v0[1], v0[2]);
-            glm::vec3 p1(v1[0], v1[1], v1[2]);
+            const float a = ComputeAlpha(times[i], times[i + 1], t);
+            const glm::vec3 p0 = AnimQuant::LoadVec3Key(values, quantized, i);
+            const glm::vec3 p1 = AnimQuant::LoadVec3Key(values, quantized, i + 1);
             return glm::mix(p0, p1, a);
         }
 
-        static inline glm::quat SampleQuat(const float *times, const float *values, uint32_t keyCount, float t)
+        static inline glm::quat SampleQuat(const float *times, const float *values, uint32_t keyCount, float t,
+                                           bool quantized = false)
+        {
+            return SampleQuatAt(times, values, keyCount, t, FindKeyInterval(times, keyCount, t), quantized);
+        }
+
+        // Same as SampleQuat with the key interval i already found.
+        static inline glm::quat SampleQuatAt(const float *times, const float *values, uint32_t keyCount, float t, uint32_t i,
+                                             bool quantized = false)
         {
             if (keyCount == 0)
                 return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
             if (keyCount == 1)
-            {
-                const float *v = values;
-                glm::quat q(v[3], v[0], v[1], v[2]); // stored XYZW
-                return glm::normalize(q);
-            }
+                return AnimQuant::LoadQuatKey(values, quantized, 0);
 
-            uint32_t i = FindKeyInterval(times, keyCount, t);
-            float t0 = times[i];
-            float t1 = times[i + 1];
-            float a = ComputeAlpha(t0, t1, t);
-
-            const float *v0 = values + i * 4;
-            const float *v1 = values + (i + 1) * 4;
-
-            glm::quat q0(v0[3], v0[0], v0[1], v0[2]);
-            glm::quat q1(v1[3], v1[0], v1[1], v1[2]);
-
-            q0 = glm::normalize(q0);
-            q1 = glm::normalize(q1);
+            const float a = ComputeAlpha(times[i], times[i + 1], t);
+            const glm::quat q0 = AnimQuant::LoadQuatKey(values, quantized, i);
+            glm::quat q1 = AnimQuant::LoadQuatKey(values, quantized, i + 1);
 
             if (glm::dot(q0, q1) < 0.0f)
                 q1 = -q1;
@@ -206,43 +265,118 @@ namespace Engine
             return glm::normalize(glm::slerp(q0, q1, a));
         }
 
-        inline void recomputeGlobals()
+        // Parent-first DFS over the child lists (no recursion), same visiting order as the
+        // cooker. Nodes not reachable from a root (broken files) are appended as roots.
+        inline void buildNodeOrder()
         {
             const uint32_t nodeCount = static_cast<uint32_t>(nodes.size());
-            if (nodeCount == 0)
-                return;
-
             const uint32_t U32_MAX = ~0u;
-            std::vector<uint8_t> visited(nodeCount, 0);
-
-            std::function<void(uint32_t, const glm::mat4 &)> compute = [&](uint32_t nodeIdx, const glm::mat4 &parentGlobal)
+            nodeOrder.clear();
+            nodeOrderParents.clear();
+            nodeOrder.reserve(nodeCount);
+            nodeOrderParents.reserve(nodeCount);
+
+            std::vector<uint8_t> placed(nodeCount, 0);
+            std::vector<std::pair<uint32_t, uint32_t>> stack; // (node, parent)
+            auto walk = [&](uint32_t root)
             {
-                if (nodeIdx >= nodeCount)
-                    return;
-                if (visited[nodeIdx])
-                    return;
-                visited[nodeIdx] = 1;
-
-                ModelNode &n = nodes[nodeIdx];
-                n.globalMatrix = parentGlobal * n.localMatrix;
-
-                if (n.childCount == 0)
-                    return;
-                if (n.firstChildIndex == U32_MAX)
-                    return;
-
-                const uint32_t start = n.firstChildIndex;
-                for (uint32_t ci = 0; ci < n.childCount; ++ci)
+                stack.emplace_back(root, U32_MAX);
+                while (!stack.empty())
                 {
-                    const uint32_t child = nodeChildIndices[start + ci];
-                    compute(child, n.globalMatrix);
+                    const auto [nodeIdx, parentIdx] = stack.back();
+                    stack.pop_back();
+                    if (nodeIdx >= nodeCount || placed[nodeIdx])
+                        continue;
+                    placed[nodeIdx] = 1;
+                    nodeOrder.push_back(nodeIdx);
+                    nodeOrderParents.push_back(parentIdx);
+
+                    const ModelNode &n = nodes[nodeIdx];
+                    if (n.childCount == 0 || n.firstChildIndex == U32_MAX)
+                        continue;
+                    for (uint32_t ci = n.childCount; ci-- > 0;)
+                    {
+                        const size_t slot = size_t(n.firstChildIndex) + ci;
+                        if (slot < nodeChildIndices.size())
+                            stack.emplace_back(nodeChildIndices[slot], nodeIdx);
+                    }
                 }
             };
 
             for (uint32_t i = 0; i < nodeCount; ++i)
             {
                 if (nodes[i].parentIndex == U32_MAX)
-                    compute(i, glm::mat4(1.0f));
+                    walk(i);
+            }
+            for (uint32_t i = 0; i < nodeCount; ++i)
+            {
+                if (!placed[i])
+                    walk(i);
+            }
+        }
+
+        bool hasNodeOrder() const { return nodeOrder.size() == nodes.size() && nodeOrderParents.size() == nodes.size(); }
+
+        inline void buildPaletteNodes()
+        {
+            paletteNodes.clear();
+            nodePaletteSlot.assign(nodes.size(), ~0u);
+            for (uint32_t i = 0; i < static_cast<uint32_t>(nodes.size()); ++i)
+            {
+                if ((nodes[i].flags & smodel::SModelNodeFlag_RigidPrimitives) == 0)
+                    continue;
+                nodePaletteSlot[i] = static_cast<uint32_t>(paletteNodes.size());
+                paletteNodes.push_back(i);
+            }
+        }
+
+        uint32_t paletteNodeCount() const { return static_cast<uint32_t>(paletteNodes.size()); }
+        bool hasPaletteNodes() const { return nodePaletteSlot.size() == nodes.size(); }
+
+        // Fills samplerKeyRate. Samplers flagged UniformTimes by the cooker are taken as is;
+        // others (exporters usually write a fixed frame rate) qualify when every key sits within
+        // a quarter step of the even grid, close enough for the computed index to be at most one
+        // key off, which FindKeyIntervalFrom corrects.
+        inline void buildSamplerKeyRates()
+        {
+            samplerKeyRate.assign(animSamplers.size(), 0.0f);
+            for (size_t si = 0; si < animSamplers.size(); ++si)
+            {
+                const auto &s = animSamplers[si];
+                if (s.timeCount < 2 || size_t(s.firstTime) + s.timeCount > animTimes.size())
+                    continue;
+                const float *times = animTimes.data() + s.firstTime;
+                const float span = times[s.timeCount - 1] - times[0];
+                if (!(span > 1e-6f))
+                    continue;
+                const float step = span / static_cast<float>(s.timeCount - 1);
+
+                bool uniform = (s.flags & smodel::SModelAnimSamplerFlag_UniformTimes) != 0;
+                if (!uniform)
+                {
+                    uniform = true;
+                    for (uint32_t k = 1; k + 1 < s.timeCount && uniform; ++k)
+                        uniform = std::fabs(times[k] - (times[0] + step * static_cast<float>(k))) <= 0.25f * step;
+                }
+                if (uniform)
+                    samplerKeyRate[si] = 1.0f / step;
+            }
+        }
+
+        inline void recomputeGlobals()
+        {
+            if (!hasNodeOrder())
+                buildNodeOrder();
+
+            const uint32_t U32_MAX = ~0u;
+            for (size_t k = 0; k < nodeOrder.size(); ++k)
+            {
+                ModelNode &n = nodes[nodeOrder[k]];
+                const uint32_t parent = nodeOrderParents[k];
+                if (parent == U32_MAX)
+                    n.globalMatrix = n.localMatrix;
+                else
+                    AffineKernel::MulAffine(nodes[parent].globalMatrix, n.localMatrix, n.globalMatrix);
             }
         }
 
@@ -316,18 +450,19 @@ namespace Engine
                     values = animValues.data() + s.firstValue;
                 else
                     continue;
+                const bool quantized = AnimQuant::IsQuantized(s);
 
                 if (ch.path == (uint16_t)smodel::SModelAnimPath::Translation)
                 {
-                    animatedTRS[ch.targetNode].t = SampleVec3(times, values, s.timeCount, t);
+                    animatedTRS[ch.targetNode].t = SampleVec3(times, values, s.timeCount, t, quantized);
                 }
                 else if (ch.path == (uint16_t)smodel::SModelAnimPath::Scale)
                 {
-                    animatedTRS[ch.targetNode].s = SampleVec3(times, values, s.timeCount, t);
+                    animatedTRS[ch.targetNode].s = SampleVec3(times, values, s.timeCount, t, quantized);
                 }
                 else if (ch.path == (uint16_t)smodel::SModelAnimPath::Rotation)
                 {
-                    animatedTRS[ch.targetNode].r = SampleQuat(times, values, s.timeCount, t);
+                    animatedTRS[ch.targetNode].r = SampleQuat(times, values, s.timeCount, t, quantized);
                 }
             }
 
@@ -341,20 +476,24 @@ namespace Engine
 
         // Evaluate clip at an explicit time into globalsOut (nodeCount matrices).
         // This does not mutate nodes/local/global matrices, so it can be used per entity.
+        // Needs buildNodeOrder() (the loader runs it); without it nodes are taken in index
+        // order, which is parent-first for cooked files.
+        // Key lookup: samplers with a uniform key rate compute their key index; the others start
+        // from `cursor` (the caller's last keys for this clip) when given, and binary-search
+        // otherwise. All three pick the same keys.
         inline void evaluatePoseInto(uint32_t clipIndex, float timeSec,
                                      std::vector<NodeTRS> &trsScratch,
                                      std::vector<glm::mat4> &localsScratch,
                                      std::vector<glm::mat4> &globalsOut,
-                                     std::vector<uint8_t> &visitedScratch) const
+                                     AnimationCursor *cursor = nullptr) const
         {
             const uint32_t nodeCount = static_cast<uint32_t>(nodes.size());
-            globalsOut.assign(nodeCount, glm::mat4(1.0f));
+            globalsOut.resize(nodeCount);
             if (nodeCount == 0)
                 return;
 
             trsScratch.resize(nodeCount);
             localsScratch.resize(nodeCount);
-            visitedScratch.assign(nodeCount, 0);
 
             // Start from rest pose if available.
             if (restTRS.size() == nodes.size())
@@ -375,6 +514,9 @@ namespace Engine
                 const float t = timeSec;
                 const uint32_t clipFirst = clip.firstChannel;
                 const uint32_t clipCount = clip.channelCount;
+                if (cursor)
+                    cursor->bind(safeClip, clipCount);
+                const bool haveRates = samplerKeyRate.size() == animSamplers.size();
                 for (uint32_t ci = 0; ci < clipCount; ci++)
                 {
                     const uint32_t chIdx = clipFirst + ci;
@@ -401,17 +543,32 @@ namespace Engine
                     else
                         continue;
 
+                    const bool quantized = AnimQuant::IsQuantized(s);
+                    const float rate = haveRates ? samplerKeyRate[ch.samplerIndex] : 0.0f;
+                    uint32_t key;
+                    if (rate > 0.0f)
+                    {
+                        const float guess = std::min(std::max(0.0f, (t - times[0]) * rate), static_cast<float>(s.timeCount));
+                        key = FindKeyIntervalFrom(times, s.timeCount, t, static_cast<uint32_t>(guess));
+                    }
+                    else if (cursor)
+                        key = FindKeyIntervalFrom(times, s.timeCount, t, cursor->keys[ci]);
+                    else
+                        key = FindKeyInterval(times, s.timeCount, t);
+                    if (cursor)
+                        cursor->keys[ci] = key;
+
                     if (ch.path == (uint16_t)smodel::SModelAnimPath::Translation)
                     {
-                        trsScratch[ch.targetNode].t = SampleVec3(times, values, s.timeCount, t);
+                        trsScratch[ch.targetNode].t = SampleVec3At(times, values, s.timeCount, t, key, quantized);
                     }
                     else if (ch.path == (uint16_t)smodel::SModelAnimPath::Scale)
                     {
-                        trsScratch[ch.targetNode].s = SampleVec3(times, values, s.timeCount, t);
+                        trsScratch[ch.targetNode].s = SampleVec3At(times, values, s.timeCount, t, key, quantized);
                     }
                     else if (ch.path == (uint16_t)smodel::SModelAnimPath::Rotation)
                     {
-                        trsScratch[ch.targetNode].r = SampleQuat(times, values, s.timeCount, t);
+                        trsScratch[ch.targetNode].r = SampleQuatAt(times, values, s.timeCount, t, key, quantized);
                     }
                 }
             }
@@ -420,37 +577,115 @@ namespace Engine
                 localsScratch[i] = ComposeTRS(trsScratch[i]);
 
             const uint32_t U32_MAX = ~0u;
+            const glm::mat4 *locals = localsScratch.data();
+            glm::mat4 *globals = globalsOut.data();
+            const bool ordered = hasNodeOrder();
+            for (uint32_t k = 0; k < nodeCount; ++k)
+            {
+                const uint32_t nodeIdx = ordered ? nodeOrder[k] : k;
+                uint32_t parent = ordered ? nodeOrderParents[k] : nodes[k].parentIndex;
+                if (!ordered && parent >= k)
+                    parent = U32_MAX; // not parent-first: treat as root
+                if (parent == U32_MAX)
+                    globals[nodeIdx] = locals[nodeIdx];
+                else
+                    AffineKernel::MulAffine(globals[parent], locals[nodeIdx], globals[nodeIdx]);
+            }
+        }
 
-            std::function<void(uint32_t, const glm::mat4 &)> compute = [&](uint32_t nodeIdx, const glm::mat4 &parentGlobal)
+        // Skinning matrices (global * inverseBind) for every skin into jointsOut (totalJointCount),
+        // as palette rows.
+        inline void buildJointPaletteInto(const std::vector<glm::mat4> &globals, std::vector<PaletteMatrix> &jointsOut) const
+        {
+            jointsOut.assign(totalJointCount, PaletteIdentity());
+            if (totalJointCount == 0 || globals.size() != nodes.size())
+                return;
+
+            for (const auto &skin : skins)
             {
-                if (nodeIdx >= nodeCount)
-                    return;
-                if (visitedScratch[nodeIdx])
-                    return;
-                visitedScratch[nodeIdx] = 1;
-
-                globalsOut[nodeIdx] = parentGlobal * localsScratch[nodeIdx];
-
-                const ModelNode &n = nodes[nodeIdx];
-                if (n.childCount == 0)
-                    return;
-                if (n.firstChildIndex == U32_MAX)
-                    return;
-
-                const uint32_t start = n.firstChildIndex;
-                for (uint32_t ci = 0; ci < n.childCount; ++ci)
+                for (uint32_t j = 0; j < skin.jointCount; ++j)
                 {
-                    const uint32_t child = nodeChildIndices[start + ci];
-                    compute(child, globalsOut[nodeIdx]);
+                    if (j >= skin.jointNodeIndices.size() || j >= skin.inverseBind.size())
+                        continue;
+
+                    const uint32_t nodeIx = skin.jointNodeIndices[j];
+                    if (nodeIx >= globals.size())
+                        continue;
+
+                    const uint32_t outIx = skin.jointBase + j;
+                    if (outIx >= jointsOut.size())
+                        continue;
+
+                    jointsOut[outIx] = ToPaletteMatrix(globals[nodeIx] * skin.inverseBind[j]);
                 }
-            };
+            }
+        }
 
-            for (uint32_t i = 0; i < nodeCount; ++i)
+        // Memory a bake of clipIndex at sampleHz would take (0 for an invalid clip).
+        inline size_t bakedClipBytes(uint32_t clipIndex, float sampleHz) const
+        {
+            if (clipIndex >= animClips.size() || nodes.empty())
+                return 0;
+            return BakedClip::BytesFor(animClips[clipIndex].durationSec, sampleHz,
+                                       static_cast<uint32_t>(nodes.size()), totalJointCount);
+        }
+
+        // Pre-sample clipIndex at sampleHz into out (see BakedClip).
+        inline void bakeClip(uint32_t clipIndex, float sampleHz, BakedClip &out) const
+        {
+            out = BakedClip{};
+            if (clipIndex >= animClips.size() || nodes.empty())
+                return;
+
+            const float duration = std::max(animClips[clipIndex].durationSec, 0.0f);
+            out.frameCount = BakedClip::FrameCountFor(duration, sampleHz);
+            out.frameStep = (out.frameCount > 1) ? duration / static_cast<float>(out.frameCount - 1) : 0.0f;
+            out.duration = duration;
+            out.nodeCount = static_cast<uint32_t>(nodes.size());
+            out.jointCount = totalJointCount;
+            out.nodeGlobals.reserve(size_t(out.frameCount) * out.nodeCount);
+            out.joints.reserve(size_t(out.frameCount) * out.jointCount);
+
+            std::vector<NodeTRS> trs;
+            std::vector<glm::mat4> locals;
+            std::vector<glm::mat4> globals;
+            std::vector<PaletteMatrix> jointMats;
+            for (uint32_t f = 0; f < out.frameCount; ++f)
             {
-                if (nodes[i].parentIndex == U32_MAX)
-                    compute(i, glm::mat4(1.0f));
+                const float t = (f + 1 == out.frameCount) ? duration : out.frameStep * static_cast<float>(f);
+                evaluatePoseInto(clipIndex, t, trs, locals, globals);
+                const size_t first = out.nodeGlobals.size();
+                out.nodeGlobals.resize(first + globals.size());
+                ToPaletteMatrices(globals.data(), globals.size(), out.nodeGlobals.data() + first);
+                if (out.jointCount > 0)
+                {
+                    buildJointPaletteInto(globals, jointMats);
+                    out.joints.insert(out.joints.end(), jointMats.begin(), jointMats.end());
+                }
             }
         }
+
+        // Baked poses for clipIndex, or nullptr when the clip has to be sampled live.
+        inline const BakedClip *findBakedClip(uint32_t clipIndex) const
+        {
+            if (clipIndex >= bakedClips.size() || !bakedClips[clipIndex].valid())
+                return nullptr;
+            return &bakedClips[clipIndex];
+        }
+
+        inline size_t bakedAnimationBytes() const
+        {
+            size_t bytes = 0;
+            for (const BakedClip &clip : bakedClips)
+                bytes += clip.bytes();
+            return bytes;
+        }
+
+        inline void clearBakedClips()
+        {
+            bakedClips.clear();
+            bakedClips.shrink_to_fit();
+        }
     };
 
 } // namespace Engine
@@ -29,7 +29,9 @@ namespace Engine::smodel
 
     // Current (and only supported) runtime version.
     static constexpr uint16_t SMODEL_VERSION_MAJOR = 4;
-    static constexpr uint16_t SMODEL_VERSION_MINOR = 0;
+    // 4.1: sampler flags (evenly spaced key times, quantized keys).
+    // 4.2: node flags (nodes drawing unskinned primitives).
+    static constexpr uint16_t SMODEL_VERSION_MINOR = 2;
 
     // Small helper for loader validation.
     // If this returns false, loader should reject the file.
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+namespace Engine
+{
+    /**
+     * @brief Storage type of node and joint palettes: an affine transform without its last row.
+     *
+     * Node globals and skinning matrices are always affine (last row 0, 0, 0, 1), so palettes
+     * keep only the top three rows, 48 bytes instead of 64. Column r of the glm::mat3x4 holds
+     * row r of the transform, which is exactly how a std430 `mat3x4` array is laid out on the
+     * GPU (smodel.vert rebuilds the mat4 as `mat4(transpose(m))`, pose.comp writes
+     * `transpose(mat4x3(m))`). Pose evaluation still works on glm::mat4 and converts when it
+     * writes a palette.
+     */
+    using PaletteMatrix = glm::mat3x4;
+
+    static_assert(sizeof(PaletteMatrix) == 48, "PaletteMatrix must match std430 mat3x4");
+
+    /// Identity transform as palette rows.
+    inline PaletteMatrix PaletteIdentity() { return PaletteMatrix(1.0f); }
+
+    /// Top three rows of an affine `m` (the last row is dropped, not checked).
+    inline PaletteMatrix ToPaletteMatrix(const glm::mat4 &m)
+    {
+        PaletteMatrix p;
+        for (int r = 0; r < 3; ++r)
+            p[r] = glm::vec4(m[0][r], m[1][r], m[2][r], m[3][r]);
+        return p;
+    }
+
+    /// The full matrix back, last row (0, 0, 0, 1).
+    inline glm::mat4 PaletteToMat4(const PaletteMatrix &p)
+    {
+        glm::mat4 m;
+        for (int c = 0; c < 4; ++c)
+            m[c] = glm::vec4(p[0][c], p[1][c], p[2][c], c == 3 ? 1.0f : 0.0f);
+        return m;
+    }
+
+    inline void ToPaletteMatrices(const glm::mat4 *src, size_t count, PaletteMatrix *dst)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = ToPaletteMatrix(src[i]);
+    }
+}
@@ -25,6 +25,17 @@ namespace Engine::smodel
         Quat = 1,
     };
 
+    // SModelAnimationSamplerRecord::flags
+    enum SModelAnimSamplerFlags : uint16_t
+    {
+        // Key times are evenly spaced from the first to the last key, so the key for a time is
+        // (t - t0) * (timeCount - 1) / (tLast - t0) instead of a search.
+        SModelAnimSamplerFlag_UniformTimes = 1u << 0,
+        // Values are 16-bit quantized keys instead of floats (v4.1+, see AnimQuant in
+        // assets/AnimationQuantization.h); valueCount counts 32-bit words.
+        SModelAnimSamplerFlag_Quantized = 1u << 1,
+    };
+
     struct SModelAnimationClipRecord
     {
         uint32_t nameOffset; // string table offset (0 if none)
@@ -46,11 +57,11 @@ namespace Engine::smodel
         uint32_t timeCount;
 
         uint32_t firstValue; // index into animValues (float)
-        uint32_t valueCount; // floats count (timeCount*3 or timeCount*4)
+        uint32_t valueCount; // floats count (timeCount*3 or timeCount*4; quantized: AnimQuant::PackedValueCount)
 
         uint8_t interpolation; // SModelAnimInterpolation
         uint8_t valueType;     // SModelAnimValueType
-        uint16_t _pad;
+        uint16_t flags;        // SModelAnimSamplerFlags (0 in files cooked before flags existed)
     };
 
 #pragma pack(pop)
@@ -22,7 +22,7 @@ namespace Engine::smodel
     {
         uint32_t magic;        // must equal 'SMOD'
         uint16_t versionMajor; // 4
-        uint16_t versionMinor; // 0
+        uint16_t versionMinor; // 2
 
         uint32_t fileSizeBytes; // entire file size (validation)
         uint32_t flags;         // reserved for future use (0 for v1)
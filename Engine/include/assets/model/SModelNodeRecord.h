@@ -3,8 +3,18 @@
 
 namespace Engine::smodel
 {
+    // SModelNodeRecord::flags
+    enum SModelNodeFlags : uint32_t
+    {
+        // At least one of the node's primitives is drawn without a skin, so its vertices are
+        // transformed by the node's global matrix (v4.2+). Only these nodes get node palette
+        // entries at runtime; skinned primitives read the joint palette.
+        SModelNodeFlag_RigidPrimitives = 1u << 0,
+    };
+
 #pragma pack(push, 1)
-    // Binary record describing a scene node for .smodel V2
+    // Binary record describing a scene node for .smodel V2.
+    // Node tables are written parent-first: parentIndex < the node's own index.
     struct SModelNodeRecord
     {
         // String table offsets
@@ -21,8 +31,10 @@ namespace Engine::smodel
 
         // Local transform (column-major 4x4)
         float localMatrix[16];
+
+        uint32_t flags; // SModelNodeFlags (v4.2+)
     };
 #pragma pack(pop)
 
-    static_assert(sizeof(SModelNodeRecord) == 88, "SModelNodeRecord size mismatch");
+    static_assert(sizeof(SModelNodeRecord) == 92, "SModelNodeRecord size mismatch");
 }
@@ -21,21 +21,29 @@ layout(location = 5) in vec4 inInstanceCol1;
 layout(location = 6) in vec4 inInstanceCol2;
 layout(location = 7) in vec4 inInstanceCol3;
 
+// Per-instance pose: which [pose] row of the palettes this instance reads
+// (instances playing the same clip bucket share one)
+layout(location = 10) in uint inPoseIndex;
+
 layout(set = 0, binding = 0) uniform CameraUBO {
     mat4 view;
     mat4 proj;
 } cam;
 
-// Flattened node globals: [instance][node]
+// Palettes hold affine transforms as their top three rows (Engine::PaletteMatrix:
+// column r = row r), 48 bytes per matrix; fromRows() restores the (0, 0, 0, 1) row.
+
+// Flattened node globals: [pose][palette node] (only nodes drawing unskinned primitives,
+// or every node, depending on what the pass uploaded)
 layout(set = 0, binding = 1, std430) readonly buffer NodePalette
 {
-    mat4 nodeGlobals[];
+    mat3x4 nodeGlobals[];
 } palette;
 
-// Flattened joint matrices: [instance][joint]
+// Flattened joint matrices: [pose][joint]
 layout(set = 0, binding = 2, std430) readonly buffer JointPalette
 {
-    mat4 jointMats[];
+    mat3x4 jointMats[];
 } joints;
 
 layout(push_constant) uniform PushConstants
@@ -43,17 +51,22 @@ layout(push_constant) uniform PushConstants
     mat4 model;
     vec4 baseColorFactor;
     vec4 materialParams;
-    uvec4 nodeInfo; // x=nodeIndex, y=nodeCount
+    uvec4 nodeInfo; // x=node's palette slot, y=palette nodes per pose
     uvec4 skinInfo; // x=skinBaseJoint, y=skinJointCount, z=jointPaletteStride
 } pc;
 
 layout(location = 0) out vec3 vNormal;
 layout(location = 1) out vec2 vUV0;
 
+mat4 fromRows(mat3x4 rows)
+{
+    return mat4(transpose(rows));
+}
+
 void main()
 {
     mat4 instanceWorld = mat4(inInstanceCol0, inInstanceCol1, inInstanceCol2, inInstanceCol3);
-    uint instanceIndex = uint(gl_InstanceIndex);
+    uint poseIndex = inPoseIndex;
     uint nodeIndex = pc.nodeInfo.x;
     uint nodeCount = max(pc.nodeInfo.y, 1u);
 
@@ -69,17 +82,18 @@ void main()
     {
         // Skinning: joint matrices already bring vertices into model space.
         // Build a weighted skin matrix from up to 4 joints.
-        mat4 skinM = mat4(0.0);
+        mat3x4 skinRows = mat3x4(0.0);
         vec4 w = inWeights;
 
         // Clamp joint indices to skinJointCount to avoid OOB.
         uvec4 j = min(inJoints, uvec4(max(skinJointCount - 1u, 0u)));
 
-        uint base = instanceIndex * jointStride + skinBase;
-        skinM += w.x * joints.jointMats[base + j.x];
-        skinM += w.y * joints.jointMats[base + j.y];
-        skinM += w.z * joints.jointMats[base + j.z];
-        skinM += w.w * joints.jointMats[base + j.w];
+        uint base = poseIndex * jointStride + skinBase;
+        skinRows += w.x * joints.jointMats[base + j.x];
+        skinRows += w.y * joints.jointMats[base + j.y];
+        skinRows += w.z * joints.jointMats[base + j.z];
+        skinRows += w.w * joints.jointMats[base + j.w];
+        mat4 skinM = fromRows(skinRows);
 
         modelPos = skinM * vec4(inPosition, 1.0);
         modelNormal = normalize(mat3(skinM) * inNormal);
@@ -89,7 +103,7 @@ void main()
     else
     {
         // Unskinned: use node transform palette.
-        mat4 nodeM = palette.nodeGlobals[instanceIndex * nodeCount + nodeIndex];
+        mat4 nodeM = fromRows(palette.nodeGlobals[poseIndex * nodeCount + nodeIndex]);
         M = instanceWorld * pc.model * nodeM;
         modelPos = vec4(inPosition, 1.0);
         modelNormal = inNormal;
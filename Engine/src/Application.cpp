@@ -9,9 +9,96 @@
 #include "Engine/ImGuiLayer.h"
 #include <iostream>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 namespace Engine
 {
+    namespace
+    {
+        // Persistent worker running Application::OnSimulate() in pipelined mode.
+        // kick() hands it one frame; wait() blocks until that frame is done.
+        class SimulationThread
+        {
+        public:
+            explicit SimulationThread(std::function<void(TimeStep)> fn)
+                : m_fn(std::move(fn)), m_thread([this]()
+                                                { loop(); })
+            {
+            }
+
+            ~SimulationThread()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_quit = true;
+                }
+                m_cv.notify_all();
+                m_thread.join();
+            }
+
+            SimulationThread(const SimulationThread &) = delete;
+            SimulationThread &operator=(const SimulationThread &) = delete;
+
+            void kick(TimeStep ts)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_ts = ts;
+                    m_busy = true;
+                }
+                m_cv.notify_all();
+            }
+
+            // Returns the milliseconds the caller spent blocked.
+            float wait()
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this]()
+                          { return !m_busy; });
+                return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            }
+
+            // Duration of the last finished OnSimulate() (valid after wait()).
+            float lastSimMs() const { return m_lastSimMs; }
+
+        private:
+            void loop()
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                for (;;)
+                {
+                    m_cv.wait(lock, [this]()
+                              { return m_busy || m_quit; });
+                    if (m_quit)
+                        return;
+
+                    const TimeStep ts = m_ts;
+                    lock.unlock();
+                    const auto t0 = std::chrono::steady_clock::now();
+                    m_fn(ts);
+                    const float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+                    lock.lock();
+
+                    m_lastSimMs = ms;
+                    m_busy = false;
+                    m_cv.notify_all();
+                }
+            }
+
+            std::function<void(TimeStep)> m_fn;
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            TimeStep m_ts{};
+            bool m_busy = false;
+            bool m_quit = false;
+            float m_lastSimMs = 0.0f;
+            std::thread m_thread; // last: started after the state above is initialized
+        };
+    }
 
     struct Application::Impl
     {
@@ -23,6 +110,10 @@ namespace Engine
         bool running = true;
         EventCallbackFn eventCallback;
         std::unique_ptr<ECS::ECSContext> ecs;
+
+        bool pipelined = false;
+        bool simInFlight = false;
+        std::unique_ptr<SimulationThread> simThread; // last: joined before the rest is torn down
     };
 
     Application::Application()
@@ -85,6 +176,10 @@ namespace Engine
                 m_Impl->perfMonitor->beginFrame();
             }
 
+            // Pipelined: the previous frame's simulation must finish before input handling,
+            // extraction or any other main-thread access to the ECS.
+            waitForSimulation();
+
             // Poll window events
             m_Impl->window->OnUpdate();
 
@@ -99,10 +194,25 @@ namespace Engine
                 m_Impl->imguiLayer->beginFrame();
             }
 
-            // User update/render hooks
+            // User hooks. Pipelined: render this frame's extracted state while the next
+            // simulation step runs on the sim thread (joined at the top of the next frame).
             TimeStep ts{};
             ts.DeltaSeconds = deltaSeconds;
             OnUpdate(ts);
+            if (m_Impl->pipelined)
+            {
+                OnExtract();
+                if (!m_Impl->simThread)
+                    m_Impl->simThread = std::make_unique<SimulationThread>([this](TimeStep t)
+                                                                           { OnSimulate(t); });
+                m_Impl->simThread->kick(ts);
+                m_Impl->simInFlight = true;
+            }
+            else
+            {
+                OnSimulate(ts);
+                OnExtract();
+            }
             OnRender();
 
             // End ImGui frame (this also calls the render callback)
@@ -120,8 +230,32 @@ namespace Engine
                 m_Impl->perfMonitor->endFrame();
             }
         }
+
+        waitForSimulation();
+    }
+
+    void Application::waitForSimulation()
+    {
+        if (!m_Impl->simInFlight)
+            return;
+        const float waitMs = m_Impl->simThread->wait();
+        m_Impl->simInFlight = false;
+        OverlayStats::set("Sim thread", m_Impl->simThread->lastSimMs(), "%.2f ms");
+        OverlayStats::set("Main waited for sim", waitMs, "%.2f ms");
+    }
+
+    void Application::SetPipelinedSimulation(bool enabled)
+    {
+        m_Impl->pipelined = enabled;
+        if (!enabled)
+        {
+            OverlayStats::remove("Sim thread");
+            OverlayStats::remove("Main waited for sim");
+        }
     }
 
+    bool Application::IsPipelinedSimulation() const { return m_Impl->pipelined; }
+
     void Application::handleWindowEvent(const std::string &name)
     {
         if (m_Impl->eventCallback)
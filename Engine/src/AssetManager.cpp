@@ -807,12 +807,13 @@ namespace Engine
                 dst.childCount = nr.childCount;
                 dst.firstPrimitiveIndex = nr.firstPrimitiveIndex;
                 dst.primitiveCount = nr.primitiveCount;
+                dst.flags = nr.flags;
                 dst.debugName = view.getStringOrEmpty(nr.nameStrOffset);
 
                 // Copy local matrix (column-major)
                 std::memcpy(glm::value_ptr(dst.localMatrix), nr.localMatrix, sizeof(nr.localMatrix));
 
-                // Defer global computation; ordering is not guaranteed.
+                // Globals are computed once all nodes are in.
                 dst.globalMatrix = glm::mat4(1.0f);
 
                 if (nr.parentIndex == U32_MAX)
@@ -821,41 +822,11 @@ namespace Engine
 
             model->rootNodeIndex = rootIdx;
 
-            // Compute globals using explicit child lists (supports any node ordering).
-            {
-                const uint32_t nodeCount = static_cast<uint32_t>(model->nodes.size());
-                std::vector<uint8_t> visited(nodeCount, 0);
-
-                std::function<void(uint32_t, const glm::mat4 &)> compute = [&](uint32_t nodeIdx, const glm::mat4 &parentGlobal)
-                {
-                    if (nodeIdx >= nodeCount)
-                        return;
-                    if (visited[nodeIdx])
-                        return;
-                    visited[nodeIdx] = 1;
-
-                    ModelAsset::ModelNode &n = model->nodes[nodeIdx];
-                    n.globalMatrix = parentGlobal * n.localMatrix;
-
-                    if (n.childCount == 0)
-                        return;
-                    if (n.firstChildIndex == U32_MAX)
-                        return;
-
-                    const uint32_t start = n.firstChildIndex;
-                    for (uint32_t ci = 0; ci < n.childCount; ++ci)
-                    {
-                        const uint32_t child = model->nodeChildIndices[start + ci];
-                        compute(child, n.globalMatrix);
-                    }
-                };
-
-                for (uint32_t i = 0; i < nodeCount; ++i)
-                {
-                    if (model->nodes[i].parentIndex == U32_MAX)
-                        compute(i, glm::mat4(1.0f));
-                }
-            }
+            // Flat parent-first evaluation order (identity for cooked files, which are emitted
+            // parent-first; any other ordering is sorted here once), then globals in one pass.
+            model->buildNodeOrder();
+            model->recomputeGlobals();
+            model->buildPaletteNodes();
 
             // Recompute bounds in node-global space (node transforms applied)
             bool firstCorner = true;
@@ -967,6 +938,8 @@ namespace Engine
             model->animValues.resize(view.animValuesCount());
             std::memcpy(model->animValues.data(), view.animValues, sizeof(float) * view.animValuesCount());
         }
+        // Key rates for samplers with evenly spaced keys (key index computed, not searched).
+        model->buildSamplerKeyRates();
 
         // --------------------------
         // Initialize runtime animation TRS buffers from node local matrices
@@ -985,6 +958,8 @@ namespace Engine
         model->animState.loop = true;
         model->animState.playing = true;
 
+        bakeModelAnimations(*model);
+
         // Register model and cache it
         ModelHandle modelHandle = createModel_Internal(std::move(model), cookedModelPath, 1);
 
@@ -1027,77 +1002,180 @@ namespace Engine
         }
     }
 
+    // ------------------------------------------------------------
+    // Animation baking
+    // ------------------------------------------------------------
+    void AssetManager::setAnimationBaking(const AnimationBakeSettings &settings)
+    {
+        m_bakeSettings = settings;
+
+        // Re-bake in load order (ids grow with each load) so the budget goes to the same
+        // clips as if the settings had been applied before loading.
+        std::vector<uint64_t> ids;
+        ids.reserve(m_models.size());
+        for (auto &kv : m_models)
+        {
+            if (kv.second.asset)
+                dropModelAnimations(*kv.second.asset);
+            ids.push_back(kv.first);
+        }
+        std::sort(ids.begin(), ids.end());
+
+        for (uint64_t id : ids)
+        {
+            if (!m_models[id].asset)
+                continue;
+            bakeModelAnimations(*m_models[id].asset);
+        }
+    }
+
+    void AssetManager::bakeModelAnimations(ModelAsset &model)
+    {
+        if (!m_bakeSettings.enabled || m_bakeSettings.sampleHz <= 0.0f)
+            return;
+
+        const uint32_t clipCount = static_cast<uint32_t>(model.animClips.size());
+        model.bakedClips.assign(clipCount, BakedClip{});
+        for (uint32_t c = 0; c < clipCount; ++c)
+        {
+            // Skip clips that do not fit; a smaller one later may still.
+            const size_t bytes = model.bakedClipBytes(c, m_bakeSettings.sampleHz);
+            if (bytes == 0 || m_bakedAnimBytes + bytes > m_bakeSettings.budgetBytes)
+                continue;
+
+            model.bakeClip(c, m_bakeSettings.sampleHz, model.bakedClips[c]);
+            m_bakedAnimBytes += model.bakedClips[c].bytes();
+            ++m_bakedClipCount;
+        }
+    }
+
+    void AssetManager::dropModelAnimations(ModelAsset &model)
+    {
+        for (const BakedClip &clip : model.bakedClips)
+        {
+            if (!clip.valid())
+                continue;
+            m_bakedAnimBytes -= std::min(m_bakedAnimBytes, clip.bytes());
+            if (m_bakedClipCount > 0)
+                --m_bakedClipCount;
+        }
+        model.clearBakedClips();
+    }
+
     // ------------------------------------------------------------
     // Garbage collection with dependency release
     // ------------------------------------------------------------
     void AssetManager::garbageCollect()
     {
-        // 1) Destroy models with refCount == 0
-        for (auto it = m_models.begin(); it != m_models.end();)
+        m_gcPhase = 0;
+        TimeSlice unbounded = TimeSlice::unbounded();
+        garbageCollect(unbounded);
+    }
+
+    bool AssetManager::garbageCollect(TimeSlice &slice)
+    {
+        // Phases in dependency order: models release meshes + materials, materials release textures.
+        while (m_gcPhase < 4)
         {
-            if (it->second.refCount == 0)
-            {
-                // Release model deps
-                for (auto &mh : it->second.meshDeps)
-                    release(mh);
-                for (auto &mat : it->second.materialDeps)
-                    release(mat);
-
-                m_modelPathCache.erase(it->second.path);
-                it = m_models.erase(it);
-            }
-            else
-            {
-                ++it;
-            }
+            if (!collectPhase(m_gcPhase, slice))
+                return false;
+            ++m_gcPhase;
         }
+        m_gcPhase = 0;
+        return true;
+    }
 
-        // 2) Destroy materials with refCount == 0
-        for (auto it = m_materials.begin(); it != m_materials.end();)
+    // One GC phase. Returns false when the slice expired after a destroy; the phase is then
+    // rescanned from the start on the next call (entries already destroyed are gone).
+    bool AssetManager::collectPhase(uint32_t phase, TimeSlice &slice)
+    {
+        switch (phase)
         {
-            if (it->second.refCount == 0)
+        case 0: // 1) Destroy models with refCount == 0
+            for (auto it = m_models.begin(); it != m_models.end();)
             {
-                // Release textures referenced by this material
-                for (auto &th : it->second.textureDeps)
-                    release(th);
-                it = m_materials.erase(it);
+                if (it->second.refCount == 0)
+                {
+                    // Release model deps
+                    for (auto &mh : it->second.meshDeps)
+                        release(mh);
+                    for (auto &mat : it->second.materialDeps)
+                        release(mat);
+
+                    if (it->second.asset)
+                        dropModelAnimations(*it->second.asset);
+
+                    m_modelPathCache.erase(it->second.path);
+                    it = m_models.erase(it);
+                    if (slice.expired())
+                        return false;
+                }
+                else
+                {
+                    ++it;
+                }
             }
-            else
+            return true;
+
+        case 1: // 2) Destroy materials with refCount == 0
+            for (auto it = m_materials.begin(); it != m_materials.end();)
             {
-                ++it;
+                if (it->second.refCount == 0)
+                {
+                    // Release textures referenced by this material
+                    for (auto &th : it->second.textureDeps)
+                        release(th);
+                    it = m_materials.erase(it);
+                    if (slice.expired())
+                        return false;
+                }
+                else
+                {
+                    ++it;
+                }
             }
-        }
+            return true;
 
-        // 3) Destroy meshes with refCount == 0
-        for (auto it = m_meshes.begin(); it != m_meshes.end();)
-        {
-            if (it->second.refCount == 0)
+        case 2: // 3) Destroy meshes with refCount == 0
+            for (auto it = m_meshes.begin(); it != m_meshes.end();)
             {
-                if (it->second.asset)
-                    it->second.asset->destroy(m_device);
+                if (it->second.refCount == 0)
+                {
+                    if (it->second.asset)
+                        it->second.asset->destroy(m_device);
 
-                m_meshPathCache.erase(it->second.path);
-                it = m_meshes.erase(it);
-            }
-            else
-            {
-                ++it;
+                    m_meshPathCache.erase(it->second.path);
+                    it = m_meshes.erase(it);
+                    if (slice.expired())
+                        return false;
+                }
+                else
+                {
+                    ++it;
+                }
             }
-        }
+            return true;
 
-        // 4) Destroy textures with refCount == 0
-        for (auto it = m_textures.begin(); it != m_textures.end();)
-        {
-            if (it->second.refCount == 0)
+        case 3: // 4) Destroy textures with refCount == 0
+            for (auto it = m_textures.begin(); it != m_textures.end();)
             {
-                if (it->second.asset)
-                    it->second.asset->destroy(m_device);
-                it = m_textures.erase(it);
-            }
-            else
-            {
-                ++it;
+                if (it->second.refCount == 0)
+                {
+                    if (it->second.asset)
+                        it->second.asset->destroy(m_device);
+                    it = m_textures.erase(it);
+                    if (slice.expired())
+                        return false;
+                }
+                else
+                {
+                    ++it;
+                }
             }
+            return true;
+
+        default:
+            return true;
         }
     }
 
@@ -0,0 +1,404 @@
+#include "Engine/GpuPoseEvaluator.h"
+#include "Engine/Pipeline.h"
+#include "assets/ModelAsset.h"
+#include "utils/BufferUtils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+namespace Engine
+{
+    bool GpuPoseEvaluator::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties, uint32_t &typeIndex) const
+    {
+        VkPhysicalDeviceMemoryProperties memProps{};
+        vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memProps);
+        for (uint32_t i = 0; i < memProps.memoryTypeCount; ++i)
+        {
+            if ((typeFilter & (1u << i)) && (memProps.memoryTypes[i].propertyFlags & properties) == properties)
+            {
+                typeIndex = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Host-visible, coherent, persistently mapped buffer.
+    bool GpuPoseEvaluator::createHostBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer,
+                                            VkDeviceMemory &memory, void **mapped) const
+    {
+        VkBufferCreateInfo binfo{};
+        binfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        binfo.size = size;
+        binfo.usage = usage;
+        binfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (vkCreateBuffer(m_device, &binfo, nullptr, &buffer) != VK_SUCCESS)
+            return false;
+
+        VkMemoryRequirements memReq{};
+        vkGetBufferMemoryRequirements(m_device, buffer, &memReq);
+
+        VkMemoryAllocateInfo mai{};
+        mai.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        mai.allocationSize = memReq.size;
+        if (!findMemoryType(memReq.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                            mai.memoryTypeIndex) ||
+            vkAllocateMemory(m_device, &mai, nullptr, &memory) != VK_SUCCESS)
+        {
+            vkDestroyBuffer(m_device, buffer, nullptr);
+            buffer = VK_NULL_HANDLE;
+            return false;
+        }
+        vkBindBufferMemory(m_device, buffer, memory, 0);
+
+        if (vkMapMemory(m_device, memory, 0, VK_WHOLE_SIZE, 0, mapped) != VK_SUCCESS)
+        {
+            vkDestroyBuffer(m_device, buffer, nullptr);
+            vkFreeMemory(m_device, memory, nullptr);
+            buffer = VK_NULL_HANDLE;
+            memory = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
+    }
+
+    // Staging buffer -> device-local storage buffer, one blocking copy (same as mesh uploads).
+    bool GpuPoseEvaluator::uploadAnimation(VkQueue queue, uint32_t queueFamilyIndex, const std::vector<uint32_t> &words)
+    {
+        const VkDeviceSize bytes = static_cast<VkDeviceSize>(words.size()) * sizeof(uint32_t);
+
+        VkBuffer staging = VK_NULL_HANDLE;
+        VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+        void *mapped = nullptr;
+        if (!createHostBuffer(bytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, staging, stagingMemory, &mapped))
+            return false;
+        std::memcpy(mapped, words.data(), static_cast<size_t>(bytes));
+        vkUnmapMemory(m_device, stagingMemory);
+
+        bool ok = CreateDeviceLocalBuffer(m_device, m_physicalDevice, bytes,
+                                          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                          m_animBuffer, m_animMemory) == VK_SUCCESS;
+        if (ok)
+        {
+            VkCommandPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = queueFamilyIndex;
+            VkCommandPool uploadPool = VK_NULL_HANDLE;
+            ok = vkCreateCommandPool(m_device, &poolInfo, nullptr, &uploadPool) == VK_SUCCESS;
+            if (ok)
+            {
+                ok = CopyBuffer(m_device, uploadPool, queue, staging, m_animBuffer, bytes) == VK_SUCCESS;
+                vkDestroyCommandPool(m_device, uploadPool, nullptr);
+            }
+        }
+
+        vkDestroyBuffer(m_device, staging, nullptr);
+        vkFreeMemory(m_device, stagingMemory, nullptr);
+        return ok;
+    }
+
+    bool GpuPoseEvaluator::create(VkDevice device, VkPhysicalDevice physicalDevice, VkQueue queue, uint32_t queueFamilyIndex,
+                                  const ModelAsset &model, uint32_t frameSlots, const std::string &shaderPath)
+    {
+        destroy();
+        m_device = device;
+        m_physicalDevice = physicalDevice;
+        if (m_device == VK_NULL_HANDLE || m_physicalDevice == VK_NULL_HANDLE)
+            return false;
+        frameSlots = std::max(frameSlots, 1u);
+
+        VkShaderModule shader = VK_NULL_HANDLE;
+        try
+        {
+            shader = Pipeline::createShaderModuleFromFile(m_device, shaderPath);
+        }
+        catch (const std::exception &e)
+        {
+            std::fprintf(stderr, "GpuPoseEvaluator: %s\n", e.what());
+            return false;
+        }
+
+        std::vector<uint32_t> words;
+        GpuAnimation::Build(model, words, m_layout);
+
+        bool ok = uploadAnimation(queue, queueFamilyIndex, words);
+
+        // Set 0: animation tables, requests, node palette, joint palette.
+        if (ok)
+        {
+            VkDescriptorSetLayoutBinding bindings[4]{};
+            for (uint32_t b = 0; b < 4; ++b)
+            {
+                bindings[b].binding = b;
+                bindings[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                bindings[b].descriptorCount = 1;
+                bindings[b].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            }
+            VkDescriptorSetLayoutCreateInfo dsl{};
+            dsl.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            dsl.bindingCount = 4;
+            dsl.pBindings = bindings;
+            ok = vkCreateDescriptorSetLayout(m_device, &dsl, nullptr, &m_setLayout) == VK_SUCCESS;
+        }
+        if (ok)
+        {
+            VkDescriptorPoolSize poolSize{};
+            poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            poolSize.descriptorCount = frameSlots * 4u;
+            VkDescriptorPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            poolInfo.maxSets = frameSlots;
+            poolInfo.poolSizeCount = 1;
+            poolInfo.pPoolSizes = &poolSize;
+            ok = vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &m_pool) == VK_SUCCESS;
+        }
+        if (ok)
+        {
+            m_slots.resize(frameSlots);
+            std::vector<VkDescriptorSetLayout> layouts(frameSlots, m_setLayout);
+            std::vector<VkDescriptorSet> sets(frameSlots, VK_NULL_HANDLE);
+            VkDescriptorSetAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocInfo.descriptorPool = m_pool;
+            allocInfo.descriptorSetCount = frameSlots;
+            allocInfo.pSetLayouts = layouts.data();
+            ok = vkAllocateDescriptorSets(m_device, &allocInfo, sets.data()) == VK_SUCCESS;
+            for (uint32_t i = 0; ok && i < frameSlots; ++i)
+                m_slots[i].set = sets[i];
+        }
+        if (ok)
+        {
+            VkPushConstantRange pcRange{};
+            pcRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            pcRange.offset = 0;
+            pcRange.size = sizeof(PushConstants);
+            VkPipelineLayoutCreateInfo plInfo{};
+            plInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            plInfo.setLayoutCount = 1;
+            plInfo.pSetLayouts = &m_setLayout;
+            plInfo.pushConstantRangeCount = 1;
+            plInfo.pPushConstantRanges = &pcRange;
+            ok = vkCreatePipelineLayout(m_device, &plInfo, nullptr, &m_pipelineLayout) == VK_SUCCESS;
+        }
+        if (ok)
+        {
+            VkComputePipelineCreateInfo cpi{};
+            cpi.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            cpi.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            cpi.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            cpi.stage.module = shader;
+            cpi.stage.pName = "main";
+            cpi.layout = m_pipelineLayout;
+            ok = vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &cpi, nullptr, &m_pipeline) == VK_SUCCESS;
+        }
+        vkDestroyShaderModule(m_device, shader, nullptr);
+
+        if (!ok)
+        {
+            std::fprintf(stderr, "GpuPoseEvaluator: failed to create compute resources\n");
+            destroy();
+            return false;
+        }
+
+        // Timestamps are optional: only when the queue family supports them.
+        uint32_t familyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &familyCount, families.data());
+        if (queueFamilyIndex < familyCount && families[queueFamilyIndex].timestampValidBits > 0)
+        {
+            VkPhysicalDeviceProperties props{};
+            vkGetPhysicalDeviceProperties(m_physicalDevice, &props);
+            m_timestampPeriod = props.limits.timestampPeriod;
+
+            VkQueryPoolCreateInfo qpi{};
+            qpi.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            qpi.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            qpi.queryCount = frameSlots * 2u;
+            if (vkCreateQueryPool(m_device, &qpi, nullptr, &m_queryPool) != VK_SUCCESS)
+                m_queryPool = VK_NULL_HANDLE;
+        }
+        return true;
+    }
+
+    void GpuPoseEvaluator::destroy()
+    {
+        if (m_device == VK_NULL_HANDLE)
+            return;
+
+        for (Slot &slot : m_slots)
+        {
+            if (slot.requestMapped)
+                vkUnmapMemory(m_device, slot.requestMemory);
+            if (slot.requestBuffer != VK_NULL_HANDLE)
+                vkDestroyBuffer(m_device, slot.requestBuffer, nullptr);
+            if (slot.requestMemory != VK_NULL_HANDLE)
+                vkFreeMemory(m_device, slot.requestMemory, nullptr);
+        }
+        m_slots.clear();
+
+        if (m_queryPool != VK_NULL_HANDLE)
+            vkDestroyQueryPool(m_device, m_queryPool, nullptr);
+        if (m_pipeline != VK_NULL_HANDLE)
+            vkDestroyPipeline(m_device, m_pipeline, nullptr);
+        if (m_pipelineLayout != VK_NULL_HANDLE)
+            vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+        if (m_pool != VK_NULL_HANDLE)
+            vkDestroyDescriptorPool(m_device, m_pool, nullptr);
+        if (m_setLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(m_device, m_setLayout, nullptr);
+        if (m_animBuffer != VK_NULL_HANDLE)
+            vkDestroyBuffer(m_device, m_animBuffer, nullptr);
+        if (m_animMemory != VK_NULL_HANDLE)
+            vkFreeMemory(m_device, m_animMemory, nullptr);
+
+        m_queryPool = VK_NULL_HANDLE;
+        m_pipeline = VK_NULL_HANDLE;
+        m_pipelineLayout = VK_NULL_HANDLE;
+        m_pool = VK_NULL_HANDLE;
+        m_setLayout = VK_NULL_HANDLE;
+        m_animBuffer = VK_NULL_HANDLE;
+        m_animMemory = VK_NULL_HANDLE;
+        m_layout = GpuAnimationLayout{};
+        m_lastGpuMs = 0.0f;
+        m_device = VK_NULL_HANDLE;
+        m_physicalDevice = VK_NULL_HANDLE;
+    }
+
+    bool GpuPoseEvaluator::ensureRequestCapacity(Slot &slot, uint32_t needed)
+    {
+        if (needed <= slot.requestCapacity && slot.requestBuffer != VK_NULL_HANDLE)
+            return true;
+
+        uint32_t newCap = std::max<uint32_t>(1024u, slot.requestCapacity);
+        while (newCap < needed)
+            newCap *= 2u;
+
+        if (slot.requestMapped)
+            vkUnmapMemory(m_device, slot.requestMemory);
+        if (slot.requestBuffer != VK_NULL_HANDLE)
+            vkDestroyBuffer(m_device, slot.requestBuffer, nullptr);
+        if (slot.requestMemory != VK_NULL_HANDLE)
+            vkFreeMemory(m_device, slot.requestMemory, nullptr);
+        slot.requestBuffer = VK_NULL_HANDLE;
+        slot.requestMemory = VK_NULL_HANDLE;
+        slot.requestMapped = nullptr;
+        slot.requestCapacity = 0;
+
+        if (!createHostBuffer(static_cast<VkDeviceSize>(newCap) * sizeof(PoseRequest), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                              slot.requestBuffer, slot.requestMemory, &slot.requestMapped))
+            return false;
+        slot.requestCapacity = newCap;
+        return true;
+    }
+
+    // Results of the slot's previous dispatch (complete once the caller reuses the slot).
+    void GpuPoseEvaluator::readTimestamps(Slot &slot, uint32_t frameSlot)
+    {
+        if (m_queryPool == VK_NULL_HANDLE || !slot.queriesWritten)
+            return;
+        uint64_t ticks[2] = {0, 0};
+        if (vkGetQueryPoolResults(m_device, m_queryPool, frameSlot * 2u, 2, sizeof(ticks), ticks, sizeof(uint64_t),
+                                  VK_QUERY_RESULT_64_BIT) == VK_SUCCESS &&
+            ticks[1] >= ticks[0])
+        {
+            m_lastGpuMs = static_cast<float>(static_cast<double>(ticks[1] - ticks[0]) * m_timestampPeriod * 1e-6);
+        }
+    }
+
+    bool GpuPoseEvaluator::record(VkCommandBuffer cmd, uint32_t frameSlot, const PoseRequest *requests, uint32_t poseCount,
+                                  VkBuffer nodeOut, VkDeviceSize nodeBytes, VkBuffer jointOut, VkDeviceSize jointBytes)
+    {
+        if (!valid() || poseCount == 0 || !requests || nodeOut == VK_NULL_HANDLE)
+            return false;
+        if (m_layout.jointCount > 0 && jointOut == VK_NULL_HANDLE)
+            return false;
+
+        frameSlot %= static_cast<uint32_t>(m_slots.size());
+        Slot &slot = m_slots[frameSlot];
+        readTimestamps(slot, frameSlot);
+
+        if (!ensureRequestCapacity(slot, poseCount))
+            return false;
+        std::memcpy(slot.requestMapped, requests, sizeof(PoseRequest) * poseCount);
+
+        // Unskinned models never write joints; point the binding at the node palette.
+        if (jointOut == VK_NULL_HANDLE)
+        {
+            jointOut = nodeOut;
+            jointBytes = nodeBytes;
+        }
+
+        if (slot.boundRequests != slot.requestBuffer || slot.boundNodes != nodeOut || slot.boundNodeBytes != nodeBytes ||
+            slot.boundJoints != jointOut || slot.boundJointBytes != jointBytes)
+        {
+            VkDescriptorBufferInfo infos[4]{};
+            infos[0] = {m_animBuffer, 0, VK_WHOLE_SIZE};
+            infos[1] = {slot.requestBuffer, 0, VK_WHOLE_SIZE};
+            infos[2] = {nodeOut, 0, nodeBytes};
+            infos[3] = {jointOut, 0, jointBytes};
+
+            VkWriteDescriptorSet writes[4]{};
+            for (uint32_t b = 0; b < 4; ++b)
+            {
+                writes[b].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[b].dstSet = slot.set;
+                writes[b].dstBinding = b;
+                writes[b].dstArrayElement = 0;
+                writes[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                writes[b].descriptorCount = 1;
+                writes[b].pBufferInfo = &infos[b];
+            }
+            vkUpdateDescriptorSets(m_device, 4, writes, 0, nullptr);
+            slot.boundRequests = slot.requestBuffer;
+            slot.boundNodes = nodeOut;
+            slot.boundNodeBytes = nodeBytes;
+            slot.boundJoints = jointOut;
+            slot.boundJointBytes = jointBytes;
+        }
+
+        if (m_queryPool != VK_NULL_HANDLE)
+        {
+            vkCmdResetQueryPool(cmd, m_queryPool, frameSlot * 2u, 2);
+            vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool, frameSlot * 2u);
+        }
+
+        PushConstants pc{};
+        pc.counts[0] = poseCount;
+        pc.counts[1] = m_layout.nodeCount;
+        pc.counts[2] = m_layout.jointCount;
+        pc.counts[3] = m_layout.clipCount;
+        pc.tables[0] = m_layout.clipOffset;
+        pc.tables[1] = m_layout.channelOffset;
+        pc.tables[2] = m_layout.samplerOffset;
+        pc.tables[3] = m_layout.timeOffset;
+        pc.tables2[0] = m_layout.valueOffset;
+        pc.tables2[1] = m_layout.restOffset;
+        pc.tables2[2] = m_layout.orderOffset;
+        pc.tables2[3] = m_layout.jointOffset;
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &slot.set, 0, nullptr);
+        vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pc);
+        vkCmdDispatch(cmd, (poseCount + kWorkgroupSize - 1) / kWorkgroupSize, 1, 1);
+
+        if (m_queryPool != VK_NULL_HANDLE)
+        {
+            vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, m_queryPool, frameSlot * 2u + 1u);
+            slot.queriesWritten = true;
+        }
+
+        // Palettes are read by the vertex stage this frame (and by the host in tools).
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+        return true;
+    }
+}
@@ -72,8 +72,8 @@ namespace Engine
 
         pci.shaderStages = {vs, fs};
 
-        // Vertex input matches SModelRenderPassModule (VertexPNTTJW)
-        std::array<VkVertexInputBindingDescription, 2> bindingDescs{};
+        // Vertex input matches SModelRenderPassModule (VertexPNTTJW + instance world + pose index)
+        std::array<VkVertexInputBindingDescription, 3> bindingDescs{};
         bindingDescs[0].binding = 0;
         bindingDescs[0].stride = 72;
         bindingDescs[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
@@ -82,7 +82,11 @@ namespace Engine
         bindingDescs[1].stride = sizeof(glm::mat4);
         bindingDescs[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
-        std::array<VkVertexInputAttributeDescription, 10> attrs{};
+        bindingDescs[2].binding = 2;
+        bindingDescs[2].stride = sizeof(uint32_t);
+        bindingDescs[2].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+        std::array<VkVertexInputAttributeDescription, 11> attrs{};
         attrs[0] = {0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0};
         attrs[1] = {1, 0, VK_FORMAT_R32G32B32_SFLOAT, 12};
         attrs[2] = {2, 0, VK_FORMAT_R32G32_SFLOAT, 24};
@@ -96,6 +100,7 @@ namespace Engine
         attrs[7] = {5, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 16};
         attrs[8] = {6, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 32};
         attrs[9] = {7, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 48};
+        attrs[10] = {10, 2, VK_FORMAT_R32_UINT, 0};
 
         VkPipelineVertexInputStateCreateInfo vi{};
         vi.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -276,7 +281,7 @@ namespace Engine
 
             VkBufferCreateInfo pbinfo{};
             pbinfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            pbinfo.size = static_cast<VkDeviceSize>(cf.paletteCapacityMatrices) * sizeof(glm::mat4);
+            pbinfo.size = static_cast<VkDeviceSize>(cf.paletteCapacityMatrices) * sizeof(PaletteMatrix);
             pbinfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
             pbinfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -306,8 +311,8 @@ namespace Engine
 
             if (cf.paletteMapped)
             {
-                const glm::mat4 I(1.0f);
-                std::memcpy(cf.paletteMapped, &I, sizeof(glm::mat4));
+                const PaletteMatrix I = PaletteIdentity();
+                std::memcpy(cf.paletteMapped, &I, sizeof(PaletteMatrix));
             }
 
             // Joint palette SSBO: allocate a tiny buffer (identity matrix) to satisfy smodel.vert.
@@ -315,7 +320,7 @@ namespace Engine
 
             VkBufferCreateInfo jbinfo{};
             jbinfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            jbinfo.size = static_cast<VkDeviceSize>(cf.jointPaletteCapacityMatrices) * sizeof(glm::mat4);
+            jbinfo.size = static_cast<VkDeviceSize>(cf.jointPaletteCapacityMatrices) * sizeof(PaletteMatrix);
             jbinfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
             jbinfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -345,8 +350,8 @@ namespace Engine
 
             if (cf.jointPaletteMapped)
             {
-                const glm::mat4 I(1.0f);
-                std::memcpy(cf.jointPaletteMapped, &I, sizeof(glm::mat4));
+                const PaletteMatrix I = PaletteIdentity();
+                std::memcpy(cf.jointPaletteMapped, &I, sizeof(PaletteMatrix));
             }
 
             VkDescriptorBufferInfo dbi{};
@@ -357,12 +362,12 @@ namespace Engine
             VkDescriptorBufferInfo pbi{};
             pbi.buffer = cf.paletteBuffer;
             pbi.offset = 0;
-            pbi.range = static_cast<VkDeviceSize>(cf.paletteCapacityMatrices) * sizeof(glm::mat4);
+            pbi.range = static_cast<VkDeviceSize>(cf.paletteCapacityMatrices) * sizeof(PaletteMatrix);
 
             VkDescriptorBufferInfo jbi{};
             jbi.buffer = cf.jointPaletteBuffer;
             jbi.offset = 0;
-            jbi.range = static_cast<VkDeviceSize>(cf.jointPaletteCapacityMatrices) * sizeof(glm::mat4);
+            jbi.range = static_cast<VkDeviceSize>(cf.jointPaletteCapacityMatrices) * sizeof(PaletteMatrix);
 
             VkWriteDescriptorSet writes[3]{};
             writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -464,7 +469,8 @@ namespace Engine
 
         m_instanceFrames.resize(frameCount);
 
-        const VkDeviceSize bufSize = sizeof(glm::mat4);
+        // One identity world matrix followed by pose index 0.
+        const VkDeviceSize bufSize = sizeof(glm::mat4) + sizeof(uint32_t);
         for (size_t i = 0; i < frameCount; ++i)
         {
             InstanceFrame &fr = m_instanceFrames[i];
@@ -746,7 +752,9 @@ namespace Engine
         if (!instFrame || !instFrame->mapped)
             return;
         const glm::mat4 I(1.0f);
+        const uint32_t pose = 0;
         std::memcpy(instFrame->mapped, &I, sizeof(glm::mat4));
+        std::memcpy(static_cast<char *>(instFrame->mapped) + sizeof(glm::mat4), &pose, sizeof(uint32_t));
 
         // Update plane vertices (centered around camera; UVs in world-space)
         updatePlaneForFrame(frameCtx.frameIndex);
@@ -766,9 +774,9 @@ namespace Engine
         vkCmdPushConstants(cmd, m_pipeline.getLayout(), VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &m_pc);
 
         const uint32_t vbIndex = frameCtx.frameIndex % static_cast<uint32_t>(m_planeVB.size());
-        VkBuffer vbs[2] = {m_planeVB[vbIndex].buffer, instFrame->buffer};
-        VkDeviceSize offs[2] = {0, 0};
-        vkCmdBindVertexBuffers(cmd, 0, 2, vbs, offs);
+        VkBuffer vbs[3] = {m_planeVB[vbIndex].buffer, instFrame->buffer, instFrame->buffer};
+        VkDeviceSize offs[3] = {0, 0, sizeof(glm::mat4)};
+        vkCmdBindVertexBuffers(cmd, 0, 3, vbs, offs);
         vkCmdBindIndexBuffer(cmd, m_planeIB.buffer, 0, VK_INDEX_TYPE_UINT16);
         vkCmdDrawIndexed(cmd, 6, 1, 0, 0, 0);
         DrawCallCounter::increment();
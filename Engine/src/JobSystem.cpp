@@ -0,0 +1,101 @@
+#include "Engine/JobSystem.h"
+
+#include <algorithm>
+
+namespace Engine
+{
+    uint32_t JobSystem::defaultWorkerCount()
+    {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return hw > 1 ? static_cast<uint32_t>(hw - 1) : 0u;
+    }
+
+    JobSystem::JobSystem(uint32_t workerCount)
+    {
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+            m_workers.emplace_back([this, i]
+                                   { workerLoop(i + 1); }); // thread 0 is the caller
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread &t : m_workers)
+            t.join();
+    }
+
+    void JobSystem::parallelFor(uint32_t count, uint32_t grain, const ChunkFn &fn)
+    {
+        if (count == 0)
+            return;
+        grain = std::max(1u, grain);
+
+        if (m_workers.empty() || count <= grain)
+        {
+            fn(0, count, 0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_fn = &fn;
+            m_count = count;
+            m_grain = grain;
+            m_nextChunk.store(0, std::memory_order_relaxed);
+            m_busyWorkers = static_cast<uint32_t>(m_workers.size());
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        runChunks(0);
+
+        // Workers still reference `fn` until they have checked out.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]
+                    { return m_busyWorkers == 0; });
+        m_fn = nullptr;
+    }
+
+    void JobSystem::workerLoop(uint32_t threadIndex)
+    {
+        uint64_t seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&]
+                            { return m_stop || m_generation != seen; });
+                if (m_stop)
+                    return;
+                seen = m_generation;
+            }
+
+            runChunks(threadIndex);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_busyWorkers == 0)
+                    m_done.notify_one();
+            }
+        }
+    }
+
+    void JobSystem::runChunks(uint32_t threadIndex)
+    {
+        const uint32_t chunks = (m_count + m_grain - 1) / m_grain;
+        for (;;)
+        {
+            const uint32_t c = m_nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (c >= chunks)
+                return;
+            const uint32_t begin = c * m_grain;
+            const uint32_t end = std::min(m_count, begin + m_grain);
+            (*m_fn)(begin, end, threadIndex);
+        }
+    }
+}
@@ -8,9 +8,11 @@
 #include <numeric>
 #include <atomic>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 
 #ifdef _WIN32
@@ -58,6 +60,49 @@ namespace Engine
         return g_drawCallCount.load(std::memory_order_relaxed);
     }
 
+    // -----------------------------------------------------------------------
+    // Global overlay stats (published by gameplay code)
+    // -----------------------------------------------------------------------
+    static std::mutex g_overlayStatsMutex;
+    static std::vector<OverlayStats::Entry> g_overlayStats;
+
+    void OverlayStats::set(const std::string& label, float value, const char* format)
+    {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), format ? format : "%.0f", static_cast<double>(value));
+
+        std::lock_guard<std::mutex> lock(g_overlayStatsMutex);
+        for (auto& e : g_overlayStats)
+        {
+            if (e.label == label)
+            {
+                e.text = buf;
+                return;
+            }
+        }
+        g_overlayStats.push_back({label, buf});
+    }
+
+    void OverlayStats::remove(const std::string& label)
+    {
+        std::lock_guard<std::mutex> lock(g_overlayStatsMutex);
+        g_overlayStats.erase(std::remove_if(g_overlayStats.begin(), g_overlayStats.end(),
+                                            [&](const Entry& e) { return e.label == label; }),
+                             g_overlayStats.end());
+    }
+
+    void OverlayStats::clear()
+    {
+        std::lock_guard<std::mutex> lock(g_overlayStatsMutex);
+        g_overlayStats.clear();
+    }
+
+    std::vector<OverlayStats::Entry> OverlayStats::snapshot()
+    {
+        std::lock_guard<std::mutex> lock(g_overlayStatsMutex);
+        return g_overlayStats;
+    }
+
     // -----------------------------------------------------------------------
     // Ctor / Dtor
     // -----------------------------------------------------------------------
@@ -665,6 +710,20 @@ namespace Engine
             ImGui::PopStyleColor();
             ImGui::Text("  Draw Calls: %u", m_lastFrameDrawCalls);
 
+            // --- Simulation Section (stats published via OverlayStats) ---
+            const std::vector<OverlayStats::Entry> simStats = OverlayStats::snapshot();
+            if (!simStats.empty())
+            {
+                ImGui::Spacing();
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 1.0f, 0.4f, 1.0f));
+                ImGui::Text("Simulation");
+                ImGui::PopStyleColor();
+                for (const auto& e : simStats)
+                {
+                    ImGui::Text("  %s: %s", e.label.c_str(), e.text.c_str());
+                }
+            }
+
             ImGui::Spacing();
             ImGui::Separator();
             ImGui::TextDisabled("Press F1 to toggle");
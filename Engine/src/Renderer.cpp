@@ -531,6 +531,14 @@ namespace Engine
             vkCmdWriteTimestamp(frame.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_timestampQueryPool, startQuery);
         }
 
+        // Newest extracted snapshot; modules record their pre-pass work (compute) from it.
+        frame.snapshot = m_snapshots.acquireRead();
+        for (auto &p : m_passes)
+        {
+            if (p)
+                p->recordPrePass(frame, frame.commandBuffer);
+        }
+
         // Begin render pass
         VkClearValue clears[2]{};
         clears[0].color = {{0.02f, 0.02f, 0.04f, 1.0f}};
@@ -547,7 +555,7 @@ namespace Engine
 
         vkCmdBeginRenderPass(frame.commandBuffer, &rpBegin, VK_SUBPASS_CONTENTS_INLINE);
 
-        // Let modules record draw commands
+        // Let modules record draw commands from the same snapshot
         for (auto &p : m_passes)
         {
             if (p)
@@ -1,4 +1,5 @@
 #include "assets/SModelLoader.h"
+#include "assets/AnimationQuantization.h"
 
 #include <fstream>
 #include <sstream>
@@ -480,6 +481,15 @@ namespace Engine
                                 outError = "Node references invalid primitive index";
                                 return false;
                             }
+
+                            // The runtime only keeps node palette entries for flagged nodes.
+                            const int32_t skin = outView.primitives[pidx].skinIndex;
+                            const bool rigid = skin < 0 || uint32_t(skin) >= outView.header->skinCount;
+                            if (rigid && (nr.flags & SModelNodeFlag_RigidPrimitives) == 0)
+                            {
+                                outError = "Node draws an unskinned primitive but is not flagged SModelNodeFlag_RigidPrimitives";
+                                return false;
+                            }
                         }
                     }
                 }
@@ -608,13 +618,23 @@ namespace Engine
                     return false;
                 }
 
-                const uint64_t expected = (s.valueType == uint8_t(SModelAnimValueType::Vec3))
-                                              ? uint64_t(s.timeCount) * 3ull
-                                              : uint64_t(s.timeCount) * 4ull;
+                const bool quantized = AnimQuant::IsQuantized(s);
+                if (quantized && s.interpolation == uint8_t(SModelAnimInterpolation::CubicSpline))
+                {
+                    outError = "Animation sampler is quantized but uses cubic spline interpolation";
+                    return false;
+                }
+
+                uint64_t expected = (s.valueType == uint8_t(SModelAnimValueType::Vec3))
+                                        ? uint64_t(s.timeCount) * 3ull
+                                        : uint64_t(s.timeCount) * 4ull;
+                if (quantized)
+                    expected = AnimQuant::PackedValueCount(SModelAnimValueType(s.valueType), s.timeCount);
 
                 if (uint64_t(s.valueCount) != expected)
                 {
-                    outError = "Animation sampler valueCount does not match timeCount * valueWidth";
+                    outError = quantized ? "Animation sampler valueCount does not match its quantized key count"
+                                         : "Animation sampler valueCount does not match timeCount * valueWidth";
                     return false;
                 }
 
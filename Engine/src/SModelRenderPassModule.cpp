@@ -2,6 +2,7 @@
 #include "Engine/VulkanContext.h"
 #include "Engine/SwapChain.h"
 #include "Engine/PerformanceMonitor.h"
+#include "Engine/RenderSnapshot.h"
 #include "assets/ModelAsset.h"
 #include "assets/MeshAsset.h"
 #include "assets/MaterialAsset.h"
@@ -9,6 +10,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdio>
 #include <cstring>
 #include <stdexcept>
 #include <unordered_set>
@@ -240,7 +242,8 @@ namespace Engine
         m_paletteInstanceCount = instanceCount;
         m_paletteNodeCount = nodeCount;
         const size_t total = static_cast<size_t>(instanceCount) * static_cast<size_t>(nodeCount);
-        m_nodePalette.assign(nodeGlobals, nodeGlobals + total);
+        m_nodePalette.resize(total);
+        ToPaletteMatrices(nodeGlobals, total, m_nodePalette.data());
     }
 
     void SModelRenderPassModule::setJointPalette(const glm::mat4 *jointMatrices, uint32_t instanceCount, uint32_t jointCount)
@@ -253,7 +256,8 @@ namespace Engine
 
         m_jointPaletteJointCount = jointCount;
         const size_t total = static_cast<size_t>(instanceCount) * static_cast<size_t>(jointCount);
-        m_jointPalette.assign(jointMatrices, jointMatrices + total);
+        m_jointPalette.resize(total);
+        ToPaletteMatrices(jointMatrices, total, m_jointPalette.data());
     }
 
     bool SModelRenderPassModule::refreshModelMatrix()
@@ -359,6 +363,8 @@ namespace Engine
         (void)fbs;
         m_device = ctx.GetDevice();
         m_physicalDevice = ctx.GetPhysicalDevice();
+        m_queue = ctx.GetGraphicsQueue();
+        m_queueFamilyIndex = ctx.GetGraphicsQueueFamilyIndex();
         m_extent = ctx.GetSwapChain() ? ctx.GetSwapChain()->GetExtent() : VkExtent2D{};
 
         // Default model matrix: center/scale from bounds if available
@@ -532,7 +538,7 @@ namespace Engine
 
             VkBufferCreateInfo pbinfo{};
             pbinfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            pbinfo.size = static_cast<VkDeviceSize>(cf.paletteCapacityMatrices) * sizeof(glm::mat4);
+            pbinfo.size = static_cast<VkDeviceSize>(cf.paletteCapacityMatrices) * sizeof(PaletteMatrix);
             pbinfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
             pbinfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -565,7 +571,7 @@ namespace Engine
 
             VkBufferCreateInfo jbinfo{};
             jbinfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            jbinfo.size = static_cast<VkDeviceSize>(cf.jointPaletteCapacityMatrices) * sizeof(glm::mat4);
+            jbinfo.size = static_cast<VkDeviceSize>(cf.jointPaletteCapacityMatrices) * sizeof(PaletteMatrix);
             jbinfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
             jbinfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -600,12 +606,12 @@ namespace Engine
             VkDescriptorBufferInfo pbi{};
             pbi.buffer = cf.paletteBuffer;
             pbi.offset = 0;
-            pbi.range = static_cast<VkDeviceSize>(cf.paletteCapacityMatrices) * sizeof(glm::mat4);
+            pbi.range = static_cast<VkDeviceSize>(cf.paletteCapacityMatrices) * sizeof(PaletteMatrix);
 
             VkDescriptorBufferInfo jbi{};
             jbi.buffer = cf.jointPaletteBuffer;
             jbi.offset = 0;
-            jbi.range = static_cast<VkDeviceSize>(cf.jointPaletteCapacityMatrices) * sizeof(glm::mat4);
+            jbi.range = static_cast<VkDeviceSize>(cf.jointPaletteCapacityMatrices) * sizeof(PaletteMatrix);
 
             VkWriteDescriptorSet writes[3]{};
             writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -750,7 +756,7 @@ namespace Engine
 
         VkBufferCreateInfo binfo{};
         binfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        binfo.size = static_cast<VkDeviceSize>(newCap) * sizeof(glm::mat4);
+        binfo.size = static_cast<VkDeviceSize>(newCap) * sizeof(PaletteMatrix);
         binfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
         binfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -782,7 +788,7 @@ namespace Engine
         VkDescriptorBufferInfo pbi{};
         pbi.buffer = frame.paletteBuffer;
         pbi.offset = 0;
-        pbi.range = static_cast<VkDeviceSize>(frame.paletteCapacityMatrices) * sizeof(glm::mat4);
+        pbi.range = static_cast<VkDeviceSize>(frame.paletteCapacityMatrices) * sizeof(PaletteMatrix);
 
         VkWriteDescriptorSet write{};
         write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -843,7 +849,7 @@ namespace Engine
 
         VkBufferCreateInfo binfo{};
         binfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        binfo.size = static_cast<VkDeviceSize>(newCap) * sizeof(glm::mat4);
+        binfo.size = static_cast<VkDeviceSize>(newCap) * sizeof(PaletteMatrix);
         binfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
         binfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -875,7 +881,7 @@ namespace Engine
         VkDescriptorBufferInfo jbi{};
         jbi.buffer = frame.jointPaletteBuffer;
         jbi.offset = 0;
-        jbi.range = static_cast<VkDeviceSize>(frame.jointPaletteCapacityMatrices) * sizeof(glm::mat4);
+        jbi.range = static_cast<VkDeviceSize>(frame.jointPaletteCapacityMatrices) * sizeof(PaletteMatrix);
 
         VkWriteDescriptorSet write{};
         write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -916,7 +922,7 @@ namespace Engine
 
         // Start with a modest default capacity; grows on demand.
         constexpr uint32_t kDefaultCapacity = 256;
-        const VkDeviceSize bufSize = static_cast<VkDeviceSize>(kDefaultCapacity) * sizeof(glm::mat4);
+        const VkDeviceSize bufSize = static_cast<VkDeviceSize>(kDefaultCapacity) * kInstanceBytes;
 
         for (size_t i = 0; i < frameCount; ++i)
         {
@@ -1029,7 +1035,7 @@ namespace Engine
             return false;
         };
 
-        const VkDeviceSize bufSize = static_cast<VkDeviceSize>(newCap) * sizeof(glm::mat4);
+        const VkDeviceSize bufSize = static_cast<VkDeviceSize>(newCap) * kInstanceBytes;
         VkBufferCreateInfo binfo{};
         binfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         binfo.size = bufSize;
@@ -1125,7 +1131,8 @@ namespace Engine
         // Vertex input:
         //  binding 0: VertexPNTTJW (72 bytes)
         //  binding 1: Instance mat4 (64 bytes), advanced per-instance
-        std::array<VkVertexInputBindingDescription, 2> bindingDescs{};
+        //  binding 2: Instance pose index (uint32), advanced per-instance
+        std::array<VkVertexInputBindingDescription, 3> bindingDescs{};
         bindingDescs[0].binding = 0;
         bindingDescs[0].stride = 72;
         bindingDescs[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
@@ -1134,7 +1141,11 @@ namespace Engine
         bindingDescs[1].stride = sizeof(glm::mat4);
         bindingDescs[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
-        std::array<VkVertexInputAttributeDescription, 10> attrs{};
+        bindingDescs[2].binding = 2;
+        bindingDescs[2].stride = sizeof(uint32_t);
+        bindingDescs[2].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+        std::array<VkVertexInputAttributeDescription, 11> attrs{};
         attrs[0] = {0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0};     // pos
         attrs[1] = {1, 0, VK_FORMAT_R32G32B32_SFLOAT, 12};    // normal
         attrs[2] = {2, 0, VK_FORMAT_R32G32_SFLOAT, 24};       // uv0
@@ -1150,6 +1161,8 @@ namespace Engine
         attrs[8] = {6, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 32};
         attrs[9] = {7, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 48};
 
+        attrs[10] = {10, 2, VK_FORMAT_R32_UINT, 0}; // pose index into the palettes
+
         VkPipelineVertexInputStateCreateInfo vi{};
         vi.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
         vi.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescs.size());
@@ -1239,6 +1252,38 @@ namespace Engine
         if (!model || model->primitives.empty())
             return;
 
+        // Instance and palette sources: the extracted snapshot batch, or the set*() copies.
+        const RenderSnapshot *snapshot = m_useSnapshot ? frameCtx.snapshot : nullptr;
+        const glm::mat4 *worlds = m_instanceWorlds.data();
+        size_t worldCount = m_instanceWorlds.size();
+        const PaletteMatrix *nodePalette = m_nodePalette.data();
+        size_t nodePaletteSize = m_nodePalette.size();
+        const PaletteMatrix *jointPalette = m_jointPalette.data();
+        size_t jointPaletteSize = m_jointPalette.size();
+        uint32_t jointPaletteJointCount = m_jointPaletteJointCount;
+        const uint32_t *poseIndices = nullptr; // nullptr: instance i uses pose i
+        uint32_t poseCount = 0;
+        uint32_t batchPaletteNodes = ~0u; // nodePalette entries per pose when it comes from a batch
+        if (m_useSnapshot)
+        {
+            const RenderBatch *batch = snapshot ? snapshot->find(m_model) : nullptr;
+            if (!batch)
+                return;
+            worlds = batch->instanceWorlds.data();
+            worldCount = batch->instanceWorlds.size();
+            nodePalette = batch->nodePalette.data();
+            nodePaletteSize = batch->nodePalette.size();
+            jointPalette = batch->jointPalette.data();
+            jointPaletteSize = batch->jointPalette.size();
+            jointPaletteJointCount = batch->jointCount;
+            batchPaletteNodes = batch->paletteNodeCount;
+            if (batch->poseCount > 0 && batch->instancePoses.size() == worldCount)
+            {
+                poseIndices = batch->instancePoses.data();
+                poseCount = batch->poseCount;
+            }
+        }
+
         VkViewport vp{0.0f, 0.0f, static_cast<float>(m_extent.width), static_cast<float>(m_extent.height), 0.0f, 1.0f};
         VkRect2D sc{{0, 0}, {m_extent.width, m_extent.height}};
         vkCmdSetViewport(cmd, 0, 1, &vp);
@@ -1251,7 +1296,12 @@ namespace Engine
         {
             CameraUBO ubo{};
             const float aspect = (m_extent.height > 0) ? (static_cast<float>(m_extent.width) / static_cast<float>(m_extent.height)) : 1.0f;
-            if (m_camera)
+            if (snapshot && snapshot->hasCamera)
+            {
+                ubo.view = snapshot->view;
+                ubo.proj = snapshot->proj;
+            }
+            else if (m_camera)
             {
                 m_camera->SetAspect(aspect);
                 ubo.view = m_camera->GetViewMatrix();
@@ -1278,13 +1328,15 @@ namespace Engine
         const uint32_t instIndex = (!m_instanceFrames.empty()) ? (frameCtx.frameIndex % static_cast<uint32_t>(m_instanceFrames.size())) : 0;
         InstanceFrame *instFrame = (!m_instanceFrames.empty()) ? &m_instanceFrames[instIndex] : nullptr;
 
-        const uint32_t instanceCount = m_instanceWorlds.empty() ? 1u : static_cast<uint32_t>(m_instanceWorlds.size());
+        const uint32_t instanceCount = (worldCount == 0) ? 1u : static_cast<uint32_t>(worldCount);
+        if (!poseIndices)
+            poseCount = instanceCount;
         if (instFrame)
         {
             if (!ensureInstanceCapacity(*instFrame, instanceCount))
                 return;
 
-            const glm::mat4 *src = m_instanceWorlds.empty() ? nullptr : m_instanceWorlds.data();
+            const glm::mat4 *src = (worldCount == 0) ? nullptr : worlds;
             if (src)
             {
                 std::memcpy(instFrame->mapped, src, sizeof(glm::mat4) * instanceCount);
@@ -1294,12 +1346,33 @@ namespace Engine
                 const glm::mat4 I = identityMat4();
                 std::memcpy(instFrame->mapped, &I, sizeof(glm::mat4));
             }
+
+            uint32_t *dstPoses = reinterpret_cast<uint32_t *>(static_cast<char *>(instFrame->mapped) + instFrame->poseIndexOffset());
+            if (poseIndices)
+            {
+                std::memcpy(dstPoses, poseIndices, sizeof(uint32_t) * instanceCount);
+            }
+            else
+            {
+                for (uint32_t i = 0; i < instanceCount; ++i)
+                    dstPoses[i] = i;
+            }
         }
 
-        // Update node palette buffer for this frame (SSBO in set=0 binding=1).
+        // Node palette layout: snapshot batches carry only the model's palette nodes (the ones
+        // drawing unskinned primitives, none for fully skinned models); set*() palettes and
+        // the GPU pose path (its dispatch uses every node's slot) keep all nodes.
         const uint32_t nodeCount = model->nodes.empty() ? 1u : static_cast<uint32_t>(model->nodes.size());
-        const uint32_t neededMatrices = instanceCount * nodeCount;
-        if (camFrame && camFrame->paletteMapped)
+        const bool posesWritten = m_posesWritten;
+        m_posesWritten = false;
+        const bool compactNodes = !posesWritten && !model->nodes.empty() && model->hasPaletteNodes() &&
+                                  batchPaletteNodes == model->paletteNodeCount();
+        const uint32_t nodeStride = compactNodes ? model->paletteNodeCount() : nodeCount;
+        size_t uploadedBytes = 0;
+
+        // Update node palette buffer for this frame (SSBO in set=0 binding=1), one entry per pose.
+        const uint32_t neededMatrices = poseCount * nodeStride;
+        if (camFrame && camFrame->paletteMapped && !posesWritten && neededMatrices > 0)
         {
             if (!ensurePaletteCapacity(*camFrame, neededMatrices))
                 return;
@@ -1307,52 +1380,63 @@ namespace Engine
             const size_t expected = static_cast<size_t>(neededMatrices);
 
             // Prefer the explicitly provided palette; otherwise fall back to the model's current node globals.
-            if (m_nodePalette.size() == expected)
+            if (nodePaletteSize == expected)
             {
-                std::memcpy(camFrame->paletteMapped, m_nodePalette.data(), sizeof(glm::mat4) * expected);
+                std::memcpy(camFrame->paletteMapped, nodePalette, sizeof(PaletteMatrix) * expected);
             }
             else
             {
-                // Build a minimal fallback palette: replicate current per-node globals for each instance.
-                std::vector<glm::mat4> fallback;
+                // Build a minimal fallback palette: replicate current per-node globals for each pose.
+                std::vector<PaletteMatrix> fallback;
                 fallback.resize(expected);
                 const uint32_t modelNodeCount = static_cast<uint32_t>(model->nodes.size());
-                for (uint32_t inst = 0; inst < instanceCount; ++inst)
+                for (uint32_t pose = 0; pose < poseCount; ++pose)
                 {
-                    for (uint32_t ni = 0; ni < nodeCount; ++ni)
+                    for (uint32_t slot = 0; slot < nodeStride; ++slot)
                     {
-                        glm::mat4 g = glm::mat4(1.0f);
+                        const uint32_t ni = compactNodes ? model->paletteNodes[slot] : slot;
+                        PaletteMatrix g = PaletteIdentity();
                         if (ni < modelNodeCount)
-                            g = model->nodes[ni].globalMatrix;
-                        fallback[static_cast<size_t>(inst) * nodeCount + ni] = g;
+                            g = ToPaletteMatrix(model->nodes[ni].globalMatrix);
+                        fallback[static_cast<size_t>(pose) * nodeStride + slot] = g;
                     }
                 }
-                std::memcpy(camFrame->paletteMapped, fallback.data(), sizeof(glm::mat4) * expected);
+                std::memcpy(camFrame->paletteMapped, fallback.data(), sizeof(PaletteMatrix) * expected);
             }
+            uploadedBytes += sizeof(PaletteMatrix) * expected;
         }
 
-        // Update joint palette buffer for this frame (SSBO in set=0 binding=2).
+        // Update joint palette buffer for this frame (SSBO in set=0 binding=2). Unskinned models
+        // upload nothing: the shader only reads joints for primitives with a skin.
         const uint32_t jointStride = (model->totalJointCount > 0) ? model->totalJointCount : 1u;
-        const uint32_t neededJointMatrices = instanceCount * jointStride;
-        if (camFrame && camFrame->jointPaletteMapped)
+        const uint32_t neededJointMatrices = poseCount * jointStride;
+        if (camFrame && camFrame->jointPaletteMapped && !posesWritten && model->totalJointCount > 0)
         {
             if (!ensureJointPaletteCapacity(*camFrame, neededJointMatrices))
                 return;
 
             const size_t expected = static_cast<size_t>(neededJointMatrices);
-            if (model->totalJointCount > 0 && m_jointPaletteJointCount == model->totalJointCount && m_jointPalette.size() == expected)
+            if (jointPaletteJointCount == model->totalJointCount && jointPaletteSize == expected)
             {
-                std::memcpy(camFrame->jointPaletteMapped, m_jointPalette.data(), sizeof(glm::mat4) * expected);
+                std::memcpy(camFrame->jointPaletteMapped, jointPalette, sizeof(PaletteMatrix) * expected);
             }
             else
             {
-                // Default to identity matrices. Shader will not use these unless skinJointCount > 0.
-                std::vector<glm::mat4> fallback;
-                fallback.assign(expected, glm::mat4(1.0f));
-                std::memcpy(camFrame->jointPaletteMapped, fallback.data(), sizeof(glm::mat4) * expected);
+                // Default to identity matrices.
+                std::vector<PaletteMatrix> fallback;
+                fallback.assign(expected, PaletteIdentity());
+                std::memcpy(camFrame->jointPaletteMapped, fallback.data(), sizeof(PaletteMatrix) * expected);
             }
+            uploadedBytes += sizeof(PaletteMatrix) * expected;
         }
 
+        // Palette bytes written this frame vs what full node + joint palettes would take.
+        if (m_uploadStat.empty())
+            m_uploadStat = std::string("Palette upload ") + (model->debugName && model->debugName[0] ? model->debugName : "model");
+        const size_t fullBytes = sizeof(PaletteMatrix) * static_cast<size_t>(poseCount) * (nodeCount + jointStride);
+        OverlayStats::set(m_uploadStat, static_cast<float>(uploadedBytes) / 1024.0f, "%.1f KB");
+        OverlayStats::set(m_uploadStat + " (all nodes)", posesWritten ? 0.0f : static_cast<float>(fullBytes) / 1024.0f, "%.1f KB");
+
         // Pass ordering like glTF: 0=OPAQUE,1=MASK,2=BLEND
         for (uint32_t pass = 0; pass < 3; ++pass)
         {
@@ -1373,8 +1457,9 @@ namespace Engine
 
             if (instFrame && instFrame->buffer != VK_NULL_HANDLE)
             {
-                VkDeviceSize instOffset = 0;
-                vkCmdBindVertexBuffers(cmd, 1, 1, &instFrame->buffer, &instOffset);
+                const VkBuffer instBuffers[2] = {instFrame->buffer, instFrame->buffer};
+                const VkDeviceSize instOffsets[2] = {0, instFrame->poseIndexOffset()};
+                vkCmdBindVertexBuffers(cmd, 1, 2, instBuffers, instOffsets);
             }
 
             if (!model->nodes.empty())
@@ -1412,8 +1497,9 @@ namespace Engine
                         pc.materialParams[1] = static_cast<float>(mat->alphaMode);
                         pc.materialParams[2] = 0.0f;
                         pc.materialParams[3] = 0.0f;
-                        pc.nodeIndex = nodeIndex;
-                        pc.nodeCount = static_cast<uint32_t>(model->nodes.size());
+                        const uint32_t slot = compactNodes ? model->nodePaletteSlot[nodeIndex] : nodeIndex;
+                        pc.nodeIndex = (slot == ~0u) ? 0u : slot; // ~0u: skinned primitives only
+                        pc.nodeCount = nodeStride;
 
                         // Skinning per-primitive
                         pc.jointPaletteStride = jointStride;
@@ -1503,6 +1589,81 @@ namespace Engine
         }
     }
 
+    void SModelRenderPassModule::recordPrePass(FrameContext &frameCtx, VkCommandBuffer cmd)
+    {
+        m_posesWritten = false;
+        if (!m_enabled || !m_useSnapshot || !m_assets || !m_model.isValid())
+            return;
+        const RenderBatch *batch = frameCtx.snapshot ? frameCtx.snapshot->find(m_model) : nullptr;
+        if (!batch || batch->poseRequests.empty() || batch->poseRequests.size() != batch->poseCount)
+            return;
+        const ModelAsset *model = m_assets->getModel(m_model);
+        if (!model || model->primitives.empty() || m_cameraFrames.empty())
+            return;
+
+        // Same frame slot and palette strides record() uses.
+        const uint32_t camIndex = frameCtx.frameIndex % static_cast<uint32_t>(m_cameraFrames.size());
+        CameraFrame &camFrame = m_cameraFrames[camIndex];
+        const uint32_t poseCount = batch->poseCount;
+        const uint32_t nodeCount = model->nodes.empty() ? 1u : static_cast<uint32_t>(model->nodes.size());
+        const uint32_t jointStride = (model->totalJointCount > 0) ? model->totalJointCount : 1u;
+        if (!camFrame.paletteMapped || !camFrame.jointPaletteMapped)
+            return;
+        if (!ensurePaletteCapacity(camFrame, poseCount * nodeCount) ||
+            !ensureJointPaletteCapacity(camFrame, poseCount * jointStride))
+            return;
+
+        if (!m_gpuPoses && !m_gpuPosesFailed)
+        {
+            m_gpuPoses = std::make_unique<GpuPoseEvaluator>();
+            if (!m_gpuPoses->create(m_device, m_physicalDevice, m_queue, m_queueFamilyIndex, *model,
+                                    static_cast<uint32_t>(m_cameraFrames.size())))
+            {
+                std::fprintf(stderr, "SModelRenderPassModule: GPU pose evaluation unavailable, evaluating pose requests on the CPU\n");
+                m_gpuPoses.reset();
+                m_gpuPosesFailed = true;
+            }
+            else
+            {
+                m_gpuPoseStat = std::string("GPU poses ") + (model->debugName && model->debugName[0] ? model->debugName : "model");
+            }
+        }
+
+        if (m_gpuPoses)
+        {
+            const VkDeviceSize nodeBytes = static_cast<VkDeviceSize>(camFrame.paletteCapacityMatrices) * sizeof(PaletteMatrix);
+            const VkDeviceSize jointBytes = static_cast<VkDeviceSize>(camFrame.jointPaletteCapacityMatrices) * sizeof(PaletteMatrix);
+            m_posesWritten = m_gpuPoses->record(cmd, camIndex, batch->poseRequests.data(), poseCount,
+                                                camFrame.paletteBuffer, nodeBytes,
+                                                model->totalJointCount > 0 ? camFrame.jointPaletteBuffer : VK_NULL_HANDLE, jointBytes);
+            OverlayStats::set(m_gpuPoseStat, m_gpuPoses->lastGpuMs(), "%.3f ms");
+        }
+        if (!m_posesWritten)
+        {
+            evaluatePosesOnCpu(*model, *batch, camFrame);
+            m_posesWritten = true;
+        }
+    }
+
+    // Fallback for the GPU pose path: the same poses, evaluated here into the mapped palettes.
+    void SModelRenderPassModule::evaluatePosesOnCpu(const ModelAsset &model, const RenderBatch &batch, CameraFrame &frame)
+    {
+        const uint32_t nodeCount = model.nodes.empty() ? 1u : static_cast<uint32_t>(model.nodes.size());
+        const uint32_t jointStride = (model.totalJointCount > 0) ? model.totalJointCount : 1u;
+        PaletteMatrix *nodesOut = static_cast<PaletteMatrix *>(frame.paletteMapped);
+        PaletteMatrix *jointsOut = static_cast<PaletteMatrix *>(frame.jointPaletteMapped);
+        for (uint32_t pose = 0; pose < batch.poseCount; ++pose)
+        {
+            const PoseRequest &req = batch.poseRequests[pose];
+            model.evaluatePoseInto(req.clip, req.timeSec, m_cpuTrs, m_cpuLocals, m_cpuGlobals);
+            model.buildJointPaletteInto(m_cpuGlobals, m_cpuJoints);
+            m_cpuGlobals.resize(nodeCount, glm::mat4(1.0f));
+            m_cpuJoints.resize(jointStride, PaletteIdentity());
+            ToPaletteMatrices(m_cpuGlobals.data(), nodeCount, nodesOut + size_t(pose) * nodeCount);
+            std::memcpy(jointsOut + size_t(pose) * jointStride, m_cpuJoints.data(), sizeof(PaletteMatrix) * jointStride);
+        }
+    }
+
     void SModelRenderPassModule::onResize(VulkanContext &ctx, VkExtent2D newExtent)
     {
         (void)ctx;
@@ -1514,6 +1675,8 @@ namespace Engine
         if (m_device == VK_NULL_HANDLE)
             return;
 
+        m_gpuPoses.reset();
+        m_gpuPosesFailed = false;
         destroyCameraResources();
         destroyInstanceResources();
         destroyMaterialResources();
@@ -10,11 +10,17 @@
 #include <iostream>
 #include <filesystem>
 #include <cstring>
+#include <cstdlib>
+#include <cmath>
 #include <algorithm>
 #include <functional>
 
 // Your engine format header (adjust include path if needed)
 #include "assets/ModelFormat.h"
+#include "assets/AnimationCompression.h"
+
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
 
 #ifndef AI_MATKEY_GLTF_ALPHACUTOFF
 // Older Assimp doesn't expose this macro, but the property exists in glTF materials.
@@ -376,9 +382,46 @@ static inline float TicksToSeconds(double ticks, double ticksPerSecond)
     return (float)(ticks / tps);
 }
 
+// Appends one channel's key times (seconds) and calls emit(k, a) for every output key: the
+// value is key k blended towards key k + 1 by a (a == 0: key k alone).
+// resampleHz > 0 replaces the keys with evenly spaced ones over the same span (first and last
+// key times kept), linearly interpolated from the source keys. Returns the keys written.
+template <typename Key, typename Emit>
+static uint32_t AppendKeys(const Key *keys, uint32_t keyCount, double tps, double resampleHz,
+                           std::vector<float> &animTimes, Emit &&emit)
+{
+    const double t0 = (keyCount > 0) ? keys[0].mTime / tps : 0.0;
+    const double t1 = (keyCount > 0) ? keys[keyCount - 1].mTime / tps : 0.0;
+    if (resampleHz <= 0.0 || keyCount < 2 || t1 - t0 <= 1e-6)
+    {
+        for (uint32_t i = 0; i < keyCount; i++)
+        {
+            animTimes.push_back(TicksToSeconds(keys[i].mTime, tps));
+            emit(i, 0.0f);
+        }
+        return keyCount;
+    }
+
+    const uint32_t count = std::max(2u, (uint32_t)std::ceil((t1 - t0) * resampleHz - 1e-6) + 1u);
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const double t = (i + 1 == count) ? t1 : t0 + (t1 - t0) * i / (double)(count - 1);
+        while (k + 2 < keyCount && keys[k + 1].mTime / tps <= t)
+            k++;
+        const double ta = keys[k].mTime / tps;
+        const double tb = keys[k + 1].mTime / tps;
+        const double a = (tb > ta) ? std::min(std::max((t - ta) / (tb - ta), 0.0), 1.0) : 0.0;
+        animTimes.push_back((float)t);
+        emit(k, (float)a);
+    }
+    return count;
+}
+
 static uint16_t AddVec3Sampler(const aiVectorKey *keys,
                                uint32_t keyCount,
                                double tps,
+                               double resampleHz,
                                sm::SModelAnimInterpolation interp,
                                std::vector<float> &animTimes,
                                std::vector<float> &animValues,
@@ -386,19 +429,21 @@ static uint16_t AddVec3Sampler(const aiVectorKey *keys,
 {
     sm::SModelAnimationSamplerRecord s{};
     s.firstTime = (uint32_t)animTimes.size();
-    s.timeCount = keyCount;
     s.firstValue = (uint32_t)animValues.size();
-    s.valueCount = keyCount * 3;
     s.interpolation = (uint8_t)interp;
     s.valueType = (uint8_t)sm::SModelAnimValueType::Vec3;
 
-    for (uint32_t i = 0; i < keyCount; i++)
-    {
-        animTimes.push_back(TicksToSeconds(keys[i].mTime, tps));
-        animValues.push_back((float)keys[i].mValue.x);
-        animValues.push_back((float)keys[i].mValue.y);
-        animValues.push_back((float)keys[i].mValue.z);
-    }
+    s.timeCount = AppendKeys(keys, keyCount, tps, resampleHz, animTimes, [&](uint32_t k, float a)
+                             {
+        aiVector3D v = keys[k].mValue;
+        if (a > 0.0f)
+            v = v + (keys[k + 1].mValue - v) * a;
+        animValues.push_back((float)v.x);
+        animValues.push_back((float)v.y);
+        animValues.push_back((float)v.z); });
+    s.valueCount = s.timeCount * 3;
+    if (Engine::AnimCompression::HasUniformTimes(animTimes.data() + s.firstTime, s.timeCount))
+        s.flags |= sm::SModelAnimSamplerFlag_UniformTimes;
 
     uint32_t samplerIndex = (uint32_t)animSamplers.size();
     animSamplers.push_back(s);
@@ -408,6 +453,7 @@ static uint16_t AddVec3Sampler(const aiVectorKey *keys,
 static uint16_t AddQuatSampler(const aiQuatKey *keys,
                                uint32_t keyCount,
                                double tps,
+                               double resampleHz,
                                sm::SModelAnimInterpolation interp,
                                std::vector<float> &animTimes,
                                std::vector<float> &animValues,
@@ -415,21 +461,26 @@ static uint16_t AddQuatSampler(const aiQuatKey *keys,
 {
     sm::SModelAnimationSamplerRecord s{};
     s.firstTime = (uint32_t)animTimes.size();
-    s.timeCount = keyCount;
     s.firstValue = (uint32_t)animValues.size();
-    s.valueCount = keyCount * 4;
     s.interpolation = (uint8_t)interp;
     s.valueType = (uint8_t)sm::SModelAnimValueType::Quat;
 
-    for (uint32_t i = 0; i < keyCount; i++)
-    {
-        animTimes.push_back(TicksToSeconds(keys[i].mTime, tps));
+    s.timeCount = AppendKeys(keys, keyCount, tps, resampleHz, animTimes, [&](uint32_t k, float a)
+                             {
+        aiQuaternion q = keys[k].mValue;
+        if (a > 0.0f)
+        {
+            aiQuaternion::Interpolate(q, keys[k].mValue, keys[k + 1].mValue, a); // shortest arc
+            q.Normalize();
+        }
         // Store quat as XYZW (consistent with loader validation expectations)
-        animValues.push_back((float)keys[i].mValue.x);
-        animValues.push_back((float)keys[i].mValue.y);
-        animValues.push_back((float)keys[i].mValue.z);
-        animValues.push_back((float)keys[i].mValue.w);
-    }
+        animValues.push_back((float)q.x);
+        animValues.push_back((float)q.y);
+        animValues.push_back((float)q.z);
+        animValues.push_back((float)q.w); });
+    s.valueCount = s.timeCount * 4;
+    if (Engine::AnimCompression::HasUniformTimes(animTimes.data() + s.firstTime, s.timeCount))
+        s.flags |= sm::SModelAnimSamplerFlag_UniformTimes;
 
     uint32_t samplerIndex = (uint32_t)animSamplers.size();
     animSamplers.push_back(s);
@@ -455,10 +506,46 @@ int main(int argc, char **argv)
 {
     if (argc < 3)
     {
-        std::cout << "Usage: GltfToSModel <input.gltf/.glb> <output.smodel>\n";
+        std::cout << "Usage: GltfToSModel <input.gltf/.glb> <output.smodel> [--resample-hz N] [--compress-anim]\n"
+                     "                    [--anim-tolerance UNITS] [--anim-tolerance-rot RADIANS]\n";
+        std::cout << "  --resample-hz N           re-key every animation channel at N evenly spaced keys per second\n";
+        std::cout << "  --compress-anim           strip constant channels, reduce keys, quantize (see AnimationCompression.h)\n";
+        std::cout << "  --anim-tolerance U        max translation / scale error when reducing keys (default 1e-4)\n";
+        std::cout << "  --anim-tolerance-rot R    max rotation error in radians (default 5e-4)\n";
         return 0;
     }
 
+    // Animation keys are written as authored unless resampled; evenly spaced channels either
+    // way are flagged so the runtime computes key indices instead of searching for them.
+    double resampleHz = 0.0;
+    bool compressAnim = false;
+    Engine::AnimCompression::Settings animCompression;
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--resample-hz") == 0 && i + 1 < argc)
+        {
+            resampleHz = std::max(0.0, std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--compress-anim") == 0)
+        {
+            compressAnim = true;
+        }
+        else if (std::strcmp(argv[i], "--anim-tolerance") == 0 && i + 1 < argc)
+        {
+            animCompression.translationTolerance = std::max(0.0f, (float)std::atof(argv[++i]));
+            animCompression.scaleTolerance = animCompression.translationTolerance;
+        }
+        else if (std::strcmp(argv[i], "--anim-tolerance-rot") == 0 && i + 1 < argc)
+        {
+            animCompression.rotationTolerance = std::max(0.0f, (float)std::atof(argv[++i]));
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
     const std::string inputPath = NormalizePathSlashes(argv[1]);
     const std::string outputPath = NormalizePathSlashes(argv[2]);
     const std::string modelDir = GetDirectoryOfFile(inputPath);
@@ -509,6 +596,7 @@ int main(int argc, char **argv)
 
     // Animations (V3)
     std::vector<sm::SModelAnimationClipRecord> animClips;
+    std::vector<std::string> animClipNames; // parallel to animClips (compression report)
     std::vector<sm::SModelAnimationChannelRecord> animChannels;
     std::vector<sm::SModelAnimationSamplerRecord> animSamplers;
     std::vector<float> animTimes;  // seconds
@@ -983,6 +1071,8 @@ int main(int argc, char **argv)
 
     // ------------------------------------------------------------
     // Build node graph (DFS)
+    // Pre-order emission puts every parent before its children (parentIndex < index), which
+    // the runtime relies on to compute node globals in one linear pass.
     const uint32_t U32_MAX = ~0u;
 
     // Assimp animation channels target nodes by name
@@ -1016,6 +1106,9 @@ int main(int argc, char **argv)
             {
                 nodePrimitiveIndices.push_back(static_cast<uint32_t>(primIdx));
                 rec.primitiveCount++;
+                // Unskinned primitives are placed by the node's global matrix at runtime.
+                if (primRecords[static_cast<size_t>(primIdx)].skinIndex < 0)
+                    rec.flags |= sm::SModelNodeFlag_RigidPrimitives;
             }
         }
 
@@ -1050,6 +1143,15 @@ int main(int argc, char **argv)
 
     (void)EmitNode(scene->mRootNode, U32_MAX);
 
+    for (uint32_t i = 0; i < nodeRecords.size(); ++i)
+    {
+        if (nodeRecords[i].parentIndex != U32_MAX && nodeRecords[i].parentIndex >= i)
+        {
+            std::cout << "Node order is not parent-first (node " << i << ", parent " << nodeRecords[i].parentIndex << ")\n";
+            return 1;
+        }
+    }
+
     // ------------------------------------------------------------
     // Finalize skin tables (resolve joint node names -> node indices)
     // ------------------------------------------------------------
@@ -1130,6 +1232,7 @@ int main(int argc, char **argv)
                     const uint16_t samplerIndex = AddVec3Sampler(ch->mPositionKeys,
                                                                  (uint32_t)ch->mNumPositionKeys,
                                                                  tps,
+                                                                 resampleHz,
                                                                  interp,
                                                                  animTimes,
                                                                  animValues,
@@ -1149,6 +1252,7 @@ int main(int argc, char **argv)
                     const uint16_t samplerIndex = AddQuatSampler(ch->mRotationKeys,
                                                                  (uint32_t)ch->mNumRotationKeys,
                                                                  tps,
+                                                                 resampleHz,
                                                                  interp,
                                                                  animTimes,
                                                                  animValues,
@@ -1168,6 +1272,7 @@ int main(int argc, char **argv)
                     const uint16_t samplerIndex = AddVec3Sampler(ch->mScalingKeys,
                                                                  (uint32_t)ch->mNumScalingKeys,
                                                                  tps,
+                                                                 resampleHz,
                                                                  interp,
                                                                  animTimes,
                                                                  animValues,
@@ -1186,6 +1291,7 @@ int main(int argc, char **argv)
             if (clip.channelCount > 0)
             {
                 animClips.push_back(clip);
+                animClipNames.push_back(clipName);
             }
             else
             {
@@ -1195,6 +1301,53 @@ int main(int argc, char **argv)
         }
     }
 
+    // ------------------------------------------------------------
+    // Optional animation compression (per-clip report: size and max error vs the raw keys)
+    // ------------------------------------------------------------
+    if (compressAnim && !animClips.empty())
+    {
+        // Rest TRS decomposed the way the runtime does it (AssetManager), so channels that
+        // only restate the rest pose can be dropped.
+        std::vector<Engine::ModelAsset::NodeTRS> restTRS(nodeRecords.size());
+        for (size_t i = 0; i < nodeRecords.size(); ++i)
+        {
+            const glm::mat4 local = glm::make_mat4(nodeRecords[i].localMatrix);
+            glm::vec3 skew;
+            glm::vec4 perspective;
+            glm::decompose(local, restTRS[i].s, restTRS[i].r, restTRS[i].t, skew, perspective);
+            restTRS[i].r = glm::normalize(restTRS[i].r);
+        }
+
+        Engine::AnimCompression::Tables raw;
+        raw.clips = std::move(animClips);
+        raw.channels = std::move(animChannels);
+        raw.samplers = std::move(animSamplers);
+        raw.times = std::move(animTimes);
+        raw.values = std::move(animValues);
+
+        Engine::AnimCompression::Tables packed;
+        std::vector<Engine::AnimCompression::ClipReport> reports;
+        Engine::AnimCompression::Compress(raw, restTRS, animCompression, packed, &reports);
+
+        std::cout << "Animation compression (tolerance " << animCompression.translationTolerance << " units, "
+                  << animCompression.rotationTolerance << " rad):\n";
+        for (size_t c = 0; c < reports.size(); ++c)
+        {
+            const auto &r = reports[c];
+            std::cout << "  " << animClipNames[c] << ": " << r.channelsIn << " -> " << r.channelsOut << " channels, "
+                      << r.keysIn << " -> " << r.keysOut << " keys, " << r.bytesIn << " -> " << r.bytesOut << " bytes, max error "
+                      << r.maxTranslationError << " units / " << r.maxRotationError * 57.29578f << " deg / "
+                      << r.maxScaleError << " scale\n";
+        }
+        std::cout << "  total: " << raw.bytes() << " -> " << packed.bytes() << " bytes\n";
+
+        animClips = std::move(packed.clips);
+        animChannels = std::move(packed.channels);
+        animSamplers = std::move(packed.samplers);
+        animTimes = std::move(packed.times);
+        animValues = std::move(packed.values);
+    }
+
     // Build header offsets
     // File layout:
     // Header
@@ -1214,8 +1367,8 @@ int main(int argc, char **argv)
     // ------------------------------------------------------------
     sm::SModelHeader header{};
     header.magic = sm::SMODEL_MAGIC;
-    header.versionMajor = 4;
-    header.versionMinor = 0;
+    header.versionMajor = sm::SMODEL_VERSION_MAJOR;
+    header.versionMinor = sm::SMODEL_VERSION_MINOR;
 
     header.meshCount = static_cast<uint32_t>(meshRecords.size());
     header.primitiveCount = static_cast<uint32_t>(primRecords.size());
@@ -1334,12 +1487,26 @@ int main(int argc, char **argv)
     std::cout << "Primitives : " << header.primitiveCount << "\n";
     std::cout << "Materials  : " << header.materialCount << "\n";
     std::cout << "Textures   : " << header.textureCount << "\n";
-    std::cout << "Nodes      : " << header.nodeCount << "\n";
+    {
+        uint32_t rigidNodes = 0;
+        for (const auto &nr : nodeRecords)
+            rigidNodes += (nr.flags & sm::SModelNodeFlag_RigidPrimitives) ? 1u : 0u;
+        std::cout << "Nodes      : " << header.nodeCount << " (" << rigidNodes << " with unskinned primitives in the node palette)\n";
+    }
     std::cout << "NodePrimIx : " << header.nodePrimitiveIndexCount << "\n";
     std::cout << "Skins      : " << header.skinCount << "\n";
     std::cout << "AnimClips  : " << header.animClipsCount << "\n";
     std::cout << "AnimChans  : " << header.animChannelsCount << "\n";
     std::cout << "AnimSamplers: " << header.animSamplersCount << "\n";
+    {
+        uint32_t uniformSamplers = 0;
+        for (const auto &smp : animSamplers)
+            uniformSamplers += (smp.flags & sm::SModelAnimSamplerFlag_UniformTimes) ? 1u : 0u;
+        std::cout << "  evenly keyed: " << uniformSamplers;
+        if (resampleHz > 0.0)
+            std::cout << " (resampled at " << resampleHz << " Hz)";
+        std::cout << "\n";
+    }
     std::cout << "AnimTimes  : " << header.animTimesCount << " floats\n";
     std::cout << "AnimValues : " << header.animValuesCount << " floats\n";
     std::cout << "StringTable: " << header.stringTableSize << " bytes\n";
@@ -27,6 +27,8 @@ public:
 
     void Close() override;
     void OnUpdate(Engine::TimeStep ts) override;
+    void OnSimulate(Engine::TimeStep ts) override;
+    void OnExtract() override;
     void OnRender() override;
 
 private:
@@ -34,6 +36,7 @@ private:
     void OnEvent(const std::string &name);
     void ApplyRTSCamera(float aspect);
     void PickAndSelectEntityAtCursor();
+    void HandleMenuResult();
 
 private:
     struct RTSCameraController
@@ -56,6 +59,9 @@ private:
     };
 
     std::unique_ptr<Engine::AssetManager> m_assets;
+    // Main-thread maintenance jobs (asset GC), run in OnUpdate within kMainJobsBudgetUs.
+    static constexpr uint32_t kMainJobsBudgetUs = 500;
+    Engine::TimeSlicer m_mainJobs;
     RTSCameraController m_rtsCam;
     glm::vec2 m_lastMouse{0.0f, 0.0f};
     bool m_isPanning = false;
@@ -74,6 +80,8 @@ private:
 
     // True once a new game is started or a save is loaded.
     bool m_inGame = false;
+    // Set in OnUpdate, read by OnSimulate (pause menu open).
+    bool m_simPaused = false;
 
     // ImGui Vulkan backend uses ImTextureID as a VkDescriptorSet.
     // When the window is resized, Application recreates ImGui (descriptor pool),
@@ -0,0 +1,304 @@
+/*
+  AnimationBench
+  --------------
+  Purpose:
+    - Standalone benchmark for per-unit pose evaluation (PoseUpdateSystem::writePose) on a crowd
+      of animated units (default 10k) all playing clips of one Knight-like synthetic model
+      (64 nodes, 48 joints, 100 clips keyed at 30 Hz), no window / Vulkan device needed.
+    - Live: keyframe sampling + hierarchy evaluation per unit (clips not baked). The key lookup
+      is timed three ways: binary search per channel, per-unit key cursors
+      (PosePalette::keyCursor) and the key index computed from the uniform key rate
+      (ModelAsset::samplerKeyRate, the default for evenly keyed clips); all must sample the
+      same keys, so their palettes are checked to be identical.
+    - Baked: clips pre-sampled at --hz (ModelAsset::bakeClip, within --budget MB like the
+      AssetManager does at load), then a frame lookup per unit, lerped and nearest.
+    - Shared: baked lerp with pose sharing at --share Hz (PoseUpdateSystem::writeSharedPose);
+      units in the same (clip, time bucket) reference one SharedPosePool slot and only units
+      crossing into a new bucket do any work. Reports unique poses vs units.
+    - Reports bake time / memory, ms per frame and ns per unit, and the max error of the baked /
+      shared joint palettes against live evaluation (largest matrix element / joint translation delta).
+
+  Usage:
+    AnimationBench [--units N] [--clips C] [--nodes K] [--joints J] [--hz H] [--budget MB] [--share H] [--frames F] [--seed S]
+*/
+
+#include "bench/SyntheticModel.h"
+#include "systems/PoseUpdateSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Engine::ECS;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float kFrameDt = 1.0f / 60.0f;
+
+    double msSince(Clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    struct Config
+    {
+        uint32_t units = 10000;
+        uint32_t clips = 100;
+        uint32_t nodes = 64;
+        uint32_t joints = 48;
+        float hz = Engine::AnimationBakeSettings::kDefaultSampleHz;
+        float budgetMB = 256.0f;
+        float shareHz = PoseUpdateSystem::kDefaultPoseShareHz;
+        uint32_t frames = 60;
+        uint32_t seed = 1234;
+    };
+
+    std::vector<RenderAnimation> makeUnits(const Config &cfg, const Engine::ModelAsset &model)
+    {
+        std::mt19937 rng(cfg.seed);
+        std::uniform_int_distribution<uint32_t> clip(0, static_cast<uint32_t>(model.animClips.size() - 1));
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<RenderAnimation> units(cfg.units);
+        for (RenderAnimation &a : units)
+        {
+            a.clipIndex = clip(rng);
+            a.timeSec = unit(rng) * model.animClips[a.clipIndex].durationSec;
+            a.speed = 0.9f + 0.2f * unit(rng);
+            a.loop = true;
+            a.playing = true;
+        }
+        return units;
+    }
+
+    // Same time advance as CharacterAnimationSystem for looping clips.
+    void advance(std::vector<RenderAnimation> &units, const Engine::ModelAsset &model)
+    {
+        for (RenderAnimation &a : units)
+        {
+            const float duration = model.animClips[a.clipIndex].durationSec;
+            a.timeSec = std::fmod(a.timeSec + kFrameDt * a.speed, duration);
+        }
+    }
+
+    struct RunResult
+    {
+        double msPerFrame = 0.0;
+        uint32_t bakedPoses = 0;
+        uint32_t livePoses = 0;
+        uint32_t uniquePoses = 0; // shared slots in use after the last frame (0 = not shared)
+    };
+
+    // shareHz > 0: pose sharing. The shared slots are copied back into `palettes` afterwards
+    // so compare() sees what each unit draws.
+    RunResult run(const Config &cfg, const Engine::ModelAsset &model, bool interpolate, float shareHz,
+                  std::vector<PosePalette> &palettes, bool keyCursors = true)
+    {
+        std::vector<RenderAnimation> units = makeUnits(cfg, model);
+        palettes.assign(units.size(), PosePalette{});
+
+        PoseUpdateSystem poses;
+        poses.setKeyCursors(keyCursors);
+        poses.setBakedInterpolation(interpolate);
+        poses.setPoseSharing(shareHz);
+        const Engine::ModelHandle handle{1, 1};
+        auto frame = [&]()
+        {
+            for (size_t i = 0; i < units.size(); ++i)
+            {
+                if (shareHz > 0.0f)
+                    poses.writeSharedPose(handle, model, units[i], palettes[i]);
+                else
+                    poses.writePose(model, units[i], palettes[i]);
+            }
+        };
+
+        // Warm-up frame (palette allocations), then the measured frames.
+        frame();
+        RunResult result;
+        const auto t0 = Clock::now();
+        for (uint32_t f = 0; f < cfg.frames; ++f)
+        {
+            advance(units, model);
+            frame();
+        }
+        result.msPerFrame = msSince(t0) / static_cast<double>(std::max(cfg.frames, 1u));
+        result.bakedPoses = poses.bakedPoses();
+        result.livePoses = poses.livePoses();
+
+        if (shareHz > 0.0f)
+        {
+            std::vector<uint8_t> used(poses.sharedPoses().capacity(), 0);
+            for (PosePalette &p : palettes)
+            {
+                const SharedPosePool::Slot *slot = poses.sharedPoses().get(p.sharedSlot);
+                if (!slot)
+                    continue;
+                result.uniquePoses += used[p.sharedSlot] ? 0u : 1u;
+                used[p.sharedSlot] = 1;
+                p.nodePalette = slot->nodePalette;
+                p.jointPalette = slot->jointPalette;
+            }
+        }
+        return result;
+    }
+
+    struct Error
+    {
+        float maxElement = 0.0f;
+        float maxTranslation = 0.0f;
+    };
+
+    Error compare(const std::vector<PosePalette> &live, const std::vector<PosePalette> &baked)
+    {
+        Error err;
+        for (size_t i = 0; i < live.size() && i < baked.size(); ++i)
+        {
+            const auto &a = live[i].jointPalette;
+            const auto &b = baked[i].jointPalette;
+            for (size_t j = 0; j < a.size() && j < b.size(); ++j)
+            {
+                for (int r = 0; r < 3; ++r)
+                {
+                    for (int c = 0; c < 4; ++c)
+                        err.maxElement = std::max(err.maxElement, std::fabs(a[j][r][c] - b[j][r][c]));
+                }
+                const glm::vec3 d(a[j][0][3] - b[j][0][3], a[j][1][3] - b[j][1][3], a[j][2][3] - b[j][2][3]);
+                err.maxTranslation = std::max(err.maxTranslation, std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z));
+            }
+        }
+        return err;
+    }
+
+    void report(const char *label, const Config &cfg, const RunResult &r)
+    {
+        std::printf("  %-14s %8.2f ms/frame  %7.0f ns/unit  (%u baked, %u live poses)", label, r.msPerFrame,
+                    r.msPerFrame * 1e6 / static_cast<double>(std::max(cfg.units, 1u)), r.bakedPoses, r.livePoses);
+        if (r.uniquePoses > 0)
+            std::printf("  %u unique poses for %u units", r.uniquePoses, cfg.units);
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Config cfg;
+    for (int i = 1; i < argc; ++i)
+    {
+        auto next = [&](uint32_t &out)
+        { out = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i]))); };
+        if (std::strcmp(argv[i], "--units") == 0 && i + 1 < argc)
+            next(cfg.units);
+        else if (std::strcmp(argv[i], "--clips") == 0 && i + 1 < argc)
+            next(cfg.clips);
+        else if (std::strcmp(argv[i], "--nodes") == 0 && i + 1 < argc)
+            next(cfg.nodes);
+        else if (std::strcmp(argv[i], "--joints") == 0 && i + 1 < argc)
+            next(cfg.joints);
+        else if (std::strcmp(argv[i], "--hz") == 0 && i + 1 < argc)
+            cfg.hz = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--budget") == 0 && i + 1 < argc)
+            cfg.budgetMB = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--share") == 0 && i + 1 < argc)
+            cfg.shareHz = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            next(cfg.frames);
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            cfg.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            std::printf("Usage: AnimationBench [--units N] [--clips C] [--nodes K] [--joints J] [--hz H] [--budget MB] [--share H] [--frames F] [--seed S]\n");
+            return 1;
+        }
+    }
+    cfg.clips = std::max(cfg.clips, 1u);
+
+    Bench::SyntheticModelDesc desc;
+    desc.nodes = cfg.nodes;
+    desc.joints = cfg.joints;
+    desc.clips = cfg.clips;
+    Engine::ModelAsset model;
+    Bench::BuildSyntheticModel(desc, model);
+
+    std::printf("AnimationBench: %u units, model with %zu nodes / %u joints / %zu clips (%zu keyed channels), %u frames\n\n",
+                cfg.units, model.nodes.size(), model.totalJointCount, model.animClips.size(), model.animChannels.size(),
+                cfg.frames);
+
+    std::vector<PosePalette> livePalettes;
+    const RunResult live = run(cfg, model, true, 0.0f, livePalettes);
+
+    // Key lookup variants on the same clips with the uniform key rates dropped.
+    Engine::ModelAsset unratedModel = model;
+    unratedModel.samplerKeyRate.clear();
+    std::vector<PosePalette> searchPalettes;
+    std::vector<PosePalette> cursorPalettes;
+    const RunResult search = run(cfg, unratedModel, true, 0.0f, searchPalettes, false);
+    const RunResult cursor = run(cfg, unratedModel, true, 0.0f, cursorPalettes, true);
+
+    // Bake within the budget, clip by clip, like AssetManager::setAnimationBaking.
+    const size_t budget = static_cast<size_t>(static_cast<double>(cfg.budgetMB) * 1024.0 * 1024.0);
+    size_t bakedBytes = 0;
+    uint32_t bakedClips = 0;
+    const auto tBake = Clock::now();
+    model.bakedClips.assign(model.animClips.size(), Engine::BakedClip{});
+    for (uint32_t c = 0; c < model.animClips.size(); ++c)
+    {
+        const size_t bytes = model.bakedClipBytes(c, cfg.hz);
+        if (bytes == 0 || bakedBytes + bytes > budget)
+            continue;
+        model.bakeClip(c, cfg.hz, model.bakedClips[c]);
+        bakedBytes += model.bakedClips[c].bytes();
+        ++bakedClips;
+    }
+    const double bakeMs = msSince(tBake);
+
+    std::vector<PosePalette> lerpPalettes;
+    std::vector<PosePalette> nearestPalettes;
+    std::vector<PosePalette> sharedPalettes;
+    const RunResult lerp = run(cfg, model, true, 0.0f, lerpPalettes);
+    const RunResult nearest = run(cfg, model, false, 0.0f, nearestPalettes);
+    const RunResult shared = run(cfg, model, true, cfg.shareHz, sharedPalettes);
+
+    std::printf("Bake at %.0f Hz: %u/%zu clips, %.1f MB (budget %.0f MB), %.1f ms\n\n", cfg.hz, bakedClips,
+                model.animClips.size(), static_cast<double>(bakedBytes) / (1024.0 * 1024.0), cfg.budgetMB, bakeMs);
+    std::printf("Live key lookup:\n");
+    report("binary search", cfg, search);
+    report("key cursor", cfg, cursor);
+    report("uniform rate", cfg, live);
+    const Error cursorErr = compare(searchPalettes, cursorPalettes);
+    const Error rateErr = compare(searchPalettes, livePalettes);
+    const bool sameKeys = cursorErr.maxElement == 0.0f && rateErr.maxElement == 0.0f;
+    std::printf("  palettes vs binary search: %s\n\n", sameKeys ? "identical" : "MISMATCH");
+
+    std::printf("Pose evaluation:\n");
+    report("live", cfg, live);
+    report("baked lerp", cfg, lerp);
+    report("baked nearest", cfg, nearest);
+    char sharedLabel[32];
+    std::snprintf(sharedLabel, sizeof(sharedLabel), "shared %.0f Hz", cfg.shareHz);
+    if (cfg.shareHz > 0.0f)
+        report(sharedLabel, cfg, shared);
+    if (lerp.msPerFrame > 0.0)
+        std::printf("  speedup (lerp) %.1fx\n", live.msPerFrame / lerp.msPerFrame);
+    if (cfg.shareHz > 0.0f && shared.msPerFrame > 0.0)
+        std::printf("  speedup (shared) %.1fx\n", live.msPerFrame / shared.msPerFrame);
+
+    const Error lerpErr = compare(livePalettes, lerpPalettes);
+    const Error nearestErr = compare(livePalettes, nearestPalettes);
+    std::printf("\nMax joint palette error vs live (model units, bones ~0.1-0.2 long):\n");
+    std::printf("  baked lerp     element %.5f  translation %.5f\n", lerpErr.maxElement, lerpErr.maxTranslation);
+    std::printf("  baked nearest  element %.5f  translation %.5f\n", nearestErr.maxElement, nearestErr.maxTranslation);
+    if (cfg.shareHz > 0.0f)
+    {
+        const Error sharedErr = compare(livePalettes, sharedPalettes);
+        std::printf("  %-14s element %.5f  translation %.5f\n", sharedLabel, sharedErr.maxElement, sharedErr.maxTranslation);
+    }
+    return sameKeys ? 0 : 1;
+}
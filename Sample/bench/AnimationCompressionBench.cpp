@@ -0,0 +1,314 @@
+/*
+  AnimationCompressionBench
+  -------------------------
+  Purpose:
+    - Standalone benchmark for the compressed .smodel animation tables
+      (Engine::AnimCompression, GltfToSmodel --compress-anim) on the Knight-like synthetic
+      model keyed like a Blender glTF export (T, R and S on every bone, 30 Hz), no window /
+      Vulkan device needed.
+    - Size: animation table bytes before / after, channels and keys kept, compression time.
+    - Decode speed: channel sampling alone and full ModelAsset::evaluatePoseInto for raw float
+      keys, quantization only (same channels and keys, decoded on the fly) and full compression,
+      --evals evaluations (default 10k, one per unit per frame) with per-unit key cursors.
+    - Error: max local translation / rotation / scale error per clip (the cooker's report), and
+      the max joint palette error over every clip at --checks times.
+
+  Usage:
+    AnimationCompressionBench [--evals N] [--clips C] [--nodes K] [--tol-t U] [--tol-r RAD] [--checks N] [--all-clips]
+*/
+
+#include "assets/AnimationCompression.h"
+#include "bench/SyntheticModel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using Engine::AnimCompression::ClipReport;
+
+    double msSince(Clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    struct Config
+    {
+        uint32_t evals = 10000;
+        uint32_t clips = 100;
+        uint32_t nodes = 64;
+        float tolT = 1e-4f;
+        float tolR = 5e-4f;
+        uint32_t checks = 64;
+        bool allClips = false;
+        uint32_t seed = 1234;
+    };
+
+    Engine::AnimCompression::Tables tablesOf(const Engine::ModelAsset &m)
+    {
+        Engine::AnimCompression::Tables t;
+        t.clips = m.animClips;
+        t.channels = m.animChannels;
+        t.samplers = m.animSamplers;
+        t.times = m.animTimes;
+        t.values = m.animValues;
+        return t;
+    }
+
+    void setTables(Engine::ModelAsset &m, const Engine::AnimCompression::Tables &t)
+    {
+        m.animClips = t.clips;
+        m.animChannels = t.channels;
+        m.animSamplers = t.samplers;
+        m.animTimes = t.times;
+        m.animValues = t.values;
+        m.buildSamplerKeyRates(); // as the loader does
+    }
+
+    struct Unit
+    {
+        uint32_t clip = 0;
+        float time = 0.0f;
+        Engine::AnimationCursor cursor;
+    };
+
+    std::vector<Unit> makeUnits(const Config &cfg, const Engine::ModelAsset &model)
+    {
+        std::mt19937 rng(cfg.seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<Unit> units(cfg.evals);
+        for (Unit &u : units)
+        {
+            u.clip = static_cast<uint32_t>(unit(rng) * static_cast<float>(model.animClips.size())) % model.animClips.size();
+            u.time = unit(rng) * model.animClips[u.clip].durationSec;
+        }
+        return units;
+    }
+
+    void advance(std::vector<Unit> &units, const Engine::ModelAsset &model)
+    {
+        for (Unit &u : units)
+            u.time = std::fmod(u.time + 1.0f / 60.0f, std::max(model.animClips[u.clip].durationSec, 1e-3f));
+    }
+
+    // Every channel of the unit's clip into trs (what evaluatePoseInto does before composing).
+    float sampleChannels(const Engine::ModelAsset &m, const Unit &u, std::vector<Engine::ModelAsset::NodeTRS> &trs)
+    {
+        const auto &clip = m.animClips[u.clip];
+        float checksum = 0.0f;
+        for (uint32_t c = 0; c < clip.channelCount; ++c)
+        {
+            const auto &ch = m.animChannels[clip.firstChannel + c];
+            const auto &s = m.animSamplers[ch.samplerIndex];
+            const float *times = m.animTimes.data() + s.firstTime;
+            const float *values = m.animValues.data() + s.firstValue;
+            const bool quantized = Engine::AnimQuant::IsQuantized(s);
+            if (ch.path == uint16_t(Engine::smodel::SModelAnimPath::Rotation))
+                trs[ch.targetNode].r = Engine::ModelAsset::SampleQuat(times, values, s.timeCount, u.time, quantized);
+            else if (ch.path == uint16_t(Engine::smodel::SModelAnimPath::Translation))
+                trs[ch.targetNode].t = Engine::ModelAsset::SampleVec3(times, values, s.timeCount, u.time, quantized);
+            else
+                trs[ch.targetNode].s = Engine::ModelAsset::SampleVec3(times, values, s.timeCount, u.time, quantized);
+            checksum += trs[ch.targetNode].t.y;
+        }
+        return checksum;
+    }
+
+    struct Timing
+    {
+        double sampleMs = 0.0;
+        double evalMs = 0.0;
+        float checksum = 0.0f;
+    };
+
+    Timing timeModel(const Config &cfg, const Engine::ModelAsset &m)
+    {
+        Timing r;
+        std::vector<Engine::ModelAsset::NodeTRS> trs(m.nodes.size());
+        std::vector<Engine::ModelAsset::NodeTRS> trsScratch;
+        std::vector<glm::mat4> locals;
+        std::vector<glm::mat4> globals;
+
+        std::vector<Unit> units = makeUnits(cfg, m);
+        for (const Unit &u : units) // warm-up
+            r.checksum += sampleChannels(m, u, trs);
+        advance(units, m);
+        auto t0 = Clock::now();
+        for (const Unit &u : units)
+            r.checksum += sampleChannels(m, u, trs);
+        r.sampleMs = msSince(t0);
+
+        for (Unit &u : units)
+            m.evaluatePoseInto(u.clip, u.time, trsScratch, locals, globals, &u.cursor);
+        advance(units, m);
+        t0 = Clock::now();
+        for (Unit &u : units)
+        {
+            m.evaluatePoseInto(u.clip, u.time, trsScratch, locals, globals, &u.cursor);
+            r.checksum += globals.back()[3][1];
+        }
+        r.evalMs = msSince(t0);
+        return r;
+    }
+
+    float jointPaletteError(const Config &cfg, const Engine::ModelAsset &a, const Engine::ModelAsset &b)
+    {
+        std::vector<Engine::ModelAsset::NodeTRS> trs;
+        std::vector<glm::mat4> locals;
+        std::vector<glm::mat4> ga, gb;
+        std::vector<Engine::PaletteMatrix> ja, jb;
+        float maxErr = 0.0f;
+        for (uint32_t c = 0; c < a.animClips.size(); ++c)
+        {
+            for (uint32_t k = 0; k <= cfg.checks; ++k)
+            {
+                const float t = a.animClips[c].durationSec * static_cast<float>(k) / static_cast<float>(std::max(cfg.checks, 1u));
+                a.evaluatePoseInto(c, t, trs, locals, ga);
+                b.evaluatePoseInto(c, t, trs, locals, gb);
+                a.buildJointPaletteInto(ga, ja);
+                b.buildJointPaletteInto(gb, jb);
+                for (size_t j = 0; j < ja.size(); ++j)
+                {
+                    const glm::vec3 d(ja[j][0][3] - jb[j][0][3], ja[j][1][3] - jb[j][1][3], ja[j][2][3] - jb[j][2][3]);
+                    maxErr = std::max(maxErr, glm::length(d));
+                }
+            }
+        }
+        return maxErr;
+    }
+
+    void printClip(uint32_t c, const ClipReport &r)
+    {
+        std::printf("  %4u  %3u -> %3u ch  %5u -> %5u keys  %7.1f -> %6.1f KB  %8.2e  %8.4f  %8.2e\n", c, r.channelsIn,
+                    r.channelsOut, r.keysIn, r.keysOut, r.bytesIn / 1024.0, r.bytesOut / 1024.0, r.maxTranslationError,
+                    r.maxRotationError * 57.29578f, r.maxScaleError);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Config cfg;
+    for (int i = 1; i < argc; ++i)
+    {
+        auto next = [&](uint32_t &out)
+        { out = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i]))); };
+        if (std::strcmp(argv[i], "--evals") == 0 && i + 1 < argc)
+            next(cfg.evals);
+        else if (std::strcmp(argv[i], "--clips") == 0 && i + 1 < argc)
+            next(cfg.clips);
+        else if (std::strcmp(argv[i], "--nodes") == 0 && i + 1 < argc)
+            next(cfg.nodes);
+        else if (std::strcmp(argv[i], "--tol-t") == 0 && i + 1 < argc)
+            cfg.tolT = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--tol-r") == 0 && i + 1 < argc)
+            cfg.tolR = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--checks") == 0 && i + 1 < argc)
+            next(cfg.checks);
+        else if (std::strcmp(argv[i], "--all-clips") == 0)
+            cfg.allClips = true;
+        else
+        {
+            std::printf("Usage: AnimationCompressionBench [--evals N] [--clips C] [--nodes K] [--tol-t U] [--tol-r RAD] [--checks N] [--all-clips]\n");
+            return 1;
+        }
+    }
+    cfg.clips = std::max(cfg.clips, 1u);
+
+    Bench::SyntheticModelDesc desc;
+    desc.nodes = cfg.nodes;
+    desc.clips = cfg.clips;
+    desc.fullTrs = true;
+    Engine::ModelAsset raw;
+    Bench::BuildSyntheticModel(desc, raw);
+    raw.buildNodeOrder();
+
+    Engine::AnimCompression::Settings settings;
+    settings.translationTolerance = cfg.tolT;
+    settings.scaleTolerance = cfg.tolT;
+    settings.rotationTolerance = cfg.tolR;
+    const Engine::AnimCompression::Tables rawTables = tablesOf(raw);
+    Engine::AnimCompression::Tables packedTables;
+    std::vector<ClipReport> reports;
+    const auto tCompress = Clock::now();
+    Engine::AnimCompression::Compress(rawTables, raw.restTRS, settings, packedTables, &reports);
+    const double compressMs = msSince(tCompress);
+
+    Engine::ModelAsset packed = raw;
+    setTables(packed, packedTables);
+
+    // Same channels and keys, quantized: isolates the decode cost.
+    Engine::AnimCompression::Settings quantizeOnly = settings;
+    quantizeOnly.stripConstant = false;
+    quantizeOnly.reduceKeys = false;
+    Engine::AnimCompression::Tables quantizedTables;
+    Engine::AnimCompression::Compress(rawTables, raw.restTRS, quantizeOnly, quantizedTables);
+    Engine::ModelAsset quantized = raw;
+    setTables(quantized, quantizedTables);
+
+    size_t keysIn = 0, keysOut = 0;
+    for (const ClipReport &r : reports)
+    {
+        keysIn += r.keysIn;
+        keysOut += r.keysOut;
+    }
+    std::printf("AnimationCompressionBench: %zu clips, %zu nodes, tolerance %.1e units / %.1e rad\n\n", raw.animClips.size(),
+                raw.nodes.size(), cfg.tolT, cfg.tolR);
+    std::printf("Size:\n");
+    std::printf("  raw         %8.1f KB  %6zu channels  %7zu keys\n", rawTables.bytes() / 1024.0, rawTables.channels.size(), keysIn);
+    std::printf("  quantized   %8.1f KB  %6zu channels  %7zu keys  (%.1fx smaller)\n", quantizedTables.bytes() / 1024.0,
+                quantizedTables.channels.size(), keysIn, static_cast<double>(rawTables.bytes()) / std::max<size_t>(quantizedTables.bytes(), 1));
+    std::printf("  compressed  %8.1f KB  %6zu channels  %7zu keys  (%.1fx smaller, %.0f ms)\n", packedTables.bytes() / 1024.0,
+                packedTables.channels.size(), keysOut, static_cast<double>(rawTables.bytes()) / std::max<size_t>(packedTables.bytes(), 1),
+                compressMs);
+
+    const Timing rawTiming = timeModel(cfg, raw);
+    const Timing quantizedTiming = timeModel(cfg, quantized);
+    const Timing packedTiming = timeModel(cfg, packed);
+    const double perEval = 1e6 / static_cast<double>(std::max(cfg.evals, 1u));
+    std::printf("\nDecode (%u evaluations):      sample channels         evaluatePoseInto\n", cfg.evals);
+    auto timingRow = [&](const char *label, const Timing &t)
+    {
+        std::printf("  %-12s %10.2f ms %6.0f ns/eval  %8.2f ms %6.0f ns/eval\n", label, t.sampleMs, t.sampleMs * perEval,
+                    t.evalMs, t.evalMs * perEval);
+    };
+    timingRow("raw", rawTiming);
+    timingRow("quantized", quantizedTiming);
+    timingRow("compressed", packedTiming);
+
+    // Per-clip errors, worst rotation first unless --all-clips.
+    std::vector<uint32_t> order(reports.size());
+    for (uint32_t c = 0; c < order.size(); ++c)
+        order[c] = c;
+    if (!cfg.allClips)
+    {
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+                  { return reports[a].maxRotationError > reports[b].maxRotationError; });
+        order.resize(std::min<size_t>(order.size(), 10));
+    }
+    ClipReport worst;
+    for (const ClipReport &r : reports)
+    {
+        worst.maxTranslationError = std::max(worst.maxTranslationError, r.maxTranslationError);
+        worst.maxRotationError = std::max(worst.maxRotationError, r.maxRotationError);
+        worst.maxScaleError = std::max(worst.maxScaleError, r.maxScaleError);
+    }
+    std::printf("\nMax local error per clip%s (translation units, rotation degrees, scale):\n", cfg.allClips ? "" : " (10 worst)");
+    std::printf("  clip  channels        keys              size                  trans       rot     scale\n");
+    for (uint32_t c : order)
+        printClip(c, reports[c]);
+    std::printf("  all clips: translation %.2e  rotation %.4f deg  scale %.2e\n", worst.maxTranslationError,
+                worst.maxRotationError * 57.29578f, worst.maxScaleError);
+
+    const float paletteErr = jointPaletteError(cfg, raw, packed);
+    std::printf("\nMax joint palette translation error (model units, bones ~0.1-0.2 long): %.2e\n", paletteErr);
+    std::printf("(checksums %.3f %.3f %.3f)\n", rawTiming.checksum, quantizedTiming.checksum, packedTiming.checksum);
+    return 0;
+}
@@ -0,0 +1,590 @@
+/*
+  AvoidanceBench
+  --------------
+  Purpose:
+    - Standalone microbenchmark for the LocalAvoidanceSystem passes on a dense
+      crowd (default 5000 units uniformly spread over a 50 m radius disk), no window /
+      Vulkan device needed.
+    - Compares three ways of computing each unit's push vector from its 3x3-cell neighbors:
+        legacy : per-neighbor lambda with store lookup, scalar sqrt/divide (pre-kernel code)
+        scalar : AvoidanceKernel::separationPushScalar on a packed batch
+        simd   : AvoidanceKernel::separationPush (AVX2 / SSE2 / NEON as compiled)
+      and reports ns/unit (gather + push), kernel-only ns/unit on pre-gathered batches with
+      the speedup over the scalar kernel, neighbors/unit and the max deviation from scalar.
+    - Reciprocal (ORCA) mode on a crowd of the same size packed at the desired spacing (hex
+      lattice, no initial overlaps) split into two blocks walking into each other (10% idle):
+      ns/unit for gather + nearest-K selection + solve and that cost scaled to 10k agents on
+      1 / 2 / 4 / 8 JobSystem threads (results must be bitwise identical across thread
+      counts; rows above the printed hardware thread count cannot scale), then a short simulation with and without ORCA reporting overlapping pairs
+      and how much of the preferred distance units actually covered.
+
+  Tolerance:
+    - simd vs scalar must match bitwise unless the compiler fuses multiply-adds in one of
+      them; the bench fails (exit code 1) if any component deviates by more than
+      kTolerance * (1 + |push|).
+    - legacy sums in neighbor order rather than lane-striped, so it is only reported.
+    - The bench also fails if the reciprocal pass differs between thread counts.
+
+  Usage:
+    AvoidanceBench [--units N] [--radius R] [--iters K] [--seed S] [--neighbors K]
+*/
+
+#include "systems/AvoidanceKernel.h"
+#include "systems/OrcaSolver.h"
+
+#include "Engine/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    constexpr float kCellSize = 3.0f;    // >= largest desired distance below (0.5 + 0.5 + 2 * 0.8)
+    constexpr float kTolerance = 1e-5f;  // relative, see header
+    constexpr uint32_t kStoreCount = 2;  // units split over two "archetypes" like knights / infantry
+    constexpr float kWalkSpeed = 3.0f;
+    constexpr float kTimeHorizon = 1.5f; // AvoidanceParams default
+    constexpr float kFrameDt = 1.0f / 60.0f;
+    constexpr float kSimSeconds = 4.0f;
+    constexpr uint32_t kGrain = 64; // LocalAvoidanceSystem rows per parallel chunk
+
+    // Stand-in for ArchetypeStore columns so the legacy path pays the same indirections.
+    struct Store
+    {
+        std::vector<float> x, z, radius, sep;
+        std::vector<float> vx, vz;  // preferred velocity (spaced crowd only)
+        std::vector<uint32_t> unit; // row -> index into Crowd::units
+        bool hasSeparation = true;
+    };
+
+    struct Entry
+    {
+        uint32_t storeId;
+        uint32_t row;
+    };
+
+    struct Crowd
+    {
+        std::vector<Store> stores;
+        std::vector<Entry> units; // iteration order
+        std::unordered_map<uint64_t, std::vector<Entry>> grid;
+
+        void rebuildGrid()
+        {
+            for (auto &kv : grid)
+                kv.second.clear();
+            for (const Entry &e : units)
+            {
+                const Store &st = stores[e.storeId];
+                const int gx = static_cast<int>(std::floor(st.x[e.row] / kCellSize));
+                const int gz = static_cast<int>(std::floor(st.z[e.row] / kCellSize));
+                grid[key(gx, gz)].push_back(e);
+            }
+        }
+
+        static uint64_t key(int gx, int gz)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(gx)) << 32) | static_cast<uint32_t>(gz);
+        }
+
+        template <typename Visitor>
+        void forNeighbors(float x, float z, Visitor &&visit) const
+        {
+            const int gx = static_cast<int>(std::floor(x / kCellSize));
+            const int gz = static_cast<int>(std::floor(z / kCellSize));
+            for (int dx = -1; dx <= 1; ++dx)
+                for (int dz = -1; dz <= 1; ++dz)
+                {
+                    auto it = grid.find(key(gx + dx, gz + dz));
+                    if (it == grid.end())
+                        continue;
+                    for (const Entry &e : it->second)
+                        visit(e.storeId, e.row);
+                }
+        }
+    };
+
+    Crowd makeCrowd(uint32_t count, float diskRadius, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> u01(0.0f, 1.0f);
+
+        Crowd c;
+        c.stores.resize(kStoreCount);
+        c.stores[1].hasSeparation = false;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const float a = u01(rng) * 6.2831853f;
+            const float d = diskRadius * std::sqrt(u01(rng));
+            const uint32_t s = i % kStoreCount;
+            Store &st = c.stores[s];
+            const uint32_t row = static_cast<uint32_t>(st.x.size());
+            st.x.push_back(d * std::cos(a));
+            st.z.push_back(d * std::sin(a));
+            st.radius.push_back(s == 0 ? 0.5f : 0.35f);
+            st.sep.push_back(s == 0 ? 0.8f : 0.0f);
+            st.unit.push_back(static_cast<uint32_t>(c.units.size()));
+            c.units.push_back(Entry{s, row});
+        }
+        c.rebuildGrid();
+        return c;
+    }
+
+    // Reciprocal mode needs a crowd that isn't already interpenetrating (overlapping pairs get
+    // a one-timestep separation constraint, which at this density is infeasible everywhere):
+    // a jittered hex lattice at the largest desired spacing, filled outward from the centre.
+    Crowd makeSpacedCrowd(uint32_t count, uint32_t seed)
+    {
+        constexpr float kSpacing = 2.7f; // > 0.5 + 0.5 + 2 * 0.8
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> jitter(-0.04f, 0.04f);
+
+        const int half = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count)))) + 1;
+        std::vector<std::pair<float, float>> lattice;
+        for (int j = -half; j <= half; ++j)
+            for (int i = -half; i <= half; ++i)
+                lattice.emplace_back((static_cast<float>(i) + 0.5f * static_cast<float>(j & 1)) * kSpacing,
+                                     static_cast<float>(j) * kSpacing * 0.8660254f);
+        std::sort(lattice.begin(), lattice.end(), [](const auto &a, const auto &b)
+                  { return a.first * a.first + a.second * a.second < b.first * b.first + b.second * b.second; });
+
+        Crowd c;
+        c.stores.resize(kStoreCount);
+        c.stores[1].hasSeparation = false;
+        for (uint32_t i = 0; i < count && i < lattice.size(); ++i)
+        {
+            const float x = lattice[i].first + jitter(rng);
+            const float z = lattice[i].second + jitter(rng);
+            const uint32_t s = i % kStoreCount;
+            Store &st = c.stores[s];
+            const uint32_t row = static_cast<uint32_t>(st.x.size());
+            st.x.push_back(x);
+            st.z.push_back(z);
+            st.radius.push_back(s == 0 ? 0.5f : 0.35f);
+            st.sep.push_back(s == 0 ? 0.8f : 0.0f);
+            const bool idle = (i % 10) == 9;
+            st.vx.push_back(idle ? 0.0f : (x < 0.0f ? kWalkSpeed : -kWalkSpeed));
+            st.vz.push_back(0.0f);
+            st.unit.push_back(static_cast<uint32_t>(c.units.size()));
+            c.units.push_back(Entry{s, row});
+        }
+        c.rebuildGrid();
+        return c;
+    }
+
+    // The per-neighbor loop LocalAvoidanceSystem ran before the batched kernel.
+    AvoidanceKernel::Push legacyPush(const Crowd &c, const Entry &self)
+    {
+        const Store &ss = c.stores[self.storeId];
+        const float px = ss.x[self.row], pz = ss.z[self.row];
+        const float r = ss.radius[self.row];
+        const float sepSelf = ss.hasSeparation ? ss.sep[self.row] : 0.0f;
+        float corrX = 0.0f, corrZ = 0.0f;
+
+        c.forNeighbors(px, pz, [&](uint32_t nStoreId, uint32_t nRow)
+                       {
+            if (nStoreId == self.storeId && nRow == self.row) return;
+            if (nStoreId >= c.stores.size()) return;
+            const Store &ns = c.stores[nStoreId];
+            const float sepOther = ns.hasSeparation ? ns.sep[nRow] : 0.0f;
+
+            float dx = px - ns.x[nRow];
+            float dz = pz - ns.z[nRow];
+            const float dist2 = dx * dx + dz * dz;
+            const float dist = (dist2 > 1e-12f) ? std::sqrt(dist2) : 0.0f;
+            const float desiredDist = (r + ns.radius[nRow]) + (sepSelf + sepOther);
+
+            float w = 0.0f;
+            if (dist < desiredDist && dist > 1e-6f)
+                w = (desiredDist - dist) / desiredDist;
+            if (w <= 0.0f) return;
+
+            dx /= dist;
+            dz /= dist;
+            corrX += dx * w;
+            corrZ += dz * w; });
+
+        return {corrX, corrZ};
+    }
+
+    // Gather like LocalAvoidanceSystem does (column pointers per store, no per-candidate checks).
+    uint32_t gather(const Crowd &c, const Entry &self, AvoidanceKernel::NeighborBatch &batch)
+    {
+        const Store &ss = c.stores[self.storeId];
+        batch.clear();
+        c.forNeighbors(ss.x[self.row], ss.z[self.row], [&](uint32_t nStoreId, uint32_t nRow)
+                       {
+            if (nStoreId == self.storeId && nRow == self.row) return;
+            const Store &ns = c.stores[nStoreId];
+            batch.push(ns.x[nRow], ns.z[nRow], ns.radius[nRow], ns.hasSeparation ? ns.sep[nRow] : 0.0f); });
+        return batch.count;
+    }
+
+    enum class Path
+    {
+        Legacy,
+        Scalar,
+        Simd
+    };
+
+    struct RunResult
+    {
+        double nsPerUnit = 0.0;
+        double kernelNsPerUnit = 0.0; // push evaluation only, neighbors pre-gathered
+        double neighborsPerUnit = 0.0;
+        std::vector<AvoidanceKernel::Push> pushes;
+    };
+
+    RunResult run(const Crowd &c, Path path, int iters)
+    {
+        RunResult out;
+        out.pushes.resize(c.units.size());
+        AvoidanceKernel::NeighborBatch batch;
+        uint64_t neighbors = 0;
+
+        double best = 1e30;
+        for (int it = 0; it < iters; ++it)
+        {
+            neighbors = 0;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < c.units.size(); ++i)
+            {
+                const Entry &self = c.units[i];
+                if (path == Path::Legacy)
+                {
+                    out.pushes[i] = legacyPush(c, self);
+                    continue;
+                }
+                neighbors += gather(c, self, batch);
+                const Store &ss = c.stores[self.storeId];
+                const float sep = ss.hasSeparation ? ss.sep[self.row] : 0.0f;
+                out.pushes[i] = (path == Path::Simd)
+                                    ? AvoidanceKernel::separationPush(ss.x[self.row], ss.z[self.row], ss.radius[self.row], sep, batch)
+                                    : AvoidanceKernel::separationPushScalar(ss.x[self.row], ss.z[self.row], ss.radius[self.row], sep, batch);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+        }
+
+        out.nsPerUnit = best / static_cast<double>(c.units.size());
+        out.neighborsPerUnit = static_cast<double>(neighbors) / static_cast<double>(c.units.size());
+        if (path == Path::Legacy)
+            return out;
+
+        // Kernel in isolation: the hash-grid walk dominates the totals above.
+        std::vector<AvoidanceKernel::NeighborBatch> batches(c.units.size());
+        for (size_t i = 0; i < c.units.size(); ++i)
+            gather(c, c.units[i], batches[i]);
+
+        best = 1e30;
+        for (int it = 0; it < iters; ++it)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < c.units.size(); ++i)
+            {
+                const Entry &self = c.units[i];
+                const Store &ss = c.stores[self.storeId];
+                const float sep = ss.hasSeparation ? ss.sep[self.row] : 0.0f;
+                out.pushes[i] = (path == Path::Simd)
+                                    ? AvoidanceKernel::separationPush(ss.x[self.row], ss.z[self.row], ss.radius[self.row], sep, batches[i])
+                                    : AvoidanceKernel::separationPushScalar(ss.x[self.row], ss.z[self.row], ss.radius[self.row], sep, batches[i]);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+        }
+        out.kernelNsPerUnit = best / static_cast<double>(c.units.size());
+        return out;
+    }
+
+    struct Deviation
+    {
+        float maxAbs = 0.0f;
+        float maxRel = 0.0f;
+        size_t bitwiseEqual = 0;
+    };
+
+    Deviation compare(const std::vector<AvoidanceKernel::Push> &a, const std::vector<AvoidanceKernel::Push> &b)
+    {
+        Deviation d;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            const float ex = std::fabs(a[i].x - b[i].x);
+            const float ez = std::fabs(a[i].z - b[i].z);
+            const float mag = std::sqrt(b[i].x * b[i].x + b[i].z * b[i].z);
+            d.maxAbs = std::max(d.maxAbs, std::max(ex, ez));
+            d.maxRel = std::max(d.maxRel, std::max(ex, ez) / (1.0f + mag));
+            if (std::memcmp(&a[i], &b[i], sizeof(AvoidanceKernel::Push)) == 0)
+                ++d.bitwiseEqual;
+        }
+        return d;
+    }
+
+    // ------------------------------------------------------------
+    // Reciprocal mode (mirrors LocalAvoidanceSystem::reciprocalVelocity)
+    // ------------------------------------------------------------
+
+    using Vec2 = OrcaSolver::Vec2;
+
+    struct OrcaScratch
+    {
+        OrcaSolver solver;
+        std::vector<OrcaSolver::Neighbor> neighbors;
+        std::vector<float> distSq;
+        std::vector<uint32_t> order;
+    };
+
+    // Solved velocity of unit `i`; `vel` holds every unit's current (= preferred) velocity.
+    Vec2 orcaVelocity(const Crowd &c, uint32_t i, const std::vector<Vec2> &vel, uint32_t maxNeighbors, OrcaScratch &s)
+    {
+        // Idle units have no dirty Velocity, so the system never solves them.
+        if (vel[i].x == 0.0f && vel[i].z == 0.0f)
+            return vel[i];
+
+        const Entry &self = c.units[i];
+        const Store &ss = c.stores[self.storeId];
+        const float px = ss.x[self.row], pz = ss.z[self.row];
+        const float sepSelf = ss.hasSeparation ? ss.sep[self.row] : 0.0f;
+
+        s.neighbors.clear();
+        s.distSq.clear();
+        c.forNeighbors(px, pz, [&](uint32_t nStoreId, uint32_t nRow)
+                       {
+            if (nStoreId == self.storeId && nRow == self.row) return;
+            const Store &ns = c.stores[nStoreId];
+            OrcaSolver::Neighbor nb;
+            nb.relPos = Vec2{ns.x[nRow] - px, ns.z[nRow] - pz};
+            nb.vel = vel[ns.unit[nRow]];
+            nb.combinedRadius = (ss.radius[self.row] + ns.radius[nRow]) +
+                                (sepSelf + (ns.hasSeparation ? ns.sep[nRow] : 0.0f));
+            nb.responsibility = (nb.vel.x * nb.vel.x + nb.vel.z * nb.vel.z > 1e-6f) ? 0.5f : 1.0f;
+            s.neighbors.push_back(nb);
+            s.distSq.push_back(nb.relPos.x * nb.relPos.x + nb.relPos.z * nb.relPos.z); });
+
+        uint32_t count = static_cast<uint32_t>(s.neighbors.size());
+        if (count > maxNeighbors)
+        {
+            s.order.resize(count);
+            for (uint32_t k = 0; k < count; ++k)
+                s.order[k] = k;
+            std::nth_element(s.order.begin(), s.order.begin() + maxNeighbors, s.order.end(),
+                             [&](uint32_t a, uint32_t b)
+                             { return s.distSq[a] < s.distSq[b] || (s.distSq[a] == s.distSq[b] && a < b); });
+            s.order.resize(maxNeighbors);
+            std::sort(s.order.begin(), s.order.end());
+            for (uint32_t k = 0; k < maxNeighbors; ++k)
+                s.neighbors[k] = s.neighbors[s.order[k]];
+            count = maxNeighbors;
+        }
+
+        // Same cap as the system: MoveSpeed (kWalkSpeed here) or the preferred speed if larger.
+        const Vec2 v = vel[i];
+        const float maxSpeed = std::max(kWalkSpeed, std::sqrt(v.x * v.x + v.z * v.z));
+        return s.solver.solve(v, v, maxSpeed, kTimeHorizon, kFrameDt, s.neighbors.data(), count);
+    }
+
+    std::vector<Vec2> preferredVelocities(const Crowd &c)
+    {
+        std::vector<Vec2> pref(c.units.size());
+        for (size_t i = 0; i < c.units.size(); ++i)
+            pref[i] = Vec2{c.stores[c.units[i].storeId].vx[c.units[i].row], c.stores[c.units[i].storeId].vz[c.units[i].row]};
+        return pref;
+    }
+
+    struct OrcaTiming
+    {
+        double nsPerUnit = 0.0; // wall time per unit
+        std::vector<Vec2> velocities;
+    };
+
+    // One double-buffered solve pass over the crowd (what LocalAvoidanceSystem does per frame),
+    // split across `jobs` in LocalAvoidanceSystem's chunk size.
+    OrcaTiming timeOrca(const Crowd &c, uint32_t maxNeighbors, int iters, Engine::JobSystem &jobs)
+    {
+        const std::vector<Vec2> vel = preferredVelocities(c);
+        OrcaTiming out;
+        out.velocities.resize(vel.size());
+        std::vector<OrcaScratch> scratch(jobs.threadCount());
+
+        const Engine::JobSystem::ChunkFn range = [&](uint32_t begin, uint32_t end, uint32_t thread)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+                out.velocities[i] = orcaVelocity(c, i, vel, maxNeighbors, scratch[thread]);
+        };
+
+        double best = 1e30;
+        for (int it = 0; it < iters; ++it)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            jobs.parallelFor(static_cast<uint32_t>(c.units.size()), kGrain, range);
+            const auto t1 = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+        }
+        out.nsPerUnit = best / static_cast<double>(c.units.size());
+        return out;
+    }
+
+    struct SimResult
+    {
+        uint32_t overlappingPairs = 0; // closer than 90% of their combined radius
+        float progress = 0.0f;         // mean distance covered / distance at preferred speed
+    };
+
+    // Walk the crowd for `seconds` at 60 Hz: Steering-style blend toward the preferred
+    // velocity, optionally ORCA, then integrate. No separation push in either case.
+    SimResult simulate(Crowd c, bool avoid, uint32_t maxNeighbors, float seconds)
+    {
+        const std::vector<Vec2> pref = preferredVelocities(c);
+        std::vector<Vec2> vel = pref, next(pref.size());
+        std::vector<float> travelled(pref.size(), 0.0f);
+        OrcaScratch scratch;
+
+        const int steps = static_cast<int>(seconds / kFrameDt);
+        const float blend = std::min(1.0f, 15.0f * kFrameDt); // SteeringSystem acceleration
+        for (int step = 0; step < steps; ++step)
+        {
+            for (size_t i = 0; i < vel.size(); ++i)
+            {
+                vel[i].x += (pref[i].x - vel[i].x) * blend;
+                vel[i].z += (pref[i].z - vel[i].z) * blend;
+            }
+            for (uint32_t i = 0; i < vel.size(); ++i)
+                next[i] = avoid ? orcaVelocity(c, i, vel, maxNeighbors, scratch) : vel[i];
+            vel.swap(next);
+
+            for (uint32_t i = 0; i < vel.size(); ++i)
+            {
+                Store &st = c.stores[c.units[i].storeId];
+                st.x[c.units[i].row] += vel[i].x * kFrameDt;
+                st.z[c.units[i].row] += vel[i].z * kFrameDt;
+                // Progress along the preferred direction (sideways dodging doesn't count).
+                const float ps = std::sqrt(pref[i].x * pref[i].x + pref[i].z * pref[i].z);
+                if (ps > 1e-6f)
+                    travelled[i] += (vel[i].x * pref[i].x + vel[i].z * pref[i].z) / ps * kFrameDt;
+            }
+            c.rebuildGrid();
+        }
+
+        SimResult r;
+        uint32_t movers = 0;
+        for (uint32_t i = 0; i < c.units.size(); ++i)
+        {
+            const Entry &self = c.units[i];
+            const Store &ss = c.stores[self.storeId];
+            const float sepSelf = ss.hasSeparation ? ss.sep[self.row] : 0.0f;
+            c.forNeighbors(ss.x[self.row], ss.z[self.row], [&](uint32_t nStoreId, uint32_t nRow)
+                           {
+                const Store &ns = c.stores[nStoreId];
+                if (ns.unit[nRow] <= i) return; // each pair once
+                const float dx = ns.x[nRow] - ss.x[self.row], dz = ns.z[nRow] - ss.z[self.row];
+                const float rr = 0.9f * ((ss.radius[self.row] + ns.radius[nRow]) + (sepSelf + (ns.hasSeparation ? ns.sep[nRow] : 0.0f)));
+                if (dx * dx + dz * dz < rr * rr)
+                    ++r.overlappingPairs; });
+
+            const float ps = std::sqrt(pref[i].x * pref[i].x + pref[i].z * pref[i].z);
+            if (ps > 1e-6f)
+            {
+                r.progress += travelled[i] / (ps * static_cast<float>(steps) * kFrameDt);
+                ++movers;
+            }
+        }
+        r.progress = movers ? r.progress / static_cast<float>(movers) : 0.0f;
+        return r;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t units = 5000;
+    float diskRadius = 50.0f;
+    int iters = 20;
+    uint32_t seed = 1234;
+    uint32_t maxNeighbors = 10;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--units") == 0 && i + 1 < argc)
+            units = static_cast<uint32_t>(std::max(2, std::atoi(argv[++i])));
+        else if (std::strcmp(argv[i], "--radius") == 0 && i + 1 < argc)
+            diskRadius = std::max(1.0f, static_cast<float>(std::atof(argv[++i])));
+        else if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc)
+            iters = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--neighbors") == 0 && i + 1 < argc)
+            maxNeighbors = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else
+        {
+            std::printf("Usage: AvoidanceBench [--units N] [--radius R] [--iters K] [--seed S] [--neighbors K]\n");
+            return 1;
+        }
+    }
+
+    const Crowd crowd = makeCrowd(units, diskRadius, seed);
+    std::printf("AvoidanceBench: %u units in a %.0f m disk, cell %.1f m, best of %d, kernel %s (%u lanes)\n\n",
+                units, diskRadius, kCellSize, iters, AvoidanceKernel::kIsaName, AvoidanceKernel::kLanes);
+
+    const RunResult legacy = run(crowd, Path::Legacy, iters);
+    const RunResult scalar = run(crowd, Path::Scalar, iters);
+    const RunResult simd = run(crowd, Path::Simd, iters);
+
+    const Deviation dLegacy = compare(legacy.pushes, scalar.pushes);
+    const Deviation dSimd = compare(simd.pushes, scalar.pushes);
+
+    std::printf("%-8s %10s %10s %9s %10s %12s %12s %10s\n", "path", "ns/unit", "kernel ns", "speedup", "neighbors",
+                "max |diff|", "max rel", "bitwise");
+    auto row = [&](const char *name, const RunResult &r, const Deviation &d)
+    {
+        if (r.kernelNsPerUnit > 0.0)
+            std::printf("%-8s %10.1f %10.1f %8.2fx", name, r.nsPerUnit, r.kernelNsPerUnit, scalar.kernelNsPerUnit / r.kernelNsPerUnit);
+        else
+            std::printf("%-8s %10.1f %10s %9s", name, r.nsPerUnit, "-", "-");
+        std::printf(" %10.1f %12.3g %12.3g %9.1f%%\n", scalar.neighborsPerUnit, d.maxAbs, d.maxRel,
+                    100.0 * static_cast<double>(d.bitwiseEqual) / static_cast<double>(units));
+    };
+    row("legacy", legacy, dLegacy);
+    row("scalar", scalar, Deviation{0.0f, 0.0f, units});
+    row("simd", simd, dSimd);
+
+    const Crowd spaced = makeSpacedCrowd(units, seed);
+    std::printf("\nreciprocal (ORCA, %u neighbors, horizon %.1f s), one double-buffered pass, %u hardware threads:\n",
+                maxNeighbors, kTimeHorizon, std::thread::hardware_concurrency());
+    std::printf("%-8s %10s %12s %10s\n", "threads", "ns/unit", "10k agents", "bitwise");
+    std::vector<Vec2> reference;
+    bool deterministic = true;
+    for (uint32_t threads : {1u, 2u, 4u, 8u})
+    {
+        Engine::JobSystem jobs(threads - 1);
+        const OrcaTiming t = timeOrca(spaced, maxNeighbors, iters, jobs);
+        if (reference.empty())
+            reference = t.velocities;
+        const bool same = std::memcmp(reference.data(), t.velocities.data(), reference.size() * sizeof(Vec2)) == 0;
+        deterministic = deterministic && same;
+        std::printf("%-8u %10.1f %9.2f ms %10s\n", threads, t.nsPerUnit, t.nsPerUnit * 10000.0 * 1e-6, same ? "yes" : "NO");
+    }
+
+    const SimResult none = simulate(spaced, false, maxNeighbors, kSimSeconds);
+    const SimResult orca = simulate(spaced, true, maxNeighbors, kSimSeconds);
+    std::printf("after %.0f s of two opposing blocks: overlapping pairs none %u / ORCA %u, progress none %.0f%% / ORCA %.0f%%\n",
+                kSimSeconds, none.overlappingPairs, orca.overlappingPairs, 100.0f * none.progress, 100.0f * orca.progress);
+
+    if (!deterministic)
+    {
+        std::printf("\nFAIL: reciprocal results depend on thread count\n");
+        return 1;
+    }
+    if (dSimd.maxRel > kTolerance)
+    {
+        std::printf("\nFAIL: simd deviates from scalar by %.3g (tolerance %.3g)\n", dSimd.maxRel, kTolerance);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,351 @@
+/*
+  ExtractionBench
+  ---------------
+  Purpose:
+    - Standalone benchmark for the render extraction stage (RenderSystem::extract) on a crowd
+      of animated instances (default 20k units over 4 models, 32 nodes / 24 joints each),
+      no window / Vulkan device needed.
+    - Legacy: the pre-snapshot RenderSystem::update (per-frame unordered_maps of batches, then
+      SModelRenderPassModule::setInstances / setNodePalette / setJointPalette copying every
+      batch again), copied below as legacyExtract.
+    - Snapshot: extraction into a reused RenderSnapshot slot, culling off (same output as the
+      legacy path; compared matrix by matrix) and on (camera looking at part of the field).
+    - Reports ms/frame, ns/instance and MB copied per frame for each.
+
+  Usage:
+    ExtractionBench [--units N] [--models M] [--nodes K] [--joints J] [--frames F] [--seed S]
+*/
+
+#include "ECS/ECSContext.h"
+#include "systems/RenderSystem.h"
+
+#include "Engine/Camera.h"
+#include "Engine/RenderSnapshot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    using namespace Engine::ECS;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float kFieldSize = 400.0f;
+
+    double msSince(Clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    struct Config
+    {
+        uint32_t units = 20000;
+        uint32_t models = 4;
+        uint32_t nodes = 32;
+        uint32_t joints = 24;
+        uint32_t frames = 60;
+        uint32_t seed = 1234;
+    };
+
+    void populate(ECSContext &ecs, const Config &cfg)
+    {
+        ecs.WireQueryManager();
+
+        ComponentMask sig;
+        for (const char *name : {"Position", "Facing", "RenderModel", "PosePalette"})
+            sig.set(ecs.components.ensureId(name));
+        const uint32_t archetypeId = ecs.archetypes.getOrCreate(sig);
+        ArchetypeStore &st = *ecs.stores.getOrCreate(archetypeId, sig, ecs.components);
+
+        std::mt19937 rng(cfg.seed);
+        std::uniform_real_distribution<float> field(0.0f, kFieldSize);
+        std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+        std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+
+        for (uint32_t i = 0; i < cfg.units; ++i)
+        {
+            const Entity e = ecs.entities.create();
+            const uint32_t r = st.createRow(e);
+            ecs.entities.attach(e, archetypeId, r);
+
+            st.positions()[r] = {field(rng), 0.0f, field(rng)};
+            st.facings()[r].yaw = angle(rng);
+
+            // Interleave models so batches are built from scattered rows, as after spawns/deaths.
+            Engine::ModelHandle h;
+            h.id = 1 + (i % cfg.models);
+            h.generation = 1;
+            st.renderModels()[r].handle = h;
+
+            // Distinct matrices per instance so the output comparison means something.
+            PosePalette &pose = st.posePalettes()[r];
+            pose.nodeCount = cfg.nodes;
+            pose.jointCount = cfg.joints;
+            pose.nodePalette.assign(cfg.nodes, Engine::PaletteIdentity());
+            pose.jointPalette.assign(cfg.joints, Engine::PaletteIdentity());
+            for (Engine::PaletteMatrix &m : pose.nodePalette)
+                for (int r = 0; r < 3; ++r)
+                    m[r][3] = jitter(rng); // translation
+            for (Engine::PaletteMatrix &m : pose.jointPalette)
+                for (int r = 0; r < 3; ++r)
+                    m[r][3] = jitter(rng);
+        }
+    }
+
+    // ---- Legacy path (pre-snapshot RenderSystem::update + pass-side copies) ----
+
+    struct LegacyBatch
+    {
+        std::vector<glm::mat4> instanceWorlds;
+        std::vector<Engine::PaletteMatrix> nodePalette;
+        uint32_t nodeCount = 0;
+        std::vector<Engine::PaletteMatrix> jointPalette;
+        uint32_t jointCount = 0;
+    };
+
+    // Stand-in for the per-model pass: what setInstances / setNodePalette / setJointPalette kept.
+    struct LegacyPassCopy
+    {
+        std::vector<glm::mat4> instanceWorlds;
+        std::vector<Engine::PaletteMatrix> nodePalette;
+        std::vector<Engine::PaletteMatrix> jointPalette;
+    };
+
+    void legacyExtract(ECSContext &ecs, QueryId qid, std::unordered_map<uint64_t, LegacyPassCopy> &passes)
+    {
+        std::unordered_map<uint64_t, LegacyBatch> batchesByModel;
+
+        const auto &q = ecs.queries.get(qid);
+        for (uint32_t archetypeId : q.matchingArchetypeIds)
+        {
+            auto *ptr = ecs.stores.get(archetypeId);
+            if (!ptr)
+                continue;
+            auto &store = *ptr;
+            auto &renderModels = store.renderModels();
+            auto &positions = store.positions();
+            auto &posePalettes = store.posePalettes();
+            const uint32_t n = store.size();
+
+            for (uint32_t row = 0; row < n; ++row)
+            {
+                const Engine::ModelHandle handle = renderModels[row].handle;
+                const uint64_t key = (static_cast<uint64_t>(handle.generation) << 32) | static_cast<uint64_t>(handle.id);
+                const auto &pos = positions[row];
+                auto *facings = store.hasFacing() ? &store.facings() : nullptr;
+
+                auto &batch = batchesByModel[key];
+                if (batch.nodeCount == 0)
+                {
+                    batch.nodeCount = posePalettes[row].nodeCount;
+                    batch.jointCount = posePalettes[row].jointCount;
+                    batch.nodePalette.reserve(64u * batch.nodeCount);
+                    if (batch.jointCount > 0)
+                        batch.jointPalette.reserve(64u * batch.jointCount);
+                }
+                if (batch.nodeCount == 0)
+                    continue;
+
+                glm::mat4 world = glm::translate(glm::mat4(1.0f), glm::vec3(pos.x, pos.y, pos.z));
+                if (facings)
+                    world = glm::rotate(world, (*facings)[row].yaw, glm::vec3(0.0f, 1.0f, 0.0f));
+                batch.instanceWorlds.emplace_back(world);
+
+                const auto &pose = posePalettes[row];
+                if (pose.nodeCount == batch.nodeCount && pose.nodePalette.size() == static_cast<size_t>(batch.nodeCount))
+                    batch.nodePalette.insert(batch.nodePalette.end(), pose.nodePalette.begin(), pose.nodePalette.end());
+                else
+                    batch.nodePalette.insert(batch.nodePalette.end(), batch.nodeCount, Engine::PaletteIdentity());
+
+                if (batch.jointCount > 0)
+                {
+                    if (pose.jointCount == batch.jointCount && pose.jointPalette.size() == static_cast<size_t>(batch.jointCount))
+                        batch.jointPalette.insert(batch.jointPalette.end(), pose.jointPalette.begin(), pose.jointPalette.end());
+                    else
+                        batch.jointPalette.insert(batch.jointPalette.end(), batch.jointCount, Engine::PaletteIdentity());
+                }
+            }
+        }
+
+        for (auto &kv : batchesByModel)
+        {
+            LegacyPassCopy &pass = passes[kv.first];
+            pass.instanceWorlds.assign(kv.second.instanceWorlds.begin(), kv.second.instanceWorlds.end());
+            pass.nodePalette.assign(kv.second.nodePalette.begin(), kv.second.nodePalette.end());
+            pass.jointPalette.assign(kv.second.jointPalette.begin(), kv.second.jointPalette.end());
+        }
+    }
+
+    template <typename M>
+    bool sameMatrices(const std::vector<M> &a, const std::vector<M> &b)
+    {
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), sizeof(M) * a.size()) == 0);
+    }
+
+    bool compare(const std::unordered_map<uint64_t, LegacyPassCopy> &legacy, const Engine::RenderSnapshot &snap)
+    {
+        uint32_t nonEmpty = 0;
+        for (uint32_t i = 0; i < snap.batchCount; ++i)
+        {
+            const Engine::RenderBatch &b = snap.batches[i];
+            if (b.instanceWorlds.empty())
+                continue;
+            ++nonEmpty;
+            const uint64_t key = (static_cast<uint64_t>(b.model.generation) << 32) | static_cast<uint64_t>(b.model.id);
+            auto it = legacy.find(key);
+            if (it == legacy.end())
+            {
+                std::printf("  model %llu missing from legacy output\n", static_cast<unsigned long long>(b.model.id));
+                return false;
+            }
+            if (!sameMatrices(it->second.instanceWorlds, b.instanceWorlds) ||
+                !sameMatrices(it->second.nodePalette, b.nodePalette) ||
+                !sameMatrices(it->second.jointPalette, b.jointPalette))
+            {
+                std::printf("  model %llu differs from legacy output\n", static_cast<unsigned long long>(b.model.id));
+                return false;
+            }
+        }
+        if (nonEmpty != legacy.size())
+        {
+            std::printf("  batch count %u != legacy %zu\n", nonEmpty, legacy.size());
+            return false;
+        }
+        return true;
+    }
+
+    double snapshotMB(const Engine::RenderSnapshot &snap)
+    {
+        size_t bytes = 0;
+        for (uint32_t i = 0; i < snap.batchCount; ++i)
+        {
+            const Engine::RenderBatch &b = snap.batches[i];
+            bytes += b.instanceWorlds.size() * sizeof(glm::mat4);
+            bytes += (b.nodePalette.size() + b.jointPalette.size()) * sizeof(Engine::PaletteMatrix);
+        }
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    void report(const char *label, double ms, uint32_t frames, uint32_t instances, double mbPerFrame)
+    {
+        const double perFrame = ms / frames;
+        std::printf("  %-22s %8.3f ms/frame  %7.1f ns/instance  %7.1f MB/frame copied\n", label, perFrame,
+                    instances ? perFrame * 1e6 / instances : 0.0, mbPerFrame);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Config cfg;
+    for (int i = 1; i < argc; ++i)
+    {
+        auto next = [&](uint32_t &out)
+        { out = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i]))); };
+        if (std::strcmp(argv[i], "--units") == 0 && i + 1 < argc)
+            next(cfg.units);
+        else if (std::strcmp(argv[i], "--models") == 0 && i + 1 < argc)
+            next(cfg.models);
+        else if (std::strcmp(argv[i], "--nodes") == 0 && i + 1 < argc)
+            next(cfg.nodes);
+        else if (std::strcmp(argv[i], "--joints") == 0 && i + 1 < argc)
+            next(cfg.joints);
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            next(cfg.frames);
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            cfg.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            std::printf("Usage: ExtractionBench [--units N] [--models M] [--nodes K] [--joints J] [--frames F] [--seed S]\n");
+            return 1;
+        }
+    }
+
+    std::printf("ExtractionBench: %u animated instances, %u models, %u nodes / %u joints each, %u frames\n\n",
+                cfg.units, cfg.models, cfg.nodes, cfg.joints, cfg.frames);
+
+    ECSContext ecs;
+    populate(ecs, cfg);
+
+    // Camera above one corner of the field, looking across it (used for the culled run).
+    Engine::Camera camera;
+    camera.SetPerspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 250.0f);
+    camera.SetPosition(glm::vec3(0.0f, 60.0f, 0.0f));
+    camera.SetRotation(45.0f, -30.0f);
+
+    RenderSystem render;
+    render.buildMasks(ecs.components);
+    render.setInterpolationEnabled(false);
+
+    ComponentMask required, excluded;
+    for (const char *name : {"RenderModel", "PosePalette", "Position"})
+        required.set(ecs.components.ensureId(name));
+    for (const char *name : {"Disabled", "Dead"})
+        excluded.set(ecs.components.ensureId(name));
+    const QueryId legacyQuery = ecs.queries.createQuery(required, excluded, ecs.stores);
+
+    // Legacy.
+    std::unordered_map<uint64_t, LegacyPassCopy> legacyPasses;
+    legacyExtract(ecs, legacyQuery, legacyPasses); // warm-up
+    auto t0 = Clock::now();
+    for (uint32_t f = 0; f < cfg.frames; ++f)
+        legacyExtract(ecs, legacyQuery, legacyPasses);
+    const double legacyMs = msSince(t0);
+
+    // Snapshot, no culling: must reproduce the legacy output.
+    Engine::RenderSnapshotBuffer buffer;
+    render.setCullingEnabled(false);
+    {
+        Engine::RenderSnapshot &warm = buffer.beginWrite();
+        render.extract(ecs, warm);
+        buffer.publish();
+    }
+    t0 = Clock::now();
+    for (uint32_t f = 0; f < cfg.frames; ++f)
+    {
+        Engine::RenderSnapshot &snap = buffer.beginWrite();
+        render.extract(ecs, snap);
+        buffer.publish();
+        (void)buffer.acquireRead();
+    }
+    const double snapMs = msSince(t0);
+    const Engine::RenderSnapshot *full = buffer.acquireRead();
+    const bool same = full && compare(legacyPasses, *full);
+    const double fullMB = full ? snapshotMB(*full) : 0.0;
+
+    // Snapshot with frustum culling.
+    render.setCamera(&camera);
+    render.setCullingEnabled(true);
+    {
+        Engine::RenderSnapshot &warm = buffer.beginWrite();
+        render.extract(ecs, warm);
+        buffer.publish();
+    }
+    t0 = Clock::now();
+    for (uint32_t f = 0; f < cfg.frames; ++f)
+    {
+        Engine::RenderSnapshot &snap = buffer.beginWrite();
+        render.extract(ecs, snap);
+        buffer.publish();
+        (void)buffer.acquireRead();
+    }
+    const double culledMs = msSince(t0);
+    const Engine::RenderSnapshot *culled = buffer.acquireRead();
+
+    std::printf("Extraction (%u instances):\n", cfg.units);
+    report("legacy (maps + copy)", legacyMs, cfg.frames, cfg.units, fullMB * 2.0);
+    report("snapshot", snapMs, cfg.frames, cfg.units, fullMB);
+    report("snapshot + culling", culledMs, cfg.frames, cfg.units, culled ? snapshotMB(*culled) : 0.0);
+    std::printf("  speedup vs legacy: %.2fx (no culling), %.2fx (culling: %u drawn, %u culled)\n\n",
+                snapMs > 0.0 ? legacyMs / snapMs : 0.0, culledMs > 0.0 ? legacyMs / culledMs : 0.0,
+                culled ? culled->visibleInstances : 0u, culled ? culled->culledInstances : 0u);
+
+    std::printf("Snapshot output vs legacy: %s\n", same ? "identical" : "MISMATCH");
+    return same ? 0 : 1;
+}
@@ -0,0 +1,397 @@
+/*
+  GpuPoseBench
+  ------------
+  Purpose:
+    - Standalone benchmark for crowd pose evaluation on the CPU vs in the pose compute pass
+      (Engine::GpuPoseEvaluator, shaders/pose.comp), --units poses per frame (default 10k)
+      of the Knight-like synthetic model, headless Vulkan (no window / swapchain). Runs on
+      any Vulkan 1.0 device with a graphics+compute queue, including lavapipe
+      (VK_ICD_FILENAMES=.../lvp_icd.x86_64.json) for CI.
+    - CPU: ModelAsset::evaluatePoseInto + buildJointPaletteInto per unit, then the copy into
+      the mapped palette buffers the vertex shader reads (what PoseUpdateSystem + the model
+      pass do today, without sharing or baking).
+    - GPU: one PoseRequest (8 bytes) per unit uploaded, one dispatch, submit + fence wait per
+      frame; reports wall time and the dispatch's timestamp-query time.
+    - Reads the GPU palettes back and checks them against the CPU ones.
+
+  Usage:
+    GpuPoseBench [--units N] [--frames F] [--nodes K] [--device I] [--shader path/to/pose.comp.spv]
+*/
+
+#include "Engine/GpuPoseEvaluator.h"
+#include "bench/SyntheticModel.h"
+
+#include <vulkan/vulkan.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef STRATO_SHADER_DIR
+#define STRATO_SHADER_DIR "shaders"
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double msSince(Clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    struct Config
+    {
+        uint32_t units = 10000;
+        uint32_t frames = 60;
+        uint32_t nodes = 64;
+        uint32_t device = 0;
+        std::string shader = STRATO_SHADER_DIR "/pose.comp.spv";
+    };
+
+    struct Headless
+    {
+        VkInstance instance = VK_NULL_HANDLE;
+        VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+        VkDevice device = VK_NULL_HANDLE;
+        VkQueue queue = VK_NULL_HANDLE;
+        uint32_t queueFamily = 0;
+        VkCommandPool pool = VK_NULL_HANDLE;
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        char deviceName[VK_MAX_PHYSICAL_DEVICE_NAME_SIZE] = {};
+
+        ~Headless()
+        {
+            if (device != VK_NULL_HANDLE)
+            {
+                vkDeviceWaitIdle(device);
+                if (fence != VK_NULL_HANDLE)
+                    vkDestroyFence(device, fence, nullptr);
+                if (pool != VK_NULL_HANDLE)
+                    vkDestroyCommandPool(device, pool, nullptr);
+                vkDestroyDevice(device, nullptr);
+            }
+            if (instance != VK_NULL_HANDLE)
+                vkDestroyInstance(instance, nullptr);
+        }
+    };
+
+    // Instance, device `index` and a queue that does graphics + compute (the evaluator's
+    // barrier targets the vertex stage, like in the renderer).
+    bool createHeadless(uint32_t index, Headless &vk)
+    {
+        VkApplicationInfo app{};
+        app.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        app.pApplicationName = "GpuPoseBench";
+        app.apiVersion = VK_API_VERSION_1_0;
+        VkInstanceCreateInfo ici{};
+        ici.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        ici.pApplicationInfo = &app;
+        if (vkCreateInstance(&ici, nullptr, &vk.instance) != VK_SUCCESS)
+            return false;
+
+        uint32_t count = 0;
+        vkEnumeratePhysicalDevices(vk.instance, &count, nullptr);
+        if (index >= count)
+            return false;
+        std::vector<VkPhysicalDevice> devices(count);
+        vkEnumeratePhysicalDevices(vk.instance, &count, devices.data());
+        vk.physicalDevice = devices[index];
+
+        VkPhysicalDeviceProperties props{};
+        vkGetPhysicalDeviceProperties(vk.physicalDevice, &props);
+        std::memcpy(vk.deviceName, props.deviceName, sizeof(vk.deviceName));
+
+        uint32_t familyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(vk.physicalDevice, &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(vk.physicalDevice, &familyCount, families.data());
+        const VkQueueFlags wanted = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;
+        vk.queueFamily = familyCount;
+        for (uint32_t f = 0; f < familyCount && vk.queueFamily == familyCount; ++f)
+        {
+            if ((families[f].queueFlags & wanted) == wanted)
+                vk.queueFamily = f;
+        }
+        if (vk.queueFamily == familyCount)
+            return false;
+
+        const float priority = 1.0f;
+        VkDeviceQueueCreateInfo qci{};
+        qci.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        qci.queueFamilyIndex = vk.queueFamily;
+        qci.queueCount = 1;
+        qci.pQueuePriorities = &priority;
+        VkDeviceCreateInfo dci{};
+        dci.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        dci.queueCreateInfoCount = 1;
+        dci.pQueueCreateInfos = &qci;
+        if (vkCreateDevice(vk.physicalDevice, &dci, nullptr, &vk.device) != VK_SUCCESS)
+            return false;
+        vkGetDeviceQueue(vk.device, vk.queueFamily, 0, &vk.queue);
+
+        VkCommandPoolCreateInfo cpci{};
+        cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        cpci.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        cpci.queueFamilyIndex = vk.queueFamily;
+        if (vkCreateCommandPool(vk.device, &cpci, nullptr, &vk.pool) != VK_SUCCESS)
+            return false;
+
+        VkCommandBufferAllocateInfo cbai{};
+        cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        cbai.commandPool = vk.pool;
+        cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        cbai.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(vk.device, &cbai, &vk.cmd) != VK_SUCCESS)
+            return false;
+
+        VkFenceCreateInfo fci{};
+        fci.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        return vkCreateFence(vk.device, &fci, nullptr, &vk.fence) == VK_SUCCESS;
+    }
+
+    // Host-visible, coherent, mapped storage buffer (like CameraFrame's palette buffers).
+    struct MappedBuffer
+    {
+        VkDevice device = VK_NULL_HANDLE;
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize bytes = 0;
+        void *mapped = nullptr;
+
+        ~MappedBuffer()
+        {
+            if (buffer != VK_NULL_HANDLE)
+                vkDestroyBuffer(device, buffer, nullptr);
+            if (memory != VK_NULL_HANDLE)
+                vkFreeMemory(device, memory, nullptr);
+        }
+    };
+
+    bool createMapped(const Headless &vk, VkDeviceSize bytes, MappedBuffer &out)
+    {
+        out.device = vk.device;
+        out.bytes = bytes;
+        VkBufferCreateInfo bci{};
+        bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bci.size = bytes;
+        bci.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (vkCreateBuffer(vk.device, &bci, nullptr, &out.buffer) != VK_SUCCESS)
+            return false;
+
+        VkMemoryRequirements req{};
+        vkGetBufferMemoryRequirements(vk.device, out.buffer, &req);
+        VkPhysicalDeviceMemoryProperties memProps{};
+        vkGetPhysicalDeviceMemoryProperties(vk.physicalDevice, &memProps);
+        const VkMemoryPropertyFlags flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        VkMemoryAllocateInfo mai{};
+        mai.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        mai.allocationSize = req.size;
+        mai.memoryTypeIndex = memProps.memoryTypeCount;
+        for (uint32_t i = 0; i < memProps.memoryTypeCount && mai.memoryTypeIndex == memProps.memoryTypeCount; ++i)
+        {
+            if ((req.memoryTypeBits & (1u << i)) && (memProps.memoryTypes[i].propertyFlags & flags) == flags)
+                mai.memoryTypeIndex = i;
+        }
+        if (mai.memoryTypeIndex == memProps.memoryTypeCount ||
+            vkAllocateMemory(vk.device, &mai, nullptr, &out.memory) != VK_SUCCESS)
+            return false;
+        vkBindBufferMemory(vk.device, out.buffer, out.memory, 0);
+        return vkMapMemory(vk.device, out.memory, 0, VK_WHOLE_SIZE, 0, &out.mapped) == VK_SUCCESS;
+    }
+
+    // Unit u's (clip, time) in frame f: spread over the clips and phases, advancing at 1x.
+    Engine::PoseRequest requestFor(const Engine::ModelAsset &model, uint32_t u, uint32_t f)
+    {
+        Engine::PoseRequest r;
+        r.clip = (u * 2654435761u >> 7) % static_cast<uint32_t>(model.animClips.size());
+        const float duration = std::max(model.animClips[r.clip].durationSec, 1e-3f);
+        r.timeSec = std::fmod(static_cast<float>(u % 97u) * 0.031f + static_cast<float>(f) / 60.0f, duration);
+        return r;
+    }
+
+    float maxDiff(const Engine::PaletteMatrix *a, const Engine::PaletteMatrix *b, size_t count)
+    {
+        float d = 0.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (int r = 0; r < 3; ++r)
+            {
+                for (int c = 0; c < 4; ++c)
+                    d = std::max(d, std::fabs(a[i][r][c] - b[i][r][c]));
+            }
+        }
+        return d;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Config cfg;
+    for (int i = 1; i < argc; ++i)
+    {
+        auto next = [&](uint32_t &out)
+        { out = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i]))); };
+        if (std::strcmp(argv[i], "--units") == 0 && i + 1 < argc)
+            next(cfg.units);
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            next(cfg.frames);
+        else if (std::strcmp(argv[i], "--nodes") == 0 && i + 1 < argc)
+            next(cfg.nodes);
+        else if (std::strcmp(argv[i], "--device") == 0 && i + 1 < argc)
+            next(cfg.device);
+        else if (std::strcmp(argv[i], "--shader") == 0 && i + 1 < argc)
+            cfg.shader = argv[++i];
+        else
+        {
+            std::printf("Usage: GpuPoseBench [--units N] [--frames F] [--nodes K] [--device I] [--shader path/to/pose.comp.spv]\n");
+            return 1;
+        }
+    }
+    cfg.units = std::max(cfg.units, 1u);
+    cfg.frames = std::max(cfg.frames, 2u);
+
+    Bench::SyntheticModelDesc desc;
+    desc.nodes = cfg.nodes;
+    Engine::ModelAsset model;
+    Bench::BuildSyntheticModel(desc, model);
+    model.buildNodeOrder();
+    const uint32_t nodeCount = static_cast<uint32_t>(model.nodes.size());
+    const uint32_t jointCount = model.totalJointCount;
+    const size_t nodeMats = size_t(cfg.units) * nodeCount;
+    const size_t jointMats = size_t(cfg.units) * jointCount;
+
+    Headless vk;
+    if (!createHeadless(cfg.device, vk))
+    {
+        std::printf("GpuPoseBench: no Vulkan device %u with a graphics+compute queue\n", cfg.device);
+        return 1;
+    }
+
+    MappedBuffer nodeBuf, jointBuf;
+    if (!createMapped(vk, nodeMats * sizeof(Engine::PaletteMatrix), nodeBuf) ||
+        !createMapped(vk, std::max<size_t>(jointMats, 1) * sizeof(Engine::PaletteMatrix), jointBuf))
+    {
+        std::printf("GpuPoseBench: could not allocate %.1f MB of host-visible palettes\n",
+                    static_cast<double>((nodeMats + jointMats) * sizeof(Engine::PaletteMatrix)) / (1024.0 * 1024.0));
+        return 1;
+    }
+
+    Engine::GpuPoseEvaluator gpu;
+    if (!gpu.create(vk.device, vk.physicalDevice, vk.queue, vk.queueFamily, model, 1, cfg.shader))
+    {
+        std::printf("GpuPoseBench: could not create the pose pipeline (shader %s)\n", cfg.shader.c_str());
+        return 1;
+    }
+
+    std::printf("GpuPoseBench: %u units x %u frames, %u nodes / %u joints per pose, device: %s\n",
+                cfg.units, cfg.frames, nodeCount, jointCount, vk.deviceName);
+    std::printf("  animation tables on the GPU: %.1f KB (uploaded once)\n\n", static_cast<double>(gpu.animationBytes()) / 1024.0);
+
+    // CPU: evaluate every unit, write the palettes the vertex shader would read.
+    std::vector<Engine::ModelAsset::NodeTRS> trs;
+    std::vector<glm::mat4> locals, globals;
+    std::vector<Engine::PaletteMatrix> jointsTmp;
+    auto *nodesOut = static_cast<Engine::PaletteMatrix *>(nodeBuf.mapped);
+    auto *jointsOut = static_cast<Engine::PaletteMatrix *>(jointBuf.mapped);
+    auto cpuFrame = [&](uint32_t f)
+    {
+        for (uint32_t u = 0; u < cfg.units; ++u)
+        {
+            const Engine::PoseRequest r = requestFor(model, u, f);
+            model.evaluatePoseInto(r.clip, r.timeSec, trs, locals, globals);
+            Engine::ToPaletteMatrices(globals.data(), nodeCount, nodesOut + size_t(u) * nodeCount);
+            if (jointCount > 0)
+            {
+                model.buildJointPaletteInto(globals, jointsTmp);
+                std::memcpy(jointsOut + size_t(u) * jointCount, jointsTmp.data(), sizeof(Engine::PaletteMatrix) * jointCount);
+            }
+        }
+    };
+
+    cpuFrame(0); // warm-up
+    const auto cpuStart = Clock::now();
+    for (uint32_t f = 0; f < cfg.frames; ++f)
+        cpuFrame(f);
+    const double cpuMs = msSince(cpuStart) / static_cast<double>(cfg.frames);
+
+    // Reference for the last frame.
+    const uint32_t checkFrame = cfg.frames - 1;
+    cpuFrame(checkFrame);
+    std::vector<Engine::PaletteMatrix> cpuNodes(nodesOut, nodesOut + nodeMats);
+    std::vector<Engine::PaletteMatrix> cpuJoints(jointsOut, jointsOut + jointMats);
+
+    // GPU: requests only, one dispatch per frame.
+    std::vector<Engine::PoseRequest> requests(cfg.units);
+    auto gpuFrame = [&](uint32_t f) -> bool
+    {
+        for (uint32_t u = 0; u < cfg.units; ++u)
+            requests[u] = requestFor(model, u, f);
+
+        VkCommandBufferBeginInfo begin{};
+        begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkResetCommandBuffer(vk.cmd, 0);
+        vkBeginCommandBuffer(vk.cmd, &begin);
+        const bool recorded = gpu.record(vk.cmd, 0, requests.data(), cfg.units, nodeBuf.buffer, nodeBuf.bytes,
+                                         jointCount > 0 ? jointBuf.buffer : VK_NULL_HANDLE, jointBuf.bytes);
+        vkEndCommandBuffer(vk.cmd);
+        if (!recorded)
+            return false;
+
+        VkSubmitInfo submit{};
+        submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit.commandBufferCount = 1;
+        submit.pCommandBuffers = &vk.cmd;
+        vkResetFences(vk.device, 1, &vk.fence);
+        if (vkQueueSubmit(vk.queue, 1, &submit, vk.fence) != VK_SUCCESS)
+            return false;
+        return vkWaitForFences(vk.device, 1, &vk.fence, VK_TRUE, UINT64_MAX) == VK_SUCCESS;
+    };
+
+    if (!gpuFrame(0)) // warm-up (pipeline, descriptor writes, request buffer growth)
+    {
+        std::printf("GpuPoseBench: recording / submitting the pose dispatch failed\n");
+        return 1;
+    }
+    double gpuDispatchMs = 0.0;
+    const auto gpuStart = Clock::now();
+    for (uint32_t f = 0; f < cfg.frames; ++f)
+    {
+        gpuFrame(f);
+        gpuDispatchMs += gpu.lastGpuMs(); // the previous submission's timestamps
+    }
+    const double gpuMs = msSince(gpuStart) / static_cast<double>(cfg.frames);
+    gpuDispatchMs /= static_cast<double>(cfg.frames);
+
+    // Readback of the last frame (the barrier includes host reads; the fence makes them visible).
+    const float nodeErr = maxDiff(cpuNodes.data(), nodesOut, nodeMats);
+    const float jointErr = maxDiff(cpuJoints.data(), jointsOut, jointMats);
+
+    const double kKB = 1024.0;
+    const double cpuUpload = static_cast<double>((nodeMats + jointMats) * sizeof(Engine::PaletteMatrix)) / kKB;
+    const double gpuUpload = static_cast<double>(size_t(cfg.units) * sizeof(Engine::PoseRequest)) / kKB;
+
+    std::printf("Per frame:\n");
+    std::printf("  %-34s %9.3f ms   upload %10.1f KB\n", "CPU evaluate + palette copy", cpuMs, cpuUpload);
+    std::printf("  %-34s %9.3f ms   upload %10.1f KB\n", "GPU dispatch (submit + wait)", gpuMs, gpuUpload);
+    if (gpuDispatchMs > 0.0)
+        std::printf("  %-34s %9.3f ms\n", "GPU dispatch (timestamp queries)", gpuDispatchMs);
+    else
+        std::printf("  %-34s %9s\n", "GPU dispatch (timestamp queries)", "n/a");
+    std::printf("  speedup (wall): %.2fx\n", gpuMs > 0.0 ? cpuMs / gpuMs : 0.0);
+
+    const float tolerance = 1e-3f;
+    const bool ok = nodeErr <= tolerance && jointErr <= tolerance;
+    std::printf("\nGPU vs CPU palettes: max element difference nodes %.2e, joints %.2e (%s)\n",
+                nodeErr, jointErr, ok ? "ok" : "MISMATCH");
+    return ok ? 0 : 1;
+}
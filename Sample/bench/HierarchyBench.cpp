@@ -0,0 +1,251 @@
+/*
+  HierarchyBench
+  --------------
+  Purpose:
+    - Standalone benchmark for the node hierarchy pass of pose evaluation (locals -> globals)
+      on the Knight-like synthetic model (64 nodes), --evals evaluations (default 10k, one per
+      unit per frame), no window / Vulkan device needed.
+    - Recursive: the previous implementation, a std::function DFS over the child lists with
+      a visited array, kept here as the reference.
+    - Linear: one pass over ModelAsset::nodeOrder / nodeOrderParents (parent-first), with
+      glm's 4x4 product, the scalar affine product and the SIMD affine kernel (AffineKernel).
+    - Also times the full ModelAsset::evaluatePoseInto (keyframe sampling + TRS compose +
+      hierarchy) and checks every linear variant against the recursive globals.
+
+  Usage:
+    HierarchyBench [--evals N] [--nodes K] [--sets S] [--seed S]
+*/
+
+#include "assets/AffineKernel.h"
+#include "bench/SyntheticModel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double msSince(Clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    struct Config
+    {
+        uint32_t evals = 10000;
+        uint32_t nodes = 64;
+        uint32_t sets = 256; // distinct local poses cycled through (keeps inputs out of L1)
+        uint32_t seed = 1234;
+    };
+
+    // Previous ModelAsset::evaluatePoseInto hierarchy pass.
+    void globalsRecursive(const Engine::ModelAsset &model, const glm::mat4 *locals, std::vector<glm::mat4> &globals,
+                          std::vector<uint8_t> &visited)
+    {
+        const uint32_t nodeCount = static_cast<uint32_t>(model.nodes.size());
+        const uint32_t U32_MAX = ~0u;
+        globals.assign(nodeCount, glm::mat4(1.0f));
+        visited.assign(nodeCount, 0);
+
+        std::function<void(uint32_t, const glm::mat4 &)> compute = [&](uint32_t nodeIdx, const glm::mat4 &parentGlobal)
+        {
+            if (nodeIdx >= nodeCount || visited[nodeIdx])
+                return;
+            visited[nodeIdx] = 1;
+            globals[nodeIdx] = parentGlobal * locals[nodeIdx];
+
+            const Engine::ModelAsset::ModelNode &n = model.nodes[nodeIdx];
+            if (n.childCount == 0 || n.firstChildIndex == U32_MAX)
+                return;
+            for (uint32_t ci = 0; ci < n.childCount; ++ci)
+                compute(model.nodeChildIndices[n.firstChildIndex + ci], globals[nodeIdx]);
+        };
+
+        for (uint32_t i = 0; i < nodeCount; ++i)
+        {
+            if (model.nodes[i].parentIndex == U32_MAX)
+                compute(i, glm::mat4(1.0f));
+        }
+    }
+
+    enum class Product
+    {
+        Glm,
+        AffineScalar,
+        AffineSimd
+    };
+
+    template <Product P>
+    void globalsLinear(const Engine::ModelAsset &model, const glm::mat4 *locals, std::vector<glm::mat4> &globals)
+    {
+        const uint32_t *order = model.nodeOrder.data();
+        const uint32_t *parents = model.nodeOrderParents.data();
+        const size_t count = model.nodeOrder.size();
+        globals.resize(model.nodes.size());
+        glm::mat4 *out = globals.data();
+        for (size_t k = 0; k < count; ++k)
+        {
+            const uint32_t n = order[k];
+            const uint32_t p = parents[k];
+            if (p == ~0u)
+                out[n] = locals[n];
+            else if (P == Product::Glm)
+                out[n] = out[p] * locals[n];
+            else if (P == Product::AffineScalar)
+                Engine::AffineKernel::MulAffineScalar(out[p], locals[n], out[n]);
+            else
+                Engine::AffineKernel::MulAffine(out[p], locals[n], out[n]);
+        }
+    }
+
+    struct RunResult
+    {
+        double ms = 0.0;
+        float checksum = 0.0f;
+    };
+
+    template <typename Fn>
+    RunResult time(const Config &cfg, uint32_t nodeCount, std::vector<glm::mat4> &globals, Fn &&fn)
+    {
+        RunResult r;
+        const auto t0 = Clock::now();
+        for (uint32_t e = 0; e < cfg.evals; ++e)
+        {
+            fn(e % cfg.sets);
+            r.checksum += globals[(e * 7u) % nodeCount][3][0];
+        }
+        r.ms = msSince(t0);
+        return r;
+    }
+
+    void report(const char *label, const Config &cfg, const RunResult &r, double baseline)
+    {
+        std::printf("  %-24s %8.3f ms  %7.0f ns/eval  %5.2fx\n", label, r.ms,
+                    r.ms * 1e6 / static_cast<double>(std::max(cfg.evals, 1u)), r.ms > 0.0 ? baseline / r.ms : 0.0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Config cfg;
+    for (int i = 1; i < argc; ++i)
+    {
+        auto next = [&](uint32_t &out)
+        { out = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i]))); };
+        if (std::strcmp(argv[i], "--evals") == 0 && i + 1 < argc)
+            next(cfg.evals);
+        else if (std::strcmp(argv[i], "--nodes") == 0 && i + 1 < argc)
+            next(cfg.nodes);
+        else if (std::strcmp(argv[i], "--sets") == 0 && i + 1 < argc)
+            next(cfg.sets);
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            cfg.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            std::printf("Usage: HierarchyBench [--evals N] [--nodes K] [--sets S] [--seed S]\n");
+            return 1;
+        }
+    }
+    cfg.sets = std::max(cfg.sets, 1u);
+
+    Bench::SyntheticModelDesc desc;
+    desc.nodes = cfg.nodes;
+    desc.clips = 16;
+    Engine::ModelAsset model;
+    Bench::BuildSyntheticModel(desc, model);
+    model.buildNodeOrder();
+    const uint32_t nodeCount = static_cast<uint32_t>(model.nodes.size());
+
+    // Local poses sampled from the clips at random times.
+    std::mt19937 rng(cfg.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<glm::mat4> locals(size_t(cfg.sets) * nodeCount);
+    {
+        std::vector<Engine::ModelAsset::NodeTRS> trs;
+        std::vector<glm::mat4> setLocals;
+        std::vector<glm::mat4> globals;
+        for (uint32_t s = 0; s < cfg.sets; ++s)
+        {
+            const uint32_t clip = static_cast<uint32_t>(unit(rng) * static_cast<float>(model.animClips.size())) % model.animClips.size();
+            model.evaluatePoseInto(clip, unit(rng) * model.animClips[clip].durationSec, trs, setLocals, globals);
+            std::copy(setLocals.begin(), setLocals.end(), locals.begin() + size_t(s) * nodeCount);
+        }
+    }
+    auto localsOf = [&](uint32_t set)
+    { return locals.data() + size_t(set) * nodeCount; };
+
+    std::printf("HierarchyBench: %u evaluations of a %u-node hierarchy (%zu local sets), affine kernel: %s\n\n",
+                cfg.evals, nodeCount, static_cast<size_t>(cfg.sets), Engine::AffineKernel::kIsaName);
+
+    std::vector<glm::mat4> globals;
+    std::vector<uint8_t> visited;
+    // Warm-up (allocations, caches).
+    for (uint32_t s = 0; s < cfg.sets; ++s)
+        globalsRecursive(model, localsOf(s), globals, visited);
+
+    const RunResult recursive = time(cfg, nodeCount, globals, [&](uint32_t s)
+                                     { globalsRecursive(model, localsOf(s), globals, visited); });
+    const RunResult linearGlm = time(cfg, nodeCount, globals, [&](uint32_t s)
+                                     { globalsLinear<Product::Glm>(model, localsOf(s), globals); });
+    const RunResult linearScalar = time(cfg, nodeCount, globals, [&](uint32_t s)
+                                        { globalsLinear<Product::AffineScalar>(model, localsOf(s), globals); });
+    const RunResult linearSimd = time(cfg, nodeCount, globals, [&](uint32_t s)
+                                      { globalsLinear<Product::AffineSimd>(model, localsOf(s), globals); });
+
+    // Full evaluation (sampling + compose + hierarchy) through ModelAsset.
+    std::vector<Engine::ModelAsset::NodeTRS> trs;
+    std::vector<glm::mat4> evalLocals;
+    const RunResult full = time(cfg, nodeCount, globals, [&](uint32_t s)
+                                {
+        const uint32_t clip = s % static_cast<uint32_t>(model.animClips.size());
+        const float t = model.animClips[clip].durationSec * static_cast<float>(s) / static_cast<float>(cfg.sets);
+        model.evaluatePoseInto(clip, t, trs, evalLocals, globals); });
+
+    std::printf("Hierarchy pass (locals -> globals):\n");
+    report("recursive (previous)", cfg, recursive, recursive.ms);
+    report("linear, glm mat4 *", cfg, linearGlm, recursive.ms);
+    report("linear, affine scalar", cfg, linearScalar, recursive.ms);
+    report("linear, affine SIMD", cfg, linearSimd, recursive.ms);
+    std::printf("\nFull evaluatePoseInto (sample + compose + hierarchy):\n");
+    report("linear, affine SIMD", cfg, full, full.ms);
+
+    // Every linear variant against the recursive reference on every local set.
+    float maxErr = 0.0f;
+    std::vector<glm::mat4> reference;
+    std::vector<glm::mat4> candidate;
+    for (uint32_t s = 0; s < cfg.sets; ++s)
+    {
+        globalsRecursive(model, localsOf(s), reference, visited);
+        for (int variant = 0; variant < 3; ++variant)
+        {
+            if (variant == 0)
+                globalsLinear<Product::Glm>(model, localsOf(s), candidate);
+            else if (variant == 1)
+                globalsLinear<Product::AffineScalar>(model, localsOf(s), candidate);
+            else
+                globalsLinear<Product::AffineSimd>(model, localsOf(s), candidate);
+            for (uint32_t n = 0; n < nodeCount; ++n)
+            {
+                for (int c = 0; c < 4; ++c)
+                {
+                    for (int r = 0; r < 4; ++r)
+                        maxErr = std::max(maxErr, std::fabs(reference[n][c][r] - candidate[n][c][r]));
+                }
+            }
+        }
+    }
+    const bool ok = maxErr < 1e-4f;
+    std::printf("\nLinear vs recursive globals: max element difference %.2e (%s)\n", maxErr, ok ? "ok" : "MISMATCH");
+    std::printf("(checksums %.3f %.3f %.3f %.3f %.3f)\n", recursive.checksum, linearGlm.checksum, linearScalar.checksum,
+                linearSimd.checksum, full.checksum);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,538 @@
+/*
+  MovementBench
+  -------------
+  Purpose:
+    - Standalone benchmark for SteeringSystem + MovementSystem on a large crowd of movers
+      (default 100k units, each walking a 4-waypoint path across a 1 km field), no window /
+      Vulkan device needed.
+    - Kernel: MovementKernel::integrate / steer on pre-packed SoA streams, scalar reference vs
+      the compiled ISA (AVX2 / SSE2 / NEON): ns/entity and speedup.
+    - Frame: the systems on a real ECSContext vs the pre-kernel per-row implementation
+      (copied below as legacySteering / legacyMovement: AoS rows, per-row dirty marking),
+      ns/entity for each pass over --frames frames, then a comparison of the final state.
+
+  Tolerance:
+    - The target is built with -ffp-contract=off (Sample/CMakeLists.txt), so kernel and systems
+      match their references bitwise even under -mfma / -march=native (with contraction on,
+      the systems drift up to ~5e-5 from the legacy code over 60 frames). The bench fails
+      (exit code 1) if any position / velocity deviates by more than
+      kTolerance * (1 + |value|), or if a path index or active flag differs.
+
+  Usage:
+    MovementBench [--units N] [--frames F] [--iters K] [--seed S]
+*/
+
+#include "ECS/ECSContext.h"
+#include "systems/MovementKernel.h"
+#include "systems/MovementSystem.h"
+#include "systems/SteeringSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Engine::ECS;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float kTolerance = 1e-5f; // relative, see header
+    constexpr float kFieldSize = 1000.0f;
+    constexpr uint32_t kWaypoints = 4;
+    constexpr float kFrameDt = 1.0f / 60.0f;
+
+    double nsSince(Clock::time_point t0)
+    {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+    }
+
+    struct World
+    {
+        ECSContext ecs;
+        uint32_t archetypeId = 0;
+        ArchetypeStore *store = nullptr;
+    };
+
+    // Same seed -> identical worlds, so legacy and kernel paths start from the same state.
+    void populate(World &w, uint32_t units, uint32_t seed)
+    {
+        w.ecs.WireQueryManager();
+
+        ComponentMask sig;
+        for (const char *name : {"Position", "Velocity", "MoveTarget", "MoveSpeed", "Path", "Facing"})
+            sig.set(w.ecs.components.ensureId(name));
+        w.archetypeId = w.ecs.archetypes.getOrCreate(sig);
+        w.store = w.ecs.stores.getOrCreate(w.archetypeId, sig, w.ecs.components);
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> field(0.0f, kFieldSize);
+        std::uniform_real_distribution<float> leg(-25.0f, 25.0f);
+        std::uniform_real_distribution<float> speed(2.5f, 5.0f);
+
+        ArchetypeStore &st = *w.store;
+        for (uint32_t i = 0; i < units; ++i)
+        {
+            const Entity e = w.ecs.entities.create();
+            const uint32_t r = st.createRow(e);
+            w.ecs.entities.attach(e, w.archetypeId, r);
+
+            const float x = field(rng);
+            const float z = field(rng);
+            st.positions()[r] = {x, 0.0f, z};
+            st.moveSpeeds()[r].value = speed(rng);
+
+            auto &path = st.paths()[r];
+            path.handle = w.ecs.pathPool.allocate(kWaypoints);
+            path.count = kWaypoints;
+            path.current = 0;
+            path.valid = true;
+            float *wp = w.ecs.pathPool.data(path.handle);
+            float wx = x, wz = z;
+            for (uint32_t k = 0; k < kWaypoints; ++k)
+            {
+                wx += leg(rng);
+                wz += leg(rng);
+                wp[2 * k + 0] = wx;
+                wp[2 * k + 1] = wz;
+            }
+
+            auto &tgt = st.moveTargets()[r];
+            tgt.x = wx + leg(rng);
+            tgt.z = wz + leg(rng);
+            tgt.active = 1;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------
+    // Pre-kernel implementation (one row at a time, markDirty per row).
+    // ---------------------------------------------------------------------------------
+
+    struct LegacyIds
+    {
+        QueryId steerQuery = QueryManager::InvalidQuery;
+        QueryId moveQuery = QueryManager::InvalidQuery;
+        uint32_t position = 0, velocity = 0, moveTarget = 0, facing = 0;
+    };
+
+    void legacySteering(ECSContext &ecs, const LegacyIds &ids, float dt)
+    {
+        const float arrivalRadius2 = 0.25f;
+        const float waypointRadius2 = 0.0625f;
+        const auto &q = ecs.queries.get(ids.steerQuery);
+        for (uint32_t archetypeId : q.matchingArchetypeIds)
+        {
+            ArchetypeStore &store = *ecs.stores.get(archetypeId);
+            auto dirtyRows = ecs.queries.consumeDirtyRows(ids.steerQuery, archetypeId);
+            const uint32_t n = store.size();
+            for (uint32_t i : dirtyRows)
+            {
+                if (i >= n)
+                    continue;
+                auto &pos = store.positions()[i];
+                auto &vel = store.velocities()[i];
+                auto &tgt = store.moveTargets()[i];
+                const auto &spd = store.moveSpeeds()[i];
+                auto &path = store.paths()[i];
+                auto &facing = store.facings()[i];
+
+                if (!tgt.active)
+                {
+                    vel.x = vel.y = vel.z = 0.0f;
+                    continue;
+                }
+
+                float tx = tgt.x;
+                float tz = tgt.z;
+                bool isFinal = true;
+                if (path.valid && path.current < path.count)
+                {
+                    const float *wp = ecs.pathPool.data(path.handle);
+                    tx = wp[2 * path.current + 0];
+                    tz = wp[2 * path.current + 1];
+                    isFinal = false;
+                }
+
+                float dx = tx - pos.x;
+                float dz = tz - pos.z;
+                float d2 = dx * dx + dz * dz;
+                float radiusToCheck2 = isFinal ? arrivalRadius2 : waypointRadius2;
+                const float stepLen = spd.value * dt;
+                radiusToCheck2 = std::max(radiusToCheck2, stepLen * stepLen);
+
+                if (d2 <= radiusToCheck2)
+                {
+                    if (isFinal)
+                    {
+                        vel.x = vel.y = vel.z = 0.0f;
+                        tgt.active = 0;
+                        path.valid = false;
+                        ecs.markDirty(ids.velocity, archetypeId, i);
+                        ecs.markDirty(ids.moveTarget, archetypeId, i);
+                        continue;
+                    }
+                    path.current++;
+                    if (path.current < path.count)
+                    {
+                        const float *wp = ecs.pathPool.data(path.handle);
+                        tx = wp[2 * path.current + 0];
+                        tz = wp[2 * path.current + 1];
+                    }
+                    else
+                    {
+                        path.valid = false;
+                        tx = tgt.x;
+                        tz = tgt.z;
+                    }
+                    dx = tx - pos.x;
+                    dz = tz - pos.z;
+                    d2 = dx * dx + dz * dz;
+                }
+
+                if (d2 > 1e-8f)
+                {
+                    const float invDist = 1.0f / std::sqrt(d2);
+                    dx *= invDist;
+                    dz *= invDist;
+                    const float targetVx = dx * spd.value;
+                    const float targetVz = dz * spd.value;
+                    const float blend = std::min(1.0f, 15.0f * dt);
+                    vel.x += (targetVx - vel.x) * blend;
+                    vel.z += (targetVz - vel.z) * blend;
+                    vel.y = 0.0f;
+                    if (std::abs(vel.x) > 0.1f || std::abs(vel.z) > 0.1f)
+                    {
+                        facing.yaw = std::atan2(vel.x, vel.z);
+                        ecs.markDirty(ids.facing, archetypeId, i);
+                    }
+                }
+                ecs.markDirty(ids.velocity, archetypeId, i);
+                ecs.markDirty(ids.moveTarget, archetypeId, i);
+            }
+        }
+    }
+
+    void legacyMovement(ECSContext &ecs, const LegacyIds &ids, float dt)
+    {
+        const auto &q = ecs.queries.get(ids.moveQuery);
+        for (uint32_t archetypeId : q.matchingArchetypeIds)
+        {
+            ArchetypeStore &store = *ecs.stores.get(archetypeId);
+            auto dirtyRows = ecs.queries.consumeDirtyRows(ids.moveQuery, archetypeId);
+            const uint32_t n = store.size();
+            auto &positions = store.positions();
+            const auto &velocities = store.velocities();
+            for (uint32_t i : dirtyRows)
+            {
+                if (i >= n)
+                    continue;
+                const float velMag1 = std::fabs(velocities[i].x) + std::fabs(velocities[i].y) + std::fabs(velocities[i].z);
+                if (velMag1 <= 1e-6f)
+                    continue;
+                positions[i].x += velocities[i].x * dt;
+                positions[i].y += velocities[i].y * dt;
+                positions[i].z += velocities[i].z * dt;
+                ecs.markDirty(ids.position, archetypeId, i);
+                ecs.markDirty(ids.velocity, archetypeId, i);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------
+    // Comparison helpers
+    // ---------------------------------------------------------------------------------
+
+    struct Deviation
+    {
+        float maxRel = 0.0f;
+        uint32_t bitwiseEqual = 0;
+        uint32_t stateMismatches = 0; // path index / active flag
+    };
+
+    void accumulate(Deviation &d, float a, float b, bool &equal)
+    {
+        if (std::memcmp(&a, &b, sizeof(float)) != 0)
+            equal = false;
+        d.maxRel = std::max(d.maxRel, std::fabs(a - b) / (1.0f + std::fabs(b)));
+    }
+
+    Deviation compareWorlds(const World &a, const World &b)
+    {
+        Deviation d;
+        const ArchetypeStore &sa = *a.store;
+        const ArchetypeStore &sb = *b.store;
+        for (uint32_t r = 0; r < sa.size(); ++r)
+        {
+            bool equal = true;
+            const auto &pa = sa.positions()[r], &pb = sb.positions()[r];
+            const auto &va = sa.velocities()[r], &vb = sb.velocities()[r];
+            accumulate(d, pa.x, pb.x, equal);
+            accumulate(d, pa.y, pb.y, equal);
+            accumulate(d, pa.z, pb.z, equal);
+            accumulate(d, va.x, vb.x, equal);
+            accumulate(d, va.z, vb.z, equal);
+            accumulate(d, sa.facings()[r].yaw, sb.facings()[r].yaw, equal);
+            if (sa.paths()[r].current != sb.paths()[r].current ||
+                sa.moveTargets()[r].active != sb.moveTargets()[r].active)
+            {
+                ++d.stateMismatches;
+                equal = false;
+            }
+            d.bitwiseEqual += equal ? 1u : 0u;
+        }
+        return d;
+    }
+
+    Deviation compareStreams(const std::vector<const std::vector<float> *> &a,
+                             const std::vector<const std::vector<float> *> &b,
+                             const std::vector<uint8_t> &maskA, const std::vector<uint8_t> &maskB, uint32_t count)
+    {
+        Deviation d;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            bool equal = maskA[i] == maskB[i];
+            if (!equal)
+                ++d.stateMismatches;
+            for (size_t f = 0; f < a.size(); ++f)
+                accumulate(d, (*a[f])[i], (*b[f])[i], equal);
+            d.bitwiseEqual += equal ? 1u : 0u;
+        }
+        return d;
+    }
+
+    // ---------------------------------------------------------------------------------
+    // Kernel-only timing on pre-packed streams
+    // ---------------------------------------------------------------------------------
+
+    struct KernelResult
+    {
+        double scalarNs = 0.0;
+        double simdNs = 0.0;
+        Deviation dev;
+    };
+
+    KernelResult benchIntegrate(const ArchetypeStore &st, int iters)
+    {
+        MovementKernel::IntegrateStreams base;
+        for (uint32_t r = 0; r < st.size(); ++r)
+        {
+            const auto &p = st.positions()[r];
+            const auto &v = st.velocities()[r];
+            base.push(p.x, p.y, p.z, v.x, v.y, v.z);
+        }
+        const uint32_t count = base.count;
+
+        KernelResult res{1e30, 1e30, {}};
+        MovementKernel::IntegrateStreams scalar = base, simd = base;
+        for (int it = 0; it < iters; ++it)
+        {
+            scalar = base;
+            auto t0 = Clock::now();
+            MovementKernel::integrateScalar(scalar, kFrameDt);
+            res.scalarNs = std::min(res.scalarNs, nsSince(t0) / count);
+
+            simd = base;
+            t0 = Clock::now();
+            MovementKernel::integrate(simd, kFrameDt);
+            res.simdNs = std::min(res.simdNs, nsSince(t0) / count);
+        }
+        res.dev = compareStreams({&simd.px, &simd.py, &simd.pz},
+                                                                   {&scalar.px, &scalar.py, &scalar.pz},
+                                                                   simd.moving, scalar.moving, count);
+        return res;
+    }
+
+    KernelResult benchSteer(const ECSContext &ecs, const ArchetypeStore &st, int iters)
+    {
+        MovementKernel::SteerStreams base;
+        for (uint32_t r = 0; r < st.size(); ++r)
+        {
+            const auto &p = st.positions()[r];
+            const auto &v = st.velocities()[r];
+            const auto &path = st.paths()[r];
+            const auto &tgt = st.moveTargets()[r];
+            float tx = tgt.x, tz = tgt.z;
+            if (path.valid && path.current < path.count)
+            {
+                const float *wp = ecs.pathPool.data(path.handle);
+                tx = wp[2 * path.current + 0];
+                tz = wp[2 * path.current + 1];
+            }
+            const float step = st.moveSpeeds()[r].value * kFrameDt;
+            base.push(p.x, p.z, v.x, v.z, tx, tz, st.moveSpeeds()[r].value, std::max(0.0625f, step * step),
+                      std::min(1.0f, 15.0f * kFrameDt));
+        }
+        const uint32_t count = base.count;
+
+        KernelResult res{1e30, 1e30, {}};
+        MovementKernel::SteerStreams scalar = base, simd = base;
+        for (int it = 0; it < iters; ++it)
+        {
+            scalar = base;
+            auto t0 = Clock::now();
+            MovementKernel::steerScalar(scalar);
+            res.scalarNs = std::min(res.scalarNs, nsSince(t0) / count);
+
+            simd = base;
+            t0 = Clock::now();
+            MovementKernel::steer(simd);
+            res.simdNs = std::min(res.simdNs, nsSince(t0) / count);
+        }
+        res.dev = compareStreams({&simd.vx, &simd.vz}, {&scalar.vx, &scalar.vz},
+                                                               simd.arrived, scalar.arrived, count);
+        return res;
+    }
+
+    // ---------------------------------------------------------------------------------
+    // Frame timing (systems on ECSContext)
+    // ---------------------------------------------------------------------------------
+
+    struct FrameResult
+    {
+        double steerNs = 0.0; // per entity per frame
+        double moveNs = 0.0;
+        uint32_t arrived = 0;
+    };
+
+    template <typename SteerFn, typename MoveFn>
+    FrameResult runFrames(World &w, uint32_t frames, SteerFn &&steer, MoveFn &&move)
+    {
+        FrameResult res;
+        double steerNs = 0.0, moveNs = 0.0;
+        for (uint32_t f = 0; f < frames; ++f)
+        {
+            auto t0 = Clock::now();
+            steer();
+            steerNs += nsSince(t0);
+            t0 = Clock::now();
+            move();
+            moveNs += nsSince(t0);
+        }
+        const double rows = static_cast<double>(w.store->size()) * frames;
+        res.steerNs = steerNs / rows;
+        res.moveNs = moveNs / rows;
+        for (uint32_t r = 0; r < w.store->size(); ++r)
+            res.arrived += w.store->moveTargets()[r].active ? 0u : 1u;
+        return res;
+    }
+
+    bool report(const char *what, const Deviation &d, uint32_t count)
+    {
+        const bool ok = d.maxRel <= kTolerance && d.stateMismatches == 0;
+        std::printf("  %-22s max rel %.3g, bitwise %.1f%%, state mismatches %u -> %s\n", what, d.maxRel,
+                    100.0 * static_cast<double>(d.bitwiseEqual) / static_cast<double>(std::max(1u, count)),
+                    d.stateMismatches, ok ? "ok" : "FAIL");
+        return ok;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t units = 100000;
+    uint32_t frames = 120;
+    int iters = 20;
+    uint32_t seed = 1234;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--units") == 0 && i + 1 < argc)
+            units = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            frames = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc)
+            iters = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            std::printf("Usage: MovementBench [--units N] [--frames F] [--iters K] [--seed S]\n");
+            return 1;
+        }
+    }
+
+    std::printf("MovementBench: %u movers, %u waypoints each, %u frames, best of %d, kernel %s (%u lanes)\n\n",
+                units, kWaypoints, frames, iters, MovementKernel::kIsaName, MovementKernel::kLanes);
+
+    // Legacy world: pre-kernel per-row code.
+    World legacy;
+    populate(legacy, units, seed);
+    LegacyIds ids;
+    ids.position = legacy.ecs.components.ensureId("Position");
+    ids.velocity = legacy.ecs.components.ensureId("Velocity");
+    ids.moveTarget = legacy.ecs.components.ensureId("MoveTarget");
+    ids.facing = legacy.ecs.components.ensureId("Facing");
+    {
+        ComponentMask steerRequired, moveRequired, excluded, steerDirty, moveDirty;
+        for (const char *name : {"Position", "Velocity", "MoveTarget", "MoveSpeed", "Path", "Facing"})
+            steerRequired.set(legacy.ecs.components.ensureId(name));
+        for (const char *name : {"Disabled", "Dead", "Sleeping"})
+            excluded.set(legacy.ecs.components.ensureId(name));
+        moveRequired.set(ids.position);
+        moveRequired.set(ids.velocity);
+        steerDirty.set(ids.position);
+        steerDirty.set(ids.moveTarget);
+        moveDirty.set(ids.velocity);
+        ids.steerQuery = legacy.ecs.queries.createDirtyQuery(steerRequired, excluded, steerDirty, legacy.ecs.stores);
+        ids.moveQuery = legacy.ecs.queries.createDirtyQuery(moveRequired, excluded, moveDirty, legacy.ecs.stores);
+    }
+
+    // Kernel world: the shipping systems.
+    World kernel;
+    populate(kernel, units, seed);
+    SteeringSystem steering;
+    MovementSystem movement;
+    steering.buildMasks(kernel.ecs.components);
+    movement.buildMasks(kernel.ecs.components);
+
+    // Warm-up frame so every unit has a velocity for the kernel-only section.
+    legacySteering(legacy.ecs, ids, kFrameDt);
+    legacyMovement(legacy.ecs, ids, kFrameDt);
+    steering.update(kernel.ecs, kFrameDt);
+    movement.update(kernel.ecs, kFrameDt);
+
+    const KernelResult integ = benchIntegrate(*kernel.store, iters);
+    const KernelResult steer = benchSteer(kernel.ecs, *kernel.store, iters);
+    std::printf("kernel on packed streams (ns/entity):\n");
+    std::printf("  %-10s %10s %10s %9s\n", "kernel", "scalar", MovementKernel::kIsaName, "speedup");
+    std::printf("  %-10s %10.2f %10.2f %8.2fx\n", "integrate", integ.scalarNs, integ.simdNs, integ.scalarNs / integ.simdNs);
+    std::printf("  %-10s %10.2f %10.2f %8.2fx\n\n", "steer", steer.scalarNs, steer.simdNs, steer.scalarNs / steer.simdNs);
+
+    const FrameResult legacyRun = runFrames(legacy, frames, [&]
+                                            { legacySteering(legacy.ecs, ids, kFrameDt); },
+                                            [&]
+                                            { legacyMovement(legacy.ecs, ids, kFrameDt); });
+    const FrameResult kernelRun = runFrames(kernel, frames, [&]
+                                            { steering.update(kernel.ecs, kFrameDt); },
+                                            [&]
+                                            { movement.update(kernel.ecs, kFrameDt); });
+
+    std::printf("systems on ECSContext (ns/entity/frame, incl. gather/scatter and dirty marking):\n");
+    std::printf("  %-10s %10s %10s %10s %9s\n", "path", "steering", "movement", "total", "arrived");
+    auto row = [&](const char *name, const FrameResult &r)
+    {
+        std::printf("  %-10s %10.2f %10.2f %10.2f %9u\n", name, r.steerNs, r.moveNs, r.steerNs + r.moveNs, r.arrived);
+    };
+    row("legacy", legacyRun);
+    row("kernel", kernelRun);
+    const double legacyTotal = legacyRun.steerNs + legacyRun.moveNs;
+    const double kernelTotal = kernelRun.steerNs + kernelRun.moveNs;
+    std::printf("  speedup %.2fx (%.2f ms -> %.2f ms per frame for %u movers)\n\n", legacyTotal / kernelTotal,
+                legacyTotal * units * 1e-6, kernelTotal * units * 1e-6, units);
+
+    std::printf("checks:\n");
+    bool ok = true;
+    ok = report("integrate simd/scalar", integ.dev, units) && ok;
+    ok = report("steer simd/scalar", steer.dev, units) && ok;
+    ok = report("systems vs legacy", compareWorlds(kernel, legacy), units) && ok;
+    if (!ok)
+    {
+        std::printf("\nFAIL\n");
+        return 1;
+    }
+    return 0;
+}
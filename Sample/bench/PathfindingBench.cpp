@@ -0,0 +1,635 @@
+/*
+  PathfindingBench
+  ----------------
+  Purpose:
+    - Standalone benchmark for NavGrid + PathfindingSystem, no window / Vulkan device needed.
+    - Builds NavGrids of several sizes and obstacle layouts (random stumps at various
+      densities, a braided maze, zig-zag corridors and the sample's BattleConfig walls),
+      issues a reproducible batch of start/goal requests and reports per search mode:
+        paths/sec, success rate, nodes expanded, path length ratio, p50/p99 latency.
+
+  Requests:
+    - Generated in squads (kSquadSize starts clustered around one point, one shared goal),
+      which is how the sample issues move orders, so the cached mode has something to reuse.
+    - Every start/goal pair is reachable for the largest size class benchmarked.
+    - Length ratio = smoothed path length / optimal 8-connected grid path at the same
+      clearance (reverse Dijkstra from each goal). Any-angle smoothing can dip below 1.0;
+      weighted A* (ε=1.2) pushes it above.
+
+  Usage:
+    PathfindingBench [--requests N] [--seed S] [--config path/to/BattleConfig.json]
+*/
+
+#include "ECS/Components.h"
+#include "ECS/PathPool.h"
+#include "systems/NavGrid.h"
+#include "systems/PathfindingSystem.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef STRATO_SAMPLE_DIR
+#define STRATO_SAMPLE_DIR "Sample"
+#endif
+
+namespace
+{
+    constexpr float kCellSize = 2.0f;    // same as SystemRunner's NavGrid
+    constexpr float kUnitRadius = 0.5f;  // CombatKnight Radius
+    constexpr int kSquadSize = 8;
+    constexpr int kSquadSpreadCells = 3; // squad-mates start within +/- this many cells
+    constexpr float kStumpRadius = 1.5f; // TreeStumpWall ObstacleRadius
+
+    // ------------------------------------------------------------
+    // Maps
+    // ------------------------------------------------------------
+    struct BenchMap
+    {
+        std::string name;
+        NavGrid grid;
+        NavGrid::CellRect requestArea; // where starts/goals are drawn from
+    };
+
+    void initGrid(BenchMap &map, float worldSize)
+    {
+        const float half = worldSize * 0.5f;
+        map.grid.rebuild(kCellSize, -half, -half, half, half);
+        map.grid.clearAll();
+        map.requestArea = map.grid.fullRect();
+    }
+
+    // Same stamp as NavGridBuilderSystem.
+    void stampObstacle(NavGrid &grid, float x, float z, float r)
+    {
+        grid.markObstacle(x, z, grid.stampRadius(r));
+    }
+
+    void finalizeGrid(NavGrid &grid)
+    {
+        grid.updateClearance(grid.fullRect());
+        grid.dirtyRects.clear();
+        grid.dirty = false;
+        ++grid.version;
+    }
+
+    void blockCellRect(NavGrid &grid, int x0, int z0, int x1, int z1)
+    {
+        for (int z = std::max(z0, 0); z <= std::min(z1, grid.height - 1); ++z)
+            for (int x = std::max(x0, 0); x <= std::min(x1, grid.width - 1); ++x)
+                grid.setBlocked(x, z);
+    }
+
+    std::unique_ptr<BenchMap> makeRandomStumps(float worldSize, float density, uint32_t seed)
+    {
+        auto map = std::make_unique<BenchMap>();
+        char name[64];
+        std::snprintf(name, sizeof(name), "stumps %.0f%%", density * 100.0f);
+        map->name = name;
+        initGrid(*map, worldSize);
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(-worldSize * 0.5f, worldSize * 0.5f);
+        std::uniform_real_distribution<float> rad(0.75f, 2.5f);
+
+        // density = fraction of the world covered by stump footprints (overlaps ignored)
+        const float meanArea = 3.14159265f * 1.75f * 1.75f;
+        const int count = static_cast<int>(density * worldSize * worldSize / meanArea);
+        for (int i = 0; i < count; ++i)
+        {
+            const float x = pos(rng);
+            const float z = pos(rng);
+            stampObstacle(map->grid, x, z, rad(rng));
+        }
+
+        finalizeGrid(map->grid);
+        return map;
+    }
+
+    // Perfect maze (recursive backtracker) with ~10% of the remaining walls knocked out
+    // so there are alternative routes. Corridors are `corridor` cells wide, walls 1 cell.
+    std::unique_ptr<BenchMap> makeMaze(float worldSize, int corridor, uint32_t seed)
+    {
+        auto map = std::make_unique<BenchMap>();
+        map->name = "maze";
+        initGrid(*map, worldSize);
+        NavGrid &g = map->grid;
+
+        const int pitch = corridor + 1;
+        const int rw = (g.width - 1) / pitch;
+        const int rh = (g.height - 1) / pitch;
+
+        blockCellRect(g, 0, 0, g.width - 1, g.height - 1);
+        auto openRoom = [&](int rx, int rz)
+        {
+            const int x0 = 1 + rx * pitch, z0 = 1 + rz * pitch;
+            for (int z = z0; z < z0 + corridor; ++z)
+                for (int x = x0; x < x0 + corridor; ++x)
+                    g.clearRect({x, z, x, z});
+        };
+        auto openWall = [&](int rx, int rz, int dx, int dz)
+        {
+            // Wall slab between room (rx, rz) and (rx + dx, rz + dz)
+            const int x0 = 1 + rx * pitch, z0 = 1 + rz * pitch;
+            if (dx != 0)
+            {
+                const int wx = dx > 0 ? x0 + corridor : x0 - 1;
+                g.clearRect({wx, z0, wx, z0 + corridor - 1});
+            }
+            else
+            {
+                const int wz = dz > 0 ? z0 + corridor : z0 - 1;
+                g.clearRect({x0, wz, x0 + corridor - 1, wz});
+            }
+        };
+
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> visited(static_cast<size_t>(rw) * rh, 0);
+        std::vector<std::pair<int, int>> stack;
+        stack.push_back({0, 0});
+        visited[0] = 1;
+        openRoom(0, 0);
+
+        static constexpr int kDx[] = {1, -1, 0, 0};
+        static constexpr int kDz[] = {0, 0, 1, -1};
+        while (!stack.empty())
+        {
+            const auto [rx, rz] = stack.back();
+            int options[4];
+            int n = 0;
+            for (int d = 0; d < 4; ++d)
+            {
+                const int nx = rx + kDx[d], nz = rz + kDz[d];
+                if (nx >= 0 && nz >= 0 && nx < rw && nz < rh && !visited[nz * rw + nx])
+                    options[n++] = d;
+            }
+            if (n == 0)
+            {
+                stack.pop_back();
+                continue;
+            }
+            const int d = options[rng() % n];
+            const int nx = rx + kDx[d], nz = rz + kDz[d];
+            visited[nz * rw + nx] = 1;
+            openRoom(nx, nz);
+            openWall(rx, rz, kDx[d], kDz[d]);
+            stack.push_back({nx, nz});
+        }
+
+        std::uniform_int_distribution<int> pickX(0, rw - 2), pickZ(0, rh - 2);
+        const int braid = rw * rh / 10;
+        for (int i = 0; i < braid; ++i)
+        {
+            if (rng() & 1u)
+                openWall(pickX(rng), pickZ(rng), 1, 0);
+            else
+                openWall(pickX(rng), pickZ(rng), 0, 1);
+        }
+
+        finalizeGrid(g);
+        return map;
+    }
+
+    // Parallel walls across the whole map with one gap each, alternating ends,
+    // so every long trip zig-zags through all of them.
+    std::unique_ptr<BenchMap> makeCorridors(float worldSize, int spacingCells, int gapCells)
+    {
+        auto map = std::make_unique<BenchMap>();
+        map->name = "corridors";
+        initGrid(*map, worldSize);
+        NavGrid &g = map->grid;
+
+        bool gapHigh = true;
+        for (int x = spacingCells; x < g.width - 1; x += spacingCells)
+        {
+            if (gapHigh)
+                blockCellRect(g, x, 0, x, g.height - 1 - gapCells);
+            else
+                blockCellRect(g, x, gapCells, x, g.height - 1);
+            gapHigh = !gapHigh;
+        }
+
+        finalizeGrid(g);
+        return map;
+    }
+
+    // BattleConfig "obstacles" walls, stamped exactly like ScenarioSpawner places stumps.
+    std::unique_ptr<BenchMap> makeScenario(const std::string &configPath)
+    {
+        std::ifstream in(configPath);
+        if (!in)
+        {
+            std::printf("Scenario config not found: %s (skipping)\n", configPath.c_str());
+            return nullptr;
+        }
+
+        nlohmann::json cfg;
+        try
+        {
+            in >> cfg;
+        }
+        catch (const std::exception &e)
+        {
+            std::printf("Failed to parse %s: %s (skipping)\n", configPath.c_str(), e.what());
+            return nullptr;
+        }
+
+        auto map = std::make_unique<BenchMap>();
+        map->name = "BattleConfig";
+        initGrid(*map, 800.0f); // same extents as SystemRunner
+
+        float minX = 1e9f, minZ = 1e9f, maxX = -1e9f, maxZ = -1e9f;
+        if (cfg.contains("obstacles") && cfg["obstacles"].is_array())
+        {
+            for (const auto &obs : cfg["obstacles"])
+            {
+                float sx = 0.0f, sz = 0.0f, ex = 0.0f, ez = 0.0f;
+                if (obs.contains("start")) { sx = obs["start"].value("x", 0.0f); sz = obs["start"].value("z", 0.0f); }
+                if (obs.contains("end"))   { ex = obs["end"].value("x", 0.0f);   ez = obs["end"].value("z", 0.0f); }
+                const float spacing = std::max(obs.value("spacing", 2.0f), 0.1f);
+
+                struct Gap { float gx, gz, w; };
+                std::vector<Gap> gaps;
+                if (obs.contains("gaps") && obs["gaps"].is_array())
+                {
+                    for (const auto &gp : obs["gaps"])
+                    {
+                        Gap gap{0.0f, 0.0f, gp.value("width", 0.0f)};
+                        if (gp.contains("center")) { gap.gx = gp["center"].value("x", 0.0f); gap.gz = gp["center"].value("z", 0.0f); }
+                        gaps.push_back(gap);
+                    }
+                }
+
+                const float dx = ex - sx, dz = ez - sz;
+                const float len = std::sqrt(dx * dx + dz * dz);
+                const float ndx = (len > 1e-4f) ? dx / len : 0.0f;
+                const float ndz = (len > 1e-4f) ? dz / len : 0.0f;
+                const int count = static_cast<int>(std::floor(len / spacing));
+                for (int i = 0; i <= count; ++i)
+                {
+                    const float px = sx + ndx * spacing * static_cast<float>(i);
+                    const float pz = sz + ndz * spacing * static_cast<float>(i);
+
+                    bool inGap = false;
+                    for (const Gap &gp : gaps)
+                    {
+                        const float gdx = px - gp.gx, gdz = pz - gp.gz;
+                        if (gdx * gdx + gdz * gdz <= (gp.w * 0.5f) * (gp.w * 0.5f))
+                        {
+                            inGap = true;
+                            break;
+                        }
+                    }
+                    if (inGap)
+                        continue;
+
+                    stampObstacle(map->grid, px, pz, kStumpRadius);
+                    minX = std::min(minX, px); maxX = std::max(maxX, px);
+                    minZ = std::min(minZ, pz); maxZ = std::max(maxZ, pz);
+                }
+            }
+        }
+
+        finalizeGrid(map->grid);
+
+        // Draw requests around the walled battlefield (plus a margin), not the whole 800 m map.
+        if (minX <= maxX)
+        {
+            const float margin = 20.0f;
+            const NavGrid &g = map->grid;
+            map->requestArea = {std::max(g.worldToGridX(minX - margin), 0), std::max(g.worldToGridZ(minZ - margin), 0),
+                                std::min(g.worldToGridX(maxX + margin), g.width - 1),
+                                std::min(g.worldToGridZ(maxZ + margin), g.height - 1)};
+        }
+        return map;
+    }
+
+    // ------------------------------------------------------------
+    // Reference distances: reverse Dijkstra from a goal, same move rules as
+    // PathfindingSystem (8-connected, no corner cutting, clearance >= minClear).
+    // ------------------------------------------------------------
+    void referenceDistances(const NavGrid &g, int goalIdx, uint8_t minClear, std::vector<float> &dist)
+    {
+        const int W = g.width;
+        dist.assign(static_cast<size_t>(g.width) * g.height, INFINITY);
+
+        using Entry = std::pair<float, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+        dist[goalIdx] = 0.0f;
+        open.push({0.0f, goalIdx});
+
+        static constexpr int dxs[] = {0, 0, -1, 1, -1, -1, 1, 1};
+        static constexpr int dzs[] = {-1, 1, 0, 0, -1, 1, -1, 1};
+        static constexpr float costs[] = {1.0f, 1.0f, 1.0f, 1.0f, 1.414f, 1.414f, 1.414f, 1.414f};
+
+        while (!open.empty())
+        {
+            const auto [d, idx] = open.top();
+            open.pop();
+            if (d > dist[idx])
+                continue;
+
+            const int cx = idx % W, cz = idx / W;
+            for (int i = 0; i < 8; ++i)
+            {
+                const int nx = cx + dxs[i], nz = cz + dzs[i];
+                if (!g.isClear(nx, nz, minClear))
+                    continue;
+                if (i >= 4 && (!g.isClear(cx + dxs[i], cz, minClear) || !g.isClear(cx, cz + dzs[i], minClear)))
+                    continue;
+                const float nd = d + costs[i];
+                const int nIdx = nz * W + nx;
+                if (nd < dist[nIdx])
+                {
+                    dist[nIdx] = nd;
+                    open.push({nd, nIdx});
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Requests
+    // ------------------------------------------------------------
+    struct Request
+    {
+        int startX, startZ;
+        int goalX, goalZ;
+        int squad; // index into squad goal list (for reference distances)
+    };
+
+    struct RequestBatch
+    {
+        std::vector<Request> requests;
+        std::vector<int> squadGoals; // goal cell index per squad
+    };
+
+    RequestBatch makeRequests(const BenchMap &map, int count, uint8_t minClear, uint32_t seed)
+    {
+        const NavGrid &g = map.grid;
+        const NavGrid::CellRect &a = map.requestArea;
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> px(a.minX, a.maxX), pz(a.minZ, a.maxZ);
+        std::uniform_int_distribution<int> spread(-kSquadSpreadCells, kSquadSpreadCells);
+
+        auto randomClearCell = [&](int &x, int &z)
+        {
+            for (int tries = 0; tries < 10000; ++tries)
+            {
+                x = px(rng);
+                z = pz(rng);
+                if (g.isClear(x, z, minClear))
+                    return true;
+            }
+            return false;
+        };
+
+        RequestBatch batch;
+        std::vector<float> dist;
+        int attempts = 0;
+        while (static_cast<int>(batch.requests.size()) < count && attempts++ < count * 4)
+        {
+            int gx = 0, gz = 0, cx = 0, cz = 0;
+            if (!randomClearCell(gx, gz) || !randomClearCell(cx, cz))
+                break;
+
+            referenceDistances(g, gz * g.width + gx, minClear, dist);
+            if (!std::isfinite(dist[cz * g.width + cx]))
+                continue; // squad centre can't reach the goal; pick another pair
+
+            const int squad = static_cast<int>(batch.squadGoals.size());
+            batch.squadGoals.push_back(gz * g.width + gx);
+            for (int m = 0; m < kSquadSize && static_cast<int>(batch.requests.size()) < count; ++m)
+            {
+                int sx = cx, sz = cz;
+                if (m > 0)
+                {
+                    sx = std::clamp(cx + spread(rng), 0, g.width - 1);
+                    sz = std::clamp(cz + spread(rng), 0, g.height - 1);
+                    if (!std::isfinite(dist[sz * g.width + sx]))
+                        continue;
+                }
+                batch.requests.push_back({sx, sz, gx, gz, squad});
+            }
+        }
+        return batch;
+    }
+
+    // ------------------------------------------------------------
+    // Search modes
+    // ------------------------------------------------------------
+    struct Mode
+    {
+        const char *name;
+        float agentRadius;
+        bool cache;
+    };
+
+    constexpr Mode kModes[] = {
+        {"A* walkable", 0.0f, false},
+        {"A* clearance", kUnitRadius, false},
+        {"A* clearance+cache", kUnitRadius, true},
+    };
+
+    struct ModeResult
+    {
+        int requests = 0;
+        int found = 0;
+        double totalSec = 0.0;
+        uint64_t expansions = 0;
+        double ratioSum = 0.0;
+        int ratioCount = 0;
+        double p50Us = 0.0;
+        double p99Us = 0.0;
+        uint64_t cacheHits = 0;
+    };
+
+    double percentile(std::vector<double> &sorted, double p)
+    {
+        if (sorted.empty())
+            return 0.0;
+        const size_t i = std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())));
+        return sorted[i];
+    }
+
+    ModeResult runMode(const BenchMap &map, const RequestBatch &batch, const Mode &mode)
+    {
+        using Clock = std::chrono::steady_clock;
+        const NavGrid &g = map.grid;
+
+        PathfindingSystem pathfinding(&g);
+        pathfinding.setCacheEnabled(mode.cache);
+        const uint8_t minClear = pathfinding.clearanceFor(mode.agentRadius);
+
+        // Reference distances per squad goal at this mode's clearance.
+        std::vector<std::vector<float>> reference(batch.squadGoals.size());
+        for (size_t s = 0; s < batch.squadGoals.size(); ++s)
+            referenceDistances(g, batch.squadGoals[s], minClear, reference[s]);
+
+        // Paths stay alive for the whole run like units holding them; pool is dropped at the end.
+        Engine::ECS::PathPool pool;
+        std::vector<Engine::ECS::Path> paths(batch.requests.size());
+        std::vector<double> latencies;
+        latencies.reserve(batch.requests.size());
+
+        ModeResult result;
+        const uint64_t expansionsBefore = pathfinding.stats().expansions;
+        const uint64_t hitsBefore = pathfinding.stats().cacheHits;
+
+        for (size_t r = 0; r < batch.requests.size(); ++r)
+        {
+            const Request &req = batch.requests[r];
+            Engine::ECS::Position pos;
+            pos.x = g.gridToWorldX(req.startX);
+            pos.z = g.gridToWorldZ(req.startZ);
+            Engine::ECS::MoveTarget tgt;
+            tgt.x = g.gridToWorldX(req.goalX);
+            tgt.z = g.gridToWorldZ(req.goalZ);
+            tgt.active = 1;
+
+            Engine::ECS::Path &path = paths[r];
+            const auto t0 = Clock::now();
+            pathfinding.planPath(pool, pos, tgt, path, mode.agentRadius);
+            const auto t1 = Clock::now();
+
+            const double sec = std::chrono::duration<double>(t1 - t0).count();
+            result.totalSec += sec;
+            latencies.push_back(sec * 1e6);
+            ++result.requests;
+
+            if (!path.valid)
+                continue;
+
+            // Walk the route (count == 0 means straight line to the target). Node-capped
+            // searches return a partial route that still ends at the target, so a route
+            // only counts as found if every leg is walkable.
+            const float *wp = path.count ? pool.data(path.handle) : nullptr;
+            float len = 0.0f, px = pos.x, pz = pos.z;
+            bool walkable = true;
+            for (uint32_t i = 0; i <= path.count; ++i)
+            {
+                const float nx = (i < path.count) ? wp[2 * i] : tgt.x;
+                const float nz = (i < path.count) ? wp[2 * i + 1] : tgt.z;
+                walkable = walkable && g.lineCheckGrid(g.worldToGridX(px), g.worldToGridZ(pz),
+                                                       g.worldToGridX(nx), g.worldToGridZ(nz));
+                len += std::hypot(nx - px, nz - pz);
+                px = nx;
+                pz = nz;
+            }
+            if (!walkable)
+                continue;
+            ++result.found;
+
+            const float ref = reference[req.squad][req.startZ * g.width + req.startX];
+            if (!std::isfinite(ref) || ref <= 0.0f)
+                continue;
+            result.ratioSum += len / (ref * g.cellSize);
+            ++result.ratioCount;
+        }
+
+        result.expansions = pathfinding.stats().expansions - expansionsBefore;
+        result.cacheHits = pathfinding.stats().cacheHits - hitsBefore;
+        std::sort(latencies.begin(), latencies.end());
+        result.p50Us = percentile(latencies, 0.50);
+        result.p99Us = percentile(latencies, 0.99);
+        return result;
+    }
+
+    void printHeader()
+    {
+        std::printf("%-14s %9s  %-19s %10s %6s %9s %8s %9s %9s %7s\n",
+                    "map", "cells", "mode", "paths/s", "ok%", "nodes/req", "len", "p50 us", "p99 us", "hits%");
+    }
+
+    void printRow(const BenchMap &map, const Mode &mode, const ModeResult &r)
+    {
+        char cells[32];
+        std::snprintf(cells, sizeof(cells), "%dx%d", map.grid.width, map.grid.height);
+        const double n = std::max(r.requests, 1);
+        std::printf("%-14s %9s  %-19s %10.0f %6.1f %9.0f %8.3f %9.1f %9.1f %7.1f\n",
+                    map.name.c_str(), cells, mode.name,
+                    r.totalSec > 0.0 ? r.requests / r.totalSec : 0.0,
+                    100.0 * r.found / n,
+                    static_cast<double>(r.expansions) / n,
+                    r.ratioCount ? r.ratioSum / r.ratioCount : 0.0,
+                    r.p50Us, r.p99Us,
+                    100.0 * static_cast<double>(r.cacheHits) / n);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int requestCount = 512;
+    uint32_t seed = 1234;
+    std::string configPath = std::string(STRATO_SAMPLE_DIR) + "/BattleConfig.json";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--requests") == 0 && i + 1 < argc)
+            requestCount = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--config") == 0 && i + 1 < argc)
+            configPath = argv[++i];
+        else
+        {
+            std::printf("Usage: PathfindingBench [--requests N] [--seed S] [--config BattleConfig.json]\n");
+            return 1;
+        }
+    }
+
+    std::printf("PathfindingBench: %d requests per map (squads of %d), seed %u, cell %.1f m\n\n",
+                requestCount, kSquadSize, seed, kCellSize);
+
+    // Map builders are deferred so only one grid is alive at a time.
+    std::vector<std::function<std::unique_ptr<BenchMap>()>> builders = {
+        [&] { return makeRandomStumps(200.0f, 0.05f, seed); },
+        [&] { return makeRandomStumps(400.0f, 0.05f, seed); },
+        [&] { return makeRandomStumps(400.0f, 0.15f, seed); },
+        [&] { return makeRandomStumps(400.0f, 0.25f, seed); },
+        [&] { return makeRandomStumps(800.0f, 0.15f, seed); },
+        [&] { return makeMaze(400.0f, 4, seed); },
+        [&] { return makeCorridors(800.0f, 24, 8); },
+        [&] { return makeScenario(configPath); },
+    };
+
+    printHeader();
+    for (auto &build : builders)
+    {
+        std::unique_ptr<BenchMap> map = build();
+        if (!map)
+            continue;
+
+        // Requests must be reachable for the largest size class benchmarked.
+        uint8_t maxClear = 1;
+        const PathfindingSystem probe(&map->grid);
+        for (const Mode &mode : kModes)
+            maxClear = std::max(maxClear, probe.clearanceFor(mode.agentRadius));
+
+        const RequestBatch batch = makeRequests(*map, requestCount, maxClear, seed);
+        if (batch.requests.empty())
+        {
+            std::printf("%-14s  no reachable requests, skipped\n", map->name.c_str());
+            continue;
+        }
+
+        for (const Mode &mode : kModes)
+            printRow(*map, mode, runMode(*map, batch, mode));
+    }
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+/*
+  SyntheticModel
+  --------------
+  Purpose:
+    - Builds a CPU-only Engine::ModelAsset shaped like the cooked Knight (a skinned bone tree,
+      one skin, ~100 clips of densely keyed linear channels) for the animation benchmarks,
+      so they run without .smodel files or a Vulkan device.
+    - Deterministic for a given SyntheticModelDesc (seeded).
+*/
+
+#include "assets/ModelAsset.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Bench
+{
+    struct SyntheticModelDesc
+    {
+        uint32_t nodes = 64;        // scene root + armature + bones
+        uint32_t joints = 48;       // first `joints` bones are skin joints
+        uint32_t clips = 100;
+        float minDurationSec = 0.8f;
+        float maxDurationSec = 3.0f;
+        float keyHz = 30.0f;        // keys per second per channel (glTF exports are baked at 30 Hz)
+        bool fullTrs = false;       // key T, R and S on every bone like Blender's glTF export (the extra channels hold the rest value)
+        uint32_t seed = 7;
+    };
+
+    inline void BuildSyntheticModel(const SyntheticModelDesc &desc, Engine::ModelAsset &model)
+    {
+        using Engine::ModelAsset;
+        namespace smodel = Engine::smodel;
+
+        model = ModelAsset{};
+        const uint32_t nodeCount = std::max(desc.nodes, 3u);
+        const uint32_t boneCount = nodeCount - 2;
+        const uint32_t jointCount = std::min(desc.joints, boneCount);
+        std::mt19937 rng(desc.seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        // Hierarchy: 0 = scene root, 1 = armature, bones 2.. mostly chained with some branching.
+        std::vector<uint32_t> parent(nodeCount, ~0u);
+        parent[1] = 0;
+        for (uint32_t i = 2; i < nodeCount; ++i)
+            parent[i] = (i == 2 || unit(rng) < 0.6f) ? i - 1 : 1 + static_cast<uint32_t>(unit(rng) * static_cast<float>(i - 1));
+
+        std::vector<std::vector<uint32_t>> children(nodeCount);
+        for (uint32_t i = 1; i < nodeCount; ++i)
+            children[parent[i]].push_back(i);
+
+        model.nodes.resize(nodeCount);
+        model.restTRS.resize(nodeCount);
+        for (uint32_t i = 0; i < nodeCount; ++i)
+        {
+            ModelAsset::ModelNode &n = model.nodes[i];
+            n.parentIndex = parent[i];
+            n.childCount = static_cast<uint32_t>(children[i].size());
+            n.firstChildIndex = n.childCount ? static_cast<uint32_t>(model.nodeChildIndices.size()) : ~0u;
+            model.nodeChildIndices.insert(model.nodeChildIndices.end(), children[i].begin(), children[i].end());
+
+            ModelAsset::NodeTRS &rest = model.restTRS[i];
+            if (i >= 2)
+            {
+                rest.t = glm::vec3(0.0f, 0.1f + 0.1f * unit(rng), 0.02f * (unit(rng) - 0.5f));
+                rest.r = glm::normalize(glm::angleAxis(0.3f * (unit(rng) - 0.5f), glm::vec3(1.0f, 0.0f, 0.0f)));
+            }
+            n.localMatrix = ModelAsset::ComposeTRS(rest);
+        }
+        model.rootNodeIndex = 0;
+        model.animatedTRS = model.restTRS;
+        model.recomputeGlobals();
+
+        // One skinned primitive on the armature.
+        Engine::ModelPrimitive body;
+        body.skinIndex = 0;
+        model.primitives.push_back(body);
+        model.nodePrimitiveIndices.push_back(0);
+        model.nodes[1].firstPrimitiveIndex = 0;
+        model.nodes[1].primitiveCount = 1;
+
+        ModelAsset::ModelSkin skin;
+        skin.jointBase = 0;
+        skin.jointCount = jointCount;
+        for (uint32_t j = 0; j < jointCount; ++j)
+        {
+            skin.jointNodeIndices.push_back(2 + j);
+            skin.inverseBind.push_back(glm::inverse(model.nodes[2 + j].globalMatrix));
+        }
+        model.skins.push_back(std::move(skin));
+        model.totalJointCount = jointCount;
+
+        // Clips: every bone rotates, a quarter also translate, a few scale.
+        auto addSampler = [&](uint32_t keys, float duration, uint32_t components, auto &&valueAt)
+        {
+            smodel::SModelAnimationSamplerRecord s{};
+            s.firstTime = static_cast<uint32_t>(model.animTimes.size());
+            s.timeCount = keys;
+            s.firstValue = static_cast<uint32_t>(model.animValues.size());
+            s.valueCount = keys * components;
+            s.interpolation = static_cast<uint8_t>(smodel::SModelAnimInterpolation::Linear);
+            s.valueType = static_cast<uint8_t>(components == 4 ? smodel::SModelAnimValueType::Quat : smodel::SModelAnimValueType::Vec3);
+            for (uint32_t k = 0; k < keys; ++k)
+            {
+                const float t = duration * static_cast<float>(k) / static_cast<float>(keys - 1);
+                model.animTimes.push_back(t);
+                valueAt(t, model.animValues);
+            }
+            model.animSamplers.push_back(s);
+            return static_cast<uint16_t>(model.animSamplers.size() - 1);
+        };
+
+        for (uint32_t c = 0; c < desc.clips; ++c)
+        {
+            smodel::SModelAnimationClipRecord clip{};
+            clip.durationSec = desc.minDurationSec + (desc.maxDurationSec - desc.minDurationSec) * unit(rng);
+            clip.firstChannel = static_cast<uint32_t>(model.animChannels.size());
+            const uint32_t keys = std::max(2u, static_cast<uint32_t>(std::ceil(clip.durationSec * desc.keyHz)) + 1u);
+            const float omega = 6.2831853f / clip.durationSec;
+
+            for (uint32_t b = 2; b < nodeCount; ++b)
+            {
+                const ModelAsset::NodeTRS rest = model.restTRS[b];
+                const float amp = 0.2f + 0.6f * unit(rng);
+                const float phase = 6.2831853f * unit(rng);
+                const glm::vec3 axis = glm::normalize(glm::vec3(unit(rng) - 0.5f, unit(rng) - 0.5f, unit(rng) - 0.5f) + glm::vec3(0.0f, 0.0f, 1e-3f));
+
+                smodel::SModelAnimationChannelRecord rot{};
+                rot.targetNode = b;
+                rot.path = static_cast<uint16_t>(smodel::SModelAnimPath::Rotation);
+                rot.samplerIndex = addSampler(keys, clip.durationSec, 4, [&](float t, std::vector<float> &out)
+                                              {
+                    const glm::quat q = glm::normalize(rest.r * glm::angleAxis(amp * std::sin(omega * t + phase), axis));
+                    out.insert(out.end(), {q.x, q.y, q.z, q.w}); });
+                model.animChannels.push_back(rot);
+
+                const bool animatedT = (b & 3u) == 0;
+                const bool animatedS = (b % 16u) == 5u;
+                if (animatedT)
+                {
+                    smodel::SModelAnimationChannelRecord tr{};
+                    tr.targetNode = b;
+                    tr.path = static_cast<uint16_t>(smodel::SModelAnimPath::Translation);
+                    tr.samplerIndex = addSampler(keys, clip.durationSec, 3, [&](float t, std::vector<float> &out)
+                                                 {
+                        const glm::vec3 p = rest.t + glm::vec3(0.0f, 0.03f * std::sin(2.0f * omega * t + phase), 0.0f);
+                        out.insert(out.end(), {p.x, p.y, p.z}); });
+                    model.animChannels.push_back(tr);
+                }
+                if (animatedS)
+                {
+                    smodel::SModelAnimationChannelRecord sc{};
+                    sc.targetNode = b;
+                    sc.path = static_cast<uint16_t>(smodel::SModelAnimPath::Scale);
+                    sc.samplerIndex = addSampler(keys, clip.durationSec, 3, [&](float t, std::vector<float> &out)
+                                                 {
+                        const float k = 1.0f + 0.05f * std::sin(omega * t);
+                        out.insert(out.end(), {k, k, k}); });
+                    model.animChannels.push_back(sc);
+                }
+                if (desc.fullTrs && !animatedT)
+                {
+                    smodel::SModelAnimationChannelRecord tr{};
+                    tr.targetNode = b;
+                    tr.path = static_cast<uint16_t>(smodel::SModelAnimPath::Translation);
+                    tr.samplerIndex = addSampler(keys, clip.durationSec, 3, [&](float, std::vector<float> &out)
+                                                 { out.insert(out.end(), {rest.t.x, rest.t.y, rest.t.z}); });
+                    model.animChannels.push_back(tr);
+                }
+                if (desc.fullTrs && !animatedS)
+                {
+                    smodel::SModelAnimationChannelRecord sc{};
+                    sc.targetNode = b;
+                    sc.path = static_cast<uint16_t>(smodel::SModelAnimPath::Scale);
+                    sc.samplerIndex = addSampler(keys, clip.durationSec, 3, [&](float, std::vector<float> &out)
+                                                 { out.insert(out.end(), {rest.s.x, rest.s.y, rest.s.z}); });
+                    model.animChannels.push_back(sc);
+                }
+            }
+
+            clip.channelCount = static_cast<uint32_t>(model.animChannels.size()) - clip.firstChannel;
+            model.animClips.push_back(clip);
+        }
+        model.buildSamplerKeyRates(); // keys are evenly spaced, as the loader would detect
+    }
+}
@@ -124,8 +124,10 @@ MySampleApp::MySampleApp() : Engine::Application()
             if (m_groundTexture.isValid())
                 m_assets->addRef(m_groundTexture);
 
-            // We only needed the texture; let the model be GC'd.
+            // We only needed the texture; let the model be GC'd (sliced, it was never drawn).
             m_assets->release(groundModel);
+            m_mainJobs.submit("Asset GC", [this](Engine::TimeSlice &slice)
+                              { return m_assets->garbageCollect(slice); });
         }
 
         if (m_groundTexture.isValid())
@@ -179,9 +181,14 @@ void MySampleApp::Close()
 
 void MySampleApp::OnUpdate(Engine::TimeStep ts)
 {
+    (void)ts;
+    HandleMenuResult();
+    m_mainJobs.run(kMainJobsBudgetUs);
+
     // When the in-game pause menu is visible, freeze the simulation so "Continue"
     // resumes exactly from the state when Escape was pressed.
-    if (m_inGame && m_menu.IsVisible())
+    m_simPaused = m_inGame && m_menu.IsVisible();
+    if (m_simPaused)
         return;
 
     auto &win = GetWindow();
@@ -241,8 +248,18 @@ void MySampleApp::OnUpdate(Engine::TimeStep ts)
 
     // Apply RTS state to engine camera every frame.
     ApplyRTSCamera(aspect);
+}
 
-    m_systems.Update(GetECS(), ts.DeltaSeconds);
+void MySampleApp::OnSimulate(Engine::TimeStep ts)
+{
+    if (m_simPaused)
+        return;
+    m_systems.Simulate(GetECS(), ts.DeltaSeconds);
+}
+
+void MySampleApp::OnExtract()
+{
+    m_systems.Extract(GetECS());
 }
 
 void MySampleApp::PickAndSelectEntityAtCursor()
@@ -446,9 +463,10 @@ void MySampleApp::OnRender()
     // ---- Battle HUD: Team health bars ----
     if (m_inGame && !m_menu.IsVisible())
     {
-        const auto &combat = m_systems.GetCombatSystem();
-        const auto &teamA = combat.getTeamStats(0);
-        const auto &teamB = combat.getTeamStats(1);
+        // Extracted copy: in pipelined mode the simulation is running while we draw.
+        const auto &hud = m_systems.GetHud();
+        const auto &teamA = hud.teams[0];
+        const auto &teamB = hud.teams[1];
 
         ImGuiIO &io = ImGui::GetIO();
         const float screenW = io.DisplaySize.x;
@@ -518,7 +536,7 @@ void MySampleApp::OnRender()
             const char *hint = nullptr;
             ImU32 hintColor = IM_COL32(200, 200, 200, 180);
 
-            if (!combat.isBattleStarted())
+            if (!hud.battleStarted)
             {
                 hint = "Click anywhere to start — armies will charge toward each other!";
                 hintColor = IM_COL32(100, 255, 100, 240);
@@ -537,7 +555,7 @@ void MySampleApp::OnRender()
         }
 
         // --- Victory / Defeat overlay ---
-        if (combat.isBattleStarted()
+        if (hud.battleStarted
             && teamA.totalSpawned > 0 && teamB.totalSpawned > 0
             && (teamA.alive == 0 || teamB.alive == 0))
         {
@@ -599,8 +617,12 @@ void MySampleApp::OnRender()
 
         ImGui::End();
     }
+}
 
-    // If menu produced a result, handle it
+void MySampleApp::HandleMenuResult()
+{
+    // Menu results come from OnRender (ImGui); apply them here, on the main thread before the
+    // next simulation starts, since they may load or reset game state.
     if (m_menu.GetResult() != MenuManager::Result::None)
     {
         auto res = m_menu.GetResult();
@@ -686,6 +708,8 @@ void MySampleApp::setupECSFromPrefabs()
     }
 
     Sample::SpawnFromScenarioFile(ecs, "BattleConfig.json", /*selectSpawned=*/false);
+    std::cout << "[ECS] Store columns: " << ecs.stores.memoryBytes() << " bytes, Path component: "
+              << sizeof(Engine::ECS::Path) << " bytes/row\n";
 
     // --- Load combat tuning from BattleConfig.json ---
     try
@@ -721,6 +745,62 @@ void MySampleApp::setupECSFromPrefabs()
                 std::cout << "[Config] Combat config loaded from BattleConfig.json\n";
             }
 
+            // Fixed simulation rate (rendering interpolates in between).
+            if (root.contains("simulation") && root["simulation"].is_object())
+            {
+                const auto &sim = root["simulation"];
+                const float hz = sim.value("hz", Engine::FixedTimestep::kDefaultHz);
+                const uint32_t maxSteps = sim.value("maxCatchUpSteps", Engine::FixedTimestep::kDefaultMaxSteps);
+                m_systems.SetFixedTimestep(hz, maxSteps);
+                m_systems.SetInterpolationEnabled(sim.value("interpolate", true));
+                m_systems.SetBackgroundBudget(sim.value("backgroundBudgetUs", Sample::SystemRunner::kDefaultBackgroundBudgetUs));
+                SetPipelinedSimulation(sim.value("pipelined", false));
+                std::cout << "[Config] Simulation at " << m_systems.GetTimestep().rate() << " Hz, up to "
+                          << m_systems.GetTimestep().maxStepsPerFrame() << " steps per frame"
+                          << (IsPipelinedSimulation() ? ", pipelined with rendering\n" : "\n");
+            }
+
+            // Local avoidance: "separation" (overlap push) or "reciprocal" (ORCA).
+            if (root.contains("avoidance") && root["avoidance"].is_object())
+            {
+                const auto &av = root["avoidance"];
+                const std::string mode = av.value("mode", std::string("separation"));
+                if (mode != "separation" && mode != "reciprocal")
+                    std::cerr << "[Config] Unknown avoidance mode '" << mode << "', using separation\n";
+                m_systems.SetAvoidance(mode == "reciprocal" ? LocalAvoidanceSystem::Mode::Reciprocal
+                                                            : LocalAvoidanceSystem::Mode::Separation,
+                                       av.value("maxNeighbors", m_systems.GetAvoidance().maxNeighbors()));
+                if (m_systems.GetAvoidance().mode() == LocalAvoidanceSystem::Mode::Reciprocal)
+                    std::cout << "[Config] Reciprocal (ORCA) avoidance, " << m_systems.GetAvoidance().maxNeighbors()
+                              << " neighbors per unit\n";
+            }
+
+            // Baked animation clips (pose lookup instead of keyframe sampling per unit).
+            if (root.contains("animation") && root["animation"].is_object())
+            {
+                const auto &anim = root["animation"];
+                const double kMB = 1024.0 * 1024.0;
+                Engine::AnimationBakeSettings bake;
+                bake.enabled = anim.value("bake", false);
+                bake.sampleHz = anim.value("bakeHz", Engine::AnimationBakeSettings::kDefaultSampleHz);
+                bake.budgetBytes = static_cast<size_t>(
+                    std::max(0.0, anim.value("bakeBudgetMB", static_cast<double>(Engine::AnimationBakeSettings::kDefaultBudgetBytes) / kMB)) * kMB);
+                bake.interpolate = anim.value("interpolate", true);
+                m_assets->setAnimationBaking(bake);
+                m_systems.SetPoseSharing(anim.value("poseShareHz", PoseUpdateSystem::kDefaultPoseShareHz));
+                m_systems.SetGpuPoses(anim.value("gpuPoses", false));
+                if (bake.enabled)
+                {
+                    std::cout << "[Config] Baked " << m_assets->bakedClipCount() << " animation clips at "
+                              << bake.sampleHz << " Hz (" << static_cast<double>(m_assets->bakedAnimationBytes()) / kMB
+                              << " of " << static_cast<double>(bake.budgetBytes) / kMB << " MB)\n";
+                }
+                if (m_systems.GetPoseSharing() > 0.0f)
+                    std::cout << "[Config] Units share poses in " << m_systems.GetPoseSharing() << " Hz time buckets\n";
+                if (m_systems.GetGpuPoses())
+                    std::cout << "[Config] Poses evaluated on the GPU (compute)\n";
+            }
+
             // Load start zone (click here to begin battle)
             if (root.contains("startZone") && root["startZone"].is_object())
             {
@@ -1,5 +1,9 @@
 #include "update.h"
 
+#include "Engine/PerformanceMonitor.h"
+
+#include <chrono>
+
 namespace Sample
 {
     void SystemRunner::Initialize(Engine::ECS::ECSContext &ecs)
@@ -14,18 +18,30 @@ namespace Sample
 
         // Ensure common IDs exist up-front (also used by scenario spawner selection).
         (void)registry.ensureId("Selected");
+        (void)registry.ensureId("Sleeping");
 
         m_command.buildMasks(registry);
         m_steering.buildMasks(registry);
         m_navGridBuilder.buildMasks(registry);
+        m_navGridBuilder.setTimeSlicer(&m_background);
         m_pathfinding.buildMasks(registry);
+        m_formation.buildMasks(registry);
+        m_formation.setPathfinding(&m_pathfinding);
+        m_command.setFormationSystem(&m_formation);
+        m_activity.buildMasks(registry);
+        m_simLod.buildMasks(registry);
         m_movement.buildMasks(registry);
         m_spatialIndex.buildMasks(registry);
+        m_avoidance.buildMasks(registry);
+        m_avoidance.setJobSystem(&m_jobs);
         m_combat.buildMasks(registry);
         m_combat.setSpatialIndex(&m_spatialIndex);
+        m_combat.setActivitySystem(&m_activity);
+        m_combat.setTimeSlicer(&m_background);
         m_characterAnim.buildMasks(registry);
         m_poseUpdate.buildMasks(registry);
         m_renderModel.buildMasks(registry);
+        m_renderModel.setSharedPoses(&m_poseUpdate.sharedPoses());
 
         // Initialize NavGrid (cover map area)
         m_navGrid.rebuild(2.0f, -400.0f, -400.0f, 400.0f, 400.0f);
@@ -34,42 +50,166 @@ namespace Sample
     }
 
     void SystemRunner::Update(Engine::ECS::ECSContext &ecs, float dtSeconds)
+    {
+        Simulate(ecs, dtSeconds);
+        Extract(ecs);
+    }
+
+    void SystemRunner::Simulate(Engine::ECS::ECSContext &ecs, float dtSeconds)
     {
         if (!m_initialized)
             Initialize(ecs);
 
+        m_lastFrameDt = dtSeconds;
         if (dtSeconds <= 0.0f)
             return;
 
+        // Fixed-step simulation: 0..maxSteps steps this frame depending on accumulated time.
+        const uint32_t steps = m_timestep.advance(dtSeconds);
+        for (uint32_t i = 0; i < steps; ++i)
+        {
+            m_renderModel.capturePreviousState(ecs);
+            Step(ecs, m_timestep.stepSeconds());
+        }
+
+        // Background maintenance within its budget. Only on frames that stepped, so what a
+        // job publishes (e.g. NavGrid::changes) is seen by the next step before the job runs again.
+        if (steps > 0)
+            m_background.run(m_backgroundBudgetUs);
+        PublishTimestepStats();
+        PublishBackgroundStats();
+    }
+
+    void SystemRunner::Extract(Engine::ECS::ECSContext &ecs)
+    {
+        if (!m_initialized)
+            return;
+
+        // Inputs for the next simulation: the camera as of this frame (sim-LOD reads the copy,
+        // so the render thread may keep using the live camera).
+        if (m_camera)
+            m_simCamera = *m_camera;
+
+        // HUD values for OnRender.
+        m_hud.teams[0] = m_combat.getTeamStats(0);
+        m_hud.teams[1] = m_combat.getTeamStats(1);
+        m_hud.battleStarted = m_combat.isBattleStarted();
+
+        if (m_lastFrameDt <= 0.0f)
+            return;
+
+        // 8. Render extraction (every frame, interpolated between the last two sim states) into
+        //    the renderer-owned snapshot the passes record from
+        m_renderModel.setInterpolationAlpha(m_timestep.alpha());
+        m_renderModel.update(ecs, m_lastFrameDt);
+    }
+
+    void SystemRunner::Step(Engine::ECS::ECSContext &ecs, float dtSeconds)
+    {
         // 1. Input
         m_command.update(ecs, dtSeconds);
 
         // 2. NavGrid (Rebuild grid from static obstacles)
         m_navGridBuilder.update(ecs, dtSeconds);
 
+        // 2.5 Formations (advance leaders, write member slot targets)
+        m_formation.update(ecs, dtSeconds);
+
+        // 2.7 Activity (wake commanded / disturbed units, put idle ones to sleep)
+        m_activity.update(ecs, dtSeconds);
+
+        // 2.8 Sim-LOD (which far / off-screen units the throttled systems update this frame)
+        m_simLod.update(ecs, dtSeconds);
+        PublishActivityStats();
+
         // 3. Pathfinding (Plan paths for units with invalid/new targets)
         m_pathfinding.update(ecs, dtSeconds);
+        PublishPathfindingStats();
 
         // 4. Steering (Follow waypoints, update facing)
         m_steering.update(ecs, dtSeconds);
 
+        // 4.5 Spatial index rebuild (neighbors for avoidance and combat)
+        m_spatialIndex.update(ecs, dtSeconds);
+
+        // 4.6 Local avoidance (adjust steered velocities around neighbors)
+        m_avoidance.update(ecs, dtSeconds);
+
         // 5. Movement integration
         m_movement.update(ecs, dtSeconds);
 
-        // 5.5 Spatial index rebuild
-        m_spatialIndex.update(ecs, dtSeconds);
-
         // 5.6 Combat (find enemies, attack, damage, death)
         m_combat.update(ecs, dtSeconds);
         
         // 6. Animation selection
         m_characterAnim.update(ecs, dtSeconds);
 
-        // 7. Pose update
-        m_poseUpdate.update(ecs, dtSeconds);
-        
-        // 8. Render
-        m_renderModel.update(ecs, dtSeconds);
+        // 7. Pose update (on the GPU the model pass evaluates from RenderAnimation instead)
+        m_poseUpdateMs = 0.0f;
+        if (!m_renderModel.gpuPoses())
+        {
+            const auto start = std::chrono::steady_clock::now();
+            m_poseUpdate.update(ecs, dtSeconds);
+            m_poseUpdateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        PublishPoseStats();
+    }
+
+    void SystemRunner::SetFixedTimestep(float hz, uint32_t maxStepsPerFrame)
+    {
+        m_timestep.setRate(hz);
+        m_timestep.setMaxStepsPerFrame(maxStepsPerFrame);
+    }
+
+    void SystemRunner::SetInterpolationEnabled(bool enabled)
+    {
+        m_renderModel.setInterpolationEnabled(enabled);
+    }
+
+    void SystemRunner::PublishTimestepStats()
+    {
+        Engine::OverlayStats::set("Sim rate", m_timestep.rate(), "%.0f Hz");
+        Engine::OverlayStats::set("Sim steps/frame", static_cast<float>(m_timestep.lastSteps()));
+        Engine::OverlayStats::set("Sim steps dropped", static_cast<float>(m_timestep.droppedSteps()));
+    }
+
+    void SystemRunner::PublishBackgroundStats()
+    {
+        Engine::OverlayStats::set("Background jobs", static_cast<float>(m_background.pendingCount()));
+        Engine::OverlayStats::set("Background time", m_background.lastRunUs(), "%.0f us");
+    }
+
+    void SystemRunner::PublishPoseStats()
+    {
+        Engine::OverlayStats::set("Poses baked", static_cast<float>(m_poseUpdate.bakedPoses()));
+        Engine::OverlayStats::set("Poses live", static_cast<float>(m_poseUpdate.livePoses()));
+        Engine::OverlayStats::set("Poses shared", static_cast<float>(m_poseUpdate.sharedPoseHits()));
+        Engine::OverlayStats::set("Shared pose slots", static_cast<float>(m_poseUpdate.sharedPoses().liveCount()));
+        Engine::OverlayStats::set("Pose update (CPU)", m_poseUpdateMs, "%.3f ms");
+    }
+
+    void SystemRunner::PublishPathfindingStats()
+    {
+        const PathfindingSystem::Stats &st = m_pathfinding.stats();
+        const float hitRate = st.cacheLookups
+                                  ? 100.0f * static_cast<float>(st.cacheHits) / static_cast<float>(st.cacheLookups)
+                                  : 0.0f;
+        Engine::OverlayStats::set("Path searches", static_cast<float>(st.searches));
+        Engine::OverlayStats::set("Path cache hits", hitRate, "%.1f%%");
+        Engine::OverlayStats::set("Path expansions saved", static_cast<float>(st.savedExpansions));
+        Engine::OverlayStats::set("Paths invalidated", static_cast<float>(st.pathsInvalidated));
+        Engine::OverlayStats::set("Formations", static_cast<float>(m_formation.activeFormations()));
+    }
+
+    void SystemRunner::PublishActivityStats()
+    {
+        Engine::OverlayStats::set("Active units", static_cast<float>(m_activity.activeCount()));
+        Engine::OverlayStats::set("Sleeping units", static_cast<float>(m_activity.sleepingCount()));
+
+        static const char *const kLodLabels[SimLodSystem::kLevels] = {
+            "Sim LOD 1/1", "Sim LOD 1/2", "Sim LOD 1/4", "Sim LOD 1/8"};
+        for (uint8_t level = 0; level < SimLodSystem::kLevels; ++level)
+            Engine::OverlayStats::set(kLodLabels[level], static_cast<float>(m_simLod.countAtLevel(level)));
     }
 
     void SystemRunner::SetAssetManager(Engine::AssetManager *assets)
@@ -87,7 +227,11 @@ namespace Sample
 
     void SystemRunner::SetCamera(Engine::Camera *camera)
     {
+        m_camera = camera;
         m_renderModel.setCamera(camera);
+        m_simLod.setCamera(camera ? &m_simCamera : nullptr);
+        if (camera)
+            m_simCamera = *camera;
     }
 
     void SystemRunner::SetGlobalMoveTarget(float x, float y, float z)
@@ -0,0 +1,227 @@
+#pragma once
+/*
+  ActivitySystem.h
+  ----------------
+  Purpose:
+    - Put idle units to sleep and wake them again, so per-frame systems only touch the
+      units that are actually doing something.
+    - A unit is idle when it has zero Velocity, no active MoveTarget and none of its
+      Position / Velocity / MoveTarget / Health rows were marked dirty since the last frame.
+      After sleepFrames() idle frames it gets the "Sleeping" tag (archetype migration, like
+      "Selected" / "Dead"), which simulation systems exclude.
+
+  Waking:
+    - Commands: any system that writes MoveTarget / Velocity / Position / Health of a sleeping
+      row and marks it dirty (CommandSystem, FormationSystem, ...) wakes it on the next update.
+    - Events: wake(entity) queues an explicit wake (CombatSystem uses it for damage and for
+      sleepers next to a fight).
+
+  Notes:
+    - Sleeping units stay visible and collidable: RenderSystem still draws them and
+      SpatialIndexSystem keeps them in a separate grid that is only rebuilt when the sleeping
+      set changes, so avoidance and target searches still see them.
+    - Tag migrations mark the moved rows dirty for every dirty query; this system drains its
+      own queries afterwards so its migrations don't count as activity.
+
+  Suggested order per frame:
+    CommandSystem -> FormationSystem -> ActivitySystem -> PathfindingSystem -> ...
+*/
+
+#include "ECS/SystemFormat.h"
+#include "ECS/Components.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class ActivitySystem : public Engine::ECS::SystemBase
+{
+public:
+    ActivitySystem()
+    {
+        setRequiredNames({"Position", "Velocity"});
+        setExcludedNames({"Disabled", "Dead", "Sleeping"});
+    }
+
+    const char *name() const override { return "ActivitySystem"; }
+
+    void buildMasks(Engine::ECS::ComponentRegistry &registry) override
+    {
+        Engine::ECS::SystemBase::buildMasks(registry);
+        m_positionId = registry.ensureId("Position");
+        m_velocityId = registry.ensureId("Velocity");
+        m_moveTargetId = registry.ensureId("MoveTarget");
+        m_healthId = registry.ensureId("Health");
+        m_sleepingId = registry.ensureId("Sleeping");
+        m_disabledId = registry.ensureId("Disabled");
+        m_deadId = registry.ensureId("Dead");
+    }
+
+    /// Idle frames before a unit is put to sleep (0 disables sleeping).
+    void setSleepFrames(uint32_t frames) { m_sleepFrames = frames; }
+    uint32_t sleepFrames() const { return m_sleepFrames; }
+
+    /// Queue a wake for the next update (no-op for units that are already awake).
+    void wake(Engine::ECS::Entity e) { m_wakeRequests.push_back(e); }
+
+    uint32_t activeCount() const { return m_activeCount; }
+    uint32_t sleepingCount() const { return m_sleepingCount; }
+
+    void update(Engine::ECS::ECSContext &ecs, float /*dt*/) override
+    {
+        if (m_awakeQueryId == Engine::ECS::QueryManager::InvalidQuery)
+        {
+            Engine::ECS::ComponentMask dirty;
+            dirty.set(m_positionId);
+            dirty.set(m_velocityId);
+            dirty.set(m_moveTargetId);
+            dirty.set(m_healthId);
+
+            m_awakeQueryId = ecs.queries.createDirtyQuery(required(), excluded(), dirty, ecs.stores);
+
+            Engine::ECS::ComponentMask sleepRequired = required();
+            sleepRequired.set(m_sleepingId);
+            Engine::ECS::ComponentMask sleepExcluded;
+            sleepExcluded.set(m_disabledId);
+            sleepExcluded.set(m_deadId);
+            m_sleepQueryId = ecs.queries.createDirtyQuery(sleepRequired, sleepExcluded, dirty, ecs.stores);
+        }
+
+        // 1. Sleepers touched since the last update wake up, as do explicit requests.
+        m_toWake.swap(m_wakeRequests);
+        m_wakeRequests.clear();
+        const auto &sleepQ = ecs.queries.get(m_sleepQueryId);
+        for (uint32_t archetypeId : sleepQ.matchingArchetypeIds)
+        {
+            const auto *store = ecs.stores.get(archetypeId);
+            if (!store)
+                continue;
+            const auto &entities = store->entities();
+            const uint32_t n = store->size();
+            for (uint32_t row : ecs.queries.consumeDirtyRows(m_sleepQueryId, archetypeId))
+            {
+                if (row < n)
+                    m_toWake.push_back(entities[row]);
+            }
+        }
+
+        // 2. Count idle frames of awake units.
+        m_toSleep.clear();
+        const auto &awakeQ = ecs.queries.get(m_awakeQueryId);
+        for (uint32_t archetypeId : awakeQ.matchingArchetypeIds)
+        {
+            const auto *store = ecs.stores.get(archetypeId);
+            if (!store)
+                continue;
+            const uint32_t n = store->size();
+
+            m_touched.assign(n, 0);
+            for (uint32_t row : ecs.queries.consumeDirtyRows(m_awakeQueryId, archetypeId))
+            {
+                if (row < n)
+                    m_touched[row] = 1;
+            }
+
+            const auto &entities = store->entities();
+            const auto &velocities = store->velocities();
+            const auto *targets = store->hasMoveTarget() ? &store->moveTargets() : nullptr;
+            for (uint32_t row = 0; row < n; ++row)
+            {
+                IdleCounter &idle = counterFor(entities[row]);
+                const auto &v = velocities[row];
+                const bool moving = (std::fabs(v.x) + std::fabs(v.y) + std::fabs(v.z)) > 1e-6f;
+                const bool targeted = targets && (*targets)[row].active != 0;
+                if (m_touched[row] || moving || targeted)
+                {
+                    idle.frames = 0;
+                    continue;
+                }
+                if (m_sleepFrames > 0 && ++idle.frames >= m_sleepFrames)
+                    m_toSleep.push_back(entities[row]);
+            }
+        }
+
+        // 3. Migrate. Wakes first so a unit both requested awake and idle stays awake this frame.
+        const bool migrated = !m_toWake.empty() || !m_toSleep.empty();
+        for (Engine::ECS::Entity e : m_toWake)
+        {
+            if (!ecs.entities.isAlive(e))
+                continue;
+            counterFor(e).frames = 0;
+            (void)ecs.removeTag(e, m_sleepingId);
+        }
+        for (Engine::ECS::Entity e : m_toSleep)
+        {
+            if (counterFor(e).frames == 0)
+                continue; // woken above
+            (void)ecs.addTag(e, m_sleepingId);
+        }
+        m_toWake.clear();
+
+        // 4. Our own migrations marked rows dirty; they are not activity.
+        if (migrated)
+        {
+            for (uint32_t archetypeId : awakeQ.matchingArchetypeIds)
+                (void)ecs.queries.consumeDirtyRows(m_awakeQueryId, archetypeId);
+            for (uint32_t archetypeId : sleepQ.matchingArchetypeIds)
+                (void)ecs.queries.consumeDirtyRows(m_sleepQueryId, archetypeId);
+        }
+
+        m_activeCount = countRows(ecs, awakeQ);
+        m_sleepingCount = countRows(ecs, sleepQ);
+    }
+
+private:
+    struct IdleCounter
+    {
+        uint32_t generation = 0;
+        uint32_t frames = 0;
+    };
+
+    // Counters are indexed by entity slot; a recycled slot starts from zero.
+    IdleCounter &counterFor(Engine::ECS::Entity e)
+    {
+        if (e.index >= m_idle.size())
+            m_idle.resize(static_cast<size_t>(e.index) + 1);
+        IdleCounter &c = m_idle[e.index];
+        if (c.generation != e.generation)
+        {
+            c.generation = e.generation;
+            c.frames = 0;
+        }
+        return c;
+    }
+
+    static uint32_t countRows(Engine::ECS::ECSContext &ecs, const Engine::ECS::Query &q)
+    {
+        uint32_t total = 0;
+        for (uint32_t archetypeId : q.matchingArchetypeIds)
+        {
+            if (const auto *store = ecs.stores.get(archetypeId))
+                total += store->size();
+        }
+        return total;
+    }
+
+    static constexpr uint32_t kDefaultSleepFrames = 60;
+
+    uint32_t m_sleepFrames = kDefaultSleepFrames;
+    uint32_t m_activeCount = 0;
+    uint32_t m_sleepingCount = 0;
+
+    std::vector<IdleCounter> m_idle;
+    std::vector<uint8_t> m_touched;
+    std::vector<Engine::ECS::Entity> m_wakeRequests;
+    std::vector<Engine::ECS::Entity> m_toWake;
+    std::vector<Engine::ECS::Entity> m_toSleep;
+
+    Engine::ECS::QueryId m_awakeQueryId = Engine::ECS::QueryManager::InvalidQuery;
+    Engine::ECS::QueryId m_sleepQueryId = Engine::ECS::QueryManager::InvalidQuery;
+    uint32_t m_positionId = Engine::ECS::ComponentRegistry::InvalidID;
+    uint32_t m_velocityId = Engine::ECS::ComponentRegistry::InvalidID;
+    uint32_t m_moveTargetId = Engine::ECS::ComponentRegistry::InvalidID;
+    uint32_t m_healthId = Engine::ECS::ComponentRegistry::InvalidID;
+    uint32_t m_sleepingId = Engine::ECS::ComponentRegistry::InvalidID;
+    uint32_t m_disabledId = Engine::ECS::ComponentRegistry::InvalidID;
+    uint32_t m_deadId = Engine::ECS::ComponentRegistry::InvalidID;
+};
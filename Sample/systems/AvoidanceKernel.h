@@ -0,0 +1,251 @@
+#pragma once
+/*
+  AvoidanceKernel.h
+  -----------------
+  Purpose:
+    - Batched separation kernel for LocalAvoidanceSystem: given one agent and a packed
+      batch of neighbor positions / radii / separations, return the weighted push
+      vector in a single pass instead of one lambda call (sqrt + divide) per neighbor.
+    - Vector paths: AVX2 (8 lanes, when built with -mavx2 / -march=native),
+      SSE2 (4 lanes, x86-64 baseline), NEON (4 lanes, AArch64); scalar fallback otherwise.
+      Define STRATO_AVOIDANCE_SCALAR to force the fallback.
+
+  Determinism:
+    - Every lane computes exactly what the scalar code computes (IEEE sqrt and divide,
+      no reciprocal estimates), and the scalar path accumulates into kLanes striped
+      partial sums reduced in the same order as the vector path. With FP contraction
+      disabled (no FMA fusing) separationPush() and separationPushScalar() are
+      bitwise identical; with fused multiply-add the difference stays within ~1e-6
+      relative of the push magnitude (AvoidanceBench reports the max deviation).
+    - Neither matches the old per-neighbor sequential sum bit for bit (different
+      summation order); that difference is of the same order.
+
+  Batch layout:
+    - SoA arrays padded to a multiple of kLanes. Padding lanes hold NaN positions,
+      which fail the distance test and contribute nothing, so the loop needs no tail.
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if !defined(STRATO_AVOIDANCE_SCALAR)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define STRATO_AVOIDANCE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STRATO_AVOIDANCE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define STRATO_AVOIDANCE_NEON 1
+#endif
+#endif
+
+namespace AvoidanceKernel
+{
+#if defined(STRATO_AVOIDANCE_AVX2)
+    constexpr uint32_t kLanes = 8;
+    constexpr const char *kIsaName = "AVX2";
+#elif defined(STRATO_AVOIDANCE_SSE2)
+    constexpr uint32_t kLanes = 4;
+    constexpr const char *kIsaName = "SSE2";
+#elif defined(STRATO_AVOIDANCE_NEON)
+    constexpr uint32_t kLanes = 4;
+    constexpr const char *kIsaName = "NEON";
+#else
+    constexpr uint32_t kLanes = 4;
+    constexpr const char *kIsaName = "scalar";
+#endif
+
+    // Same cut-off LocalAvoidanceSystem always used: closer than this the direction is undefined.
+    constexpr float kMinDist = 1e-6f;
+
+    struct NeighborBatch
+    {
+        std::vector<float> x, z, radius, sep;
+        uint32_t count = 0;
+
+        void clear() { count = 0; }
+
+        void push(float px, float pz, float r, float s)
+        {
+            if (count == x.size())
+                grow(count + 1);
+            x[count] = px;
+            z[count] = pz;
+            radius[count] = r;
+            sep[count] = s;
+            ++count;
+        }
+
+        // Number of lanes the kernels walk: count rounded up to kLanes, tail filled with NaN.
+        uint32_t seal()
+        {
+            const uint32_t padded = (count + kLanes - 1) / kLanes * kLanes;
+            if (padded > x.size())
+                grow(padded);
+            const float nan = std::numeric_limits<float>::quiet_NaN();
+            for (uint32_t i = count; i < padded; ++i)
+            {
+                x[i] = nan;
+                z[i] = nan;
+                radius[i] = 0.0f;
+                sep[i] = 0.0f;
+            }
+            return padded;
+        }
+
+    private:
+        void grow(uint32_t need)
+        {
+            size_t cap = x.empty() ? 64 : x.size();
+            while (cap < need)
+                cap *= 2;
+            x.resize(cap);
+            z.resize(cap);
+            radius.resize(cap);
+            sep.resize(cap);
+        }
+    };
+
+    struct Push
+    {
+        float x = 0.0f;
+        float z = 0.0f;
+    };
+
+    // Reference path, also the fallback when no vector ISA is available.
+    inline Push separationPushScalar(float px, float pz, float selfRadius, float selfSep, NeighborBatch &batch)
+    {
+        const uint32_t padded = batch.seal();
+        float accX[kLanes] = {};
+        float accZ[kLanes] = {};
+
+        for (uint32_t base = 0; base < padded; base += kLanes)
+        {
+            for (uint32_t l = 0; l < kLanes; ++l)
+            {
+                const uint32_t i = base + l;
+                const float dx = px - batch.x[i];
+                const float dz = pz - batch.z[i];
+                const float dist = std::sqrt(dx * dx + dz * dz);
+                const float desired = (selfRadius + batch.radius[i]) + (selfSep + batch.sep[i]);
+                if (!(dist < desired && dist > kMinDist))
+                    continue;
+                const float w = (desired - dist) / desired;
+                accX[l] += (dx / dist) * w;
+                accZ[l] += (dz / dist) * w;
+            }
+        }
+
+        Push out;
+        for (uint32_t l = 0; l < kLanes; ++l)
+        {
+            out.x += accX[l];
+            out.z += accZ[l];
+        }
+        return out;
+    }
+
+    // Weighted push away from every overlapping neighbor in `batch` (self must not be in it).
+    inline Push separationPush(float px, float pz, float selfRadius, float selfSep, NeighborBatch &batch)
+    {
+#if defined(STRATO_AVOIDANCE_AVX2)
+        const uint32_t padded = batch.seal();
+        const __m256 vpx = _mm256_set1_ps(px);
+        const __m256 vpz = _mm256_set1_ps(pz);
+        const __m256 vr = _mm256_set1_ps(selfRadius);
+        const __m256 vs = _mm256_set1_ps(selfSep);
+        const __m256 vmin = _mm256_set1_ps(kMinDist);
+        __m256 accX = _mm256_setzero_ps();
+        __m256 accZ = _mm256_setzero_ps();
+
+        for (uint32_t i = 0; i < padded; i += kLanes)
+        {
+            const __m256 dx = _mm256_sub_ps(vpx, _mm256_loadu_ps(&batch.x[i]));
+            const __m256 dz = _mm256_sub_ps(vpz, _mm256_loadu_ps(&batch.z[i]));
+            const __m256 dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dz, dz)));
+            const __m256 desired = _mm256_add_ps(_mm256_add_ps(vr, _mm256_loadu_ps(&batch.radius[i])),
+                                                 _mm256_add_ps(vs, _mm256_loadu_ps(&batch.sep[i])));
+            const __m256 mask = _mm256_and_ps(_mm256_cmp_ps(dist, desired, _CMP_LT_OQ),
+                                              _mm256_cmp_ps(dist, vmin, _CMP_GT_OQ));
+            const __m256 w = _mm256_div_ps(_mm256_sub_ps(desired, dist), desired);
+            accX = _mm256_add_ps(accX, _mm256_and_ps(mask, _mm256_mul_ps(_mm256_div_ps(dx, dist), w)));
+            accZ = _mm256_add_ps(accZ, _mm256_and_ps(mask, _mm256_mul_ps(_mm256_div_ps(dz, dist), w)));
+        }
+
+        alignas(32) float lx[kLanes], lz[kLanes];
+        _mm256_store_ps(lx, accX);
+        _mm256_store_ps(lz, accZ);
+#elif defined(STRATO_AVOIDANCE_SSE2)
+        const uint32_t padded = batch.seal();
+        const __m128 vpx = _mm_set1_ps(px);
+        const __m128 vpz = _mm_set1_ps(pz);
+        const __m128 vr = _mm_set1_ps(selfRadius);
+        const __m128 vs = _mm_set1_ps(selfSep);
+        const __m128 vmin = _mm_set1_ps(kMinDist);
+        __m128 accX = _mm_setzero_ps();
+        __m128 accZ = _mm_setzero_ps();
+
+        for (uint32_t i = 0; i < padded; i += kLanes)
+        {
+            const __m128 dx = _mm_sub_ps(vpx, _mm_loadu_ps(&batch.x[i]));
+            const __m128 dz = _mm_sub_ps(vpz, _mm_loadu_ps(&batch.z[i]));
+            const __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz)));
+            const __m128 desired = _mm_add_ps(_mm_add_ps(vr, _mm_loadu_ps(&batch.radius[i])),
+                                              _mm_add_ps(vs, _mm_loadu_ps(&batch.sep[i])));
+            const __m128 mask = _mm_and_ps(_mm_cmplt_ps(dist, desired), _mm_cmpgt_ps(dist, vmin));
+            const __m128 w = _mm_div_ps(_mm_sub_ps(desired, dist), desired);
+            accX = _mm_add_ps(accX, _mm_and_ps(mask, _mm_mul_ps(_mm_div_ps(dx, dist), w)));
+            accZ = _mm_add_ps(accZ, _mm_and_ps(mask, _mm_mul_ps(_mm_div_ps(dz, dist), w)));
+        }
+
+        alignas(16) float lx[kLanes], lz[kLanes];
+        _mm_store_ps(lx, accX);
+        _mm_store_ps(lz, accZ);
+#elif defined(STRATO_AVOIDANCE_NEON)
+        const uint32_t padded = batch.seal();
+        const float32x4_t vpx = vdupq_n_f32(px);
+        const float32x4_t vpz = vdupq_n_f32(pz);
+        const float32x4_t vr = vdupq_n_f32(selfRadius);
+        const float32x4_t vs = vdupq_n_f32(selfSep);
+        const float32x4_t vmin = vdupq_n_f32(kMinDist);
+        float32x4_t accX = vdupq_n_f32(0.0f);
+        float32x4_t accZ = vdupq_n_f32(0.0f);
+
+        for (uint32_t i = 0; i < padded; i += kLanes)
+        {
+            const float32x4_t dx = vsubq_f32(vpx, vld1q_f32(&batch.x[i]));
+            const float32x4_t dz = vsubq_f32(vpz, vld1q_f32(&batch.z[i]));
+            const float32x4_t dist = vsqrtq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dz, dz)));
+            const float32x4_t desired = vaddq_f32(vaddq_f32(vr, vld1q_f32(&batch.radius[i])),
+                                                  vaddq_f32(vs, vld1q_f32(&batch.sep[i])));
+            const uint32x4_t mask = vandq_u32(vcltq_f32(dist, desired), vcgtq_f32(dist, vmin));
+            const float32x4_t w = vdivq_f32(vsubq_f32(desired, dist), desired);
+            const float32x4_t cx = vmulq_f32(vdivq_f32(dx, dist), w);
+            const float32x4_t cz = vmulq_f32(vdivq_f32(dz, dist), w);
+            accX = vaddq_f32(accX, vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(cx))));
+            accZ = vaddq_f32(accZ, vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(cz))));
+        }
+
+        float lx[kLanes], lz[kLanes];
+        vst1q_f32(lx, accX);
+        vst1q_f32(lz, accZ);
+#else
+        return separationPushScalar(px, pz, selfRadius, selfSep, batch);
+#endif
+
+#if defined(STRATO_AVOIDANCE_AVX2) || defined(STRATO_AVOIDANCE_SSE2) || defined(STRATO_AVOIDANCE_NEON)
+        // Same left-to-right lane reduction as the scalar path.
+        Push out;
+        for (uint32_t l = 0; l < kLanes; ++l)
+        {
+            out.x += lx[l];
+            out.z += lz[l];
+        }
+        return out;
+#endif
+    }
+}
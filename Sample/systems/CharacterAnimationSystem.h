@@ -2,6 +2,7 @@
 
 #include "ECS/SystemFormat.h"
 #include "assets/AssetManager.h"
+#include "systems/SimLodSystem.h"
 
 #include <algorithm>
 #include <cmath>
@@ -21,13 +22,14 @@ namespace AnimClips
 // - Advances per-entity RenderAnimation time
 // - Automatically switches between Idle and Run animations based on movement state
 // - Checks MoveTarget.active and Velocity to determine if entity is moving
+// - Sim-LOD: far rows advance every few frames by their accumulated SimLod step
 class CharacterAnimationSystem : public Engine::ECS::SystemBase
 {
 public:
     CharacterAnimationSystem()
     {
         setRequiredNames({"RenderModel", "RenderAnimation"});
-        setExcludedNames({"Disabled", "Dead"});
+        setExcludedNames({"Disabled", "Dead", "Sleeping"});
     }
 
     const char *name() const override { return "CharacterAnimationSystem"; }
@@ -88,11 +90,18 @@ public:
             const bool hasMoveTarget = store.hasMoveTarget();
             const auto *velocities = hasVelocity ? &store.velocities() : nullptr;
             const auto *targets = hasMoveTarget ? &store.moveTargets() : nullptr;
+            const Engine::ECS::SimLod *lods = store.hasSimLod() ? store.simLods().data() : nullptr;
 
             for (uint32_t row : dirtyRows)
             {
                 if (row >= n)
                     continue;
+                if (SimLodGate::skip(lods, row))
+                {
+                    ecs.queries.markRowDirty(m_queryId, archetypeId, row, n);
+                    continue;
+                }
+                const float rowDt = SimLodGate::dt(lods, row, dt);
 
                 const Engine::ModelHandle handle = renderModels[row].handle;
                 Engine::ModelAsset *asset = m_assets->getModel(handle);
@@ -131,7 +140,7 @@ public:
                     if (anim.timeSec < duration)
                     {
                         // Still playing a one-shot anim — just advance time and skip clip change
-                        const float delta = dt * anim.speed;
+                        const float delta = rowDt * anim.speed;
                         if (std::abs(delta) > 1e-9f)
                         {
                             anim.timeSec += delta;
@@ -191,7 +200,7 @@ public:
                     continue;
                 }
 
-                const float delta = dt * anim.speed;
+                const float delta = rowDt * anim.speed;
                 if (std::abs(delta) > 1e-9f)
                 {
                     anim.timeSec += delta;
@@ -17,12 +17,22 @@
     5. HP <= 0 -> death anim, schedule removal.
 
   All tuning values are JSON-driven via BattleConfig.json "combat" section.
+
+  Sleeping units (ActivitySystem) don't fight, but stay targetable: they are found through
+  the spatial grid / roster scan, and are woken when hit or when a fighter scans next to them.
+
+  Team stats (HUD only) are rescanned whenever health or deaths change. With a TimeSlicer
+  (setTimeSlicer) the rescan runs as a background job and the previous totals stay visible
+  until it completes; rows that die or move mid-scan can make one result slightly off, and
+  the next rescan (already queued by that death) corrects it.
 */
 
 #include "ECS/SystemFormat.h"
 #include "ECS/Components.h"
 #include "systems/SpatialIndexSystem.h"
+#include "systems/ActivitySystem.h"
 #include "assets/AssetManager.h"
+#include "Engine/TimeSlicer.h"
 
 #include <algorithm>
 #include <cmath>
@@ -89,7 +99,7 @@ public:
     {
         setRequiredNames({"Position", "Health", "Velocity", "MoveTarget", "MoveSpeed",
                           "Facing", "Team", "AttackCooldown", "RenderAnimation"});
-        setExcludedNames({"Dead", "Disabled"});
+        setExcludedNames({"Dead", "Disabled", "Sleeping"});
 
         // Non-deterministic seed so each run plays differently
         std::random_device rd;
@@ -99,6 +109,7 @@ public:
     const char *name() const override { return "CombatSystem"; }
 
     void setSpatialIndex(SpatialIndexSystem *spatial) { m_spatial = spatial; }
+    void setActivitySystem(ActivitySystem *activity) { m_activity = activity; }
     void setAssetManager(Engine::AssetManager *assets) { m_assets = assets; }
 
     // Apply full config (call after loading JSON)
@@ -153,7 +164,13 @@ public:
     void setDeathRemoveDelay(float sec) { m_cfg.deathRemoveDelay = sec; }
     void setMaxHPPerUnit(float hp) { m_cfg.maxHPPerUnit = hp; }
 
-    /// Returns latest team stats (updated every frame in update()).
+    /// Rescan team stats as a background job on `slicer` (nullptr = synchronously in update()).
+    void setTimeSlicer(Engine::TimeSlicer *slicer) { m_slicer = slicer; }
+
+    /// Request a team stats rescan (e.g. after spawning or healing units outside combat).
+    void markTeamStatsDirty() { m_statsDirty = true; }
+
+    /// Returns latest team stats (refreshed after health / death changes).
     const TeamStats &getTeamStats(uint8_t teamId) const
     {
         static const TeamStats empty{};
@@ -173,6 +190,7 @@ public:
         m_renderAnimId = registry.ensureId("RenderAnimation");
         m_facingId = registry.ensureId("Facing");
         m_deadId = registry.ensureId("Dead");
+        m_sleepingId = registry.ensureId("Sleeping");
     }
 
     void update(Engine::ECS::ECSContext &ecs, float dt) override
@@ -194,13 +212,34 @@ public:
 
         // Ensure query exists early so stats refresh works before battle
         if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
+        {
             m_queryId = ecs.queries.createQuery(required(), excluded(), ecs.stores);
 
+            // Roster: every living unit, sleeping or not (targets, stats, battle orders).
+            Engine::ECS::ComponentMask rosterExcluded = excluded();
+            rosterExcluded.clear(m_sleepingId);
+            m_rosterQueryId = ecs.queries.createQuery(required(), rosterExcluded, ecs.stores);
+        }
+
         // ---- Phase 0: Refresh team stats (only when state changed) ----
         if (m_statsDirty)
         {
-            refreshTeamStats(ecs);
-            m_statsDirty = false;
+            if (!m_slicer)
+            {
+                beginTeamStatsScan();
+                Engine::TimeSlice unbounded = Engine::TimeSlice::unbounded();
+                scanTeamStats(ecs, unbounded);
+                m_statsDirty = false;
+            }
+            else if (!m_slicer->isPending(m_statsJob))
+            {
+                // A scan already in flight started before this change: let it finish and
+                // start the next one afterwards.
+                beginTeamStatsScan();
+                m_statsJob = m_slicer->submit("Team stats", [this, &ecs](Engine::TimeSlice &slice)
+                                              { return scanTeamStats(ecs, slice); });
+                m_statsDirty = false;
+            }
         }
 
         // ---- Phase 1: Process pending death removals ----
@@ -211,16 +250,17 @@ public:
             return;
 
         const auto &q = ecs.queries.get(m_queryId);
+        const auto &roster = ecs.queries.get(m_rosterQueryId);
 
         // ── Charge: issue leg-1 targets (once) ──────────────────────
         if (m_chargeActive && !m_chargeIssued)
         {
-            issueClickTargets(ecs, q);
+            issueClickTargets(ecs, roster);
             m_chargeIssued = true;
         }
         // ── Charge: promote units near click to leg-2 ───────────────
         if (m_chargeActive)
-            promoteUnitsNearClick(ecs, q);
+            promoteUnitsNearClick(ecs, q, roster);
 
         const float meleeRange2 = m_cfg.meleeRange * m_cfg.meleeRange;
 
@@ -291,6 +331,10 @@ public:
                     if (neighborStoreId == archetypeId && neighborRow == row)
                         return;
 
+                    // Fighting next to a sleeper wakes it (it still counts as a target now).
+                    if (m_activity && ns->signature().has(m_sleepingId))
+                        m_activity->wake(ns->entities()[neighborRow]);
+
                     if (ns->teams()[neighborRow].id == myTeam)
                         return;
                     if (ns->healths()[neighborRow].value <= 0.0f)
@@ -311,7 +355,7 @@ public:
                 // Fallback: full scan when spatial grid finds nothing
                 if (!bestEnemy.valid())
                 {
-                    for (uint32_t otherArchId : q.matchingArchetypeIds)
+                    for (uint32_t otherArchId : roster.matchingArchetypeIds)
                     {
                         auto *os = ecs.stores.get(otherArchId);
                         if (!os || !os->hasPosition() || !os->hasHealth() || !os->hasTeam())
@@ -348,8 +392,12 @@ public:
                 if (!bestEnemy.valid())
                 {
                     // No enemy found — during charge keep running,
-                    // otherwise stop.
-                    if (!m_chargeActive)
+                    // otherwise stop. Units already at rest are left alone so
+                    // they can go to sleep.
+                    const auto &v = store.velocities()[row];
+                    const bool atRest = (v.x == 0.0f && v.y == 0.0f && v.z == 0.0f) &&
+                                        !store.moveTargets()[row].active;
+                    if (!m_chargeActive && !atRest)
                     {
                         float yaw = store.facings()[row].yaw;
                         stops.push_back({myEntity, yaw});
@@ -531,6 +579,8 @@ public:
 
             st->healths()[rec->row].value -= d.damage;
             m_statsDirty = true;
+            if (m_activity && st->signature().has(m_sleepingId))
+                m_activity->wake(d.target);
         }
 
         // Apply damage anims (only if still alive — death anim will override below)
@@ -614,48 +664,78 @@ public:
     }
 
 private:
-    void refreshTeamStats(Engine::ECS::ECSContext &ecs)
+    void beginTeamStatsScan()
     {
-        // Reset counts
-        for (auto &[id, s] : m_teamStats)
+        for (auto &[id, s] : m_statsScratch)
         {
             s.alive = 0;
             s.currentHP = 0.0f;
         }
+        m_statsCursorMatch = 0;
+        m_statsCursorRow = 0;
+    }
 
-        if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
-            return;
+    // Accumulate roster health per team into m_statsScratch from the saved cursor until the
+    // slice expires; publish into m_teamStats and return true once every row was visited.
+    bool scanTeamStats(Engine::ECS::ECSContext &ecs, Engine::TimeSlice &slice)
+    {
+        constexpr uint32_t kRowsPerCheck = 512;
 
-        const auto &q = ecs.queries.get(m_queryId);
-        for (uint32_t archetypeId : q.matchingArchetypeIds)
+        if (m_rosterQueryId != Engine::ECS::QueryManager::InvalidQuery)
         {
-            auto *st = ecs.stores.get(archetypeId);
-            if (!st || !st->hasHealth() || !st->hasTeam())
-                continue;
-            const auto &hp = st->healths();
-            const auto &teams = st->teams();
-            const uint32_t n = st->size();
-            for (uint32_t row = 0; row < n; ++row)
+            const auto &q = ecs.queries.get(m_rosterQueryId);
+            while (m_statsCursorMatch < q.matchingArchetypeIds.size())
             {
-                uint8_t tid = teams[row].id;
-                auto &ts = m_teamStats[tid];
-                // First time we see this team, record max HP
-                if (ts.totalSpawned == 0)
-                    ts.maxHP = 0.0f;
-                ts.alive++;
-                ts.currentHP += std::max(0.0f, hp[row].value);
+                auto *st = ecs.stores.get(q.matchingArchetypeIds[m_statsCursorMatch]);
+                if (!st || !st->hasHealth() || !st->hasTeam())
+                {
+                    ++m_statsCursorMatch;
+                    m_statsCursorRow = 0;
+                    continue;
+                }
+                const auto &hp = st->healths();
+                const auto &teams = st->teams();
+                const uint32_t n = st->size();
+                while (m_statsCursorRow < n)
+                {
+                    const uint32_t end = std::min(n, m_statsCursorRow + kRowsPerCheck);
+                    for (uint32_t row = m_statsCursorRow; row < end; ++row)
+                    {
+                        auto &ts = m_statsScratch[teams[row].id];
+                        ts.alive++;
+                        ts.currentHP += std::max(0.0f, hp[row].value);
+                    }
+                    m_statsCursorRow = end;
+                    if (m_statsCursorRow < n && slice.expired())
+                        return false;
+                }
+                ++m_statsCursorMatch;
+                m_statsCursorRow = 0;
+                if (slice.expired() && m_statsCursorMatch < q.matchingArchetypeIds.size())
+                    return false;
             }
         }
 
-        // Also count dead entities in death queue per team (they were spawned but are dying)
-        // Update totalSpawned = alive + dead-in-queue + already-removed
-        // Simplification: track totalSpawned incrementally on first non-zero alive frame
+        // Publish. totalSpawned is tracked as the peak alive count (dead units in the death
+        // queue and already-removed ones are no longer in the roster).
+        for (auto &[id, s] : m_teamStats)
+        {
+            s.alive = 0;
+            s.currentHP = 0.0f;
+        }
+        for (const auto &[id, scratch] : m_statsScratch)
+        {
+            auto &s = m_teamStats[id];
+            s.alive = scratch.alive;
+            s.currentHP = scratch.currentHP;
+        }
         for (auto &[id, s] : m_teamStats)
         {
             if (s.alive > s.totalSpawned)
                 s.totalSpawned = s.alive;
             s.maxHP = s.totalSpawned * m_cfg.maxHPPerUnit;
         }
+        return true;
     }
 
     void processDeathRemovals(Engine::ECS::ECSContext &ecs, float dt)
@@ -677,6 +757,9 @@ private:
                         auto *store = ecs.stores.get(rec->archetypeId);
                         if (store)
                         {
+                            // Return pooled waypoints before the row is overwritten.
+                            if (store->hasPath())
+                                ecs.pathPool.release(store->paths()[rec->row].handle);
                             Engine::ECS::Entity moved = store->destroyRowSwap(rec->row);
                             if (moved.valid())
                                 ecs.entities.attach(moved, rec->archetypeId, rec->row);
@@ -740,6 +823,7 @@ private:
 
     // Leg 1: set every unit's MoveTarget to the click point.
     // PathfindingSystem will A* around obstacles on the next frame.
+    // Runs over the roster: the dirty MoveTarget wakes sleeping units.
     void issueClickTargets(Engine::ECS::ECSContext &ecs,
                             const Engine::ECS::Query &q)
     {
@@ -770,7 +854,8 @@ private:
     // Because kPassRadius (3 m) > SteeringSystem arrival (0.5 m),
     // the redirect happens while the unit is still RUNNING — no stop.
     void promoteUnitsNearClick(Engine::ECS::ECSContext &ecs,
-                                const Engine::ECS::Query &q)
+                                const Engine::ECS::Query &q,
+                                const Engine::ECS::Query &roster)
     {
         for (uint32_t aid : q.matchingArchetypeIds)
         {
@@ -828,7 +913,7 @@ private:
                 // Fallback: full scan if spatial found nothing
                 if (bestD2 > 1e17f)
                 {
-                    for (uint32_t oaid : q.matchingArchetypeIds)
+                    for (uint32_t oaid : roster.matchingArchetypeIds)
                     {
                         auto *os = ecs.stores.get(oaid);
                         if (!os || !os->hasPosition() || !os->hasHealth() || !os->hasTeam())
@@ -864,9 +949,9 @@ private:
     // Stagger initial cooldowns so units don't all attack on the same frame
     void staggerInitialCooldowns(Engine::ECS::ECSContext &ecs)
     {
-        if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
+        if (m_rosterQueryId == Engine::ECS::QueryManager::InvalidQuery)
             return;
-        const auto &q = ecs.queries.get(m_queryId);
+        const auto &q = ecs.queries.get(m_rosterQueryId);
         for (uint32_t archetypeId : q.matchingArchetypeIds)
         {
             auto *st = ecs.stores.get(archetypeId);
@@ -879,6 +964,7 @@ private:
     }
 
     SpatialIndexSystem *m_spatial = nullptr;
+    ActivitySystem *m_activity = nullptr;
     Engine::AssetManager *m_assets = nullptr;
     bool m_loggedStart = false;
     bool m_battleStarted = false;  // gated by ground click
@@ -897,8 +983,13 @@ private:
     int  m_humanTeamId   = -1;     // -1 = all AI, 0 = team A is human, 1 = team B
     bool m_humanAttacking = false;  // true while spacebar is held
 
-    // Per-team stats (refreshed each frame)
+    // Per-team stats (refreshed after health / death changes)
     std::unordered_map<uint8_t, TeamStats> m_teamStats;
+    std::unordered_map<uint8_t, TeamStats> m_statsScratch; // alive / currentHP of the scan in progress
+    size_t m_statsCursorMatch = 0;                          // roster archetype being scanned
+    uint32_t m_statsCursorRow = 0;
+    Engine::TimeSlicer *m_slicer = nullptr;                 // not owned
+    Engine::TimeSlicer::JobId m_statsJob = Engine::TimeSlicer::kInvalidJob;
 
     // Component IDs
     uint32_t m_positionId = Engine::ECS::ComponentRegistry::InvalidID;
@@ -910,8 +1001,10 @@ private:
     uint32_t m_renderAnimId = Engine::ECS::ComponentRegistry::InvalidID;
     uint32_t m_facingId = Engine::ECS::ComponentRegistry::InvalidID;
     uint32_t m_deadId = Engine::ECS::ComponentRegistry::InvalidID;
+    uint32_t m_sleepingId = Engine::ECS::ComponentRegistry::InvalidID;
 
-    Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
+    Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;       // awake fighters
+    Engine::ECS::QueryId m_rosterQueryId = Engine::ECS::QueryManager::InvalidQuery; // + sleeping units
 
     std::vector<PendingDeath> m_deathQueue;
     std::unordered_set<uint32_t> m_deathQueueSet;  // O(1) death-queue membership test
@@ -1,5 +1,6 @@
 #pragma once
 #include "ECS/SystemFormat.h"
+#include "FormationSystem.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -23,6 +24,10 @@ public:
         m_moveTargetId = registry.ensureId("MoveTarget");
     }
 
+    // When set, move orders are issued as one formation (single leader path) instead of
+    // writing a per-unit grid of targets.
+    void setFormationSystem(FormationSystem *formations) { m_formations = formations; }
+
     // Set the last clicked target; system will write it to entities on next update.
     void SetGlobalMoveTarget(float x, float y, float z)
     {
@@ -47,40 +52,51 @@ public:
         if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
             m_queryId = ecs.queries.createQuery(required(), excluded(), ecs.stores);
 
-        uint32_t totalSelected = 0;
-
+        // Gather the selection across all matching stores first, so the whole selection
+        // gets one layout (not one overlapping grid per archetype store).
+        m_selected.clear();
         const auto &q = ecs.queries.get(m_queryId);
         for (uint32_t archetypeId : q.matchingArchetypeIds)
         {
-            Engine::ECS::ArchetypeStore *storePtr = ecs.stores.get(archetypeId);
+            const Engine::ECS::ArchetypeStore *storePtr = ecs.stores.get(archetypeId);
             if (!storePtr)
                 continue;
-            auto &store = *storePtr;
-
-            auto &targets = const_cast<std::vector<Engine::ECS::MoveTarget> &>(store.moveTargets());
-            const uint32_t selCount = store.size();
-            if (selCount == 0)
-                continue;
-
-            totalSelected += selCount;
+            const auto &entities = storePtr->entities();
+            m_selected.insert(m_selected.end(), entities.begin(), entities.begin() + storePtr->size());
+        }
 
+        const uint32_t selCount = static_cast<uint32_t>(m_selected.size());
+        if (selCount > 0 && m_formations)
+        {
+            m_formations->issueMove(m_selected, m_pendingX, m_pendingY, m_pendingZ);
+            std::cout << "[CommandSystem] Selected=" << selCount
+                      << " baseTarget=(" << m_pendingX << "," << m_pendingZ << ") formation\n";
+        }
+        else if (selCount > 0)
+        {
             const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(selCount))));
             const float half = (static_cast<float>(side) - 1.0f) * 0.5f;
 
             for (uint32_t k = 0; k < selCount; ++k)
             {
+                const Engine::ECS::EntityRecord *rec = ecs.entities.find(m_selected[k]);
+                Engine::ECS::ArchetypeStore *store = rec ? ecs.stores.get(rec->archetypeId) : nullptr;
+                if (!store || rec->row >= store->size())
+                    continue;
+
                 const uint32_t row = k / side;
                 const uint32_t col = k % side;
                 const float ox = (static_cast<float>(col) - half) * spacing;
                 const float oz = (static_cast<float>(row) - half) * spacing;
 
-                targets[k].x = clamp(m_pendingX + ox, kMinWorld, kMaxWorld);
-                targets[k].y = m_pendingY; // height
-                targets[k].z = clamp(m_pendingZ + oz, kMinWorld, kMaxWorld);
-                targets[k].active = 1;
+                auto &target = store->moveTargets()[rec->row];
+                target.x = clamp(m_pendingX + ox, kMinWorld, kMaxWorld);
+                target.y = m_pendingY; // height
+                target.z = clamp(m_pendingZ + oz, kMinWorld, kMaxWorld);
+                target.active = 1;
 
                 // Mark MoveTarget dirty so SteeringSystem picks up the change.
-                ecs.markDirty(m_moveTargetId, archetypeId, k);
+                ecs.markDirty(m_moveTargetId, rec->archetypeId, rec->row);
             }
 
             std::cout << "[CommandSystem] Selected=" << selCount
@@ -94,6 +110,8 @@ public:
 private:
     bool m_hasPending = false;
     float m_pendingX = 0.0f, m_pendingY = 0.0f, m_pendingZ = 0.0f;
+    FormationSystem *m_formations = nullptr;
+    std::vector<Engine::ECS::Entity> m_selected;
     Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
     uint32_t m_moveTargetId = Engine::ECS::ComponentRegistry::InvalidID;
 };
\ No newline at end of file
@@ -0,0 +1,612 @@
+#pragma once
+/*
+  FormationSystem
+  ---------------
+  Purpose:
+    - Moves a group of units as one formation: a single A* path is planned for a
+      virtual leader and every member follows its slot (an offset in the leader's
+      frame) with cheap steering, instead of every unit planning its own path.
+    - Members are driven through the regular pipeline: each frame the system writes
+      the member's MoveTarget (slot + a short lookahead) and keeps its Path valid but
+      empty, so PathfindingSystem skips it and SteeringSystem seeks the target directly.
+    - MoveSpeed is throttled per member (leader speed + catch-up on slot error) so the
+      block stays cohesive; the original speed is restored when the member leaves.
+
+  Reforming around obstacles:
+    - If a member's slot is too tight for it or not in line of sight, it falls in on
+      the leader's route (planned for the formation's largest member, so it is clear for
+      everyone) and returns to its slot once the way is clear again.
+    - If even that route point is out of sight, the member gets an individual path to
+      it for a short while (the only per-member A* a formation causes).
+    - The leader slows down, and finally waits, while members lag behind.
+
+  Membership ends when the member arrives, dies, is commanded again, or another
+  system (e.g. CombatSystem chasing an enemy) overwrites its MoveTarget.
+*/
+
+#include "ECS/SystemFormat.h"
+#include "ECS/Components.h"
+#include "NavGrid.h"
+#include "PathfindingSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class FormationSystem : public Engine::ECS::SystemBase
+{
+public:
+    FormationSystem(const NavGrid *grid)
+        : m_grid(grid)
+    {
+        setRequiredNames({"Position", "MoveTarget", "MoveSpeed", "Path"});
+        setExcludedNames({"Disabled", "Dead"});
+    }
+
+    const char *name() const override { return "FormationSystem"; }
+
+    // Leader routes are planned through the PathfindingSystem (same size classes and cache).
+    void setPathfinding(PathfindingSystem *pathfinding) { m_pathfinding = pathfinding; }
+
+    void buildMasks(Engine::ECS::ComponentRegistry &registry) override
+    {
+        Engine::ECS::SystemBase::buildMasks(registry);
+        m_moveTargetId = registry.ensureId("MoveTarget");
+    }
+
+    uint32_t activeFormations() const { return m_activeCount; }
+    uint64_t leaderSearches() const { return m_leaderSearches; }
+
+    /// Order `units` to (x, z) as one formation, facing the direction of travel.
+    /// The formation is created on the next update() (after the NavGrid is rebuilt).
+    void issueMove(const std::vector<Engine::ECS::Entity> &units, float x, float y, float z)
+    {
+        m_orders.push_back(Order{units, x, y, z});
+    }
+
+    void update(Engine::ECS::ECSContext &ecs, float dt) override
+    {
+        // Leader searches wait for a time-sliced full NavGrid rebuild to land.
+        if (!m_grid || !m_grid->rebuilding)
+        {
+            for (const Order &o : m_orders)
+                createFormation(ecs, o.units, o.x, o.y, o.z);
+            m_orders.clear();
+        }
+
+        m_activeCount = 0;
+        for (Formation &f : m_formations)
+        {
+            if (!f.alive)
+                continue;
+            updateFormation(ecs, f, dt);
+            if (f.alive)
+                ++m_activeCount;
+        }
+    }
+
+private:
+    struct Order
+    {
+        std::vector<Engine::ECS::Entity> units;
+        float x, y, z;
+    };
+
+    // Units already in another formation leave it first.
+    void createFormation(Engine::ECS::ECSContext &ecs, const std::vector<Engine::ECS::Entity> &units,
+                         float x, float y, float z)
+    {
+        for (const Engine::ECS::Entity e : units)
+            leave(ecs, e);
+
+        // Gather live members.
+        std::vector<Member> members;
+        members.reserve(units.size());
+        float cx = 0.0f, cz = 0.0f, maxRadius = 0.0f, minSpeed = 1e9f;
+        for (const Engine::ECS::Entity e : units)
+        {
+            Engine::ECS::ArchetypeStore *store = nullptr;
+            uint32_t row = 0;
+            if (!locate(ecs, e, store, row))
+                continue;
+
+            Member m;
+            m.entity = e;
+            m.baseSpeed = store->moveSpeeds()[row].value;
+            const float radius = store->hasRadius() ? store->radii()[row].r : 0.0f;
+            m.minClear = m_pathfinding ? m_pathfinding->clearanceFor(radius) : uint8_t(1);
+            members.push_back(m);
+
+            cx += store->positions()[row].x;
+            cz += store->positions()[row].z;
+            maxRadius = std::max(maxRadius, radius);
+            minSpeed = std::min(minSpeed, m.baseSpeed);
+        }
+        if (members.empty())
+            return;
+
+        if (members.size() < 2 || !m_grid || !m_pathfinding)
+        {
+            for (const Member &m : members)
+                moveIndividually(ecs, m.entity, x, y, z);
+            return;
+        }
+
+        cx /= static_cast<float>(members.size());
+        cz /= static_cast<float>(members.size());
+
+        // Leader starts at the centroid, or at the member nearest to it if the centroid
+        // is inside an obstacle (e.g. a group split around a wall).
+        const uint8_t leaderClear = m_pathfinding->clearanceFor(maxRadius);
+        float sx = cx, sz = cz;
+        if (!m_grid->isClear(m_grid->worldToGridX(cx), m_grid->worldToGridZ(cz), leaderClear))
+        {
+            float best = 1e18f;
+            for (const Member &m : members)
+            {
+                const Engine::ECS::Position *p = positionOf(ecs, m.entity);
+                if (!p)
+                    continue;
+                const float d2 = (p->x - cx) * (p->x - cx) + (p->z - cz) * (p->z - cz);
+                if (d2 < best)
+                {
+                    best = d2;
+                    sx = p->x;
+                    sz = p->z;
+                }
+            }
+        }
+
+        // One search for the whole formation.
+        Engine::ECS::Position start;
+        start.x = sx;
+        start.z = sz;
+        Engine::ECS::MoveTarget goal;
+        goal.x = x;
+        goal.y = y;
+        goal.z = z;
+        goal.active = 1;
+        Engine::ECS::Path leaderPath;
+        m_pathfinding->planPath(ecs.pathPool, start, goal, leaderPath, maxRadius, kLeaderMaxNodes);
+        if (!leaderPath.valid)
+        {
+            ecs.pathPool.release(leaderPath.handle);
+            for (const Member &m : members)
+                moveIndividually(ecs, m.entity, x, y, z);
+            return;
+        }
+        ++m_leaderSearches;
+
+        Formation &f = allocFormation();
+        f.route.clear();
+        f.route.push_back(sx);
+        f.route.push_back(sz);
+        if (leaderPath.count > 0)
+        {
+            const float *wp = ecs.pathPool.data(leaderPath.handle);
+            f.route.insert(f.route.end(), wp, wp + 2 * leaderPath.count);
+        }
+        else
+        {
+            f.route.push_back(x);
+            f.route.push_back(z);
+        }
+        ecs.pathPool.release(leaderPath.handle);
+
+        f.arc.assign(1, 0.0f);
+        for (size_t k = 2; k < f.route.size(); k += 2)
+            f.arc.push_back(f.arc.back() + std::hypot(f.route[k] - f.route[k - 2], f.route[k + 1] - f.route[k - 1]));
+        f.arcPos = 0.0f;
+        f.speed = minSpeed * kLeaderSpeedScale;
+        f.y = y;
+        f.arrived = false;
+
+        // Slot layout: square-ish block facing the first leg, row 0 in front.
+        float hx = 0.0f, hz = 1.0f;
+        headingAt(f, 0.0f, hx, hz);
+        const float spacing = std::max(kMinSpacing, 2.0f * maxRadius + kSlotGap);
+        assignSlots(ecs, members, cx, cz, hx, hz, spacing);
+
+        f.members = std::move(members);
+        const uint32_t fid = static_cast<uint32_t>(&f - m_formations.data());
+        for (const Member &m : f.members)
+        {
+            if (m.entity.index >= m_formationOf.size())
+                m_formationOf.resize(static_cast<size_t>(m.entity.index) + 1, 0u);
+            m_formationOf[m.entity.index] = fid + 1;
+        }
+    }
+
+    struct Member
+    {
+        Engine::ECS::Entity entity;
+        float lateral = 0.0f;   // slot offset along the leader's right axis
+        float forward = 0.0f;   // slot offset along the leader's heading
+        float baseSpeed = 0.0f; // MoveSpeed before joining (restored on leave)
+        float lastTx = 0.0f, lastTz = 0.0f; // MoveTarget we wrote last
+        float detachTimer = 0.0f;
+        float lag = 0.0f;       // distance to its slot (or route point) last frame
+        uint8_t minClear = 1;
+        bool written = false;
+        bool detached = false;
+        bool left = false;
+    };
+
+    struct Formation
+    {
+        std::vector<Member> members;
+        std::vector<float> route; // leader polyline, interleaved x/z (start first)
+        std::vector<float> arc;   // cumulative length at each route point
+        float arcPos = 0.0f;      // leader progress along the route
+        float speed = 0.0f;       // leader speed (slowest member * kLeaderSpeedScale)
+        float y = 0.0f;
+        bool arrived = false;
+        bool alive = false;
+    };
+
+    static constexpr float kLeaderSpeedScale = 0.85f; // headroom for members to catch up
+    static constexpr float kMinSpacing = 1.5f;
+    static constexpr float kSlotGap = 0.8f;           // free space between neighbouring units
+    static constexpr float kLookahead = 2.0f;         // seek ahead of a moving slot (no premature arrival)
+    static constexpr float kCatchupGain = 1.0f;       // extra speed per metre of along-track lag
+    static constexpr float kMinSpeedScale = 0.25f;    // slowest a member ahead of its slot is throttled to
+    static constexpr float kLagSlow = 3.0f;           // leader starts slowing at this member lag (m)
+    static constexpr float kLagStop = 8.0f;           // ...and waits from here on
+    static constexpr float kPaceQuantile = 0.9f;      // lag quantile the leader paces to
+    static constexpr float kDetachTime = 3.0f;        // individual path time before rejoining
+    static constexpr float kArriveRadius = 0.5f;      // matches SteeringSystem
+    static constexpr float kRetargetEpsilon = 0.02f;  // slot movement below this keeps the old MoveTarget
+    // One search serves the whole formation, so it can afford a larger budget than a unit's.
+    static constexpr int kLeaderMaxNodes = 4 * PathfindingSystem::kMaxNodes;
+
+    const NavGrid *m_grid = nullptr;
+    PathfindingSystem *m_pathfinding = nullptr;
+    std::vector<Order> m_orders;
+    std::vector<Formation> m_formations;
+    std::vector<float> m_lagScratch;
+    std::vector<uint32_t> m_formationOf; // entity index -> formation index + 1 (0 = none)
+    uint32_t m_activeCount = 0;
+    uint64_t m_leaderSearches = 0;
+    uint32_t m_moveTargetId = Engine::ECS::ComponentRegistry::InvalidID;
+
+    Formation &allocFormation()
+    {
+        for (Formation &f : m_formations)
+        {
+            if (!f.alive)
+            {
+                f.alive = true;
+                return f;
+            }
+        }
+        m_formations.emplace_back();
+        m_formations.back().alive = true;
+        return m_formations.back();
+    }
+
+    bool locate(Engine::ECS::ECSContext &ecs, Engine::ECS::Entity e, Engine::ECS::ArchetypeStore *&store,
+                uint32_t &row) const
+    {
+        const Engine::ECS::EntityRecord *rec = ecs.entities.find(e);
+        store = rec ? ecs.stores.get(rec->archetypeId) : nullptr;
+        if (!store || rec->row >= store->size())
+            return false;
+        if (!store->signature().containsAll(required()) || !store->signature().containsNone(excluded()))
+            return false;
+        row = rec->row;
+        return true;
+    }
+
+    // nullptr if `e` is gone (or no longer matches the system).
+    const Engine::ECS::Position *positionOf(Engine::ECS::ECSContext &ecs, Engine::ECS::Entity e) const
+    {
+        Engine::ECS::ArchetypeStore *store = nullptr;
+        uint32_t row = 0;
+        return locate(ecs, e, store, row) ? &store->positions()[row] : nullptr;
+    }
+
+    void moveIndividually(Engine::ECS::ECSContext &ecs, Engine::ECS::Entity e, float x, float y, float z)
+    {
+        Engine::ECS::ArchetypeStore *store = nullptr;
+        uint32_t row = 0;
+        if (!locate(ecs, e, store, row))
+            return;
+        auto &tgt = store->moveTargets()[row];
+        tgt.x = x;
+        tgt.y = y;
+        tgt.z = z;
+        tgt.active = 1;
+        store->paths()[row].valid = false;
+        ecs.markDirty(m_moveTargetId, ecs.entities.find(e)->archetypeId, row);
+    }
+
+    // Remove `e` from its formation (if any) and give back its own speed.
+    void leave(Engine::ECS::ECSContext &ecs, Engine::ECS::Entity e)
+    {
+        if (e.index >= m_formationOf.size() || m_formationOf[e.index] == 0)
+            return;
+        Formation &f = m_formations[m_formationOf[e.index] - 1];
+        for (Member &m : f.members)
+        {
+            if (!m.left && m.entity.index == e.index && m.entity.generation == e.generation)
+                release(ecs, m);
+        }
+    }
+
+    void release(Engine::ECS::ECSContext &ecs, Member &m)
+    {
+        m.left = true;
+        if (m.entity.index < m_formationOf.size())
+            m_formationOf[m.entity.index] = 0;
+
+        Engine::ECS::ArchetypeStore *store = nullptr;
+        uint32_t row = 0;
+        if (locate(ecs, m.entity, store, row))
+            store->moveSpeeds()[row].value = m.baseSpeed;
+    }
+
+    // Front-most units take the front row; within a row, left-most take the left slots,
+    // so nobody has to cross the block to reach their slot.
+    void assignSlots(Engine::ECS::ECSContext &ecs, std::vector<Member> &members, float cx, float cz,
+                     float hx, float hz, float spacing)
+    {
+        const float rx = hz, rz = -hx; // right axis
+        const size_t n = members.size();
+        const size_t cols = static_cast<size_t>(std::ceil(std::sqrt(static_cast<float>(n))));
+        const size_t rows = (n + cols - 1) / cols;
+
+        struct Proj
+        {
+            size_t member;
+            float fwd, lat;
+        };
+        std::vector<Proj> proj(n);
+        for (size_t k = 0; k < n; ++k)
+        {
+            const Engine::ECS::Position *p = positionOf(ecs, members[k].entity);
+            proj[k] = p ? Proj{k, (p->x - cx) * hx + (p->z - cz) * hz, (p->x - cx) * rx + (p->z - cz) * rz}
+                        : Proj{k, 0.0f, 0.0f}; // gone: any slot, dropped on the next update
+        }
+        std::sort(proj.begin(), proj.end(), [](const Proj &a, const Proj &b) { return a.fwd > b.fwd; });
+
+        for (size_t r = 0; r < rows; ++r)
+        {
+            const size_t begin = r * cols;
+            const size_t end = std::min(n, begin + cols);
+            std::sort(proj.begin() + begin, proj.begin() + end,
+                      [](const Proj &a, const Proj &b) { return a.lat < b.lat; });
+
+            // Centre a partial last row.
+            const float firstCol = static_cast<float>(cols - (end - begin)) * 0.5f;
+            for (size_t k = begin; k < end; ++k)
+            {
+                Member &m = members[proj[k].member];
+                m.lateral = (firstCol + static_cast<float>(k - begin) - (static_cast<float>(cols) - 1.0f) * 0.5f) * spacing;
+                m.forward = ((static_cast<float>(rows) - 1.0f) * 0.5f - static_cast<float>(r)) * spacing;
+            }
+        }
+    }
+
+    // Point on the leader route at arc length s (clamped to the route).
+    void pointAt(const Formation &f, float s, float &x, float &z) const
+    {
+        const size_t points = f.arc.size();
+        if (s <= 0.0f || points < 2)
+        {
+            x = f.route[0];
+            z = f.route[1];
+            return;
+        }
+        if (s >= f.arc.back())
+        {
+            x = f.route[2 * (points - 1)];
+            z = f.route[2 * (points - 1) + 1];
+            return;
+        }
+        const size_t k = static_cast<size_t>(std::upper_bound(f.arc.begin(), f.arc.end(), s) - f.arc.begin());
+        const float len = f.arc[k] - f.arc[k - 1];
+        const float t = len > 1e-6f ? (s - f.arc[k - 1]) / len : 0.0f;
+        x = f.route[2 * (k - 1)] + (f.route[2 * k] - f.route[2 * (k - 1)]) * t;
+        z = f.route[2 * (k - 1) + 1] + (f.route[2 * k + 1] - f.route[2 * (k - 1) + 1]) * t;
+    }
+
+    // Unit direction of the route leg containing arc length s.
+    void headingAt(const Formation &f, float s, float &hx, float &hz) const
+    {
+        const size_t points = f.arc.size();
+        size_t k = static_cast<size_t>(std::upper_bound(f.arc.begin(), f.arc.end(), s) - f.arc.begin());
+        k = std::max<size_t>(1, std::min(k, points - 1));
+        for (; k < points; ++k)
+        {
+            const float dx = f.route[2 * k] - f.route[2 * (k - 1)];
+            const float dz = f.route[2 * k + 1] - f.route[2 * (k - 1) + 1];
+            const float len = std::sqrt(dx * dx + dz * dz);
+            if (len > 1e-4f)
+            {
+                hx = dx / len;
+                hz = dz / len;
+                return;
+            }
+        }
+    }
+
+    bool visible(float x0, float z0, float x1, float z1, uint8_t minClear) const
+    {
+        const int tx = m_grid->worldToGridX(x1), tz = m_grid->worldToGridZ(z1);
+        return m_grid->isClear(tx, tz, minClear) &&
+               m_grid->lineCheckGrid(m_grid->worldToGridX(x0), m_grid->worldToGridZ(z0), tx, tz, minClear);
+    }
+
+    void updateFormation(Engine::ECS::ECSContext &ecs, Formation &f, float dt)
+    {
+        float hx = 0.0f, hz = 1.0f;
+        headingAt(f, f.arcPos, hx, hz);
+        float lx = 0.0f, lz = 0.0f;
+        pointAt(f, f.arcPos, lx, lz);
+
+        // 1. Drop members that died or were re-targeted by someone else; gather lag.
+        m_lagScratch.clear();
+        bool anyActive = false;
+        for (Member &m : f.members)
+        {
+            if (m.left)
+                continue;
+
+            Engine::ECS::ArchetypeStore *store = nullptr;
+            uint32_t row = 0;
+            if (!locate(ecs, m.entity, store, row))
+            {
+                release(ecs, m);
+                continue;
+            }
+
+            const auto &tgt = store->moveTargets()[row];
+            const auto &pos = store->positions()[row];
+            if (m.written)
+            {
+                const bool moved = std::fabs(tgt.x - m.lastTx) > 1e-3f || std::fabs(tgt.z - m.lastTz) > 1e-3f;
+                const bool stoppedElsewhere =
+                    !tgt.active && std::hypot(pos.x - m.lastTx, pos.z - m.lastTz) > 2.0f * kArriveRadius;
+                if (moved || stoppedElsewhere)
+                {
+                    release(ecs, m);
+                    continue;
+                }
+                if (f.arrived && !tgt.active)
+                {
+                    release(ecs, m); // reached its final slot
+                    continue;
+                }
+            }
+
+            anyActive = true;
+            if (!m.detached)
+                m_lagScratch.push_back(m.lag);
+        }
+
+        if (!anyActive)
+        {
+            f.alive = false;
+            f.members.clear();
+            return;
+        }
+
+        // 2. Advance the leader, slowing down / waiting while members lag behind. A high
+        //    quantile rather than the max, so a single stuck unit can't halt the block.
+        float lag = 0.0f;
+        if (!m_lagScratch.empty())
+        {
+            auto nth = m_lagScratch.begin() +
+                       static_cast<std::ptrdiff_t>(kPaceQuantile * static_cast<float>(m_lagScratch.size() - 1));
+            std::nth_element(m_lagScratch.begin(), nth, m_lagScratch.end());
+            lag = *nth;
+        }
+        const float pace = std::clamp(1.0f - (lag - kLagSlow) / (kLagStop - kLagSlow), 0.0f, 1.0f);
+        if (!f.arrived)
+        {
+            f.arcPos = std::min(f.arcPos + f.speed * pace * dt, f.arc.back());
+            f.arrived = f.arcPos >= f.arc.back();
+            headingAt(f, f.arcPos, hx, hz);
+            pointAt(f, f.arcPos, lx, lz);
+        }
+        const float leaderSpeed = f.arrived ? 0.0f : f.speed * pace;
+        const float ahead = (f.arrived || pace <= 0.0f) ? 0.0f : kLookahead;
+
+        // 3. Steer members toward their slots (or onto the route when the slot is blocked).
+        for (Member &m : f.members)
+        {
+            if (m.left)
+                continue;
+
+            Engine::ECS::ArchetypeStore *store = nullptr;
+            uint32_t row = 0;
+            if (!locate(ecs, m.entity, store, row))
+            {
+                release(ecs, m); // as in step 1
+                continue;
+            }
+            const uint32_t archetypeId = ecs.entities.find(m.entity)->archetypeId;
+            const auto &pos = store->positions()[row];
+            auto &tgt = store->moveTargets()[row];
+            auto &path = store->paths()[row];
+            auto &speed = store->moveSpeeds()[row];
+
+            if (m.detached)
+            {
+                m.detachTimer -= dt;
+                if (m.detachTimer > 0.0f && tgt.active)
+                    continue; // following its own path (PathfindingSystem + SteeringSystem)
+                m.detached = false;
+            }
+
+            float sx = lx + hz * m.lateral + hx * m.forward;
+            float sz = lz - hx * m.lateral + hz * m.forward;
+            float tx = sx + hx * ahead;
+            float tz = sz + hz * ahead;
+            clampToGrid(sx, sz); // edge formations: outer slots would hang off the map
+            clampToGrid(tx, tz);
+
+            if (!visible(pos.x, pos.z, tx, tz, m.minClear))
+            {
+                // Fall in on the leader's route at the slot's depth.
+                pointAt(f, f.arcPos + m.forward, sx, sz);
+                pointAt(f, f.arcPos + m.forward + ahead, tx, tz);
+                if (!visible(pos.x, pos.z, tx, tz, m.minClear))
+                {
+                    // Cut off from the route: individual path to it for a while.
+                    m.detached = true;
+                    m.detachTimer = kDetachTime;
+                    writeTarget(ecs, m, archetypeId, row, tgt, tx, tz, f.y);
+                    path.valid = false;
+                    speed.value = m.baseSpeed;
+                    continue;
+                }
+            }
+
+            writeTarget(ecs, m, archetypeId, row, tgt, tx, tz, f.y);
+            m.lag = std::hypot(sx - pos.x, sz - pos.z);
+
+            // Empty-but-valid path: PathfindingSystem leaves it alone, SteeringSystem seeks the target.
+            // The route it replaces (own order, detour) must not be re-planned on obstacle changes.
+            if (!path.valid || path.handle.isValid() || path.count != 0)
+            {
+                m_pathfinding->forgetRoute(m.entity);
+                ecs.pathPool.release(path.handle);
+                path.handle = Engine::ECS::PathPool::InvalidHandle;
+                path.count = 0;
+                path.current = 0;
+                path.valid = true;
+            }
+
+            // Match the leader's pace, plus catch-up on along-track error (positive = behind).
+            const float behind = (sx - pos.x) * hx + (sz - pos.z) * hz;
+            speed.value = f.arrived ? m.baseSpeed
+                                    : std::clamp(leaderSpeed + kCatchupGain * behind,
+                                                 kMinSpeedScale * f.speed, m.baseSpeed);
+        }
+    }
+
+    void clampToGrid(float &x, float &z) const
+    {
+        x = std::clamp(x, m_grid->gridToWorldX(0), m_grid->gridToWorldX(m_grid->width - 1));
+        z = std::clamp(z, m_grid->gridToWorldZ(0), m_grid->gridToWorldZ(m_grid->height - 1));
+    }
+
+    // Only a target that actually moved is written (and marked dirty): a member holding its
+    // slot keeps a clean MoveTarget, so it can fall asleep and stays out of dirty queries.
+    void writeTarget(Engine::ECS::ECSContext &ecs, Member &m, uint32_t archetypeId, uint32_t row,
+                     Engine::ECS::MoveTarget &tgt, float x, float z, float y)
+    {
+        if (m.written && std::fabs(x - m.lastTx) <= kRetargetEpsilon && std::fabs(z - m.lastTz) <= kRetargetEpsilon)
+            return;
+        tgt.x = x;
+        tgt.y = y;
+        tgt.z = z;
+        tgt.active = 1;
+        m.lastTx = x;
+        m.lastTz = z;
+        m.written = true;
+        ecs.markDirty(m_moveTargetId, archetypeId, row);
+    }
+};
@@ -9,10 +9,32 @@
   Requirements:
     - Components present in stores: "Position", "Velocity", "Radius", "AvoidanceParams".
         - Optional component: "Separation" (extra desired spacing beyond radii).
+        - Optional component: "MoveSpeed" (Reciprocal mode: top speed when sidestepping).
     - SpatialIndexSystem must have run earlier in the frame (grid built).
     - Steering should have already produced a "preferred" velocity, stored in Velocity.
       This system keeps final speeds close to that magnitude.
 
+  Kernel:
+    - Neighbors are gathered into a packed SoA batch and the separation push is computed
+      by AvoidanceKernel::separationPush (AVX2 / SSE2 / NEON, scalar fallback).
+
+  Modes:
+    - Separation (default): push apart overlapping units, then clamp / blend toward Velocity.
+    - Reciprocal: ORCA (see OrcaSolver.h). Picks the velocity closest to Velocity that stays
+      collision-free for AvoidanceParams::timeHorizon seconds against the nearest
+      maxNeighbors() units, so no blend smoothing is applied.
+    - The sample picks the mode from BattleConfig.json ("avoidance": {"mode", "maxNeighbors"}).
+
+  Threading:
+    - Double-buffered: rows to update are collected first, each row's new velocity is
+      solved from start-of-pass data into a scratch column, and the column is written back
+      after the pass. Rows are independent, so the solve is split across the JobSystem
+      (when set) and results are bitwise identical for any thread count or row order.
+
+  Sim-LOD:
+    - Rows with a SimLod that are not due this frame are deferred (kept dirty); due rows are
+      solved with their accumulated SimLod::stepDt.
+
   Suggested order per frame:
     CommandSystem -> SteeringSystem -> SpatialIndexSystem -> LocalAvoidanceSystem -> MovementSystem
 */
@@ -23,9 +45,15 @@
 
 // The grid index system for neighbor queries
 #include "systems/SpatialIndexSystem.h"
+#include "systems/AvoidanceKernel.h"
+#include "systems/OrcaSolver.h"
+#include "systems/SimLodSystem.h"
+
+#include "Engine/JobSystem.h"
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 class LocalAvoidanceSystem : public Engine::ECS::SystemBase
 {
@@ -35,7 +63,7 @@ public:
     {
         // Require the data we adjust/read
         setRequiredNames({"Position", "Velocity", "Radius", "AvoidanceParams"});
-        setExcludedNames({"Disabled", "Dead"});
+        setExcludedNames({"Disabled", "Dead", "Sleeping"});
     }
 
     const char *name() const override { return "LocalAvoidanceSystem"; }
@@ -48,6 +76,22 @@ public:
 
     void setGrid(const SpatialIndexSystem *grid) { m_grid = grid; }
 
+    enum class Mode
+    {
+        Separation, // overlap push, smoothed by AvoidanceParams strength / maxAccel / blend
+        Reciprocal  // ORCA half-planes over AvoidanceParams::timeHorizon, no smoothing
+    };
+
+    void setMode(Mode mode) { m_mode = mode; }
+    Mode mode() const { return m_mode; }
+
+    /// Reciprocal mode only: constrain against at most this many nearest neighbors.
+    void setMaxNeighbors(uint32_t maxNeighbors) { m_maxNeighbors = std::max(1u, maxNeighbors); }
+    uint32_t maxNeighbors() const { return m_maxNeighbors; }
+
+    /// Optional worker pool; without one the pass runs on the calling thread.
+    void setJobSystem(Engine::JobSystem *jobs) { m_jobs = jobs; }
+
     void update(Engine::ECS::ECSContext &ecs, float dt) override
     {
         if (!m_grid)
@@ -55,15 +99,6 @@ public:
         if (dt <= 0.0f)
             return;
 
-        auto clamp = [](float v, float a, float b)
-        { return std::max(a, std::min(v, b)); };
-        auto length2 = [](float x, float z)
-        { return x * x + z * z; };
-        auto length = [&](float x, float z)
-        { return std::sqrt(length2(x, z)); };
-        auto lerp = [](float a, float b, float t)
-        { return a + (b - a) * t; };
-
         if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
         {
             // Avoidance should run each frame for moving entities.
@@ -72,130 +107,284 @@ public:
             m_queryId = ecs.queries.createDirtyQuery(required(), excluded(), dirty, ecs.stores);
         }
 
+        cacheStores(ecs);
+
+        // Collect the rows to solve up front so the solve loop is a flat, splittable range.
+        m_work.clear();
         const auto &q = ecs.queries.get(m_queryId);
         for (uint32_t archetypeId : q.matchingArchetypeIds)
         {
-            auto *storePtr = ecs.stores.get(archetypeId);
+            const auto *storePtr = ecs.stores.get(archetypeId);
             if (!storePtr)
                 continue;
-            auto &store = *storePtr;
 
             auto dirtyRows = ecs.queries.consumeDirtyRows(m_queryId, archetypeId);
-            if (dirtyRows.empty())
-                continue;
-
-            auto &positions = const_cast<std::vector<Engine::ECS::Position> &>(store.positions());
-            auto &velocities = const_cast<std::vector<Engine::ECS::Velocity> &>(store.velocities());
-            auto &radii = const_cast<std::vector<Engine::ECS::Radius> &>(store.radii());
-            auto &params = const_cast<std::vector<Engine::ECS::AvoidanceParams> &>(store.avoidanceParams());
-            const bool hasSep = store.hasSeparation();
-            auto *sepsPtr = hasSep ? &const_cast<std::vector<Engine::ECS::Separation> &>(store.separations()) : nullptr;
-            const uint32_t n = store.size();
+            const uint32_t n = storePtr->size();
+            const Engine::ECS::SimLod *lods = storePtr->hasSimLod() ? storePtr->simLods().data() : nullptr;
             for (uint32_t row : dirtyRows)
             {
                 if (row >= n)
                     continue;
+                if (SimLodGate::skip(lods, row))
+                {
+                    ecs.queries.markRowDirty(m_queryId, archetypeId, row, n);
+                    continue;
+                }
+                m_work.push_back(WorkItem{archetypeId, row, SimLodGate::dt(lods, row, dt)});
+            }
+        }
+        if (m_work.empty())
+            return;
 
-                auto &p = positions[row];
-                auto &v = velocities[row];
-                const auto &r = radii[row];
-                const auto &ap = params[row];
-                const float sepSelf = sepsPtr ? (*sepsPtr)[row].value : 0.0f;
-
-                // Accumulate separation correction from neighbors in 3x3 cells
-                float corrX = 0.0f, corrZ = 0.0f;
+        // Solve: every item reads only start-of-pass columns and writes only its own slot
+        // in m_next, so the result is independent of thread count and chunk order.
+        m_next.resize(m_work.size());
+        const uint32_t threads = m_jobs ? m_jobs->threadCount() : 1u;
+        if (m_scratch.size() < threads)
+            m_scratch.resize(threads);
 
-                m_grid->forNeighbors(p.x, p.z, [&](uint32_t nStoreId, uint32_t nRow)
-                                     {
-                    // Skip self
-                    if (nStoreId == archetypeId && nRow == row) return;
+        const Engine::JobSystem::ChunkFn solveRange = [&](uint32_t begin, uint32_t end, uint32_t thread)
+        {
+            Scratch &scratch = m_scratch[thread];
+            for (uint32_t k = begin; k < end; ++k)
+                m_next[k] = solve(m_work[k], scratch);
+        };
+        if (m_jobs)
+            m_jobs->parallelFor(static_cast<uint32_t>(m_work.size()), kGrain, solveRange);
+        else
+            solveRange(0, static_cast<uint32_t>(m_work.size()), 0);
+
+        // Swap the scratch column in and propagate dirtiness (single-threaded: markDirty isn't thread-safe).
+        for (size_t k = 0; k < m_work.size(); ++k)
+        {
+            const WorkItem &w = m_work[k];
+            auto &v = ecs.stores.get(w.archetypeId)->velocities()[w.row];
+            const float dv1 = std::fabs(m_next[k].x - v.x) + std::fabs(m_next[k].z - v.z);
+            v.x = m_next[k].x;
+            v.z = m_next[k].z;
+            // Leave v.y unchanged (height axis)
+
+            // Only propagate/keep active if still moving or velocity actually changed.
+            const float speed1 = std::fabs(v.x) + std::fabs(v.y) + std::fabs(v.z);
+            if (dv1 > 1e-6f || speed1 > 1e-6f)
+                ecs.markDirty(m_velocityId, w.archetypeId, w.row);
+        }
+    }
 
-                    const auto* nStore = ecs.stores.get(nStoreId);
-                    if (!nStore) return;
-                    if (!nStore->hasPosition()) return;
-                    if (!nStore->hasRadius()) return;
-                    const bool nHasSep = nStore->hasSeparation();
+private:
+    static constexpr uint32_t kDefaultMaxNeighbors = 10;
+    static constexpr uint32_t kGrain = 64; // rows per parallel chunk
 
-                    const auto& np = nStore->positions()[nRow];
-                    const auto& nr = nStore->radii()[nRow];
-                    const float sepOther = (nHasSep ? nStore->separations()[nRow].value : 0.0f);
+    struct WorkItem
+    {
+        uint32_t archetypeId;
+        uint32_t row;
+        float dt; // frame dt, or the accumulated SimLod step
+    };
 
-                    // 2D separation in gameplay ground plane (X/Z). Y is height.
-                    float dx = p.x - np.x;
-                    float dz = p.z - np.z;
+    struct VelocityXZ
+    {
+        float x = 0.0f;
+        float z = 0.0f;
+    };
 
-                    const float dist2 = dx*dx + dz*dz;
+    // Column pointers of every store, indexed by store id, so the gather loop does no
+    // per-candidate store lookups or has*() checks. Null where the store lacks the column.
+    struct StoreColumns
+    {
+        const Engine::ECS::Position *positions = nullptr;
+        const Engine::ECS::Velocity *velocities = nullptr;
+        const Engine::ECS::Radius *radii = nullptr;
+        const Engine::ECS::Separation *separations = nullptr;
+        const Engine::ECS::AvoidanceParams *params = nullptr;
+        const Engine::ECS::MoveSpeed *moveSpeeds = nullptr;
+    };
+
+    // Per-thread working memory.
+    struct Scratch
+    {
+        AvoidanceKernel::NeighborBatch batch;
+        OrcaSolver orca;
+        std::vector<OrcaSolver::Neighbor> orcaNeighbors;
+        std::vector<float> orcaDistSq;
+        std::vector<uint32_t> orcaOrder;
+    };
+
+    void cacheStores(Engine::ECS::ECSContext &ecs)
+    {
+        const auto &stores = ecs.stores.stores();
+        m_stores.assign(stores.size(), StoreColumns{});
+        for (size_t id = 0; id < stores.size(); ++id)
+        {
+            const auto &ptr = stores[id];
+            if (!ptr || !ptr->hasPosition() || !ptr->hasRadius())
+                continue;
+            StoreColumns &sc = m_stores[id];
+            sc.positions = ptr->positions().data();
+            sc.radii = ptr->radii().data();
+            if (ptr->hasVelocity())
+                sc.velocities = ptr->velocities().data();
+            if (ptr->hasSeparation())
+                sc.separations = ptr->separations().data();
+            if (ptr->hasAvoidanceParams())
+                sc.params = ptr->avoidanceParams().data();
+            if (ptr->hasMoveSpeed())
+                sc.moveSpeeds = ptr->moveSpeeds().data();
+        }
+    }
 
-                    float dist = (dist2 > 1e-12f) ? std::sqrt(dist2) : 0.0f;
+    VelocityXZ solve(const WorkItem &w, Scratch &scratch) const
+    {
+        const float dt = w.dt;
+        const StoreColumns &self = m_stores[w.archetypeId];
+        const uint32_t row = w.row;
+        const auto &p = self.positions[row];
+        const auto &v = self.velocities[row];
+        const auto &ap = self.params[row];
+        const float radius = self.radii[row].r;
+        const float sepSelf = self.separations ? self.separations[row].value : 0.0f;
+
+        if (m_mode == Mode::Reciprocal)
+        {
+            const float moveSpeed = self.moveSpeeds ? self.moveSpeeds[row].value : 0.0f;
+            return reciprocalVelocity(w, p, v, radius, sepSelf, moveSpeed, ap, dt, scratch);
+        }
+        return separationVelocity(w, p, v, radius, sepSelf, ap, dt, scratch);
+    }
 
-                    const float desiredSeparation = sepSelf + sepOther;
-                    const float desiredDist = (r.r + nr.r) + desiredSeparation;
+    VelocityXZ separationVelocity(const WorkItem &w, const Engine::ECS::Position &p, const Engine::ECS::Velocity &v,
+                                  float radius, float sepSelf, const Engine::ECS::AvoidanceParams &ap, float dt,
+                                  Scratch &scratch) const
+    {
+        auto clamp = [](float x, float a, float b)
+        { return std::max(a, std::min(x, b)); };
+        auto length = [](float x, float z)
+        { return std::sqrt(x * x + z * z); };
+        auto lerp = [](float a, float b, float t)
+        { return a + (b - a) * t; };
 
-                    // Overlap weight: strong when overlapping
-                    float wOverlap = 0.0f;
-                    if (dist < desiredDist && dist > 1e-6f)
-                        wOverlap = (desiredDist - dist) / desiredDist;
+        // Gather neighbors from the 3x3 cells into the batch, then evaluate them in one pass.
+        AvoidanceKernel::NeighborBatch &batch = scratch.batch;
+        batch.clear();
+        m_grid->forNeighbors(p.x, p.z, [&](uint32_t nStoreId, uint32_t nRow)
+                             {
+            // Skip self
+            if (nStoreId == w.archetypeId && nRow == w.row) return;
+            if (nStoreId >= m_stores.size()) return;
 
-                    // Only react within desiredDist (no extra neighborRadius).
-                    float w = wOverlap;
-                    if (w <= 0.0f) return;
+            const StoreColumns& ns = m_stores[nStoreId];
+            if (!ns.positions) return;
 
-                    // Normalize away vector
-                    if (dist > 1e-6f) { dx /= dist; dz /= dist; } else { dx = 0.0f; dz = 0.0f; }
+            // 2D separation in gameplay ground plane (X/Z). Y is height.
+            const auto& np = ns.positions[nRow];
+            batch.push(np.x, np.z, ns.radii[nRow].r, ns.separations ? ns.separations[nRow].value : 0.0f); });
 
-                    corrX += dx * w;
-                    corrZ += dz * w; });
+        const AvoidanceKernel::Push push = AvoidanceKernel::separationPush(p.x, p.z, radius, sepSelf, batch);
 
-                // Combine correction with preferred velocity (from Steering)
-                const float vPrefX = v.x;
-                const float vPrefZ = v.z;
-                const float prefSpeed = length(vPrefX, vPrefZ);
+        // Combine correction with preferred velocity (from Steering)
+        const float vPrefX = v.x;
+        const float vPrefZ = v.z;
+        const float prefSpeed = length(vPrefX, vPrefZ);
 
-                // Apply strength
-                float vRawX = vPrefX + ap.strength * corrX;
-                float vRawZ = vPrefZ + ap.strength * corrZ;
+        // Apply strength
+        float vRawX = vPrefX + ap.strength * push.x;
+        float vRawZ = vPrefZ + ap.strength * push.z;
 
-                // Clamp speed to preferred magnitude (keeps MoveSpeed implicit)
-                const float rawSpeed = length(vRawX, vRawZ);
-                if (prefSpeed > 1e-6f && rawSpeed > prefSpeed)
-                {
-                    const float s = prefSpeed / rawSpeed;
-                    vRawX *= s;
-                    vRawZ *= s;
-                }
+        // Clamp speed to preferred magnitude (keeps MoveSpeed implicit)
+        const float rawSpeed = length(vRawX, vRawZ);
+        if (prefSpeed > 1e-6f && rawSpeed > prefSpeed)
+        {
+            const float s = prefSpeed / rawSpeed;
+            vRawX *= s;
+            vRawZ *= s;
+        }
 
-                // Acceleration clamp relative to vPref
-                float dvX = vRawX - vPrefX;
-                float dvZ = vRawZ - vPrefZ;
-                const float dvMag = length(dvX, dvZ);
-                const float maxDv = ap.maxAccel * dt;
-                if (dvMag > maxDv && dvMag > 1e-6f)
-                {
-                    const float s = maxDv / dvMag;
-                    dvX *= s;
-                    dvZ *= s;
-                }
+        // Acceleration clamp relative to vPref
+        float dvX = vRawX - vPrefX;
+        float dvZ = vRawZ - vPrefZ;
+        const float dvMag = length(dvX, dvZ);
+        const float maxDv = ap.maxAccel * dt;
+        if (dvMag > maxDv && dvMag > 1e-6f)
+        {
+            const float s = maxDv / dvMag;
+            dvX *= s;
+            dvZ *= s;
+        }
 
-                const float vNewX = vPrefX + dvX;
-                const float vNewZ = vPrefZ + dvZ;
+        const float vNewX = vPrefX + dvX;
+        const float vNewZ = vPrefZ + dvZ;
 
-                // Smooth the change to reduce jitter
-                const float t = clamp(ap.blend, 0.0f, 1.0f);
-                v.x = lerp(vPrefX, vNewX, t);
-                v.z = lerp(vPrefZ, vNewZ, t);
-                // Leave v.y unchanged (height axis)
+        // Smooth the change to reduce jitter
+        const float t = clamp(ap.blend, 0.0f, 1.0f);
+        return VelocityXZ{lerp(vPrefX, vNewX, t), lerp(vPrefZ, vNewZ, t)};
+    }
 
-                // Only propagate/keep active if still moving or velocity actually changed.
-                const float dv1 = std::fabs(v.x - vPrefX) + std::fabs(v.z - vPrefZ);
-                const float speed1 = std::fabs(v.x) + std::fabs(v.y) + std::fabs(v.z);
-                if (dv1 > 1e-6f || speed1 > 1e-6f)
-                    ecs.markDirty(m_velocityId, archetypeId, row);
-            }
+    VelocityXZ reciprocalVelocity(const WorkItem &w, const Engine::ECS::Position &p, const Engine::ECS::Velocity &v,
+                                  float radius, float sepSelf, float moveSpeed,
+                                  const Engine::ECS::AvoidanceParams &ap, float dt, Scratch &scratch) const
+    {
+        auto &neighbors = scratch.orcaNeighbors;
+        auto &distSq = scratch.orcaDistSq;
+        auto &order = scratch.orcaOrder;
+        neighbors.clear();
+        distSq.clear();
+        m_grid->forNeighbors(p.x, p.z, [&](uint32_t nStoreId, uint32_t nRow)
+                             {
+            if (nStoreId == w.archetypeId && nRow == w.row) return;
+            if (nStoreId >= m_stores.size()) return;
+
+            const StoreColumns& ns = m_stores[nStoreId];
+            if (!ns.positions) return;
+
+            OrcaSolver::Neighbor nb;
+            nb.relPos = OrcaSolver::Vec2{ns.positions[nRow].x - p.x, ns.positions[nRow].z - p.z};
+            if (ns.velocities)
+                nb.vel = OrcaSolver::Vec2{ns.velocities[nRow].x, ns.velocities[nRow].z};
+            const float sepOther = ns.separations ? ns.separations[nRow].value : 0.0f;
+            nb.combinedRadius = (radius + ns.radii[nRow].r) + (sepSelf + sepOther);
+            // Idle neighbors don't run avoidance, so take the whole correction ourselves.
+            nb.responsibility = (nb.vel.x * nb.vel.x + nb.vel.z * nb.vel.z > 1e-6f) ? 0.5f : 1.0f;
+
+            neighbors.push_back(nb);
+            distSq.push_back(nb.relPos.x * nb.relPos.x + nb.relPos.z * nb.relPos.z); });
+
+        uint32_t count = static_cast<uint32_t>(neighbors.size());
+        if (count > m_maxNeighbors)
+        {
+            // Keep the nearest m_maxNeighbors (ties broken by gather order, so results are stable).
+            order.resize(count);
+            for (uint32_t i = 0; i < count; ++i)
+                order[i] = i;
+            std::nth_element(order.begin(), order.begin() + m_maxNeighbors, order.end(),
+                             [&](uint32_t a, uint32_t b)
+                             { return distSq[a] < distSq[b] || (distSq[a] == distSq[b] && a < b); });
+            order.resize(m_maxNeighbors);
+            std::sort(order.begin(), order.end());
+            for (uint32_t i = 0; i < m_maxNeighbors; ++i)
+                neighbors[i] = neighbors[order[i]];
+            count = m_maxNeighbors;
         }
+
+        // Steering already blended toward the goal, so Velocity is both the current and the
+        // preferred velocity. Allow up to MoveSpeed when sidestepping so a unit slowed down by
+        // a jam can still get out of the way (falls back to the preferred speed without it).
+        const OrcaSolver::Vec2 pref{v.x, v.z};
+        const float maxSpeed = std::max(moveSpeed, std::sqrt(pref.x * pref.x + pref.z * pref.z));
+        const OrcaSolver::Vec2 out = scratch.orca.solve(pref, pref, maxSpeed, ap.timeHorizon, dt,
+                                                        neighbors.data(), count);
+        return VelocityXZ{out.x, out.z};
     }
 
-private:
     const SpatialIndexSystem *m_grid = nullptr; // not owned
+    Engine::JobSystem *m_jobs = nullptr;        // not owned
     uint32_t m_velocityId = Engine::ECS::ComponentRegistry::InvalidID;
     Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
-};
\ No newline at end of file
+
+    Mode m_mode = Mode::Separation;
+    uint32_t m_maxNeighbors = kDefaultMaxNeighbors;
+
+    std::vector<StoreColumns> m_stores;
+    std::vector<WorkItem> m_work;
+    std::vector<VelocityXZ> m_next; // double buffer: solved velocities, swapped in after the pass
+    std::vector<Scratch> m_scratch; // one per JobSystem thread
+};
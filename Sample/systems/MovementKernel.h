@@ -0,0 +1,392 @@
+#pragma once
+/*
+  MovementKernel.h
+  ----------------
+  Purpose:
+    - Vectorized inner loops for MovementSystem (integrate) and SteeringSystem (arrive test +
+      velocity blend). Both systems gather their dirty rows into packed SoA float streams
+      (one array per x / y / z field), run the kernel 8 (AVX2) or 4 (SSE2 / NEON) rows per
+      instruction, and scatter the results back to the component rows.
+    - Define STRATO_MOVEMENT_SCALAR to force the scalar fallback.
+
+  Why streams instead of SoA components:
+    - Position / Velocity / MoveTarget stay {x, y, z} structs in ArchetypeStore because every
+      system, prefab default and archetype migration addresses them as structs. The streams
+      are the SoA layout for the hot loops only; gather/scatter is a linear pass over the
+      dirty rows, and MovementBench measures it against the kernel on pre-packed streams.
+
+  Determinism:
+    - Lanes compute exactly what the scalar reference does (IEEE sqrt / divide, same operation
+      order), so integrate() / steer() match integrateScalar() / steerScalar() bitwise unless
+      the compiler fuses multiply-adds in one of them.
+
+  Padding:
+    - seal() rounds the stream length up to kLanes. Padding lanes have zero velocity (never
+      moving) and a negative arrival radius with a zero offset (neither arrived nor steered).
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if !defined(STRATO_MOVEMENT_SCALAR)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define STRATO_MOVEMENT_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STRATO_MOVEMENT_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define STRATO_MOVEMENT_NEON 1
+#endif
+#endif
+
+namespace MovementKernel
+{
+#if defined(STRATO_MOVEMENT_AVX2)
+    constexpr uint32_t kLanes = 8;
+    constexpr const char *kIsaName = "AVX2";
+#elif defined(STRATO_MOVEMENT_SSE2)
+    constexpr uint32_t kLanes = 4;
+    constexpr const char *kIsaName = "SSE2";
+#elif defined(STRATO_MOVEMENT_NEON)
+    constexpr uint32_t kLanes = 4;
+    constexpr const char *kIsaName = "NEON";
+#else
+    constexpr uint32_t kLanes = 4;
+    constexpr const char *kIsaName = "scalar";
+#endif
+
+    // |vx| + |vy| + |vz| at or below this is "not moving" (MovementSystem's historical cut-off).
+    constexpr float kMinSpeedL1 = 1e-6f;
+    // Squared distance below which the steering direction is undefined.
+    constexpr float kMinSteerDist2 = 1e-8f;
+
+    namespace detail
+    {
+        inline uint32_t padded(uint32_t count) { return (count + kLanes - 1) / kLanes * kLanes; }
+
+        inline void growTo(std::vector<float> &v, uint32_t need)
+        {
+            if (v.size() < need)
+                v.resize(need < 64 ? 64 : need * 2);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------
+    // Integrate: p += v * dt for rows that are moving.
+    // ---------------------------------------------------------------------------------
+
+    struct IntegrateStreams
+    {
+        std::vector<float> px, py, pz, vx, vy, vz;
+        std::vector<uint8_t> moving; // out: 1 when the row moved this step
+        uint32_t count = 0;
+
+        void clear() { count = 0; }
+
+        void push(float x, float y, float z, float velX, float velY, float velZ)
+        {
+            const uint32_t i = count++;
+            if (count > px.size())
+                reserve(count);
+            px[i] = x;
+            py[i] = y;
+            pz[i] = z;
+            vx[i] = velX;
+            vy[i] = velY;
+            vz[i] = velZ;
+        }
+
+        uint32_t seal()
+        {
+            const uint32_t n = detail::padded(count);
+            reserve(n);
+            for (uint32_t i = count; i < n; ++i)
+                px[i] = py[i] = pz[i] = vx[i] = vy[i] = vz[i] = 0.0f;
+            return n;
+        }
+
+        void reserve(uint32_t n)
+        {
+            for (auto *v : {&px, &py, &pz, &vx, &vy, &vz})
+                detail::growTo(*v, n);
+            if (moving.size() < px.size())
+                moving.resize(px.size());
+        }
+    };
+
+    inline void integrateScalar(IntegrateStreams &s, float dt)
+    {
+        const uint32_t n = s.seal();
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const bool moving = (std::fabs(s.vx[i]) + std::fabs(s.vy[i]) + std::fabs(s.vz[i])) > kMinSpeedL1;
+            s.moving[i] = moving ? 1 : 0;
+            if (!moving)
+                continue;
+            s.px[i] = s.px[i] + s.vx[i] * dt;
+            s.py[i] = s.py[i] + s.vy[i] * dt;
+            s.pz[i] = s.pz[i] + s.vz[i] * dt;
+        }
+    }
+
+    inline void integrate(IntegrateStreams &s, float dt)
+    {
+#if defined(STRATO_MOVEMENT_AVX2)
+        const uint32_t n = s.seal();
+        const __m256 vdt = _mm256_set1_ps(dt);
+        const __m256 vmin = _mm256_set1_ps(kMinSpeedL1);
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        for (uint32_t i = 0; i < n; i += kLanes)
+        {
+            const __m256 vx = _mm256_loadu_ps(&s.vx[i]);
+            const __m256 vy = _mm256_loadu_ps(&s.vy[i]);
+            const __m256 vz = _mm256_loadu_ps(&s.vz[i]);
+            const __m256 l1 = _mm256_add_ps(_mm256_add_ps(_mm256_and_ps(vx, absMask), _mm256_and_ps(vy, absMask)),
+                                            _mm256_and_ps(vz, absMask));
+            const __m256 mask = _mm256_cmp_ps(l1, vmin, _CMP_GT_OQ);
+            const __m256 px = _mm256_loadu_ps(&s.px[i]);
+            const __m256 py = _mm256_loadu_ps(&s.py[i]);
+            const __m256 pz = _mm256_loadu_ps(&s.pz[i]);
+            _mm256_storeu_ps(&s.px[i], _mm256_blendv_ps(px, _mm256_add_ps(px, _mm256_mul_ps(vx, vdt)), mask));
+            _mm256_storeu_ps(&s.py[i], _mm256_blendv_ps(py, _mm256_add_ps(py, _mm256_mul_ps(vy, vdt)), mask));
+            _mm256_storeu_ps(&s.pz[i], _mm256_blendv_ps(pz, _mm256_add_ps(pz, _mm256_mul_ps(vz, vdt)), mask));
+            const int bits = _mm256_movemask_ps(mask);
+            for (uint32_t l = 0; l < kLanes; ++l)
+                s.moving[i + l] = static_cast<uint8_t>((bits >> l) & 1);
+        }
+#elif defined(STRATO_MOVEMENT_SSE2)
+        const uint32_t n = s.seal();
+        const __m128 vdt = _mm_set1_ps(dt);
+        const __m128 vmin = _mm_set1_ps(kMinSpeedL1);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        auto select = [](__m128 mask, __m128 a, __m128 b) // mask ? a : b
+        { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+        for (uint32_t i = 0; i < n; i += kLanes)
+        {
+            const __m128 vx = _mm_loadu_ps(&s.vx[i]);
+            const __m128 vy = _mm_loadu_ps(&s.vy[i]);
+            const __m128 vz = _mm_loadu_ps(&s.vz[i]);
+            const __m128 l1 = _mm_add_ps(_mm_add_ps(_mm_and_ps(vx, absMask), _mm_and_ps(vy, absMask)),
+                                         _mm_and_ps(vz, absMask));
+            const __m128 mask = _mm_cmpgt_ps(l1, vmin);
+            const __m128 px = _mm_loadu_ps(&s.px[i]);
+            const __m128 py = _mm_loadu_ps(&s.py[i]);
+            const __m128 pz = _mm_loadu_ps(&s.pz[i]);
+            _mm_storeu_ps(&s.px[i], select(mask, _mm_add_ps(px, _mm_mul_ps(vx, vdt)), px));
+            _mm_storeu_ps(&s.py[i], select(mask, _mm_add_ps(py, _mm_mul_ps(vy, vdt)), py));
+            _mm_storeu_ps(&s.pz[i], select(mask, _mm_add_ps(pz, _mm_mul_ps(vz, vdt)), pz));
+            const int bits = _mm_movemask_ps(mask);
+            for (uint32_t l = 0; l < kLanes; ++l)
+                s.moving[i + l] = static_cast<uint8_t>((bits >> l) & 1);
+        }
+#elif defined(STRATO_MOVEMENT_NEON)
+        const uint32_t n = s.seal();
+        const float32x4_t vdt = vdupq_n_f32(dt);
+        const float32x4_t vmin = vdupq_n_f32(kMinSpeedL1);
+        for (uint32_t i = 0; i < n; i += kLanes)
+        {
+            const float32x4_t vx = vld1q_f32(&s.vx[i]);
+            const float32x4_t vy = vld1q_f32(&s.vy[i]);
+            const float32x4_t vz = vld1q_f32(&s.vz[i]);
+            const float32x4_t l1 = vaddq_f32(vaddq_f32(vabsq_f32(vx), vabsq_f32(vy)), vabsq_f32(vz));
+            const uint32x4_t mask = vcgtq_f32(l1, vmin);
+            const float32x4_t px = vld1q_f32(&s.px[i]);
+            const float32x4_t py = vld1q_f32(&s.py[i]);
+            const float32x4_t pz = vld1q_f32(&s.pz[i]);
+            vst1q_f32(&s.px[i], vbslq_f32(mask, vaddq_f32(px, vmulq_f32(vx, vdt)), px));
+            vst1q_f32(&s.py[i], vbslq_f32(mask, vaddq_f32(py, vmulq_f32(vy, vdt)), py));
+            vst1q_f32(&s.pz[i], vbslq_f32(mask, vaddq_f32(pz, vmulq_f32(vz, vdt)), pz));
+            uint32_t lanes[kLanes];
+            vst1q_u32(lanes, mask);
+            for (uint32_t l = 0; l < kLanes; ++l)
+                s.moving[i + l] = lanes[l] ? 1 : 0;
+        }
+#else
+        integrateScalar(s, dt);
+#endif
+    }
+
+    // ---------------------------------------------------------------------------------
+    // Steer: arrival test against the current target, then blend the velocity toward
+    // target direction * speed. Arrived lanes keep their velocity (the caller advances the
+    // path or stops the unit); lanes on top of their target are left untouched as well, so
+    // with radius2 >= kMinSteerDist2 every lane that did not arrive was steered.
+    // ---------------------------------------------------------------------------------
+
+    struct SteerStreams
+    {
+        std::vector<float> px, pz, vx, vz, tx, tz;
+        std::vector<float> speed, radius2, blend;
+        std::vector<uint8_t> arrived; // out: 1 when within sqrt(radius2) of (tx, tz)
+        uint32_t count = 0;
+
+        void clear() { count = 0; }
+
+        void push(float x, float z, float velX, float velZ, float targetX, float targetZ,
+                  float maxSpeed, float arriveRadius2, float blendFactor)
+        {
+            const uint32_t i = count++;
+            if (count > px.size())
+                reserve(count);
+            px[i] = x;
+            pz[i] = z;
+            vx[i] = velX;
+            vz[i] = velZ;
+            tx[i] = targetX;
+            tz[i] = targetZ;
+            speed[i] = maxSpeed;
+            radius2[i] = arriveRadius2;
+            blend[i] = blendFactor;
+        }
+
+        uint32_t seal()
+        {
+            const uint32_t n = detail::padded(count);
+            reserve(n);
+            for (uint32_t i = count; i < n; ++i)
+            {
+                px[i] = pz[i] = vx[i] = vz[i] = tx[i] = tz[i] = 0.0f;
+                speed[i] = blend[i] = 0.0f;
+                radius2[i] = -1.0f;
+            }
+            return n;
+        }
+
+        void reserve(uint32_t n)
+        {
+            for (auto *v : {&px, &pz, &vx, &vz, &tx, &tz, &speed, &radius2, &blend})
+                detail::growTo(*v, n);
+            if (arrived.size() < px.size())
+                arrived.resize(px.size());
+        }
+    };
+
+    // Single-lane reference; SteeringSystem also uses it to re-steer after a waypoint advance.
+    // Returns false (velocity untouched) when the point is on top of the target.
+    inline bool steerLane(float px, float pz, float &vx, float &vz, float tx, float tz,
+                          float speed, float blend)
+    {
+        const float dx = tx - px;
+        const float dz = tz - pz;
+        const float d2 = dx * dx + dz * dz;
+        if (!(d2 > kMinSteerDist2))
+            return false;
+        const float invDist = 1.0f / std::sqrt(d2);
+        const float targetVx = (dx * invDist) * speed;
+        const float targetVz = (dz * invDist) * speed;
+        vx = vx + (targetVx - vx) * blend;
+        vz = vz + (targetVz - vz) * blend;
+        return true;
+    }
+
+    inline void steerScalar(SteerStreams &s)
+    {
+        const uint32_t n = s.seal();
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const float dx = s.tx[i] - s.px[i];
+            const float dz = s.tz[i] - s.pz[i];
+            const bool arrived = (dx * dx + dz * dz) <= s.radius2[i];
+            s.arrived[i] = arrived ? 1 : 0;
+            if (!arrived)
+                (void)steerLane(s.px[i], s.pz[i], s.vx[i], s.vz[i], s.tx[i], s.tz[i], s.speed[i], s.blend[i]);
+        }
+    }
+
+    inline void steer(SteerStreams &s)
+    {
+#if defined(STRATO_MOVEMENT_AVX2)
+        const uint32_t n = s.seal();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 vmin = _mm256_set1_ps(kMinSteerDist2);
+        for (uint32_t i = 0; i < n; i += kLanes)
+        {
+            const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&s.tx[i]), _mm256_loadu_ps(&s.px[i]));
+            const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&s.tz[i]), _mm256_loadu_ps(&s.pz[i]));
+            const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dz, dz));
+            const __m256 arrived = _mm256_cmp_ps(d2, _mm256_loadu_ps(&s.radius2[i]), _CMP_LE_OQ);
+            const __m256 steerMask = _mm256_andnot_ps(arrived, _mm256_cmp_ps(d2, vmin, _CMP_GT_OQ));
+
+            const __m256 invDist = _mm256_div_ps(one, _mm256_sqrt_ps(d2));
+            const __m256 speed = _mm256_loadu_ps(&s.speed[i]);
+            const __m256 blend = _mm256_loadu_ps(&s.blend[i]);
+            const __m256 vx = _mm256_loadu_ps(&s.vx[i]);
+            const __m256 vz = _mm256_loadu_ps(&s.vz[i]);
+            const __m256 tvx = _mm256_mul_ps(_mm256_mul_ps(dx, invDist), speed);
+            const __m256 tvz = _mm256_mul_ps(_mm256_mul_ps(dz, invDist), speed);
+            const __m256 nvx = _mm256_add_ps(vx, _mm256_mul_ps(_mm256_sub_ps(tvx, vx), blend));
+            const __m256 nvz = _mm256_add_ps(vz, _mm256_mul_ps(_mm256_sub_ps(tvz, vz), blend));
+            _mm256_storeu_ps(&s.vx[i], _mm256_blendv_ps(vx, nvx, steerMask));
+            _mm256_storeu_ps(&s.vz[i], _mm256_blendv_ps(vz, nvz, steerMask));
+
+            const int bits = _mm256_movemask_ps(arrived);
+            for (uint32_t l = 0; l < kLanes; ++l)
+                s.arrived[i + l] = static_cast<uint8_t>((bits >> l) & 1);
+        }
+#elif defined(STRATO_MOVEMENT_SSE2)
+        const uint32_t n = s.seal();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 vmin = _mm_set1_ps(kMinSteerDist2);
+        auto select = [](__m128 mask, __m128 a, __m128 b) // mask ? a : b
+        { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+        for (uint32_t i = 0; i < n; i += kLanes)
+        {
+            const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&s.tx[i]), _mm_loadu_ps(&s.px[i]));
+            const __m128 dz = _mm_sub_ps(_mm_loadu_ps(&s.tz[i]), _mm_loadu_ps(&s.pz[i]));
+            const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz));
+            const __m128 arrived = _mm_cmple_ps(d2, _mm_loadu_ps(&s.radius2[i]));
+            const __m128 steerMask = _mm_andnot_ps(arrived, _mm_cmpgt_ps(d2, vmin));
+
+            const __m128 invDist = _mm_div_ps(one, _mm_sqrt_ps(d2));
+            const __m128 speed = _mm_loadu_ps(&s.speed[i]);
+            const __m128 blend = _mm_loadu_ps(&s.blend[i]);
+            const __m128 vx = _mm_loadu_ps(&s.vx[i]);
+            const __m128 vz = _mm_loadu_ps(&s.vz[i]);
+            const __m128 tvx = _mm_mul_ps(_mm_mul_ps(dx, invDist), speed);
+            const __m128 tvz = _mm_mul_ps(_mm_mul_ps(dz, invDist), speed);
+            const __m128 nvx = _mm_add_ps(vx, _mm_mul_ps(_mm_sub_ps(tvx, vx), blend));
+            const __m128 nvz = _mm_add_ps(vz, _mm_mul_ps(_mm_sub_ps(tvz, vz), blend));
+            _mm_storeu_ps(&s.vx[i], select(steerMask, nvx, vx));
+            _mm_storeu_ps(&s.vz[i], select(steerMask, nvz, vz));
+
+            const int bits = _mm_movemask_ps(arrived);
+            for (uint32_t l = 0; l < kLanes; ++l)
+                s.arrived[i + l] = static_cast<uint8_t>((bits >> l) & 1);
+        }
+#elif defined(STRATO_MOVEMENT_NEON)
+        const uint32_t n = s.seal();
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t vmin = vdupq_n_f32(kMinSteerDist2);
+        for (uint32_t i = 0; i < n; i += kLanes)
+        {
+            const float32x4_t dx = vsubq_f32(vld1q_f32(&s.tx[i]), vld1q_f32(&s.px[i]));
+            const float32x4_t dz = vsubq_f32(vld1q_f32(&s.tz[i]), vld1q_f32(&s.pz[i]));
+            const float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dz, dz));
+            const uint32x4_t arrived = vcleq_f32(d2, vld1q_f32(&s.radius2[i]));
+            const uint32x4_t steerMask = vbicq_u32(vcgtq_f32(d2, vmin), arrived);
+
+            const float32x4_t invDist = vdivq_f32(one, vsqrtq_f32(d2));
+            const float32x4_t speed = vld1q_f32(&s.speed[i]);
+            const float32x4_t blend = vld1q_f32(&s.blend[i]);
+            const float32x4_t vx = vld1q_f32(&s.vx[i]);
+            const float32x4_t vz = vld1q_f32(&s.vz[i]);
+            const float32x4_t tvx = vmulq_f32(vmulq_f32(dx, invDist), speed);
+            const float32x4_t tvz = vmulq_f32(vmulq_f32(dz, invDist), speed);
+            const float32x4_t nvx = vaddq_f32(vx, vmulq_f32(vsubq_f32(tvx, vx), blend));
+            const float32x4_t nvz = vaddq_f32(vz, vmulq_f32(vsubq_f32(tvz, vz), blend));
+            vst1q_f32(&s.vx[i], vbslq_f32(steerMask, nvx, vx));
+            vst1q_f32(&s.vz[i], vbslq_f32(steerMask, nvz, vz));
+
+            uint32_t lanes[kLanes];
+            vst1q_u32(lanes, arrived);
+            for (uint32_t l = 0; l < kLanes; ++l)
+                s.arrived[i + l] = lanes[l] ? 1 : 0;
+        }
+#else
+        steerScalar(s);
+#endif
+    }
+}
@@ -5,6 +5,8 @@
   Purpose:
     - Moves entities: position += velocity * dt for any archetype store that has both Position and Velocity
       and does not contain excluded tags.
+    - Dirty rows are packed into SoA streams and integrated by MovementKernel (8 rows per AVX2
+      instruction); moved rows are marked dirty in one batch per store.
 
   How to customize:
     - Change required/excluded component names in the constructor to reflect the game rules.
@@ -13,7 +15,10 @@
 
 #include "ECS/SystemFormat.h" // IGameplaySystem, SystemBase
 #include "ECS/Components.h"
-#include <cmath>
+#include "systems/MovementKernel.h"
+#include <cstdint>
+#include <vector>
+
 class MovementSystem : public Engine::ECS::SystemBase
 {
 public:
@@ -25,7 +30,7 @@ public:
 
         // Optional excluded tags/components (define them in your registry if you use them).
         // Comment out if not used.
-        setExcludedNames({"Disabled", "Dead"});
+        setExcludedNames({"Disabled", "Dead", "Sleeping"});
     }
 
     const char *name() const override { return "MovementSystem"; }
@@ -64,45 +69,44 @@ public:
 
             const uint32_t n = store.size();
             auto &positions = const_cast<std::vector<Engine::ECS::Position> &>(store.positions());
-            auto &velocities = const_cast<std::vector<Engine::ECS::Velocity> &>(store.velocities());
-
-            const bool canLogTarget = store.hasMoveTarget();
-            const auto *targetsPtr = canLogTarget ? &store.moveTargets() : nullptr;
+            const auto &velocities = store.velocities();
 
+            // Gather dirty rows into SoA streams, integrate kLanes rows per instruction, scatter back.
+            m_streams.clear();
+            m_rows.clear();
             for (uint32_t i : dirtyRows)
             {
                 if (i >= n)
                     continue;
+                const auto &p = positions[i];
+                const auto &v = velocities[i];
+                m_streams.push(p.x, p.y, p.z, v.x, v.y, v.z);
+                m_rows.push_back(i);
+            }
 
-                const float velMag1 = std::fabs(velocities[i].x) + std::fabs(velocities[i].y) + std::fabs(velocities[i].z);
-                if (velMag1 <= 1e-6f)
-                    continue;
-
-                const auto before = positions[i];
-
-                positions[i].x += velocities[i].x * dt;
-                positions[i].y += velocities[i].y * dt;
-                positions[i].z += velocities[i].z * dt;
-
-                ecs.markDirty(m_positionId, archetypeId, i);
-
-                // Keep movers active: movement must run every frame while velocity is non-zero.
-                ecs.markDirty(m_velocityId, archetypeId, i);
+            MovementKernel::integrate(m_streams, dt);
 
-                const bool targetActive = (targetsPtr && (*targetsPtr)[i].active != 0);
-                const bool moving = (std::fabs(velocities[i].x) + std::fabs(velocities[i].y) + std::fabs(velocities[i].z)) > 1e-6f;
-                if (targetActive || moving)
-                {
-                    const auto after = positions[i];
-                    const float dx = after.x - before.x;
-                    const float dy = after.y - before.y;
-                    const float dz = after.z - before.z;
-                }
+            m_moved.clear();
+            for (uint32_t k = 0; k < m_streams.count; ++k)
+            {
+                if (!m_streams.moving[k])
+                    continue;
+                const uint32_t i = m_rows[k];
+                positions[i] = {m_streams.px[k], m_streams.py[k], m_streams.pz[k]};
+                m_moved.push_back(i);
             }
+
+            // Keep movers active: movement must run every frame while velocity is non-zero.
+            ecs.markDirtyRows(m_positionId, archetypeId, m_moved);
+            ecs.markDirtyRows(m_velocityId, archetypeId, m_moved);
         }
     }
 
 private:
+    MovementKernel::IntegrateStreams m_streams;
+    std::vector<uint32_t> m_rows;  // stream lane -> store row
+    std::vector<uint32_t> m_moved; // rows whose position changed
+
     Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
     uint32_t m_positionId = Engine::ECS::ComponentRegistry::InvalidID;
     uint32_t m_velocityId = Engine::ECS::ComponentRegistry::InvalidID;
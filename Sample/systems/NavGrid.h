@@ -6,27 +6,122 @@
     - Stores the 2D walkability grid (blocked/open).
     - Provides coordinate mapping between world space and grid space.
     - Used by PathfindingSystem to plan paths.
+
+  Layout:
+    - Walkability is bit-packed, 64 cells per uint64_t word (1 = blocked).
+    - Each row starts on a word boundary (wordsPerRow words per row), so a
+      horizontal run of cells can be tested with a couple of mask operations.
+    - Padding bits past `width` in the last word of a row are kept set (blocked),
+      so word reads never need to special-case the right edge.
+    - Obstacle changes are tracked as dirty rectangles (grid space) so
+      NavGridBuilderSystem only clears and re-rasterizes the touched region.
+
+  Clearance:
+    - clearance[gz * width + gx] = Chebyshev distance (in cells) to the nearest
+      blocked or off-grid cell, capped at kMaxClearance. Blocked cells are 0.
+    - Computed with a two-pass (forward/backward) distance transform. Because the
+      value is capped, a change only affects cells within kMaxClearance of it, so
+      dirty rects are re-transformed over a small window instead of the whole map.
+    - Agents test `clearance >= requiredClearance(radius)`, so units of every size
+      share one grid.
 */
 
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 class NavGrid
 {
 public:
+    // Inclusive rectangle in grid coordinates.
+    struct CellRect
+    {
+        int minX = 0;
+        int minZ = 0;
+        int maxX = -1;
+        int maxZ = -1;
+
+        bool empty() const { return maxX < minX || maxZ < minZ; }
+    };
+
+    // Clearance values are capped here (in cells); also bounds the incremental update window.
+    static constexpr uint8_t kMaxClearance = 8;
+
     float cellSize = 2.0f;
     float worldMinX = 0.0f;
     float worldMinZ = 0.0f;
     int width = 0;
     int height = 0;
+    int wordsPerRow = 0;
 
-    // 0 = walkable, 1 = blocked
-    std::vector<uint8_t> blocked;
+    // Bit-packed walkability: bit (gx & 63) of blockedBits[gz * wordsPerRow + (gx >> 6)].
+    // 1 = blocked, 0 = walkable.
+    std::vector<uint64_t> blockedBits;
 
-    // Dirty flag — set true when obstacles change; NavGridBuilderSystem clears it after rebuild.
+    // Per-cell distance to the nearest obstacle in cells (see header comment).
+    std::vector<uint8_t> clearance;
+
+    // Dirty flag — set true when the whole grid must be rebuilt (initial build, resize).
+    // NavGridBuilderSystem clears it after rebuild.
     bool dirty = true;
 
+    // A time-sliced full rebuild is in progress (set by NavGridBuilderSystem): cells not
+    // rebuilt yet read as open, so new path searches should wait until it clears.
+    bool rebuilding = false;
+
+    // Bumped by NavGridBuilderSystem whenever walkability/clearance changes, so caches
+    // derived from the grid (e.g. PathfindingSystem's path cache) can detect staleness.
+    uint32_t version = 0;
+
+    // `version` of the last builder pass that left nothing queued (every synchronous pass,
+    // the final step of a time-sliced rebuild). Caches that re-check their entries against
+    // the grid anyway can flush on this instead of on every strip of a sliced rebuild.
+    uint32_t settledVersion = 0;
+
+    // Regions invalidated since the last build (obstacle added/removed/moved).
+    // NavGridBuilderSystem clears and re-rasterizes only these, then empties the list.
+    std::vector<CellRect> dirtyRects;
+
+    // A region NavGridBuilderSystem rebuilt. `opened` = at least one cell in it became
+    // walkable (so routes detouring around it may now be longer than necessary).
+    struct Change
+    {
+        CellRect rect;
+        bool opened = false;
+        uint32_t version = 0; // the version this rebuild was published as
+    };
+
+    // Versions of history kept in `changes`.
+    static constexpr uint32_t kChangeHistory = 16;
+
+    // Regions rebuilt by recent NavGridBuilderSystem passes, oldest first, covering versions
+    // changesFrom..version. A reader that last looked at version v processes the entries
+    // newer than v, so it sees every region even if several passes ran in between (sliced
+    // rebuilds); if v + 1 < changesFrom, some were dropped and it must assume the whole grid
+    // changed. PathfindingSystem re-plans only the routes crossing them.
+    std::vector<Change> changes;
+    uint32_t changesFrom = 1;
+
+    /// Publish a region rebuilt by the pass that is about to bump `version`.
+    void publishChange(const CellRect &rect, bool opened)
+    {
+        changes.push_back(Change{rect, opened, version + 1});
+    }
+
+    /// Forget changes older than kChangeHistory versions (call after bumping `version`).
+    void trimChanges()
+    {
+        if (version < kChangeHistory)
+            return;
+        const uint32_t oldest = version - kChangeHistory + 1;
+        size_t k = 0;
+        while (k < changes.size() && changes[k].version < oldest)
+            ++k;
+        changes.erase(changes.begin(), changes.begin() + static_cast<std::ptrdiff_t>(k));
+        changesFrom = std::max(changesFrom, oldest);
+    }
+
     void rebuild(float cSize, float minX, float minZ, float maxX, float maxZ)
     {
         cellSize = (cSize > 0.1f) ? cSize : 2.0f;
@@ -42,47 +137,112 @@ public:
         if (width < 1) width = 1;
         if (height < 1) height = 1;
 
-        blocked.assign(static_cast<size_t>(width * height), 0);
+        wordsPerRow = (width + 63) >> 6;
+        blockedBits.assign(static_cast<size_t>(wordsPerRow) * static_cast<size_t>(height), 0);
+        clearAll();
+        clearance.assign(static_cast<size_t>(width) * static_cast<size_t>(height), 0);
+        updateClearance(fullRect());
+
+        dirtyRects.clear();
+        changes.clear();
+        changesFrom = version + 1;
+        dirty = true;
     }
-    // Check if a straight line from (x0, z0) to (x1, z1) is clear of obstacles.
-    // Coordinates are in WORLD space.
-    bool lineCheck(float x0, float z0, float x1, float z1) const
+
+    // ------------------------------------------------------------------
+    // Cell access
+    // ------------------------------------------------------------------
+
+    bool isBlocked(int gx, int gz) const
     {
-        // Convert to grid coordinates
-        int gx0 = worldToGridX(x0);
-        int gz0 = worldToGridZ(z0);
-        int gx1 = worldToGridX(x1);
-        int gz1 = worldToGridZ(z1);
+        return (blockedBits[static_cast<size_t>(gz) * wordsPerRow + (gx >> 6)] >> (gx & 63)) & 1ull;
+    }
 
-        // Bresenham's Line Algorithm
-        int dx = std::abs(gx1 - gx0);
-        int dz = std::abs(gz1 - gz0);
-        int sx = (gx0 < gx1) ? 1 : -1;
-        int sz = (gz0 < gz1) ? 1 : -1;
-        int err = dx - dz;
+    void setBlocked(int gx, int gz)
+    {
+        blockedBits[static_cast<size_t>(gz) * wordsPerRow + (gx >> 6)] |= (1ull << (gx & 63));
+    }
 
-        while (true)
-        {
-            // Check current cell
-            if (!isWalkable(gx0, gz0))
-                return false; // Hit obstacle
+    /// Returns `n` (1..64) blocked bits of row gz starting at gx; bit i = cell (gx + i).
+    /// Cells outside the grid read as blocked.
+    uint64_t rowBits(int gz, int gx, int n) const
+    {
+        if (gz < 0 || gz >= height)
+            return lowMask(n);
 
-            if (gx0 == gx1 && gz0 == gz1)
-                break;
+        const uint64_t *row = &blockedBits[static_cast<size_t>(gz) * wordsPerRow];
+        uint64_t out = 0;
+        int shift = 0;
 
-            int e2 = 2 * err;
-            if (e2 > -dz)
-            {
-                err -= dz;
-                gx0 += sx;
-            }
-            if (e2 < dx)
+        if (gx < 0)
+        {
+            const int pad = std::min(-gx, n);
+            out = lowMask(pad);
+            shift = pad;
+            gx = 0;
+        }
+
+        while (shift < n)
+        {
+            const int remaining = n - shift;
+            if (gx >= width)
             {
-                err += dx;
-                gz0 += sz;
+                out |= lowMask(remaining) << shift;
+                break;
             }
+            const int bit = gx & 63;
+            const int take = std::min(64 - bit, remaining);
+            out |= ((row[gx >> 6] >> bit) & lowMask(take)) << shift;
+            shift += take;
+            gx += take;
         }
-        return true;
+        return out;
+    }
+
+    /// 3x3 blocked neighbourhood around (gx, gz) packed into 9 bits:
+    /// bit (dz + 1) * 3 + (dx + 1) is set when cell (gx + dx, gz + dz) is blocked or off-grid.
+    uint32_t neighborMask(int gx, int gz) const
+    {
+        return static_cast<uint32_t>(rowBits(gz - 1, gx - 1, 3)) |
+               (static_cast<uint32_t>(rowBits(gz, gx - 1, 3)) << 3) |
+               (static_cast<uint32_t>(rowBits(gz + 1, gx - 1, 3)) << 6);
+    }
+
+    /// True if every cell in row gz from x0..x1 (inclusive, any order) is walkable.
+    bool rowRangeClear(int gz, int x0, int x1) const
+    {
+        if (x0 > x1) std::swap(x0, x1);
+        if (gz < 0 || gz >= height || x0 < 0 || x1 >= width)
+            return false;
+
+        const uint64_t *row = &blockedBits[static_cast<size_t>(gz) * wordsPerRow];
+        const int w0 = x0 >> 6;
+        const int w1 = x1 >> 6;
+        const uint64_t headMask = ~0ull << (x0 & 63);
+        const uint64_t tailMask = lowMask((x1 & 63) + 1);
+
+        if (w0 == w1)
+            return (row[w0] & headMask & tailMask) == 0;
+
+        if (row[w0] & headMask)
+            return false;
+        for (int w = w0 + 1; w < w1; ++w)
+        {
+            if (row[w])
+                return false;
+        }
+        return (row[w1] & tailMask) == 0;
+    }
+
+    // ------------------------------------------------------------------
+    // Queries
+    // ------------------------------------------------------------------
+
+    // Check if a straight line from (x0, z0) to (x1, z1) is clear of obstacles.
+    // Coordinates are in WORLD space.
+    bool lineCheck(float x0, float z0, float x1, float z1) const
+    {
+        return lineCheckGrid(worldToGridX(x0), worldToGridZ(z0), worldToGridX(x1), worldToGridZ(z1));
     }
 
     int worldToGridX(float wx) const
@@ -114,11 +274,35 @@ public:
     {
         if (!isValid(gx, gz))
             return false;
-        return blocked[gz * width + gx] == 0;
+        return !isBlocked(gx, gz);
+    }
+
+    /// Smallest clearance (in cells) that keeps an agent of `agentRadius` (world units)
+    /// off every blocked cell when standing on a cell centre.
+    /// A cell at Chebyshev distance d from a blocked cell has at least (d - 0.5) cells
+    /// between its centre and that cell's edge, so we need d >= r / cellSize + 0.5.
+    uint8_t requiredClearance(float agentRadius) const
+    {
+        const float cells = std::ceil(std::max(0.0f, agentRadius) / cellSize + 0.5f);
+        return static_cast<uint8_t>(std::min<float>(std::max(cells, 1.0f), kMaxClearance));
+    }
+
+    uint8_t clearanceAt(int gx, int gz) const
+    {
+        if (!isValid(gx, gz))
+            return 0;
+        return clearance[static_cast<size_t>(gz) * width + gx];
+    }
+
+    bool isClear(int gx, int gz, uint8_t minClear) const
+    {
+        return clearanceAt(gx, gz) >= minClear;
     }
 
     /// Line-of-sight check entirely in grid space (avoids float↔int conversions).
     /// Bresenham's from (gx0,gz0) to (gx1,gz1).  Returns true if every cell is walkable.
+    /// Consecutive cells on the same row are gathered into a run and tested word-wise,
+    /// so x-major lines cost roughly one mask test per row instead of one per cell.
     bool lineCheckGrid(int gx0, int gz0, int gx1, int gz1) const
     {
         int dx = std::abs(gx1 - gx0);
@@ -127,35 +311,189 @@ public:
         int sz = (gz0 < gz1) ? 1 : -1;
         int err = dx - dz;
 
+        int runStartX = gx0;
         while (true)
         {
-            if (!isWalkable(gx0, gz0))
-                return false;
             if (gx0 == gx1 && gz0 == gz1)
-                break;
+                return rowRangeClear(gz0, runStartX, gx0);
+
             int e2 = 2 * err;
+            const int prevX = gx0;
             if (e2 > -dz) { err -= dz; gx0 += sx; }
-            if (e2 < dx)  { err += dx; gz0 += sz; }
+            if (e2 < dx)
+            {
+                // Leaving this row: flush the run gathered so far.
+                if (!rowRangeClear(gz0, runStartX, prevX))
+                    return false;
+                err += dx;
+                gz0 += sz;
+                runStartX = gx0;
+            }
+        }
+    }
+
+    /// Clearance-aware line-of-sight: every sampled cell along the line (excluding the
+    /// start cell, which the agent already occupies) must have clearance >= minClear.
+    /// Clearance is 1-Lipschitz in Chebyshev distance, so from a cell with clearance c
+    /// the next (c - minClear) steps along the major axis are known-clear and skipped.
+    /// With minClear <= 1 this is the plain bit-packed walkability test.
+    bool lineCheckGrid(int gx0, int gz0, int gx1, int gz1, uint8_t minClear) const
+    {
+        if (minClear <= 1)
+            return lineCheckGrid(gx0, gz0, gx1, gz1);
+
+        const int dx = gx1 - gx0;
+        const int dz = gz1 - gz0;
+        const int n = std::max(std::abs(dx), std::abs(dz));
+        if (n == 0)
+            return true;
+
+        // Cell i along the line: rounded with floor(v + 0.5) so a jump of k steps moves at
+        // most k cells on either axis (keeps the skip conservative).
+        int i = 1;
+        while (i <= n)
+        {
+            const int x = gx0 + floorDiv(2 * i * dx + n, 2 * n);
+            const int z = gz0 + floorDiv(2 * i * dz + n, 2 * n);
+            const uint8_t c = clearanceAt(x, z);
+            if (c < minClear)
+                return false;
+            i += 1 + (c - minClear);
         }
         return true;
     }
 
+    // ------------------------------------------------------------------
+    // Rasterization / incremental rebuild
+    // ------------------------------------------------------------------
+
+    CellRect fullRect() const
+    {
+        return CellRect{0, 0, width - 1, height - 1};
+    }
+
+    /// Grid-space bounding rect of a world-space circle, clamped to the grid.
+    CellRect circleRect(float wx, float wz, float radius) const
+    {
+        CellRect r;
+        r.minX = std::max(0, worldToGridX(wx - radius));
+        r.maxX = std::min(width - 1, worldToGridX(wx + radius));
+        r.minZ = std::max(0, worldToGridZ(wz - radius));
+        r.maxZ = std::min(height - 1, worldToGridZ(wz + radius));
+        return r;
+    }
+
+    /// Radius an obstacle of physical radius `r` is stamped at: half a cell more, so the
+    /// centre-sampled raster covers the whole trunk.
+    float stampRadius(float r) const
+    {
+        return r + 0.5f * cellSize;
+    }
+
+    /// Queue the footprint of an obstacle circle (already inflated) for re-rasterization.
+    /// Call for both the old and the new footprint when an obstacle is added, removed or moved.
+    void invalidateCircle(float wx, float wz, float radius)
+    {
+        const CellRect r = circleRect(wx, wz, radius);
+        if (!r.empty())
+            dirtyRects.push_back(r);
+    }
+
+    /// Mark every cell walkable (padding bits stay blocked).
+    void clearAll()
+    {
+        clearRect(fullRect());
+    }
+
+    /// Mark every cell in `r` walkable. Works a word at a time.
+    void clearRect(const CellRect &r)
+    {
+        if (r.empty())
+            return;
+
+        const int w0 = r.minX >> 6;
+        const int w1 = r.maxX >> 6;
+        const uint64_t headMask = ~0ull << (r.minX & 63);
+        const uint64_t tailMask = lowMask((r.maxX & 63) + 1);
+
+        for (int gz = r.minZ; gz <= r.maxZ; ++gz)
+        {
+            uint64_t *row = &blockedBits[static_cast<size_t>(gz) * wordsPerRow];
+            if (w0 == w1)
+            {
+                row[w0] &= ~(headMask & tailMask);
+            }
+            else
+            {
+                row[w0] &= ~headMask;
+                for (int w = w0 + 1; w < w1; ++w)
+                    row[w] = 0;
+                row[w1] &= ~tailMask;
+            }
+            // Keep off-grid padding blocked so rowBits() needs no edge checks.
+            row[wordsPerRow - 1] |= paddingMask();
+        }
+    }
+
+    /// Append the blocked-bit words covering `r` (row by row) to `out`, for anyOpened().
+    void snapshotRect(const CellRect &r, std::vector<uint64_t> &out) const
+    {
+        if (r.empty())
+            return;
+        const int w0 = r.minX >> 6;
+        const int w1 = r.maxX >> 6;
+        for (int gz = r.minZ; gz <= r.maxZ; ++gz)
+        {
+            const uint64_t *row = &blockedBits[static_cast<size_t>(gz) * wordsPerRow];
+            out.insert(out.end(), row + w0, row + w1 + 1);
+        }
+    }
+
+    /// True if a cell of `r` that was blocked in `before` (snapshotRect of the same rect)
+    /// is walkable now. Returns the number of words consumed through `used`.
+    bool anyOpened(const CellRect &r, const uint64_t *before, size_t &used) const
+    {
+        used = 0;
+        if (r.empty())
+            return false;
+        const int w0 = r.minX >> 6;
+        const int w1 = r.maxX >> 6;
+        const uint64_t headMask = ~0ull << (r.minX & 63);
+        const uint64_t tailMask = lowMask((r.maxX & 63) + 1);
+
+        bool opened = false;
+        for (int gz = r.minZ; gz <= r.maxZ; ++gz)
+        {
+            const uint64_t *row = &blockedBits[static_cast<size_t>(gz) * wordsPerRow];
+            for (int w = w0; w <= w1; ++w, ++used)
+            {
+                uint64_t mask = ~0ull;
+                if (w == w0) mask &= headMask;
+                if (w == w1) mask &= tailMask;
+                opened = opened || (before[used] & ~row[w] & mask) != 0;
+            }
+        }
+        return opened;
+    }
+
     void markObstacle(float wx, float wz, float radius)
     {
-        int gxMin = worldToGridX(wx - radius);
-        int gxMax = worldToGridX(wx + radius);
-        int gzMin = worldToGridZ(wz - radius);
-        int gzMax = worldToGridZ(wz + radius);
+        markObstacleClipped(wx, wz, radius, fullRect());
+    }
 
-        gxMin = std::max(0, gxMin);
-        gxMax = std::min(width - 1, gxMax);
-        gzMin = std::max(0, gzMin);
-        gzMax = std::min(height - 1, gzMax);
+    /// Rasterize an obstacle circle, touching only cells inside `clip`.
+    void markObstacleClipped(float wx, float wz, float radius, const CellRect &clip)
+    {
+        CellRect r = circleRect(wx, wz, radius);
+        r.minX = std::max(r.minX, clip.minX);
+        r.maxX = std::min(r.maxX, clip.maxX);
+        r.minZ = std::max(r.minZ, clip.minZ);
+        r.maxZ = std::min(r.maxZ, clip.maxZ);
 
         // Simple bounding box loop, then circle check
-        for (int gz = gzMin; gz <= gzMax; ++gz)
+        for (int gz = r.minZ; gz <= r.maxZ; ++gz)
         {
-            for (int gx = gxMin; gx <= gxMax; ++gx)
+            for (int gx = r.minX; gx <= r.maxX; ++gx)
             {
                 float cx = gridToWorldX(gx);
                 float cz = gridToWorldZ(gz);
@@ -163,9 +501,111 @@ public:
                 float dz = cz - wz;
                 if (dx * dx + dz * dz <= radius * radius)
                 {
-                    blocked[gz * width + gx] = 1;
+                    setBlocked(gx, gz);
                 }
             }
         }
     }
+
+    /// Recompute clearance for every cell whose capped value can change when cells in
+    /// `r` change: transform the window r + 2K (K = kMaxClearance) and write back r + K.
+    /// Cells in r + K have their nearest obstacle (within K) inside the window, so the
+    /// windowed result is exact for them.
+    void updateClearance(const CellRect &r)
+    {
+        if (r.empty() || clearance.empty())
+            return;
+
+        const int K = kMaxClearance;
+        const CellRect win = expandRect(r, 2 * K);
+        const CellRect out = expandRect(r, K);
+        const int ww = win.maxX - win.minX + 1;
+        const int wh = win.maxZ - win.minZ + 1;
+
+        m_clearScratch.resize(static_cast<size_t>(ww) * static_cast<size_t>(wh));
+        auto at = [&](int x, int z) -> uint8_t & { return m_clearScratch[static_cast<size_t>(z - win.minZ) * ww + (x - win.minX)]; };
+
+        // Seed: blocked = 0, otherwise distance to the grid border (off-grid counts as blocked).
+        for (int gz = win.minZ; gz <= win.maxZ; ++gz)
+        {
+            for (int gx = win.minX; gx <= win.maxX; ++gx)
+            {
+                const int edge = std::min(std::min(gx + 1, width - gx), std::min(gz + 1, height - gz));
+                at(gx, gz) = isBlocked(gx, gz) ? uint8_t(0) : static_cast<uint8_t>(std::min(edge, K));
+            }
+        }
+
+        // Forward pass: west, north-west, north, north-east.
+        for (int gz = win.minZ; gz <= win.maxZ; ++gz)
+        {
+            for (int gx = win.minX; gx <= win.maxX; ++gx)
+            {
+                uint8_t &v = at(gx, gz);
+                if (v == 0)
+                    continue;
+                int best = v;
+                if (gx > win.minX) best = std::min(best, at(gx - 1, gz) + 1);
+                if (gz > win.minZ)
+                {
+                    best = std::min(best, at(gx, gz - 1) + 1);
+                    if (gx > win.minX) best = std::min(best, at(gx - 1, gz - 1) + 1);
+                    if (gx < win.maxX) best = std::min(best, at(gx + 1, gz - 1) + 1);
+                }
+                v = static_cast<uint8_t>(best);
+            }
+        }
+
+        // Backward pass: east, south-east, south, south-west.
+        for (int gz = win.maxZ; gz >= win.minZ; --gz)
+        {
+            for (int gx = win.maxX; gx >= win.minX; --gx)
+            {
+                uint8_t &v = at(gx, gz);
+                if (v == 0)
+                    continue;
+                int best = v;
+                if (gx < win.maxX) best = std::min(best, at(gx + 1, gz) + 1);
+                if (gz < win.maxZ)
+                {
+                    best = std::min(best, at(gx, gz + 1) + 1);
+                    if (gx < win.maxX) best = std::min(best, at(gx + 1, gz + 1) + 1);
+                    if (gx > win.minX) best = std::min(best, at(gx - 1, gz + 1) + 1);
+                }
+                v = static_cast<uint8_t>(best);
+            }
+        }
+
+        for (int gz = out.minZ; gz <= out.maxZ; ++gz)
+        {
+            std::copy_n(&at(out.minX, gz), out.maxX - out.minX + 1,
+                        &clearance[static_cast<size_t>(gz) * width + out.minX]);
+        }
+    }
+
+private:
+    // Scratch window for updateClearance (reused to avoid per-update allocations).
+    std::vector<uint8_t> m_clearScratch;
+
+    CellRect expandRect(const CellRect &r, int by) const
+    {
+        return CellRect{std::max(0, r.minX - by), std::max(0, r.minZ - by),
+                        std::min(width - 1, r.maxX + by), std::min(height - 1, r.maxZ + by)};
+    }
+
+    static int floorDiv(int a, int b)
+    {
+        const int q = a / b;
+        return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+    }
+
+    static uint64_t lowMask(int n)
+    {
+        return (n >= 64) ? ~0ull : ((1ull << n) - 1ull);
+    }
+
+    uint64_t paddingMask() const
+    {
+        const int used = width & 63;
+        return used ? ~lowMask(used) : 0ull;
+    }
 };
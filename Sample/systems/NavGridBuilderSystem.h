@@ -5,12 +5,41 @@
   Purpose:
     - Scans all entities with Obstacle + ObstacleRadius components.
     - Marks their blocked cells in the NavGrid.
-    - Runs ONCE at init (or on demand), not every frame ideally.
+    - Full rebuild only when the grid is flagged dirty (init / resize).
+    - Otherwise processes NavGrid::dirtyRects: clears each rect word-wise and
+      re-rasterizes only obstacles overlapping it (clipped to the rect), so adding
+      or removing a single stump costs a handful of cells instead of the whole map.
+    - Keeps NavGrid::clearance in sync (windowed distance transform per dirty rect).
+    - Finds obstacle changes itself: each update compares the live obstacles with the
+      footprints they were stamped at and calls onObstacleChanged() for anything spawned,
+      moved, resized or gone (destroyed, Disabled / Dead), old and new footprint.
+    - Publishes the regions rebuilt in each pass to NavGrid::changes (tagged with the
+      version they land in, flagging those where a cell opened up) so PathfindingSystem
+      re-plans only the routes crossing them.
+    - Obstacles are stamped at their physical radius (plus half a cell so the
+      centre-sampled raster covers the whole trunk); agent size is handled by
+      clearance queries in PathfindingSystem instead of a global inflation.
+    - With a TimeSlicer (setTimeSlicer), the work is queued instead of done in update():
+      a full rebuild becomes kRebuildStripRows-row strips, dirty rects are kept as is, and
+      a background job processes them within the slicer's per-frame budget. Each strip /
+      rect is cleared, re-rasterized and re-transformed on its own (stamps are clipped and
+      the clearance window covers the neighbours), so the grid is exact once the queue
+      drains; until then readers see the rebuild land piece by piece, each published to
+      NavGrid::changes like a dirty rect.
+    - The first build (NavGrid::version 0) is always synchronous: sliced, every strip would
+      publish as "opened" and the first paths would be planned on a partial grid, then
+      re-planned strip after strip.
+    - A later sliced full rebuild (grid resize) sets NavGrid::rebuilding until its last strip
+      lands; the resized grid reads as open until then, so PathfindingSystem and
+      FormationSystem hold new searches back while it is set.
 */
 
 #include "ECS/SystemFormat.h"
+#include "Engine/TimeSlicer.h"
 #include "NavGrid.h"
 
+#include <vector>
+
 class NavGridBuilderSystem : public Engine::ECS::SystemBase
 {
 public:
@@ -23,19 +52,243 @@ public:
 
     const char *name() const override { return "NavGridBuilderSystem"; }
 
-    // Call this if obstacles change, or just check a dirty flag
+    /// Rows per queued strip of a time-sliced full rebuild.
+    static constexpr int kRebuildStripRows = 8;
+
+    /// Run rebuilds as a background job on `slicer` (nullptr = synchronously in update()).
+    void setTimeSlicer(Engine::TimeSlicer *slicer) { m_slicer = slicer; }
+
+    /// Strips / rects still waiting for the background job.
+    size_t pendingRects() const { return m_pending.size() - m_pendingHead; }
+
+    /// Notify that an obstacle with physical radius `r` appeared at / disappeared from (x, z).
+    /// update() does this for every obstacle entity it sees change; call it directly only
+    /// for footprints the ECS doesn't know about.
+    void onObstacleChanged(float x, float z, float r)
+    {
+        if (m_grid)
+            m_grid->invalidateCircle(x, z, m_grid->stampRadius(r));
+    }
+
     void update(Engine::ECS::ECSContext &ecs, float dt) override
     {
+        (void)dt;
         if (!m_grid)
             return;
 
-        // Only rebuild when the grid is marked dirty (initial build or obstacle change).
-        if (!m_grid->dirty)
+        // A pending full rebuild covers every change, and the first scan has nothing to
+        // compare against (the grid was built from the obstacles as they are): just record.
+        trackObstacles(ecs, m_scanSerial != 0 && !m_grid->dirty);
+
+        if (m_slicer && (m_grid->version != 0 || !m_grid->dirty))
+        {
+            enqueueWork(ecs);
             return;
+        }
+
+        if (m_grid->dirty)
+        {
+            // Full rebuild (initial build or grid resize); pending rects are subsumed.
+            m_pending.clear();
+            m_pendingHead = 0;
+            m_grid->clearAll();
+            rasterize(ecs, m_grid->fullRect());
+            m_grid->updateClearance(m_grid->fullRect());
+            m_grid->dirtyRects.clear();
+            // Covers every earlier change.
+            m_grid->changes.clear();
+            m_grid->changesFrom = m_grid->version + 1;
+            m_grid->publishChange(m_grid->fullRect(), true);
+            m_grid->dirty = false;
+            m_grid->rebuilding = false;
+            ++m_grid->version;
+            m_grid->settledVersion = m_grid->version;
+            return;
+        }
+
+        if (m_grid->dirtyRects.empty())
+            return;
+
+        // Snapshot the old bits so each change can report whether anything opened up.
+        m_before.clear();
+        for (const NavGrid::CellRect &r : m_grid->dirtyRects)
+            m_grid->snapshotRect(r, m_before);
+
+        // Stamps are clipped to their rect, so overlapping rects can be rebuilt in any order.
+        // All of them are stamped before the clearance passes so each clearance window
+        // already reads its neighbours' final cells.
+        for (const NavGrid::CellRect &r : m_grid->dirtyRects)
+            m_grid->clearRect(r);
+        for (const NavGrid::CellRect &r : m_grid->dirtyRects)
+            rasterize(ecs, r);
+        for (const NavGrid::CellRect &r : m_grid->dirtyRects)
+            m_grid->updateClearance(r);
+
+        size_t offset = 0;
+        for (const NavGrid::CellRect &r : m_grid->dirtyRects)
+        {
+            size_t used = 0;
+            const bool opened = m_grid->anyOpened(r, m_before.data() + offset, used);
+            offset += used;
+            m_grid->publishChange(r, opened);
+        }
+
+        m_grid->dirtyRects.clear();
+        ++m_grid->version;
+        m_grid->settledVersion = m_grid->version;
+        m_grid->trimChanges();
+    }
+
+private:
+    NavGrid *m_grid = nullptr;
+    std::vector<uint64_t> m_before; // pre-rebuild blocked bits of the dirty rects
 
-        // Reset grid: mark all as walkable
-        std::fill(m_grid->blocked.begin(), m_grid->blocked.end(), 0);
+    // Footprint each obstacle was last seen with, by entity index (r < 0 = none).
+    struct Footprint
+    {
+        float x = 0.0f, z = 0.0f, r = -1.0f;
+        uint32_t generation = 0;
+        uint32_t seen = 0; // m_scanSerial of the last scan that found it
+    };
+    std::vector<Footprint> m_footprints;
+    std::vector<uint32_t> m_tracked; // entity indices with a footprint
+    uint32_t m_scanSerial = 0;
 
+    Engine::TimeSlicer *m_slicer = nullptr; // not owned
+    Engine::TimeSlicer::JobId m_job = Engine::TimeSlicer::kInvalidJob;
+    std::vector<NavGrid::CellRect> m_pending; // queued strips / rects, consumed from m_pendingHead
+    size_t m_pendingHead = 0;
+
+    // Move the grid's requested work into the queue and make sure the job is running.
+    void enqueueWork(Engine::ECS::ECSContext &ecs)
+    {
+        if (m_grid->dirty)
+        {
+            // Full rebuild supersedes anything queued.
+            m_pending.clear();
+            m_pendingHead = 0;
+            const NavGrid::CellRect full = m_grid->fullRect();
+            for (int z = full.minZ; z <= full.maxZ; z += kRebuildStripRows)
+            {
+                NavGrid::CellRect strip = full;
+                strip.minZ = z;
+                strip.maxZ = std::min(full.maxZ, z + kRebuildStripRows - 1);
+                m_pending.push_back(strip);
+            }
+            m_grid->dirtyRects.clear();
+            m_grid->dirty = false;
+            m_grid->rebuilding = true;
+        }
+        else if (!m_grid->dirtyRects.empty())
+        {
+            m_pending.insert(m_pending.end(), m_grid->dirtyRects.begin(), m_grid->dirtyRects.end());
+            m_grid->dirtyRects.clear();
+        }
+
+        if (m_pendingHead < m_pending.size() && !m_slicer->isPending(m_job))
+        {
+            m_job = m_slicer->submit("NavGrid rebuild", [this, &ecs](Engine::TimeSlice &slice)
+                                     { return processPending(ecs, slice); });
+        }
+    }
+
+    // Background job step: process queued rects until the slice expires. Publishes this
+    // step's rects as one NavGrid version. Returns true when the queue is empty.
+    bool processPending(Engine::ECS::ECSContext &ecs, Engine::TimeSlice &slice)
+    {
+        if (m_pendingHead >= m_pending.size())
+            return true;
+
+        do
+        {
+            const NavGrid::CellRect r = m_pending[m_pendingHead++];
+            m_before.clear();
+            m_grid->snapshotRect(r, m_before);
+            m_grid->clearRect(r);
+            rasterize(ecs, r);
+            m_grid->updateClearance(r);
+            size_t used = 0;
+            const bool opened = m_grid->anyOpened(r, m_before.data(), used);
+            m_grid->publishChange(r, opened);
+        } while (m_pendingHead < m_pending.size() && !slice.expired());
+        ++m_grid->version;
+        m_grid->trimChanges();
+
+        if (m_pendingHead < m_pending.size())
+            return false;
+        m_pending.clear();
+        m_pendingHead = 0;
+        m_grid->settledVersion = m_grid->version;
+        m_grid->rebuilding = false;
+        return true;
+    }
+
+    // Compare live obstacles with their recorded footprints; with `invalidate`, dirty the old
+    // and new footprint of each one that appeared, moved, resized or disappeared.
+    void trackObstacles(Engine::ECS::ECSContext &ecs, bool invalidate)
+    {
+        ++m_scanSerial;
+        const size_t trackedBefore = m_tracked.size();
+        size_t found = 0; // of those
+        for (const auto &ptr : ecs.stores.stores())
+        {
+            if (!ptr)
+                continue;
+            auto &store = *ptr;
+            if (!store.signature().containsAll(required()) || !store.signature().containsNone(excluded()))
+                continue;
+
+            const auto &positions = store.positions();
+            const auto &radii = store.obstacleRadii();
+            const auto &entities = store.entities();
+            const uint32_t n = store.size();
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                const Engine::ECS::Entity e = entities[i];
+                if (e.index >= m_footprints.size())
+                    m_footprints.resize(static_cast<size_t>(e.index) + 1);
+                Footprint &fp = m_footprints[e.index];
+                const float x = positions[i].x, z = positions[i].z, r = radii[i].r;
+                const bool known = fp.r >= 0.0f;
+                found += known ? 1u : 0u;
+                if (known && fp.generation == e.generation && fp.x == x && fp.z == z && fp.r == r)
+                {
+                    fp.seen = m_scanSerial;
+                    continue;
+                }
+
+                if (!known)
+                    m_tracked.push_back(e.index);
+                else if (invalidate)
+                    onObstacleChanged(fp.x, fp.z, fp.r);
+                if (invalidate)
+                    onObstacleChanged(x, z, r);
+                fp = Footprint{x, z, r, e.generation, m_scanSerial};
+            }
+        }
+
+        // Not found this scan: destroyed or excluded since.
+        if (found == trackedBefore)
+            return;
+        for (size_t k = 0; k < m_tracked.size();)
+        {
+            Footprint &fp = m_footprints[m_tracked[k]];
+            if (fp.seen == m_scanSerial)
+            {
+                ++k;
+                continue;
+            }
+            if (invalidate)
+                onObstacleChanged(fp.x, fp.z, fp.r);
+            fp.r = -1.0f;
+            m_tracked[k] = m_tracked.back();
+            m_tracked.pop_back();
+        }
+    }
+
+    // Stamp every live obstacle whose stamped circle overlaps `clip`, touching only cells inside it.
+    void rasterize(Engine::ECS::ECSContext &ecs, const NavGrid::CellRect &clip)
+    {
         for (const auto &ptr : ecs.stores.stores())
         {
             if (!ptr)
@@ -53,14 +306,14 @@ public:
 
             for (uint32_t i = 0; i < n; ++i)
             {
-                // Inflate by 2.5m beyond physical radius so knights don't clip stumps on 2m grid
-                m_grid->markObstacle(positions[i].x, positions[i].z, radii[i].r + 2.5f);
+                const float r = m_grid->stampRadius(radii[i].r);
+                const NavGrid::CellRect box = m_grid->circleRect(positions[i].x, positions[i].z, r);
+                if (box.maxX < clip.minX || box.minX > clip.maxX ||
+                    box.maxZ < clip.minZ || box.minZ > clip.maxZ)
+                    continue;
+
+                m_grid->markObstacleClipped(positions[i].x, positions[i].z, r, clip);
             }
         }
-
-        m_grid->dirty = false;
     }
-
-private:
-    NavGrid *m_grid = nullptr;
 };
@@ -0,0 +1,276 @@
+#pragma once
+/*
+  OrcaSolver.h
+  ------------
+  Purpose:
+    - Optimal reciprocal collision avoidance (ORCA, van den Berg et al.) for one agent on
+      the X/Z ground plane, used by LocalAvoidanceSystem's Reciprocal mode.
+    - Each neighbor contributes one half-plane of velocities that stay collision-free
+      for `timeHorizon` seconds when both agents share the avoidance effort; a 2D linear
+      program then picks the allowed velocity closest to the preferred one.
+
+  Notes:
+    - Agent-agent only. Static obstacles are handled by the NavGrid / pathfinding, so the
+      RVO2 obstacle lines are not needed.
+    - Already-overlapping pairs get a constraint that separates them within one timestep
+      instead of the time horizon (no separate push force).
+    - When the constraints are infeasible (very dense crowds) the 3D program minimises the
+      largest penetration into any half-plane, as in RVO2.
+    - `responsibility` is the share of the avoidance this agent takes for a neighbor: 0.5
+      for reciprocating agents, 1.0 for neighbors that will not react (idle units).
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class OrcaSolver
+{
+public:
+    struct Vec2
+    {
+        float x = 0.0f;
+        float z = 0.0f;
+    };
+
+    struct Neighbor
+    {
+        Vec2 relPos;   // neighbor position - agent position
+        Vec2 vel;      // neighbor velocity
+        float combinedRadius = 0.0f;
+        float responsibility = 0.5f;
+    };
+
+    /// Collision-free velocity closest to `prefVel`, at most `maxSpeed` long.
+    /// `vel` is the agent's current velocity (the one the constraints are built around).
+    Vec2 solve(const Vec2 &vel, const Vec2 &prefVel, float maxSpeed, float timeHorizon, float dt,
+               const Neighbor *neighbors, uint32_t count)
+    {
+        m_lines.clear();
+        const float invTimeHorizon = 1.0f / std::max(timeHorizon, 1e-3f);
+        const float invTimeStep = 1.0f / std::max(dt, 1e-4f);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const Neighbor &nb = neighbors[i];
+            const Vec2 relPos = nb.relPos;
+            const Vec2 relVel = sub(vel, nb.vel);
+            const float distSq = absSq(relPos);
+            const float combinedRadius = nb.combinedRadius;
+            const float combinedRadiusSq = combinedRadius * combinedRadius;
+
+            Line line;
+            Vec2 u;
+
+            if (distSq > combinedRadiusSq)
+            {
+                // No collision yet. Vector from cutoff centre to relative velocity.
+                const Vec2 w = sub(relVel, mul(relPos, invTimeHorizon));
+                const float wLengthSq = absSq(w);
+                const float dotProduct1 = dot(w, relPos);
+
+                if (dotProduct1 < 0.0f && dotProduct1 * dotProduct1 > combinedRadiusSq * wLengthSq)
+                {
+                    // Project on the cut-off circle.
+                    const float wLength = std::sqrt(wLengthSq);
+                    const Vec2 unitW = mul(w, 1.0f / wLength);
+                    line.direction = Vec2{unitW.z, -unitW.x};
+                    u = mul(unitW, combinedRadius * invTimeHorizon - wLength);
+                }
+                else
+                {
+                    // Project on the nearer leg of the cone.
+                    const float leg = std::sqrt(distSq - combinedRadiusSq);
+                    if (det(relPos, w) > 0.0f)
+                        line.direction = mul(Vec2{relPos.x * leg - relPos.z * combinedRadius,
+                                                  relPos.x * combinedRadius + relPos.z * leg},
+                                             1.0f / distSq);
+                    else
+                        line.direction = mul(Vec2{relPos.x * leg + relPos.z * combinedRadius,
+                                                  -relPos.x * combinedRadius + relPos.z * leg},
+                                             -1.0f / distSq);
+
+                    const float dotProduct2 = dot(relVel, line.direction);
+                    u = sub(mul(line.direction, dotProduct2), relVel);
+                }
+            }
+            else
+            {
+                // Overlapping: separate within one timestep.
+                const Vec2 w = sub(relVel, mul(relPos, invTimeStep));
+                const float wLength = std::sqrt(absSq(w));
+                if (wLength < 1e-6f)
+                    continue; // coincident with matching velocity: no usable direction
+                const Vec2 unitW = mul(w, 1.0f / wLength);
+                line.direction = Vec2{unitW.z, -unitW.x};
+                u = mul(unitW, combinedRadius * invTimeStep - wLength);
+            }
+
+            line.point = add(vel, mul(u, nb.responsibility));
+            m_lines.push_back(line);
+        }
+
+        Vec2 result;
+        const size_t lineFail = linearProgram2(prefVel, maxSpeed, false, result);
+        if (lineFail < m_lines.size())
+            linearProgram3(lineFail, maxSpeed, result);
+        return result;
+    }
+
+private:
+    struct Line
+    {
+        Vec2 point;
+        Vec2 direction;
+    };
+
+    static Vec2 add(const Vec2 &a, const Vec2 &b) { return {a.x + b.x, a.z + b.z}; }
+    static Vec2 sub(const Vec2 &a, const Vec2 &b) { return {a.x - b.x, a.z - b.z}; }
+    static Vec2 mul(const Vec2 &a, float s) { return {a.x * s, a.z * s}; }
+    static float dot(const Vec2 &a, const Vec2 &b) { return a.x * b.x + a.z * b.z; }
+    static float det(const Vec2 &a, const Vec2 &b) { return a.x * b.z - a.z * b.x; }
+    static float absSq(const Vec2 &a) { return dot(a, a); }
+
+    static constexpr float kEpsilon = 1e-5f;
+
+    // Optimise along line `lineNo` subject to lines [0, lineNo) and the speed circle.
+    bool linearProgram1(const std::vector<Line> &lines, size_t lineNo, float radius, const Vec2 &optVelocity,
+                        bool directionOpt, Vec2 &result) const
+    {
+        const Line &ln = lines[lineNo];
+        const float dotProduct = dot(ln.point, ln.direction);
+        const float discriminant = dotProduct * dotProduct + radius * radius - absSq(ln.point);
+        if (discriminant < 0.0f)
+            return false; // speed circle fully invalidates this line
+
+        const float sqrtDiscriminant = std::sqrt(discriminant);
+        float tLeft = -dotProduct - sqrtDiscriminant;
+        float tRight = -dotProduct + sqrtDiscriminant;
+
+        for (size_t i = 0; i < lineNo; ++i)
+        {
+            const float denominator = det(ln.direction, lines[i].direction);
+            const float numerator = det(lines[i].direction, sub(ln.point, lines[i].point));
+
+            if (std::fabs(denominator) <= kEpsilon)
+            {
+                // Lines are (almost) parallel.
+                if (numerator < 0.0f)
+                    return false;
+                continue;
+            }
+
+            const float t = numerator / denominator;
+            if (denominator >= 0.0f)
+                tRight = std::min(tRight, t); // line i bounds line lineNo on the right
+            else
+                tLeft = std::max(tLeft, t); // line i bounds line lineNo on the left
+
+            if (tLeft > tRight)
+                return false;
+        }
+
+        if (directionOpt)
+        {
+            // Optimise direction.
+            result = add(ln.point, mul(ln.direction, dot(optVelocity, ln.direction) > 0.0f ? tRight : tLeft));
+        }
+        else
+        {
+            // Optimise closest point.
+            const float t = dot(ln.direction, sub(optVelocity, ln.point));
+            result = add(ln.point, mul(ln.direction, std::max(tLeft, std::min(t, tRight))));
+        }
+        return true;
+    }
+
+    // Returns lines.size() on success, otherwise the index of the first line that failed.
+    size_t linearProgram2(const Vec2 &optVelocity, float radius, bool directionOpt, Vec2 &result) const
+    {
+        return linearProgram2(m_lines, optVelocity, radius, directionOpt, result);
+    }
+
+    size_t linearProgram2(const std::vector<Line> &lines, const Vec2 &optVelocity, float radius, bool directionOpt,
+                          Vec2 &result) const
+    {
+        if (directionOpt)
+        {
+            // optVelocity is a unit direction here.
+            result = mul(optVelocity, radius);
+        }
+        else if (absSq(optVelocity) > radius * radius)
+        {
+            result = mul(optVelocity, radius / std::sqrt(absSq(optVelocity)));
+        }
+        else
+        {
+            result = optVelocity;
+        }
+
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            if (det(lines[i].direction, sub(lines[i].point, result)) > 0.0f)
+            {
+                // Result violates constraint i: move it onto line i.
+                const Vec2 tempResult = result;
+                if (!linearProgram1(lines, i, radius, optVelocity, directionOpt, result))
+                {
+                    result = tempResult;
+                    return i;
+                }
+            }
+        }
+        return lines.size();
+    }
+
+    // Infeasible case: minimise the maximum violation, starting from line `beginLine`.
+    void linearProgram3(size_t beginLine, float radius, Vec2 &result)
+    {
+        float distance = 0.0f;
+        for (size_t i = beginLine; i < m_lines.size(); ++i)
+        {
+            if (det(m_lines[i].direction, sub(m_lines[i].point, result)) <= distance)
+                continue;
+
+            // Result does not satisfy line i: project the earlier lines onto it.
+            m_projLines.clear();
+            for (size_t j = 0; j < i; ++j)
+            {
+                Line line;
+                const float determinant = det(m_lines[i].direction, m_lines[j].direction);
+                if (std::fabs(determinant) <= kEpsilon)
+                {
+                    if (dot(m_lines[i].direction, m_lines[j].direction) > 0.0f)
+                        continue; // same direction
+                    line.point = mul(add(m_lines[i].point, m_lines[j].point), 0.5f);
+                }
+                else
+                {
+                    line.point = add(m_lines[i].point,
+                                     mul(m_lines[i].direction,
+                                         det(m_lines[j].direction, sub(m_lines[i].point, m_lines[j].point)) / determinant));
+                }
+
+                Vec2 d = sub(m_lines[j].direction, m_lines[i].direction);
+                const float len = std::sqrt(absSq(d));
+                if (len <= kEpsilon)
+                    continue;
+                line.direction = mul(d, 1.0f / len);
+                m_projLines.push_back(line);
+            }
+
+            const Vec2 tempResult = result;
+            if (linearProgram2(m_projLines, Vec2{-m_lines[i].direction.z, m_lines[i].direction.x}, radius, true, result) <
+                m_projLines.size())
+            {
+                // Only fails through floating-point error; keep the previous result.
+                result = tempResult;
+            }
+            distance = det(m_lines[i].direction, sub(m_lines[i].point, result));
+        }
+    }
+
+    std::vector<Line> m_lines;
+    std::vector<Line> m_projLines;
+};
@@ -0,0 +1,194 @@
+#pragma once
+/*
+  PathIndex.h
+  -----------
+  Purpose:
+    - Spatial index of active paths: which NavGrid clusters (kClusterCells square)
+      each entity's remaining route passes through.
+    - Lets PathfindingSystem re-plan only the paths that cross an obstacle change
+      instead of ignoring the change or re-planning every unit.
+
+  Layout:
+    - One entry list per cluster; an entry is (entity index, stamp).
+    - Each entity has a current stamp; re-inserting or removing a path bumps it, so
+      old entries become stale and are dropped lazily the next time their cluster is
+      queried. No per-path cluster list has to be kept for removal.
+    - Routes are rasterized by sampling each leg once per grid cell, so a cluster the
+      leg only clips at a corner may be missed; callers query with a margin of at
+      least one cell.
+*/
+
+#include "ECS/Entity.h"
+#include "NavGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class PathIndex
+{
+public:
+    static constexpr int kClusterCells = 8;
+
+    /// Size the cluster grid to `grid`. Drops every entry if the grid dimensions changed.
+    void resize(const NavGrid &grid)
+    {
+        const int cw = (grid.width + kClusterCells - 1) / kClusterCells;
+        const int ch = (grid.height + kClusterCells - 1) / kClusterCells;
+        if (cw == m_clustersX && ch == m_clustersZ)
+            return;
+
+        m_clustersX = cw;
+        m_clustersZ = ch;
+        m_clusters.assign(static_cast<size_t>(cw) * ch, {});
+        m_clusterMark.assign(m_clusters.size(), 0u);
+        std::fill(m_owners.begin(), m_owners.end(), Owner{});
+    }
+
+    /// Index (or re-index) `e`'s route: a polyline of `pointCount` interleaved (x, z) points,
+    /// starting at the entity's position. Replaces any previous route for `e`.
+    void insert(const NavGrid &grid, Engine::ECS::Entity e, const float *pointsXZ, uint32_t pointCount,
+                uint8_t minClear)
+    {
+        if (m_clusters.empty() || pointCount == 0)
+            return;
+
+        Owner &o = owner(e);
+        ++o.stamp;
+        o.entity = e;
+        o.minClear = minClear;
+        o.live = true;
+
+        ++m_serial;
+        if (m_serial == 0)
+        {
+            std::fill(m_clusterMark.begin(), m_clusterMark.end(), 0u);
+            m_serial = 1;
+        }
+
+        auto addPoint = [&](float x, float z)
+        {
+            const int c = clusterOf(grid, x, z);
+            if (m_clusterMark[c] == m_serial)
+                return;
+            m_clusterMark[c] = m_serial;
+            m_clusters[c].push_back(Entry{e.index, o.stamp});
+        };
+
+        addPoint(pointsXZ[0], pointsXZ[1]);
+        for (uint32_t i = 1; i < pointCount; ++i)
+        {
+            const float x0 = pointsXZ[2 * (i - 1)], z0 = pointsXZ[2 * (i - 1) + 1];
+            const float x1 = pointsXZ[2 * i], z1 = pointsXZ[2 * i + 1];
+            const float len = std::sqrt((x1 - x0) * (x1 - x0) + (z1 - z0) * (z1 - z0));
+            const int steps = std::max(1, static_cast<int>(std::ceil(len / grid.cellSize)));
+            for (int s = 1; s <= steps; ++s)
+            {
+                const float t = static_cast<float>(s) / static_cast<float>(steps);
+                addPoint(x0 + (x1 - x0) * t, z0 + (z1 - z0) * t);
+            }
+        }
+    }
+
+    /// Forget `e`'s route (target cleared, entity died, ...). Its entries go stale.
+    void remove(Engine::ECS::Entity e)
+    {
+        if (e.index < m_owners.size() && m_owners[e.index].live)
+        {
+            ++m_owners[e.index].stamp;
+            m_owners[e.index].live = false;
+        }
+    }
+
+    /// Append every entity whose indexed route touches a cluster overlapping `r`
+    /// expanded by `marginCells`. Each entity is reported once; stale entries are purged.
+    void query(const NavGrid::CellRect &r, int marginCells, std::vector<Engine::ECS::Entity> &out)
+    {
+        if (m_clusters.empty() || r.empty())
+            return;
+
+        const int cx0 = std::max(0, (r.minX - marginCells) / kClusterCells);
+        const int cz0 = std::max(0, (r.minZ - marginCells) / kClusterCells);
+        const int cx1 = std::min(m_clustersX - 1, (r.maxX + marginCells) / kClusterCells);
+        const int cz1 = std::min(m_clustersZ - 1, (r.maxZ + marginCells) / kClusterCells);
+
+        ++m_querySerial;
+        for (int cz = cz0; cz <= cz1; ++cz)
+        {
+            for (int cx = cx0; cx <= cx1; ++cx)
+            {
+                std::vector<Entry> &list = m_clusters[static_cast<size_t>(cz) * m_clustersX + cx];
+                for (size_t k = 0; k < list.size();)
+                {
+                    const Entry &en = list[k];
+                    Owner &o = m_owners[en.entityIndex];
+                    if (!o.live || o.stamp != en.stamp)
+                    {
+                        list[k] = list.back();
+                        list.pop_back();
+                        continue;
+                    }
+                    if (o.queryMark != m_querySerial)
+                    {
+                        o.queryMark = m_querySerial;
+                        out.push_back(o.entity);
+                    }
+                    ++k;
+                }
+            }
+        }
+    }
+
+    /// Size class the entity's indexed route was planned at (0 if not indexed).
+    uint8_t minClearOf(Engine::ECS::Entity e) const
+    {
+        return (e.index < m_owners.size() && m_owners[e.index].live) ? m_owners[e.index].minClear : uint8_t(0);
+    }
+
+    size_t entryCount() const
+    {
+        size_t n = 0;
+        for (const auto &list : m_clusters)
+            n += list.size();
+        return n;
+    }
+
+private:
+    struct Entry
+    {
+        uint32_t entityIndex = 0;
+        uint32_t stamp = 0;
+    };
+
+    struct Owner
+    {
+        Engine::ECS::Entity entity;
+        uint32_t stamp = 0;
+        uint32_t queryMark = 0;
+        uint8_t minClear = 0;
+        bool live = false;
+    };
+
+    Owner &owner(Engine::ECS::Entity e)
+    {
+        if (e.index >= m_owners.size())
+            m_owners.resize(static_cast<size_t>(e.index) + 1);
+        return m_owners[e.index];
+    }
+
+    int clusterOf(const NavGrid &grid, float x, float z) const
+    {
+        const int gx = std::max(0, std::min(grid.width - 1, grid.worldToGridX(x)));
+        const int gz = std::max(0, std::min(grid.height - 1, grid.worldToGridZ(z)));
+        return (gz / kClusterCells) * m_clustersX + gx / kClusterCells;
+    }
+
+    int m_clustersX = 0;
+    int m_clustersZ = 0;
+    std::vector<std::vector<Entry>> m_clusters;
+    std::vector<uint32_t> m_clusterMark; // dedupe clusters within one insert()
+    std::vector<Owner> m_owners;         // indexed by entity index
+    uint32_t m_serial = 0;
+    uint32_t m_querySerial = 0;
+};
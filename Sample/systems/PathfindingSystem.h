@@ -6,6 +6,10 @@
     - Finds A* path for units that have a MoveTarget but no valid Path.
     - Updates Path component with waypoints.
     - Only runs when needed (dirty query on MoveTarget).
+    - Skips Sleeping units (ActivitySystem); the dirty MoveTarget that wakes one also
+      brings it back into the query.
+    - Plans nothing while NavGrid::rebuilding (a time-sliced full rebuild is in flight);
+      requests made meanwhile stay dirty and are served once it completes.
   
   Optimizations:
     - Generation counter avoids clearing 160K-element arrays per A* call.
@@ -16,14 +20,30 @@
     - Compact index-based NodeEntry (8 bytes) for better cache utilization.
     - Grid-space lineCheck avoids float↔int conversions in smoothing.
     - Target cell validation with spiral fallback prevents wasted A* on blocked goals.
+    - Neighbour expansion reads a 3x3 block from the bit-packed NavGrid in one call.
+    - Radius-aware: each agent needs NavGrid clearance >= requiredClearance(Radius + margin),
+      so small units fit through gaps that large ones can't, on the same grid.
+    - Clearance-based smoothing skips known-clear cells along each line check.
+    - Waypoints are stored in ECSContext::pathPool sized to the smoothed path; consecutive
+      requests with the same start cell, goal and size class share one pooled span.
+    - Path cache keyed by (start region, goal cell, size class); squad-mates splice onto a
+      cached route with a short local A*. Flushed when a NavGrid rebuild completes
+      (settledVersion); in between, an entry from an older version is line-checked again
+      before use and dropped if the grid now blocks it.
+    - Selective invalidation: every route is registered in a PathIndex (clusters it
+      crosses). When NavGridBuilderSystem publishes NavGrid::changes, only routes near a
+      changed region are re-checked, and only those now blocked (or that may shortcut
+      through a region that opened up) are re-planned.
 */
 
 #include "ECS/SystemFormat.h"
 #include "NavGrid.h"
+#include "PathIndex.h"
 #include <cmath>
 #include <algorithm>
 #include <cstdint>
 #include <vector>
+#include <unordered_map>
 
 class PathfindingSystem : public Engine::ECS::SystemBase
 {
@@ -32,11 +52,29 @@ public:
         : m_grid(grid)
     {
         setRequiredNames({"Position", "MoveTarget", "Path"});
-        setExcludedNames({"Disabled", "Dead", "Obstacle"});
+        setExcludedNames({"Disabled", "Dead", "Obstacle", "Sleeping"});
     }
 
     const char *name() const override { return "PathfindingSystem"; }
 
+    // Default A* expansion budget per request.
+    static constexpr int kMaxNodes = 4000;
+
+    // Cumulative counters (never reset) for the performance overlay.
+    struct Stats
+    {
+        uint64_t searches = 0;        // full A* searches
+        uint64_t expansions = 0;      // nodes expanded (full + splice searches)
+        uint64_t cacheLookups = 0;    // requests that needed A* and consulted the cache
+        uint64_t cacheHits = 0;       // requests served by splicing onto a cached route
+        uint64_t cacheMisses = 0;     // lookups without a usable entry (incl. stale / failed splices)
+        uint64_t spliceFailures = 0;  // cached route found but the splice search failed
+        uint64_t savedExpansions = 0; // original search cost minus splice cost, summed over hits
+        uint64_t invalidationChecks = 0; // routes re-checked against NavGrid changes
+        uint64_t pathsInvalidated = 0;   // routes re-planned because of NavGrid changes
+    };
+    const Stats &stats() const { return m_stats; }
+
     void buildMasks(Engine::ECS::ComponentRegistry &registry) override
     {
         Engine::ECS::SystemBase::buildMasks(registry);
@@ -57,6 +95,20 @@ public:
             m_queryId = ecs.queries.createDirtyQuery(required(), excluded(), dirty, ecs.stores);
         }
 
+        // Mid sliced full rebuild (resize) the grid is partly unstamped: leave the dirty rows
+        // queued and existing paths alone. The changes are caught up on afterwards (or,
+        // past NavGrid::kChangeHistory versions, every route is re-planned).
+        if (m_grid->rebuilding)
+            return;
+
+        // Re-plan routes crossing obstacle changes; marks their MoveTarget dirty so the
+        // loop below picks them up this frame.
+        m_pathIndex.resize(*m_grid);
+        invalidateChangedPaths(ecs);
+
+        // Sharing is only valid within one update (the grid can change between frames).
+        m_lastPlan = SharedPlan{};
+
         const auto &q = ecs.queries.get(m_queryId);
         for (uint32_t archetypeId : q.matchingArchetypeIds)
         {
@@ -72,6 +124,7 @@ public:
             auto &positions = store.positions();
             auto &targets = store.moveTargets();
             auto &paths = store.paths();
+            const auto &entities = store.entities();
             const uint32_t n = store.size();
 
             for (uint32_t i : dirtyRows)
@@ -85,6 +138,10 @@ public:
 
                 if (!tgt.active)
                 {
+                    m_pathIndex.remove(entities[i]);
+                    ecs.pathPool.release(path.handle);
+                    path.handle = Engine::ECS::PathPool::InvalidHandle;
+                    path.count = 0;
                     path.valid = false;
                     continue;
                 }
@@ -100,11 +157,50 @@ public:
                 }
 
                 // Plan path!
-                runAStar(pos, tgt, path);
+                const float agentRadius = store.hasRadius() ? store.radii()[i].r : 0.0f;
+                const uint8_t plannedClear = planPath(ecs.pathPool, pos, tgt, path, agentRadius);
+                if (path.valid)
+                    indexRoute(ecs.pathPool, entities[i], pos, tgt, path, plannedClear);
+                else
+                    m_pathIndex.remove(entities[i]);
             }
         }
     }
 
+    /// Plan one path for an agent of the given radius (also used by tools/benchmarks).
+    /// Searches at the agent's clearance size class; if the agent is squeezed so tightly
+    /// that nothing is reachable at its clearance, falls back to plain walkability.
+    /// `maxNodes` bounds the A* expansion (callers planning one path for many units,
+    /// e.g. a formation leader, can afford more). Returns the clearance the route was planned at.
+    uint8_t planPath(Engine::ECS::PathPool &pool, const Engine::ECS::Position &pos,
+                     const Engine::ECS::MoveTarget &tgt, Engine::ECS::Path &path, float agentRadius,
+                     int maxNodes = kMaxNodes)
+    {
+        const uint8_t minClear = m_grid->requiredClearance(agentRadius + kClearanceMargin);
+        if (runAStar(pool, pos, tgt, path, minClear, maxNodes) || minClear <= 1)
+            return minClear;
+        runAStar(pool, pos, tgt, path, 1, maxNodes);
+        return 1;
+    }
+
+    /// Enable/disable the path cache (enabled by default). Disabling also clears it.
+    void setCacheEnabled(bool enabled)
+    {
+        m_cacheEnabled = enabled;
+        if (!enabled)
+            m_cache.clear();
+    }
+
+    /// Drop `e`'s route from the selective-invalidation index, for callers that replace
+    /// its Path themselves (FormationSystem members).
+    void forgetRoute(Engine::ECS::Entity e) { m_pathIndex.remove(e); }
+
+    /// Clearance (in cells) PathfindingSystem requires for an agent of this radius.
+    uint8_t clearanceFor(float agentRadius) const
+    {
+        return m_grid ? m_grid->requiredClearance(agentRadius + kClearanceMargin) : uint8_t(1);
+    }
+
 private:
     const NavGrid *m_grid;
     Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
@@ -131,10 +227,70 @@ private:
     std::vector<int> m_pathIndices;   // backtracked cell indices (raw)
     std::vector<int> m_smoothedIdx;   // smoothed cell indices
 
+    // Last pooled path written this update; an identical request reuses its span.
+    struct SharedPlan
+    {
+        int startIdx = -1;
+        int targetIdx = -1;
+        uint8_t minClear = 0;
+        float targetX = 0.0f;
+        float targetZ = 0.0f;
+        Engine::ECS::PathHandle handle = Engine::ECS::PathPool::InvalidHandle;
+    };
+    SharedPlan m_lastPlan;
+
+    // Path cache: smoothed routes keyed by (start region, goal cell, size class), kept until
+    // the NavGrid settles after a rebuild. Nearby requests splice onto a cached route.
+    struct CacheEntry
+    {
+        std::vector<int> cells; // smoothed cell indices, start excluded
+        int expansions = 0;     // A* cost of the original search
+        uint32_t version = 0;   // NavGrid version the route was last checked against
+    };
+    std::unordered_map<uint64_t, CacheEntry> m_cache;
+    uint32_t m_cacheVersion = 0; // NavGrid::settledVersion the cache was flushed at
+    bool m_cacheEnabled = true;
+
+    // Selective invalidation
+    PathIndex m_pathIndex;
+    uint32_t m_changesVersion = 0;
+    std::vector<Engine::ECS::Entity> m_candidates;
+    std::vector<float> m_routeScratch;
+    int m_lastExpansions = 0;
+    Stats m_stats;
+
+    static constexpr int kLocalMaxNodes = 256;      // budget for the splice search
+    static constexpr int kCacheRegionCells = 8;     // start-region size (cells per side)
+    static constexpr size_t kMaxCacheEntries = 512;
+    static constexpr size_t kMaxLookahead = 16;     // string pulling / splice join window
+
     // Weighted A*: epsilon > 1.0 trades optimality for speed.
     // 1.2 means paths are at most 20% longer than optimal — great for games.
     static constexpr float kEpsilon = 1.2f;
 
+    // Extra clearance (world units) on top of the agent radius, absorbing steering
+    // overshoot around corners so units don't clip stump trunks.
+    static constexpr float kClearanceMargin = 1.0f;
+
+    // Bit position of neighbour (dx, dz) in NavGrid::neighborMask().
+    static constexpr int nbBit(int dx, int dz) { return (dz + 1) * 3 + (dx + 1); }
+
+    // Same layout as NavGrid::neighborMask(), but a bit is set when the cell's clearance
+    // is below minClear (blocked and off-grid cells have clearance 0).
+    uint32_t clearanceMask(int cx, int cz, uint8_t minClear) const
+    {
+        uint32_t mask = 0;
+        for (int dz = -1; dz <= 1; ++dz)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                if (m_grid->clearanceAt(cx + dx, cz + dz) < minClear)
+                    mask |= 1u << nbBit(dx, dz);
+            }
+        }
+        return mask;
+    }
+
     // Heuristic: Octile distance
     float heuristic(int x1, int z1, int x2, int z2) const
     {
@@ -176,22 +332,31 @@ private:
         m_closedGen[idx] = m_currentGen;
     }
 
-    void runAStar(const Engine::ECS::Position &startPos, const Engine::ECS::MoveTarget &target, Engine::ECS::Path &outPath)
+    // Returns false if the search could not leave the start cell or find a usable goal
+    // cell at the requested clearance (outPath is still written).
+    bool runAStar(Engine::ECS::PathPool &pool, const Engine::ECS::Position &startPos,
+                  const Engine::ECS::MoveTarget &target, Engine::ECS::Path &outPath, uint8_t minClear,
+                  int maxNodes)
     {
+        // Drop the previous route's waypoints; every exit below writes a fresh state.
+        pool.release(outPath.handle);
+        outPath.handle = Engine::ECS::PathPool::InvalidHandle;
+        outPath.count = 0;
+        outPath.current = 0;
+
         const int W = m_grid->width;
         const int H = m_grid->height;
 
         auto idx = [W](int x, int z) { return z * W + x; };
-        auto idxToX = [W](int i) { return i % W; };
-        auto idxToZ = [W](int i) { return i / W; };
 
-        const int startX = m_grid->worldToGridX(startPos.x);
-        const int startZ = m_grid->worldToGridZ(startPos.z);
+        const int startX = std::max(0, std::min(W - 1, m_grid->worldToGridX(startPos.x)));
+        const int startZ = std::max(0, std::min(H - 1, m_grid->worldToGridZ(startPos.z)));
         int targetX = std::max(0, std::min(W - 1, m_grid->worldToGridX(target.x)));
         int targetZ = std::max(0, std::min(H - 1, m_grid->worldToGridZ(target.z)));
 
-        // --- Target validation: if target cell is blocked, spiral-search for nearest walkable ---
-        if (!m_grid->isWalkable(targetX, targetZ))
+        // --- Target validation: if target cell is blocked (or too tight for this agent),
+        //     spiral-search for the nearest cell with enough clearance ---
+        if (!m_grid->isClear(targetX, targetZ, minClear))
         {
             bool relocated = false;
             for (int r = 1; r <= 10 && !relocated; ++r)
@@ -202,7 +367,7 @@ private:
                     {
                         if (std::abs(dx) != r && std::abs(dz) != r) continue; // only ring
                         int nx = targetX + dx, nz = targetZ + dz;
-                        if (m_grid->isWalkable(nx, nz))
+                        if (m_grid->isClear(nx, nz, minClear))
                         {
                             targetX = nx; targetZ = nz;
                             relocated = true;
@@ -213,7 +378,7 @@ private:
             if (!relocated)
             {
                 outPath.valid = false;
-                return; // No reachable cell near target
+                return false; // No reachable cell near target
             }
         }
 
@@ -226,18 +391,102 @@ private:
             outPath.valid = true;
             outPath.count = 0;
             outPath.current = 0;
-            return;
+            return true;
+        }
+
+        // Identical request to the previous plan (same cells, exact target, size class):
+        // share its pooled waypoints instead of searching again.
+        if (pool.isLive(m_lastPlan.handle) && m_lastPlan.startIdx == startIdx && m_lastPlan.targetIdx == targetIdx &&
+            m_lastPlan.minClear == minClear && m_lastPlan.targetX == target.x && m_lastPlan.targetZ == target.z)
+        {
+            outPath.handle = pool.addRef(m_lastPlan.handle);
+            outPath.count = pool.count(outPath.handle);
+            outPath.valid = true;
+            return true;
         }
 
         // Line-of-sight shortcut: skip A* if straight line is clear
-        if (m_grid->lineCheckGrid(startX, startZ, targetX, targetZ))
+        if (m_grid->lineCheckGrid(startX, startZ, targetX, targetZ, minClear))
         {
             outPath.valid = true;
             outPath.count = 0;
             outPath.current = 0;
-            return;
+            return true;
+        }
+
+        // --- Path cache: splice onto a nearby unit's route to the same goal cell ---
+        if (m_cacheVersion != m_grid->settledVersion)
+        {
+            m_cache.clear();
+            m_cacheVersion = m_grid->settledVersion;
         }
 
+        const uint64_t key = cacheKey(startX, startZ, targetIdx, minClear);
+        auto cached = m_cache.end();
+        if (m_cacheEnabled)
+        {
+            ++m_stats.cacheLookups;
+            cached = m_cache.find(key);
+            if (cached != m_cache.end() && !cacheEntryCurrent(cached->second, minClear))
+            {
+                m_cache.erase(cached);
+                cached = m_cache.end();
+            }
+        }
+        if (cached != m_cache.end())
+        {
+            if (spliceCached(cached->second, startX, startZ, minClear))
+            {
+                ++m_stats.cacheHits;
+                m_stats.expansions += static_cast<uint64_t>(m_lastExpansions);
+                if (cached->second.expansions > m_lastExpansions)
+                    m_stats.savedExpansions += static_cast<uint64_t>(cached->second.expansions - m_lastExpansions);
+
+                writeWaypoints(pool, target, outPath, startIdx, targetIdx, minClear);
+                return true;
+            }
+            // The failed splice search still cost its expansions.
+            ++m_stats.spliceFailures;
+            m_stats.expansions += static_cast<uint64_t>(m_lastExpansions);
+        }
+        if (m_cacheEnabled)
+            ++m_stats.cacheMisses;
+
+        // --- Full search ---
+        const bool found = searchCells(startX, startZ, targetX, targetZ, minClear, maxNodes);
+        ++m_stats.searches;
+        m_stats.expansions += static_cast<uint64_t>(m_lastExpansions);
+
+        smoothCells(startX, startZ, minClear);
+
+        if (m_cacheEnabled && found && !m_smoothedIdx.empty())
+        {
+            if (m_cache.size() >= kMaxCacheEntries)
+                m_cache.clear(); // crude bound; entries are cheap to rebuild
+            CacheEntry &entry = m_cache[key];
+            entry.cells = m_smoothedIdx;
+            entry.expansions = m_lastExpansions;
+            entry.version = m_grid->version;
+        }
+
+        writeWaypoints(pool, target, outPath, startIdx, targetIdx, minClear);
+        return found || !m_pathIndices.empty();
+    }
+
+    // Weighted A* from (startX, startZ) to (targetX, targetZ), expanding at most maxNodes.
+    // Fills m_pathIndices with the raw cell corridor (start excluded) to the target, or to
+    // the closest cell reached when the target wasn't found. Returns true if found.
+    bool searchCells(int startX, int startZ, int targetX, int targetZ, uint8_t minClear, int maxNodes)
+    {
+        const int W = m_grid->width;
+
+        auto idx = [W](int x, int z) { return z * W + x; };
+        auto idxToX = [W](int i) { return i % W; };
+        auto idxToZ = [W](int i) { return i / W; };
+
+        const int startIdx = idx(startX, startZ);
+        const int targetIdx = idx(targetX, targetZ);
+
         // --- Generation counter: bump instead of clearing arrays ---
         ensureGridBuffers();
         ++m_currentGen;
@@ -275,7 +524,6 @@ private:
         float closestH = startH;
 
         int nodesExplored = 0;
-        constexpr int MAX_NODES = 4000;
 
         static constexpr int dxAddr[] = {0, 0, -1, 1, -1, -1, 1, 1};
         static constexpr int dzAddr[] = {-1, 1, 0, 0, -1, 1, -1, 1};
@@ -289,7 +537,7 @@ private:
                 continue;
             setClosed(current.idx);
 
-            if (++nodesExplored > MAX_NODES)
+            if (++nodesExplored > maxNodes)
                 break;
 
             if (current.idx == targetIdx)
@@ -310,21 +558,24 @@ private:
             const int cx = idxToX(current.idx);
             const int cz = idxToZ(current.idx);
 
+            // One 3x3 fetch covers all 8 neighbours and the diagonal corner checks
+            // (off-grid cells read as blocked). Size classes above 1 cell read clearance.
+            const uint32_t nbBlocked = (minClear <= 1) ? m_grid->neighborMask(cx, cz)
+                                                       : clearanceMask(cx, cz, minClear);
+
             for (int i = 0; i < 8; ++i)
             {
+                if (nbBlocked & (1u << nbBit(dxAddr[i], dzAddr[i]))) continue;
+
                 const int nx = cx + dxAddr[i];
                 const int nz = cz + dzAddr[i];
-
-                if (nx < 0 || nx >= W || nz < 0 || nz >= H) continue;
-
                 const int nIdx = idx(nx, nz);
-                if (m_grid->blocked[nIdx]) continue; // direct array access (faster than isWalkable)
                 if (isClosed(nIdx)) continue;
 
                 // Diagonal corner check
                 if (i >= 4)
                 {
-                    if (m_grid->blocked[idx(cx, nz)] || m_grid->blocked[idx(nx, cz)])
+                    if (nbBlocked & ((1u << nbBit(0, dzAddr[i])) | (1u << nbBit(dxAddr[i], 0))))
                         continue;
                 }
 
@@ -339,6 +590,8 @@ private:
             }
         }
 
+        m_lastExpansions = std::min(nodesExplored, maxNodes);
+
         // Reconstruct path (flat indices)
         int backIdx = found ? targetIdx : closestIdx;
         m_pathIndices.clear();
@@ -353,15 +606,21 @@ private:
         }
 
         std::reverse(m_pathIndices.begin(), m_pathIndices.end());
+        return found;
+    }
+
+    // --- String Pulling (grid-space lineCheck, capped lookahead) ---
+    // Reduces m_pathIndices (corridor from the start cell) to m_smoothedIdx.
+    void smoothCells(int startX, int startZ, uint8_t minClear)
+    {
+        const int W = m_grid->width;
+        auto idxToX = [W](int i) { return i % W; };
+        auto idxToZ = [W](int i) { return i / W; };
 
-        // --- String Pulling (grid-space lineCheck, capped lookahead) ---
-        // Prepend start to get full corridor
         m_smoothedIdx.clear();
         m_smoothedIdx.reserve(m_pathIndices.size() + 1);
 
-        constexpr size_t kMaxLookahead = 16;
-
-        // Use startIdx as anchor; walk forward through m_pathIndices
+        // Use the start cell as anchor; walk forward through m_pathIndices
         int anchorX = startX, anchorZ = startZ;
         size_t pi = 0;
 
@@ -374,7 +633,7 @@ private:
             {
                 const int jx = idxToX(m_pathIndices[j]);
                 const int jz = idxToZ(m_pathIndices[j]);
-                if (!m_grid->lineCheckGrid(anchorX, anchorZ, jx, jz))
+                if (!m_grid->lineCheckGrid(anchorX, anchorZ, jx, jz, minClear))
                     break;
                 bestAdvance = j;
             }
@@ -392,29 +651,244 @@ private:
         {
             m_smoothedIdx.push_back(m_pathIndices.back());
         }
+    }
 
-        // Fill waypoints; use exact target coords for the final one.
-        outPath.count = 0;
+    // Build m_smoothedIdx for a unit at (startX, startZ) from a cached route:
+    // join at the furthest cached waypoint (within lookahead) that is directly visible,
+    // otherwise run a short local A* onto the route's first waypoint.
+    // Sets m_lastExpansions to the local search cost (0 for a direct join).
+    // An entry from an older NavGrid version (mid-rebuild) is only reused if every leg of
+    // it is still clear for `minClear`.
+    bool cacheEntryCurrent(CacheEntry &entry, uint8_t minClear) const
+    {
+        if (entry.version == m_grid->version)
+            return true;
+        const int W = m_grid->width;
+        const std::vector<int> &cells = entry.cells;
+        for (size_t k = 1; k < cells.size(); ++k)
+        {
+            if (!m_grid->lineCheckGrid(cells[k - 1] % W, cells[k - 1] / W, cells[k] % W, cells[k] / W, minClear))
+                return false;
+        }
+        entry.version = m_grid->version;
+        return true;
+    }
+
+    bool spliceCached(const CacheEntry &entry, int startX, int startZ, uint8_t minClear)
+    {
+        const int W = m_grid->width;
+        const std::vector<int> &cells = entry.cells;
+        if (cells.empty())
+            return false;
+
+        m_lastExpansions = 0;
+
+        size_t join = cells.size();
+        const size_t maxCheck = std::min(cells.size(), kMaxLookahead);
+        for (size_t k = 0; k < maxCheck; ++k)
+        {
+            if (m_grid->lineCheckGrid(startX, startZ, cells[k] % W, cells[k] / W, minClear))
+                join = k;
+        }
+
+        if (join < cells.size())
+        {
+            m_smoothedIdx.assign(cells.begin() + static_cast<std::ptrdiff_t>(join), cells.end());
+            return true;
+        }
+
+        if (!searchCells(startX, startZ, cells[0] % W, cells[0] / W, minClear, kLocalMaxNodes))
+            return false;
+
+        smoothCells(startX, startZ, minClear); // ends at cells[0]
+        m_smoothedIdx.insert(m_smoothedIdx.end(), cells.begin() + 1, cells.end());
+        return true;
+    }
+
+    // Copy m_smoothedIdx into a pooled span (capped at MAX_WAYPOINTS); the final waypoint
+    // uses the exact target coordinates.
+    void writeWaypoints(Engine::ECS::PathPool &pool, const Engine::ECS::MoveTarget &target,
+                        Engine::ECS::Path &outPath, int startIdx, int targetIdx, uint8_t minClear)
+    {
+        const int W = m_grid->width;
+
+        const uint32_t wpCount = static_cast<uint32_t>(
+            std::min<size_t>(m_smoothedIdx.size(), Engine::ECS::Path::MAX_WAYPOINTS));
+        outPath.handle = pool.allocate(wpCount);
+        outPath.count = pool.count(outPath.handle);
         outPath.current = 0;
 
-        for (size_t si = 0; si < m_smoothedIdx.size(); ++si)
+        if (outPath.count > 0)
         {
-            if (outPath.count >= Engine::ECS::Path::MAX_WAYPOINTS) break;
+            float *wp = pool.data(outPath.handle);
+            for (uint32_t si = 0; si < outPath.count; ++si)
+            {
+                const bool isLast = (si == m_smoothedIdx.size() - 1);
+                if (isLast)
+                {
+                    wp[2 * si + 0] = target.x;
+                    wp[2 * si + 1] = target.z;
+                }
+                else
+                {
+                    wp[2 * si + 0] = m_grid->gridToWorldX(m_smoothedIdx[si] % W);
+                    wp[2 * si + 1] = m_grid->gridToWorldZ(m_smoothedIdx[si] / W);
+                }
+            }
+
+            m_lastPlan = SharedPlan{startIdx, targetIdx, minClear, target.x, target.z, outPath.handle};
+        }
 
-            const bool isLast = (si == m_smoothedIdx.size() - 1);
-            if (isLast)
+        outPath.valid = true;
+    }
+
+    // Register the remaining route (position -> waypoints, or straight to the target).
+    void indexRoute(const Engine::ECS::PathPool &pool, Engine::ECS::Entity e, const Engine::ECS::Position &pos,
+                    const Engine::ECS::MoveTarget &tgt, const Engine::ECS::Path &path, uint8_t minClear)
+    {
+        gatherRoute(pool, pos, tgt, path);
+        m_pathIndex.insert(*m_grid, e, m_routeScratch.data(),
+                           static_cast<uint32_t>(m_routeScratch.size() / 2), minClear);
+    }
+
+    // m_routeScratch = [pos, waypoints from path.current on] (or [pos, target] for a
+    // line-of-sight route), interleaved x/z.
+    void gatherRoute(const Engine::ECS::PathPool &pool, const Engine::ECS::Position &pos,
+                     const Engine::ECS::MoveTarget &tgt, const Engine::ECS::Path &path)
+    {
+        m_routeScratch.clear();
+        m_routeScratch.push_back(pos.x);
+        m_routeScratch.push_back(pos.z);
+        if (path.count == 0 || !pool.isLive(path.handle))
+        {
+            m_routeScratch.push_back(tgt.x);
+            m_routeScratch.push_back(tgt.z);
+            return;
+        }
+        const float *wp = pool.data(path.handle);
+        for (uint32_t k = path.current; k < path.count; ++k)
+        {
+            m_routeScratch.push_back(wp[2 * k]);
+            m_routeScratch.push_back(wp[2 * k + 1]);
+        }
+    }
+
+    // Process the NavGrid::changes published since the last visit (every version in between,
+    // not just the latest): look up routes near each changed region in the PathIndex,
+    // re-check them and re-plan (valid = false + MoveTarget dirty) those that are affected.
+    // If the grid's history no longer reaches back that far, every route is re-planned.
+    void invalidateChangedPaths(Engine::ECS::ECSContext &ecs)
+    {
+        if (m_changesVersion == m_grid->version)
+            return;
+        const uint32_t seen = m_changesVersion;
+        m_changesVersion = m_grid->version;
+
+        if (seen + 1 < m_grid->changesFrom)
+        {
+            invalidateChange(ecs, NavGrid::Change{m_grid->fullRect(), true, m_grid->version});
+            return;
+        }
+        for (const NavGrid::Change &change : m_grid->changes)
+        {
+            if (change.version > seen)
+                invalidateChange(ecs, change);
+        }
+    }
+
+    void invalidateChange(Engine::ECS::ECSContext &ecs, const NavGrid::Change &change)
+    {
+        // Clearance (what routes are checked against) changes up to kMaxClearance cells
+        // beyond a rebuilt rect; +1 covers legs the index only clipped at a corner.
+        constexpr int kMargin = NavGrid::kMaxClearance + 1;
+
+        m_candidates.clear();
+        m_pathIndex.query(change.rect, kMargin, m_candidates);
+
+        const NavGrid::CellRect zone{change.rect.minX - kMargin, change.rect.minZ - kMargin,
+                                     change.rect.maxX + kMargin, change.rect.maxZ + kMargin};
+
+        for (const Engine::ECS::Entity e : m_candidates)
+        {
+            const Engine::ECS::EntityRecord *rec = ecs.entities.find(e);
+            Engine::ECS::ArchetypeStore *store = rec ? ecs.stores.get(rec->archetypeId) : nullptr;
+            if (!store || !store->hasPath() || !store->hasMoveTarget() || rec->row >= store->size())
+            {
+                m_pathIndex.remove(e);
+                continue;
+            }
+
+            auto &path = store->paths()[rec->row];
+            const auto &tgt = store->moveTargets()[rec->row];
+            if (!path.valid || !tgt.active)
             {
-                outPath.waypointsX[outPath.count] = target.x;
-                outPath.waypointsZ[outPath.count] = target.z;
+                m_pathIndex.remove(e);
+                continue;
             }
-            else
+            if (!store->signature().containsNone(excluded()))
             {
-                outPath.waypointsX[outPath.count] = m_grid->gridToWorldX(idxToX(m_smoothedIdx[si]));
-                outPath.waypointsZ[outPath.count] = m_grid->gridToWorldZ(idxToZ(m_smoothedIdx[si]));
+                // Asleep (or otherwise out of the query): re-plan once it wakes up
+                // instead of re-checking it here.
+                m_pathIndex.remove(e);
+                path.valid = false;
+                continue;
             }
-            outPath.count++;
+
+            ++m_stats.invalidationChecks;
+            gatherRoute(ecs.pathPool, store->positions()[rec->row], tgt, path);
+            if (!routeAffected(zone, change.opened, m_pathIndex.minClearOf(e)))
+                continue;
+
+            ++m_stats.pathsInvalidated;
+            m_pathIndex.remove(e);
+            path.valid = false;
+            ecs.markDirty(m_moveTargetId, rec->archetypeId, rec->row);
         }
+    }
 
-        outPath.valid = true;
+    // Does the route in m_routeScratch pass through `zone` and either hit a cell that is
+    // now too tight for it, or (opened) pass near a region that may offer a shortcut?
+    bool routeAffected(const NavGrid::CellRect &zone, bool opened, uint8_t minClear) const
+    {
+        const size_t points = m_routeScratch.size() / 2;
+        for (size_t k = 1; k < points; ++k)
+        {
+            const float x0 = m_routeScratch[2 * (k - 1)], z0 = m_routeScratch[2 * (k - 1) + 1];
+            const float x1 = m_routeScratch[2 * k], z1 = m_routeScratch[2 * k + 1];
+            if (!legTouches(zone, x0, z0, x1, z1))
+                continue;
+            if (opened)
+                return true;
+            if (!m_grid->lineCheckGrid(m_grid->worldToGridX(x0), m_grid->worldToGridZ(z0),
+                                       m_grid->worldToGridX(x1), m_grid->worldToGridZ(z1), minClear))
+                return true;
+        }
+        return false;
+    }
+
+    // Sample the leg once per cell (like PathIndex) and test against the zone.
+    bool legTouches(const NavGrid::CellRect &zone, float x0, float z0, float x1, float z1) const
+    {
+        const float len = std::sqrt((x1 - x0) * (x1 - x0) + (z1 - z0) * (z1 - z0));
+        const int steps = std::max(1, static_cast<int>(std::ceil(len / m_grid->cellSize)));
+        for (int s = 0; s <= steps; ++s)
+        {
+            const float t = static_cast<float>(s) / static_cast<float>(steps);
+            const int gx = m_grid->worldToGridX(x0 + (x1 - x0) * t);
+            const int gz = m_grid->worldToGridZ(z0 + (z1 - z0) * t);
+            if (gx >= zone.minX && gx <= zone.maxX && gz >= zone.minZ && gz <= zone.maxZ)
+                return true;
+        }
+        return false;
+    }
+
+    // Cache key: start region (kCacheRegionCells square), goal cell and size class.
+    // The NavGrid version is handled by flushing the whole cache when it changes.
+    uint64_t cacheKey(int startX, int startZ, int targetIdx, uint8_t minClear) const
+    {
+        const uint64_t rx = static_cast<uint64_t>(std::max(0, startX) / kCacheRegionCells) & 0xFFFu;
+        const uint64_t rz = static_cast<uint64_t>(std::max(0, startZ) / kCacheRegionCells) & 0xFFFu;
+        return (static_cast<uint64_t>(static_cast<uint32_t>(targetIdx)) << 32) |
+               (static_cast<uint64_t>(minClear) << 24) | (rz << 12) | rx;
     }
 };
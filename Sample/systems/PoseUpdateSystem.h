@@ -2,27 +2,44 @@
 
 #include "ECS/SystemFormat.h"
 #include "assets/AssetManager.h"
+#include "systems/SharedPosePool.h"
+#include "systems/SimLodSystem.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <vector>
 
 // PoseUpdateSystem
 // - Recomputes cached pose palettes (node + joint matrices) into ECS::PosePalette.
 // - Uses dirty query keyed off RenderAnimation/RenderModel changes.
+// - Clips baked by the AssetManager (AnimationBakeSettings) are a frame lookup instead of
+//   keyframe sampling; unbaked clips (over budget, baking off) are evaluated live.
+// - Sim-LOD: rows that are not due this frame stay queued until they are.
+// - Pose sharing (setPoseSharing): animation time is quantized to 1/shareHz buckets and all
+//   units in the same (model, clip, bucket) reference one SharedPosePool slot, evaluated once
+//   when the bucket is first reached. A unit only does work when it crosses into a new bucket.
+// - Live sampling resumes each unit's key lookups from PosePalette::keyCursor (see
+//   Engine::AnimationCursor); samplers with evenly spaced keys compute the key directly.
 class PoseUpdateSystem : public Engine::ECS::SystemBase
 {
 public:
     PoseUpdateSystem()
     {
         setRequiredNames({"RenderModel", "RenderAnimation", "PosePalette"});
-        setExcludedNames({"Disabled", "Dead"});
+        setExcludedNames({"Disabled", "Dead", "Sleeping"});
     }
 
     const char *name() const override { return "PoseUpdateSystem"; }
 
     void setAssetManager(Engine::AssetManager *assets) { m_assets = assets; }
 
+    // Buckets per second for pose sharing; 0 = every unit evaluates its own exact pose.
+    static constexpr float kDefaultPoseShareHz = 30.0f;
+    void setPoseSharing(float hz) { m_shareHz = std::max(0.0f, hz); }
+    float poseSharing() const { return m_shareHz; }
+    const SharedPosePool &sharedPoses() const { return m_pool; }
+
     void buildMasks(Engine::ECS::ComponentRegistry &registry) override
     {
         Engine::ECS::SystemBase::buildMasks(registry);
@@ -32,8 +49,13 @@ public:
 
     void update(Engine::ECS::ECSContext &ecs, float dt) override
     {
+        m_bakedPoses = 0;
+        m_livePoses = 0;
+        m_sharedHits = 0;
         if (!m_assets)
             return;
+        if (!m_interpolateOverridden)
+            m_interpolateBaked = m_assets->animationBaking().interpolate;
 
         if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
         {
@@ -42,6 +64,7 @@ public:
             dirty.set(m_renderModelId);
             m_queryId = ecs.queries.createDirtyQuery(required(), excluded(), dirty, ecs.stores);
         }
+        const bool share = m_shareHz > 0.0f;
 
         const auto &q = ecs.queries.get(m_queryId);
         for (uint32_t archetypeId : q.matchingArchetypeIds)
@@ -59,6 +82,7 @@ public:
             auto &renderModels = store->renderModels();
             auto &renderAnimations = store->renderAnimations();
             auto &posePalettes = store->posePalettes();
+            const Engine::ECS::SimLod *lods = store->hasSimLod() ? store->simLods().data() : nullptr;
 
             for (uint32_t row : dirtyRows)
             {
@@ -66,6 +90,11 @@ public:
                 {
                     continue;
                 }
+                if (SimLodGate::skip(lods, row))
+                {
+                    ecs.queries.markRowDirty(m_queryId, archetypeId, row, store->size());
+                    continue;
+                }
 
                 const Engine::ModelHandle handle = renderModels[row].handle;
                 Engine::ModelAsset *asset = m_assets->getModel(handle);
@@ -77,66 +106,179 @@ public:
                     out.jointPalette.clear();
                     out.nodeCount = 0;
                     out.jointCount = 0;
+                    out.sharedSlot = SharedPosePool::kNoSlot;
                     continue;
                 }
 
-                const auto &anim = renderAnimations[row];
-                const uint32_t safeClip = (!asset->animClips.empty())
-                                              ? std::min(anim.clipIndex, static_cast<uint32_t>(asset->animClips.size() - 1))
-                                              : 0u;
-                const float timeSec = (!asset->animClips.empty() && anim.playing) ? anim.timeSec : 0.0f;
+                if (share)
+                    writeSharedPose(handle, *asset, renderAnimations[row], out);
+                else
+                    writePose(*asset, renderAnimations[row], out);
+            }
+        }
 
-                // Compute node globals into scratch, then copy into component.
-                asset->evaluatePoseInto(safeClip, timeSec,
-                                        m_trsScratch,
-                                        m_localsScratch,
-                                        m_globalsScratch,
-                                        m_visitedScratch);
+        sweepSharedPoses(ecs);
+    }
 
-                out.nodeCount = static_cast<uint32_t>(asset->nodes.size());
-                out.nodePalette = m_globalsScratch;
+    // Point `out` at the shared slot for the unit's (model, clip, bucket), evaluating the slot
+    // at the bucket's time (bucket / shareHz) if no unit reached that bucket before.
+    void writeSharedPose(Engine::ModelHandle handle, const Engine::ModelAsset &asset,
+                         const Engine::ECS::RenderAnimation &anim, Engine::ECS::PosePalette &out)
+    {
+        const uint32_t clip = safeClip(asset, anim);
+        const float timeSec = playbackTime(asset, anim);
+        SharedPosePool::Key key;
+        key.model = (static_cast<uint64_t>(handle.generation) << 32) | handle.id;
+        key.clip = clip;
+        key.bucket = static_cast<uint32_t>(std::max(0.0f, std::floor(timeSec * m_shareHz + 0.5f))); // nearest
 
-                // Joint palette
-                out.jointCount = asset->totalJointCount;
-                out.jointPalette.assign(out.jointCount, glm::mat4(1.0f));
+        if (m_pool.matches(out.sharedSlot, key))
+        {
+            ++m_sharedHits; // still in the same bucket
+            return;
+        }
 
-                if (out.jointCount > 0 && m_globalsScratch.size() == out.nodeCount)
-                {
-                    for (const auto &skin : asset->skins)
-                    {
-                        if (skin.jointCount == 0)
-                            continue;
-                        for (uint32_t j = 0; j < skin.jointCount; ++j)
-                        {
-                            if (j >= skin.jointNodeIndices.size() || j >= skin.inverseBind.size())
-                                continue;
-
-                            const uint32_t nodeIx = skin.jointNodeIndices[j];
-                            if (nodeIx >= m_globalsScratch.size())
-                                continue;
-
-                            const uint32_t outIx = skin.jointBase + j;
-                            if (outIx >= out.jointPalette.size())
-                                continue;
-
-                            out.jointPalette[outIx] = m_globalsScratch[nodeIx] * skin.inverseBind[j];
-                        }
-                    }
-                }
-            }
+        bool created = false;
+        const uint32_t slot = m_pool.acquire(key, created);
+        SharedPosePool::Slot &s = m_pool.at(slot);
+        if (created)
+        {
+            evaluate(asset, clip, static_cast<float>(key.bucket) / m_shareHz, s.nodePalette, s.jointPalette, out.keyCursor); // clamped to the clip
+            s.nodeCount = static_cast<uint32_t>(s.nodePalette.size());
+            s.jointCount = static_cast<uint32_t>(s.jointPalette.size());
+        }
+        else
+        {
+            ++m_sharedHits;
+        }
+
+        out.sharedSlot = slot;
+        out.nodeCount = s.nodeCount;
+        out.jointCount = s.jointCount;
+        if (out.nodePalette.capacity() > 0 || out.jointPalette.capacity() > 0)
+        {
+            std::vector<Engine::PaletteMatrix>().swap(out.nodePalette);
+            std::vector<Engine::PaletteMatrix>().swap(out.jointPalette);
+        }
+    }
+
+    // Pose for one entity: a baked-frame lookup when the clip was baked at load time,
+    // otherwise keyframe sampling + hierarchy evaluation.
+    void writePose(const Engine::ModelAsset &asset, const Engine::ECS::RenderAnimation &anim, Engine::ECS::PosePalette &out)
+    {
+        evaluate(asset, safeClip(asset, anim), playbackTime(asset, anim), out.nodePalette, out.jointPalette, out.keyCursor);
+        out.nodeCount = static_cast<uint32_t>(out.nodePalette.size());
+        out.jointCount = static_cast<uint32_t>(out.jointPalette.size());
+        out.sharedSlot = SharedPosePool::kNoSlot;
+    }
+
+    // Node globals + joint palette of `clip` at `timeSec`, resized to the model's counts.
+    void evaluate(const Engine::ModelAsset &asset, uint32_t clip, float timeSec,
+                  std::vector<Engine::PaletteMatrix> &nodesOut, std::vector<Engine::PaletteMatrix> &jointsOut,
+                  Engine::AnimationCursor &cursor)
+    {
+        if (const Engine::BakedClip *baked = asset.findBakedClip(clip))
+        {
+            baked->sampleInto(timeSec, m_interpolateBaked, nodesOut, jointsOut);
+            ++m_bakedPoses;
+            return;
         }
+
+        // Full node globals into scratch, then the joint palette from them and the node rows.
+        asset.evaluatePoseInto(clip, timeSec,
+                               m_trsScratch,
+                               m_localsScratch,
+                               m_globalsScratch,
+                               m_keyCursors ? &cursor : nullptr);
+        asset.buildJointPaletteInto(m_globalsScratch, jointsOut);
+        nodesOut.resize(m_globalsScratch.size());
+        Engine::ToPaletteMatrices(m_globalsScratch.data(), m_globalsScratch.size(), nodesOut.data());
+        ++m_livePoses;
     }
 
+    /// Resume key lookups from each unit's cursor (default) or binary-search every channel
+    /// (benchmarks / debugging). Either way the same keys are sampled.
+    void setKeyCursors(bool enabled) { m_keyCursors = enabled; }
+    bool keyCursors() const { return m_keyCursors; }
+
+    /// Blend between baked frames or snap to the nearest, overriding the AssetManager's
+    /// AnimationBakeSettings::interpolate (which update() follows otherwise).
+    void setBakedInterpolation(bool enabled)
+    {
+        m_interpolateBaked = enabled;
+        m_interpolateOverridden = true;
+    }
+
+    /// Poses served from baked clips / sampled live during the last update().
+    uint32_t bakedPoses() const { return m_bakedPoses; }
+    uint32_t livePoses() const { return m_livePoses; }
+    /// Rows that reused an already evaluated shared pose during the last update().
+    uint32_t sharedPoseHits() const { return m_sharedHits; }
+
 private:
+    static uint32_t safeClip(const Engine::ModelAsset &asset, const Engine::ECS::RenderAnimation &anim)
+    {
+        return (!asset.animClips.empty())
+                   ? std::min(anim.clipIndex, static_cast<uint32_t>(asset.animClips.size() - 1))
+                   : 0u;
+    }
+
+    static float playbackTime(const Engine::ModelAsset &asset, const Engine::ECS::RenderAnimation &anim)
+    {
+        return (!asset.animClips.empty() && anim.playing) ? anim.timeSec : 0.0f;
+    }
+
+    // Recycle slots no entity references any more (dead, despawned, moved on to another
+    // bucket). Walks every PosePalette row, including excluded ones: a sleeping or dead unit
+    // still drawn keeps its slot.
+    void sweepSharedPoses(Engine::ECS::ECSContext &ecs)
+    {
+        if (m_pool.capacity() == 0)
+            return;
+        if (m_allPosesQuery == Engine::ECS::QueryManager::InvalidQuery)
+        {
+            Engine::ECS::ComponentMask posed;
+            posed.set(ecs.components.ensureId("PosePalette"));
+            m_allPosesQuery = ecs.queries.createQuery(posed, Engine::ECS::ComponentMask{}, ecs.stores);
+        }
+
+        m_pool.beginMark();
+        const auto &q = ecs.queries.get(m_allPosesQuery);
+        for (uint32_t archetypeId : q.matchingArchetypeIds)
+        {
+            const Engine::ECS::ArchetypeStore *store = ecs.stores.get(archetypeId);
+            if (!store || !store->hasPosePalette())
+                continue;
+            const auto &posePalettes = store->posePalettes();
+            const uint32_t n = store->size();
+            for (uint32_t row = 0; row < n; ++row)
+            {
+                if (posePalettes[row].sharedSlot != SharedPosePool::kNoSlot)
+                    m_pool.mark(posePalettes[row].sharedSlot);
+            }
+        }
+        m_pool.sweep();
+    }
+
     Engine::AssetManager *m_assets = nullptr;
 
     Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
     uint32_t m_renderAnimId = Engine::ECS::ComponentRegistry::InvalidID;
     uint32_t m_renderModelId = Engine::ECS::ComponentRegistry::InvalidID;
 
+    bool m_interpolateBaked = true;
+    bool m_interpolateOverridden = false; // setBakedInterpolation() wins over the bake settings
+    bool m_keyCursors = true;
+    uint32_t m_bakedPoses = 0;
+    uint32_t m_livePoses = 0;
+    uint32_t m_sharedHits = 0;
+
+    float m_shareHz = 0.0f;
+    SharedPosePool m_pool;
+    Engine::ECS::QueryId m_allPosesQuery = Engine::ECS::QueryManager::InvalidQuery;
+
     // Scratch buffers reused across rows.
     std::vector<Engine::ModelAsset::NodeTRS> m_trsScratch;
     std::vector<glm::mat4> m_localsScratch;
     std::vector<glm::mat4> m_globalsScratch;
-    std::vector<uint8_t> m_visitedScratch;
 };
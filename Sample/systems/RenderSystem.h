@@ -5,12 +5,18 @@
 #include "assets/AssetManager.h"
 
 #include "Engine/Camera.h"
+#include "Engine/PerformanceMonitor.h"
+#include "Engine/RenderSnapshot.h"
 #include "Engine/Renderer.h"
 #include "Engine/SModelRenderPassModule.h"
 
+#include "systems/SharedPosePool.h"
+
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <memory>
@@ -34,28 +40,147 @@ public:
     void setRenderer(Engine::Renderer *renderer) { m_renderer = renderer; }
     void setCamera(Engine::Camera *camera) { m_camera = camera; }
 
+    // Pool that PosePalette::sharedSlot refers to (PoseUpdateSystem::sharedPoses()). Each
+    // referenced slot is uploaded once per batch; without a pool shared rows draw in bind pose.
+    void setSharedPoses(const SharedPosePool *pool) { m_sharedPoses = pool; }
+
+    // GPU pose path: batches carry one Engine::PoseRequest (clip, time) per pose instead of
+    // palettes, and each model's pass evaluates them in a compute dispatch, so PoseUpdateSystem
+    // does not need to run. With shareHz > 0 time is snapped to the same 1/shareHz buckets pose
+    // sharing uses and units in the same (clip, bucket) share one request.
+    void setGpuPoses(bool enabled) { m_gpuPoses = enabled; }
+    bool gpuPoses() const { return m_gpuPoses; }
+    void setGpuPoseSharing(float shareHz) { m_gpuShareHz = std::max(0.0f, shareHz); }
+
+    // Fixed-step interpolation: the sim runs at its own rate, so each frame draws units at
+    // lerp(previous sim state, current sim state, alpha). capturePreviousState() must run
+    // right before every sim step; alpha comes from Engine::FixedTimestep::alpha().
+    void setInterpolationAlpha(float alpha) { m_alpha = std::clamp(alpha, 0.0f, 1.0f); }
+    // Turning interpolation back on re-seeds the previous state from the current one (on the
+    // next step or extraction, whichever comes first): what m_previous holds is from when it
+    // was last enabled, and blending against it would snap.
+    void setInterpolationEnabled(bool enabled)
+    {
+        m_seedPrevious = m_seedPrevious || (enabled && !m_interpolate);
+        m_interpolate = enabled;
+    }
+
+    void capturePreviousState(Engine::ECS::ECSContext &ecs)
+    {
+        if (!m_interpolate)
+            return;
+        m_seedPrevious = false;
+        if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
+            m_queryId = ecs.queries.createQuery(required(), excluded(), ecs.stores);
+
+        const auto &q = ecs.queries.get(m_queryId);
+        for (uint32_t archetypeId : q.matchingArchetypeIds)
+        {
+            const auto *store = ecs.stores.get(archetypeId);
+            if (!store || !store->hasPosition())
+                continue;
+            const auto &entities = store->entities();
+            const auto &positions = store->positions();
+            const auto *facings = store->hasFacing() ? &store->facings() : nullptr;
+            const uint32_t n = store->size();
+            for (uint32_t row = 0; row < n; ++row)
+            {
+                const Engine::ECS::Entity e = entities[row];
+                if (e.index >= m_previous.size())
+                    m_previous.resize(static_cast<size_t>(e.index) + 1);
+                PreviousState &prev = m_previous[e.index];
+                prev.generation = e.generation;
+                prev.x = positions[row].x;
+                prev.y = positions[row].y;
+                prev.z = positions[row].z;
+                prev.yaw = facings ? (*facings)[row].yaw : 0.0f;
+            }
+        }
+    }
+
+    // Frustum culling against a bounding sphere of kDefaultCullRadius around each unit's
+    // position (models carry no bounds yet, so the radius is a per-system setting).
+    static constexpr float kDefaultCullRadius = 2.5f;
+    void setCullingEnabled(bool enabled) { m_cull = enabled; }
+    void setCullRadius(float radius) { m_cullRadius = std::max(0.0f, radius); }
+
+    // Extraction stage: copy this frame's instances into a snapshot owned by the renderer,
+    // then make sure every model in it has a pass reading from the snapshot.
     void update(Engine::ECS::ECSContext &ecs, float dt) override
     {
+        (void)dt;
         if (!m_assets || !m_renderer || !m_camera)
             return;
 
-        auto keyFromHandle = [](const Engine::ModelHandle &h) -> uint64_t
-        {
-            return (static_cast<uint64_t>(h.generation) << 32) | static_cast<uint64_t>(h.id);
-        };
+        const VkExtent2D extent = m_renderer->getExtent();
+        if (extent.width > 0 && extent.height > 0)
+            m_camera->SetAspect(static_cast<float>(extent.width) / static_cast<float>(extent.height));
 
-        struct PerModelBatch
+        const auto t0 = std::chrono::steady_clock::now();
+        Engine::RenderSnapshotBuffer &buffer = m_renderer->snapshots();
+        Engine::RenderSnapshot &snap = buffer.beginWrite();
+        extract(ecs, snap);
+        buffer.publish();
+        const auto t1 = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < snap.batchCount; ++i)
         {
-            std::vector<glm::mat4> instanceWorlds;
-            std::vector<glm::mat4> nodePalette; // flattened: [instance][node]
-            uint32_t nodeCount = 0;
+            const Engine::RenderBatch &batch = snap.batches[i];
+            if (batch.instanceWorlds.empty())
+                continue;
+            const uint64_t key = keyFromHandle(batch.model);
+            if (m_passes.find(key) != m_passes.end())
+                continue;
 
-            std::vector<glm::mat4> jointPalette; // flattened: [instance][joint]
-            uint32_t jointCount = 0;
-        };
+            auto pass = std::make_shared<Engine::SModelRenderPassModule>();
+            pass->setAssets(m_assets);
+            pass->setModel(batch.model);
+            pass->setCamera(m_camera);
+            pass->setUseSnapshot(true);
+            pass->setEnabled(true);
+            m_renderer->registerPass(pass);
+            m_passes.emplace(key, std::move(pass));
+        }
 
-        std::unordered_map<uint64_t, PerModelBatch> batchesByModel;
-        std::unordered_map<uint64_t, Engine::ModelHandle> handleByKey;
+        Engine::OverlayStats::set("Render extract", std::chrono::duration<float, std::milli>(t1 - t0).count(), "%.2f ms");
+        Engine::OverlayStats::set("Instances drawn", static_cast<float>(snap.visibleInstances));
+        Engine::OverlayStats::set("Instances culled", static_cast<float>(snap.culledInstances));
+        Engine::OverlayStats::set("Unique poses", static_cast<float>(snap.uniquePoses));
+    }
+
+    // Fill `snap` from the ECS: per-model instance transforms (interpolated), node / joint
+    // palettes (one entry per distinct pose, indexed per instance) and the camera matrices.
+    // Batch vectors are reused, so steady-state extraction does not allocate. Without an
+    // asset manager (headless tools) palette sizes come from PosePalette alone; without a
+    // camera nothing is culled.
+    void extract(Engine::ECS::ECSContext &ecs, Engine::RenderSnapshot &snap)
+    {
+        if (m_interpolate && m_seedPrevious)
+            capturePreviousState(ecs);
+
+        for (uint32_t i = 0; i < snap.batchCount; ++i)
+            snap.batches[i].clear();
+        snap.batchCount = 0;
+        snap.visibleInstances = 0;
+        snap.culledInstances = 0;
+        snap.uniquePoses = 0;
+        ++m_extractEpoch;
+        if (m_sharedPoses && m_slotPoseEpoch.size() < m_sharedPoses->capacity())
+        {
+            m_slotPoseEpoch.resize(m_sharedPoses->capacity(), 0);
+            m_slotPose.resize(m_sharedPoses->capacity(), 0);
+        }
+
+        snap.hasCamera = m_camera != nullptr;
+        if (m_camera)
+        {
+            snap.view = m_camera->GetViewMatrix();
+            snap.proj = m_camera->GetProjectionMatrix();
+        }
+        const bool cull = m_cull && m_camera;
+        glm::vec4 planes[6];
+        if (cull)
+            extractFrustumPlanes(snap.proj * snap.view, planes);
 
         if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
             m_queryId = ecs.queries.createQuery(required(), excluded(), ecs.stores);
@@ -63,143 +188,290 @@ public:
         const auto &q = ecs.queries.get(m_queryId);
         for (uint32_t archetypeId : q.matchingArchetypeIds)
         {
-            auto *ptr = ecs.stores.get(archetypeId);
-            if (!ptr)
+            auto *store = ecs.stores.get(archetypeId);
+            if (!store)
                 continue;
-
-            auto &store = *ptr;
-            if (!store.signature().containsAll(required()))
-                continue;
-            if (!store.signature().containsNone(excluded()))
-                continue;
-            if (!store.hasRenderModel())
-                continue;
-            if (!store.hasPosePalette())
-                continue;
-            if (!store.hasPosition())
+            if (!store->hasRenderModel() || !store->hasPosePalette() || !store->hasPosition())
                 continue;
 
-            auto &renderModels = store.renderModels();
-            auto &positions = store.positions();
-            auto &posePalettes = store.posePalettes();
-            const uint32_t n = store.size();
+            const auto &renderModels = store->renderModels();
+            const auto &positions = store->positions();
+            const auto &posePalettes = store->posePalettes();
+            const auto &entities = store->entities();
+            const auto *facings = store->hasFacing() ? &store->facings() : nullptr;
+            const auto *animations = store->hasRenderAnimation() ? &store->renderAnimations() : nullptr;
+            const uint32_t n = store->size();
 
+            uint64_t lastKey = UINT64_MAX;
+            Engine::RenderBatch *batch = nullptr;
             for (uint32_t row = 0; row < n; ++row)
             {
                 const Engine::ModelHandle handle = renderModels[row].handle;
-                Engine::ModelAsset *asset = m_assets->getModel(handle);
-                if (!asset)
-                    continue;
-
                 const uint64_t key = keyFromHandle(handle);
-
-                const auto &pos = positions[row];
-
-                handleByKey[key] = handle;
-
-                auto &batch = batchesByModel[key];
-                if (batch.nodeCount == 0)
+                if (key != lastKey)
                 {
-                    // Prefer counts from PosePalette (it is what we will upload).
-                    batch.nodeCount = posePalettes[row].nodeCount;
-                    batch.jointCount = posePalettes[row].jointCount;
-                    if (batch.nodeCount == 0)
-                        batch.nodeCount = static_cast<uint32_t>(asset->nodes.size());
-                    if (batch.jointCount == 0)
-                        batch.jointCount = asset->totalJointCount;
-
-                    batch.nodePalette.reserve(64u * batch.nodeCount);
-                    if (batch.jointCount > 0)
-                        batch.jointPalette.reserve(64u * batch.jointCount);
+                    batch = batchFor(snap, handle, key, posePalettes[row]);
+                    lastKey = key;
                 }
-
-                if (batch.nodeCount == 0)
+                if (!batch)
                     continue;
 
-                // World matrix
-                auto *facings = store.hasFacing() ? &store.facings() : nullptr;
-                glm::mat4 world = glm::translate(glm::mat4(1.0f), glm::vec3(pos.x, pos.y, pos.z));
+                float x = positions[row].x, y = positions[row].y, z = positions[row].z;
+                float yaw = facings ? (*facings)[row].yaw : 0.0f;
+                if (m_interpolate)
+                    interpolate(entities[row], x, y, z, yaw);
 
-                if (facings)
+                if (cull && !sphereInFrustum(planes, x, y, z, m_cullRadius))
                 {
-                    const float yaw = (*facings)[row].yaw;
-                    world = glm::rotate(world, yaw, glm::vec3(0.0f, 1.0f, 0.0f));
+                    ++snap.culledInstances;
+                    continue;
                 }
+                ++snap.visibleInstances;
 
-                batch.instanceWorlds.emplace_back(world);
+                glm::mat4 world = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, z));
+                if (facings)
+                    world = glm::rotate(world, yaw, glm::vec3(0.0f, 1.0f, 0.0f));
+                batch->instanceWorlds.push_back(world);
 
-                // Palettes come from PosePalette component.
-                const auto &pose = posePalettes[row];
-                if (pose.nodeCount == batch.nodeCount && pose.nodePalette.size() == static_cast<size_t>(batch.nodeCount))
-                {
-                    batch.nodePalette.insert(batch.nodePalette.end(), pose.nodePalette.begin(), pose.nodePalette.end());
-                }
+                if (m_gpuPoses)
+                    batch->instancePoses.push_back(requestIndex(snap, *batch, animations ? &(*animations)[row] : nullptr));
                 else
-                {
-                    batch.nodePalette.insert(batch.nodePalette.end(), batch.nodeCount, glm::mat4(1.0f));
-                }
-
-                if (batch.jointCount > 0)
-                {
-                    if (pose.jointCount == batch.jointCount && pose.jointPalette.size() == static_cast<size_t>(batch.jointCount))
-                        batch.jointPalette.insert(batch.jointPalette.end(), pose.jointPalette.begin(), pose.jointPalette.end());
-                    else
-                        batch.jointPalette.insert(batch.jointPalette.end(), batch.jointCount, glm::mat4(1.0f));
-                }
-
-                (void)asset;
+                    batch->instancePoses.push_back(poseIndex(snap, *batch, posePalettes[row]));
             }
         }
+    }
 
-        // Create/update passes for models that have instances this frame.
-        for (auto &kv : batchesByModel)
-        {
-            const uint64_t key = kv.first;
-            auto &batch = kv.second;
-            auto &worlds = batch.instanceWorlds;
-            if (worlds.empty())
-                continue;
-
-            const Engine::ModelHandle handle = handleByKey[key];
+private:
+    static uint64_t keyFromHandle(const Engine::ModelHandle &h)
+    {
+        return (static_cast<uint64_t>(h.generation) << 32) | static_cast<uint64_t>(h.id);
+    }
 
-            auto it = m_passes.find(key);
-            if (it == m_passes.end())
+    // Batch for `handle` in this snapshot, set up on the first row of the model this frame.
+    // Batch slots are stable per model (m_batchIndex), so the slot's vectors keep the capacity
+    // they grew to for the same model. Returns nullptr when the model cannot be drawn.
+    Engine::RenderBatch *batchFor(Engine::RenderSnapshot &snap, Engine::ModelHandle handle, uint64_t key,
+                                  const Engine::ECS::PosePalette &pose)
+    {
+        auto it = m_batchIndex.find(key);
+        if (it == m_batchIndex.end())
+            it = m_batchIndex.emplace(key, static_cast<uint32_t>(m_batchIndex.size())).first;
+        const uint32_t index = it->second;
+
+        if (m_batchEpoch.size() <= index)
+            m_batchEpoch.resize(static_cast<size_t>(index) + 1, 0);
+        if (snap.batches.size() <= index)
+            snap.batches.resize(static_cast<size_t>(index) + 1);
+        for (uint32_t i = snap.batchCount; i <= index; ++i)
+            snap.batches[i].clear();
+        snap.batchCount = std::max(snap.batchCount, index + 1);
+
+        Engine::RenderBatch &batch = snap.batches[index];
+        if (m_batchEpoch[index] != m_extractEpoch)
+        {
+            // First row of this model in this extraction: resolve the asset once.
+            m_batchEpoch[index] = m_extractEpoch;
+            batch.model = handle;
+            batch.nodeCount = pose.nodeCount;
+            batch.jointCount = pose.jointCount;
+            const Engine::ModelAsset *asset = m_assets ? m_assets->getModel(handle) : nullptr;
+            if (m_assets && !asset)
+                batch.nodeCount = 0;
+            else if (asset)
             {
-                auto pass = std::make_shared<Engine::SModelRenderPassModule>();
-                pass->setAssets(m_assets);
-                pass->setModel(handle);
-                pass->setCamera(m_camera);
-                pass->setEnabled(true);
-                m_renderer->registerPass(pass);
-                it = m_passes.emplace(key, std::move(pass)).first;
+                // Prefer counts from PosePalette (it is what we will upload).
+                if (batch.nodeCount == 0)
+                    batch.nodeCount = static_cast<uint32_t>(asset->nodes.size());
+                if (batch.jointCount == 0)
+                    batch.jointCount = asset->totalJointCount;
             }
 
-            it->second->setCamera(m_camera);
-            it->second->setEnabled(true);
-            it->second->setInstances(worlds.data(), static_cast<uint32_t>(worlds.size()));
-            it->second->setNodePalette(batch.nodePalette.data(), static_cast<uint32_t>(worlds.size()), batch.nodeCount);
+            // Node palette: only the nodes drawing unskinned primitives, when the model
+            // lists them.
+            if (m_batchPaletteNodes.size() <= index)
+                m_batchPaletteNodes.resize(static_cast<size_t>(index) + 1, nullptr);
+            const bool compact = asset && asset->hasPaletteNodes() && asset->nodes.size() == batch.nodeCount;
+            m_batchPaletteNodes[index] = compact ? &asset->paletteNodes : nullptr;
+            batch.paletteNodeCount = compact ? asset->paletteNodeCount() : batch.nodeCount;
+        }
+        return batch.nodeCount > 0 ? &batch : nullptr;
+    }
 
-            if (batch.jointCount > 0 && batch.jointPalette.size() == worlds.size() * static_cast<size_t>(batch.jointCount))
+    // Batch-local pose index for one instance. A shared slot is appended to the batch the
+    // first time an instance references it this extraction (a slot belongs to one model, so
+    // one slot -> index map serves every batch); an entity-owned pose is always appended.
+    uint32_t poseIndex(Engine::RenderSnapshot &snap, Engine::RenderBatch &batch, const Engine::ECS::PosePalette &pose)
+    {
+        const std::vector<Engine::PaletteMatrix> *nodes = &pose.nodePalette;
+        const std::vector<Engine::PaletteMatrix> *joints = &pose.jointPalette;
+        uint32_t nodeCount = pose.nodeCount;
+        uint32_t jointCount = pose.jointCount;
+        const uint32_t slot = pose.sharedSlot;
+        if (slot != SharedPosePool::kNoSlot)
+        {
+            const SharedPosePool::Slot *shared = m_sharedPoses ? m_sharedPoses->get(slot) : nullptr;
+            if (shared && slot < m_slotPoseEpoch.size())
             {
-                it->second->setJointPalette(batch.jointPalette.data(), static_cast<uint32_t>(worlds.size()), batch.jointCount);
+                if (m_slotPoseEpoch[slot] == m_extractEpoch)
+                    return m_slotPose[slot];
+                m_slotPoseEpoch[slot] = m_extractEpoch;
+                m_slotPose[slot] = batch.poseCount;
+                nodes = &shared->nodePalette;
+                joints = &shared->jointPalette;
+                nodeCount = shared->nodeCount;
+                jointCount = shared->jointCount;
             }
+            else
+            {
+                nodeCount = 0; // unknown slot: identities
+                jointCount = 0;
+            }
+        }
+
+        const size_t batchSlot = static_cast<size_t>(&batch - snap.batches.data());
+        const std::vector<uint32_t> *paletteNodes = m_batchPaletteNodes[batchSlot];
+        if (!paletteNodes)
+            appendPalette(batch.nodePalette, *nodes, nodeCount, batch.nodeCount);
+        else if (nodeCount == batch.nodeCount && nodes->size() == static_cast<size_t>(nodeCount))
+        {
+            for (uint32_t n : *paletteNodes)
+                batch.nodePalette.push_back((*nodes)[n]);
         }
+        else
+            batch.nodePalette.insert(batch.nodePalette.end(), paletteNodes->size(), Engine::PaletteIdentity());
+        if (batch.jointCount > 0)
+            appendPalette(batch.jointPalette, *joints, jointCount, batch.jointCount);
+        ++snap.uniquePoses;
+        return batch.poseCount++;
+    }
 
-        // Disable passes that have no instances this frame.
-        for (auto &kv : m_passes)
+    // GPU pose path: batch-local pose index of the unit's (clip, time) request, appended the
+    // first time it is seen in this extraction when requests are shared.
+    uint32_t requestIndex(Engine::RenderSnapshot &snap, Engine::RenderBatch &batch, const Engine::ECS::RenderAnimation *anim)
+    {
+        Engine::PoseRequest req;
+        if (anim)
         {
-            if (batchesByModel.find(kv.first) == batchesByModel.end())
+            req.clip = anim->clipIndex;
+            req.timeSec = anim->playing ? anim->timeSec : 0.0f;
+        }
+
+        if (m_gpuShareHz > 0.0f)
+        {
+            const uint32_t bucket = static_cast<uint32_t>(std::max(0.0f, std::floor(req.timeSec * m_gpuShareHz + 0.5f)));
+            req.timeSec = static_cast<float>(bucket) / m_gpuShareHz;
+
+            const size_t slot = static_cast<size_t>(&batch - snap.batches.data());
+            if (m_requestIndex.size() <= slot)
             {
-                kv.second->setEnabled(false);
+                m_requestIndex.resize(slot + 1);
+                m_requestEpoch.resize(slot + 1, 0);
             }
+            if (m_requestEpoch[slot] != m_extractEpoch)
+            {
+                m_requestEpoch[slot] = m_extractEpoch;
+                m_requestIndex[slot].clear();
+            }
+            const uint64_t key = (static_cast<uint64_t>(req.clip) << 32) | bucket;
+            const auto it = m_requestIndex[slot].emplace(key, batch.poseCount);
+            if (!it.second)
+                return it.first->second; // already requested this extraction
         }
+
+        batch.poseRequests.push_back(req);
+        ++snap.uniquePoses;
+        return batch.poseCount++;
+    }
+
+    // Append one pose's palette, or identities when the pose does not match the batch.
+    static void appendPalette(std::vector<Engine::PaletteMatrix> &dst, const std::vector<Engine::PaletteMatrix> &src, uint32_t srcCount,
+                              uint32_t count)
+    {
+        if (srcCount == count && src.size() == static_cast<size_t>(count))
+            dst.insert(dst.end(), src.begin(), src.end());
+        else
+            dst.insert(dst.end(), count, Engine::PaletteIdentity());
+    }
+
+    // Gribb/Hartmann plane extraction; planes are normalized so the sphere test uses meters.
+    static void extractFrustumPlanes(const glm::mat4 &m, glm::vec4 (&planes)[6])
+    {
+        const glm::vec4 r0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        const glm::vec4 r1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        const glm::vec4 r2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        const glm::vec4 r3(m[0][3], m[1][3], m[2][3], m[3][3]);
+        planes[0] = r3 + r0; // left
+        planes[1] = r3 - r0; // right
+        planes[2] = r3 + r1; // bottom
+        planes[3] = r3 - r1; // top
+        planes[4] = r3 + r2; // near (GLM's default -1..1 depth; also conservative for 0..1)
+        planes[5] = r3 - r2; // far
+        for (glm::vec4 &p : planes)
+        {
+            const float len = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+            if (len > 0.0f)
+                p /= len;
+        }
+    }
+
+    static bool sphereInFrustum(const glm::vec4 (&planes)[6], float x, float y, float z, float radius)
+    {
+        for (const glm::vec4 &p : planes)
+        {
+            if (p.x * x + p.y * y + p.z * z + p.w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    struct PreviousState
+    {
+        uint32_t generation = UINT32_MAX; // entity generation when captured (slot reuse check)
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        float yaw = 0.0f;
+    };
+
+    // Blend the current sim state (in/out) with the one captured before the last step.
+    void interpolate(Engine::ECS::Entity e, float &x, float &y, float &z, float &yaw) const
+    {
+        if (e.index >= m_previous.size() || m_previous[e.index].generation != e.generation)
+            return; // spawned since the last step: draw as is
+        const PreviousState &prev = m_previous[e.index];
+        x = prev.x + (x - prev.x) * m_alpha;
+        y = prev.y + (y - prev.y) * m_alpha;
+        z = prev.z + (z - prev.z) * m_alpha;
+
+        // Shortest way around the circle.
+        constexpr float kPi = 3.14159265358979f;
+        float dYaw = yaw - prev.yaw;
+        dYaw -= 2.0f * kPi * std::floor((dYaw + kPi) / (2.0f * kPi));
+        yaw = prev.yaw + dYaw * m_alpha;
     }
 
-private:
     Engine::AssetManager *m_assets = nullptr; // not owned
     Engine::Renderer *m_renderer = nullptr;   // not owned
     Engine::Camera *m_camera = nullptr;       // not owned
+    const SharedPosePool *m_sharedPoses = nullptr; // not owned
 
     std::unordered_map<uint64_t, std::shared_ptr<Engine::SModelRenderPassModule>> m_passes;
+    std::unordered_map<uint64_t, uint32_t> m_batchIndex; // model key -> snapshot batch slot
+    std::vector<uint64_t> m_batchEpoch;                  // per batch slot: extraction it was set up in
+    std::vector<const std::vector<uint32_t> *> m_batchPaletteNodes; // per batch slot: ModelAsset::paletteNodes, nullptr = all nodes
+    uint64_t m_extractEpoch = 0;
+    std::vector<uint64_t> m_slotPoseEpoch; // per shared pose slot: extraction it was appended in
+    std::vector<uint32_t> m_slotPose;      // per shared pose slot: its pose index in that batch
+
+    bool m_gpuPoses = false;
+    float m_gpuShareHz = 0.0f;
+    std::vector<std::unordered_map<uint64_t, uint32_t>> m_requestIndex; // per batch slot: (clip, bucket) -> pose
+    std::vector<uint64_t> m_requestEpoch;                               // per batch slot: extraction m_requestIndex is from
+
+    bool m_cull = true;
+    float m_cullRadius = kDefaultCullRadius;
+
+    bool m_interpolate = true;
+    bool m_seedPrevious = false; // interpolation was just re-enabled, m_previous is stale
+    float m_alpha = 1.0f;
+    std::vector<PreviousState> m_previous; // indexed by entity slot
     Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
 };
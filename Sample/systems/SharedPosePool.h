@@ -0,0 +1,141 @@
+#pragma once
+
+#include "assets/PaletteMatrix.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// SharedPosePool
+// - Pose palettes shared by every unit playing the same clip of the same model at (nearly)
+//   the same time: (model, clip, time bucket) -> one slot holding node + joint palettes.
+// - PoseUpdateSystem evaluates a slot once when its key first appears and points
+//   PosePalette::sharedSlot at it; RenderSystem uploads each referenced slot once per batch
+//   and the GPU picks it per instance.
+// - Slots are not reference counted (units die without a release hook). Instead the owner
+//   marks every referenced slot once per update and sweep() recycles the rest.
+class SharedPosePool
+{
+public:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    struct Key
+    {
+        uint64_t model = 0; // ModelHandle as (generation << 32) | id
+        uint32_t clip = 0;
+        uint32_t bucket = 0; // timeSec * shareHz, rounded to nearest
+
+        bool operator==(const Key &o) const { return model == o.model && clip == o.clip && bucket == o.bucket; }
+    };
+
+    struct Slot
+    {
+        Key key;
+        bool live = false;
+        uint64_t mark = 0;
+        std::vector<Engine::PaletteMatrix> nodePalette;
+        std::vector<Engine::PaletteMatrix> jointPalette;
+        uint32_t nodeCount = 0;
+        uint32_t jointCount = 0;
+    };
+
+    /// Slot for `key`; a new one is taken (created = true) when no unit uses the key yet.
+    /// Freed slots are reused with the palette capacity they already grew to.
+    uint32_t acquire(const Key &key, bool &created)
+    {
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            created = false;
+            return it->second;
+        }
+
+        uint32_t slot;
+        if (!m_free.empty())
+        {
+            slot = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+        Slot &s = m_slots[slot];
+        s.key = key;
+        s.live = true;
+        s.mark = m_epoch;
+        m_index.emplace(key, slot);
+        ++m_liveCount;
+        created = true;
+        return slot;
+    }
+
+    bool matches(uint32_t slot, const Key &key) const
+    {
+        return slot < m_slots.size() && m_slots[slot].live && m_slots[slot].key == key;
+    }
+
+    Slot &at(uint32_t slot) { return m_slots[slot]; }
+
+    /// Live slot or nullptr (stale / out of range indices are tolerated).
+    const Slot *get(uint32_t slot) const
+    {
+        return (slot < m_slots.size() && m_slots[slot].live) ? &m_slots[slot] : nullptr;
+    }
+
+    // Mark-and-sweep: beginMark(), mark() every slot still referenced, then sweep().
+    void beginMark() { ++m_epoch; }
+
+    void mark(uint32_t slot)
+    {
+        if (slot < m_slots.size())
+            m_slots[slot].mark = m_epoch;
+    }
+
+    /// Frees live slots not marked since beginMark(); returns how many were freed.
+    uint32_t sweep()
+    {
+        uint32_t freed = 0;
+        for (uint32_t i = 0; i < m_slots.size(); ++i)
+        {
+            Slot &s = m_slots[i];
+            if (!s.live || s.mark == m_epoch)
+                continue;
+            m_index.erase(s.key);
+            s.live = false;
+            m_free.push_back(i);
+            ++freed;
+        }
+        m_liveCount -= freed;
+        return freed;
+    }
+
+    void clear()
+    {
+        m_slots.clear();
+        m_free.clear();
+        m_index.clear();
+        m_liveCount = 0;
+    }
+
+    uint32_t liveCount() const { return m_liveCount; }
+    uint32_t capacity() const { return static_cast<uint32_t>(m_slots.size()); }
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key &k) const
+        {
+            uint64_t h = k.model * 0x9E3779B97F4A7C15ull;
+            h ^= (static_cast<uint64_t>(k.clip) << 32 | k.bucket) + 0x7F4A7C159E3779B9ull + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free;
+    std::unordered_map<Key, uint32_t, KeyHash> m_index;
+    uint64_t m_epoch = 0;
+    uint32_t m_liveCount = 0;
+};
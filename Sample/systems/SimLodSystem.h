@@ -0,0 +1,162 @@
+#pragma once
+/*
+  SimLodSystem.h
+  --------------
+  Purpose:
+    - Assign each unit a simulation level-of-detail from the camera: on-screen units near
+      the camera update every frame, farther ones every 2nd / 4th frame, off-screen ones
+      every 8th frame.
+    - Writes SimLod::due / stepDt once per frame; throttled systems (Steering, LocalAvoidance,
+      CharacterAnimation, PoseUpdate) skip rows that are not due and integrate the
+      accumulated stepDt when they are (see SimLodGate below).
+
+  Staggering:
+    - A row at level L is due when (frame + entity.index) is a multiple of 2^L, so each
+      level's units are spread evenly over its period instead of all updating on one frame.
+
+  Notes:
+    - MovementSystem is not throttled: positions integrate every frame with the velocity the
+      throttled systems last produced, so far units keep moving smoothly.
+    - Without a camera every unit stays at level 0 (every frame).
+    - Units without a SimLod component are never throttled.
+*/
+
+#include "ECS/SystemFormat.h"
+#include "ECS/Components.h"
+
+#include "Engine/Camera.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Helpers for throttled systems.
+namespace SimLodGate
+{
+    // True when `row` is not due this frame (the caller should defer it).
+    inline bool skip(const Engine::ECS::SimLod *lods, uint32_t row)
+    {
+        return lods && !lods[row].due;
+    }
+
+    // Time step for a due row: the accumulated step, or the frame dt when not throttled.
+    inline float dt(const Engine::ECS::SimLod *lods, uint32_t row, float frameDt)
+    {
+        return (lods && lods[row].stepDt > 0.0f) ? lods[row].stepDt : frameDt;
+    }
+}
+
+class SimLodSystem : public Engine::ECS::SystemBase
+{
+public:
+    static constexpr uint8_t kLevels = 4; // 1, 1/2, 1/4, 1/8 rate
+
+    SimLodSystem()
+    {
+        setRequiredNames({"Position", "SimLod"});
+        setExcludedNames({"Disabled", "Dead", "Sleeping"});
+    }
+
+    const char *name() const override { return "SimLodSystem"; }
+
+    void setCamera(const Engine::Camera *camera) { m_camera = camera; }
+
+    // On-screen distance bands (meters): < nearDist every frame, < midDist every 2nd frame,
+    // beyond every 4th frame. Off-screen units always update every 8th frame.
+    void setDistances(float nearDist, float midDist)
+    {
+        m_nearDist = std::max(0.0f, nearDist);
+        m_midDist = std::max(m_nearDist, midDist);
+    }
+
+    /// Units assigned to `level` (update every 2^level frames) in the last update.
+    uint32_t countAtLevel(uint8_t level) const { return level < kLevels ? m_levelCounts[level] : 0u; }
+
+    void update(Engine::ECS::ECSContext &ecs, float dt) override
+    {
+        if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
+            m_queryId = ecs.queries.createQuery(required(), excluded(), ecs.stores);
+
+        ++m_frame;
+        m_levelCounts.fill(0);
+
+        glm::mat4 viewProj(1.0f);
+        glm::vec3 camPos(0.0f);
+        if (m_camera)
+        {
+            viewProj = m_camera->GetProjectionMatrix() * m_camera->GetViewMatrix();
+            camPos = m_camera->GetPosition();
+        }
+        const float near2 = m_nearDist * m_nearDist;
+        const float mid2 = m_midDist * m_midDist;
+
+        const auto &q = ecs.queries.get(m_queryId);
+        for (uint32_t archetypeId : q.matchingArchetypeIds)
+        {
+            auto *store = ecs.stores.get(archetypeId);
+            if (!store || !store->hasSimLod())
+                continue;
+
+            const auto &positions = store->positions();
+            const auto &entities = store->entities();
+            auto &lods = store->simLods();
+            const uint32_t n = store->size();
+
+            for (uint32_t row = 0; row < n; ++row)
+            {
+                auto &lod = lods[row];
+                const auto &p = positions[row];
+
+                uint8_t level = 0;
+                if (m_camera)
+                {
+                    const glm::vec4 clip = viewProj * glm::vec4(p.x, p.y, p.z, 1.0f);
+                    const float lim = clip.w * (1.0f + kScreenMargin);
+                    const bool onScreen = clip.w > 0.0f && std::fabs(clip.x) <= lim && std::fabs(clip.y) <= lim;
+                    if (!onScreen)
+                    {
+                        level = 3;
+                    }
+                    else
+                    {
+                        const float dx = p.x - camPos.x;
+                        const float dy = p.y - camPos.y;
+                        const float dz = p.z - camPos.z;
+                        const float d2 = dx * dx + dy * dy + dz * dz;
+                        level = d2 < near2 ? 0 : (d2 < mid2 ? 1 : 2);
+                    }
+                }
+
+                const uint32_t periodMask = (1u << level) - 1u;
+                lod.level = level;
+                lod.pendingDt += dt;
+                lod.due = ((m_frame + entities[row].index) & periodMask) == 0;
+                if (lod.due)
+                {
+                    lod.stepDt = lod.pendingDt;
+                    lod.pendingDt = 0.0f;
+                }
+                else
+                {
+                    lod.stepDt = 0.0f;
+                }
+                ++m_levelCounts[level];
+            }
+        }
+    }
+
+private:
+    // Clip-space margin so units just outside the view are already at full rate when they enter.
+    static constexpr float kScreenMargin = 0.15f;
+
+    const Engine::Camera *m_camera = nullptr; // not owned
+    float m_nearDist = 40.0f;
+    float m_midDist = 90.0f;
+
+    uint32_t m_frame = 0;
+    std::array<uint32_t, kLevels> m_levelCounts{};
+    Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
+};
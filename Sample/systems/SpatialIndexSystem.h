@@ -16,6 +16,8 @@
   Notes:
     - This is stateless across frames: we rebuild the grid each frame (simple and fast for RTS scales).
     - The grid stores (storeId, row) pairs so you can access components back in ArchetypeStoreManager.
+    - Sleeping entities (see ActivitySystem) don't move, so they live in a second grid that is only
+      rebuilt when the sleeping set changes. forNeighbors() visits both grids.
 */
 
 #include "ECS/SystemFormat.h"
@@ -72,6 +74,13 @@ public:
 
     const char *name() const override { return "SpatialIndexSystem"; }
 
+    void buildMasks(Engine::ECS::ComponentRegistry &registry) override
+    {
+        Engine::ECS::SystemBase::buildMasks(registry);
+        m_positionId = registry.ensureId("Position");
+        m_sleepingId = registry.ensureId("Sleeping");
+    }
+
     void setCellSize(float cellSize) { m_cellSize = (cellSize > 1e-6f) ? cellSize : 1e-6f; }
     float getCellSize() const { return m_cellSize; }
 
@@ -84,29 +93,47 @@ public:
         // Optional: if entity count changes wildly, you can occasionally m_grid.clear()
 
         if (m_queryId == Engine::ECS::QueryManager::InvalidQuery)
-            m_queryId = ecs.queries.createQuery(required(), excluded(), ecs.stores);
+        {
+            Engine::ECS::ComponentMask awakeExcluded = excluded();
+            awakeExcluded.set(m_sleepingId);
+            m_queryId = ecs.queries.createQuery(required(), awakeExcluded, ecs.stores);
+
+            // Sleepers: rows entering a sleeping store are marked dirty by the tag migration,
+            // rows leaving swap another row in (dirty) or shrink the store.
+            Engine::ECS::ComponentMask sleepRequired = required();
+            sleepRequired.set(m_sleepingId);
+            Engine::ECS::ComponentMask dirty;
+            dirty.set(m_positionId);
+            m_sleepQueryId = ecs.queries.createDirtyQuery(sleepRequired, excluded(), dirty, ecs.stores);
+        }
 
         const auto &q = ecs.queries.get(m_queryId);
         for (uint32_t archetypeId : q.matchingArchetypeIds)
+            insertStore(ecs, archetypeId, m_grid);
+
+        // Rebuild the sleeping grid only when its membership changed.
+        bool sleepersChanged = false;
+        const auto &sq = ecs.queries.get(m_sleepQueryId);
+        if (m_sleepStoreSizes.size() != sq.matchingArchetypeIds.size())
+        {
+            m_sleepStoreSizes.resize(sq.matchingArchetypeIds.size(), 0);
+            sleepersChanged = true;
+        }
+        for (size_t i = 0; i < sq.matchingArchetypeIds.size(); ++i)
         {
+            const uint32_t archetypeId = sq.matchingArchetypeIds[i];
             const Engine::ECS::ArchetypeStore *storePtr = ecs.stores.get(archetypeId);
-            if (!storePtr)
-                continue;
-            const auto &store = *storePtr;
-            if (!store.hasPosition())
-                continue;
-
-            const auto &positions = store.positions();
-            const uint32_t n = store.size();
-            for (uint32_t row = 0; row < n; ++row)
-            {
-                const auto &p = positions[row];
-                const int gx = static_cast<int>(std::floor(p.x / m_cellSize));
-                const int gz = static_cast<int>(std::floor(p.z / m_cellSize));
-                GridKey key{gx, gz};
-                auto &cell = m_grid[key];
-                cell.entries.push_back(GridEntry{archetypeId, row});
-            }
+            const uint32_t n = storePtr ? storePtr->size() : 0u;
+            if (!ecs.queries.consumeDirtyRows(m_sleepQueryId, archetypeId).empty() || n != m_sleepStoreSizes[i])
+                sleepersChanged = true;
+            m_sleepStoreSizes[i] = n;
+        }
+        if (sleepersChanged)
+        {
+            for (auto &kv : m_sleepGrid)
+                kv.second.entries.clear();
+            for (uint32_t archetypeId : sq.matchingArchetypeIds)
+                insertStore(ecs, archetypeId, m_sleepGrid);
         }
     }
 
@@ -123,19 +150,55 @@ public:
             {
                 const GridKey key{gx + dx, gz + dy};
                 auto it = m_grid.find(key);
-                if (it == m_grid.end())
-                    continue;
-                for (const auto &e : it->second.entries)
-                    visit(e.storeId, e.row);
+                if (it != m_grid.end())
+                {
+                    for (const auto &e : it->second.entries)
+                        visit(e.storeId, e.row);
+                }
+                auto sit = m_sleepGrid.find(key);
+                if (sit != m_sleepGrid.end())
+                {
+                    for (const auto &e : sit->second.entries)
+                        visit(e.storeId, e.row);
+                }
             }
         }
     }
 
-    // Optional: expose direct cell access if needed
+    // Optional: expose direct cell access if needed (awake entities; sleepers are in sleepGrid())
     const std::unordered_map<GridKey, GridCell, GridKeyHash> &grid() const { return m_grid; }
+    const std::unordered_map<GridKey, GridCell, GridKeyHash> &sleepGrid() const { return m_sleepGrid; }
 
 private:
+    void insertStore(Engine::ECS::ECSContext &ecs, uint32_t archetypeId,
+                     std::unordered_map<GridKey, GridCell, GridKeyHash> &grid) const
+    {
+        const Engine::ECS::ArchetypeStore *storePtr = ecs.stores.get(archetypeId);
+        if (!storePtr)
+            return;
+        const auto &store = *storePtr;
+        if (!store.hasPosition())
+            return;
+
+        const auto &positions = store.positions();
+        const uint32_t n = store.size();
+        for (uint32_t row = 0; row < n; ++row)
+        {
+            const auto &p = positions[row];
+            const int gx = static_cast<int>(std::floor(p.x / m_cellSize));
+            const int gz = static_cast<int>(std::floor(p.z / m_cellSize));
+            GridKey key{gx, gz};
+            auto &cell = grid[key];
+            cell.entries.push_back(GridEntry{archetypeId, row});
+        }
+    }
+
     float m_cellSize; // equals neighbor radius R
     std::unordered_map<GridKey, GridCell, GridKeyHash> m_grid;
+    std::unordered_map<GridKey, GridCell, GridKeyHash> m_sleepGrid;
+    std::vector<uint32_t> m_sleepStoreSizes; // per sleep-query match, at the last rebuild
     Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
+    Engine::ECS::QueryId m_sleepQueryId = Engine::ECS::QueryManager::InvalidQuery;
+    uint32_t m_positionId = Engine::ECS::ComponentRegistry::InvalidID;
+    uint32_t m_sleepingId = Engine::ECS::ComponentRegistry::InvalidID;
 };
\ No newline at end of file
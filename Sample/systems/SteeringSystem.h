@@ -1,8 +1,12 @@
 #pragma once
 #include "ECS/SystemFormat.h"
 #include "ECS/Components.h"
+#include "systems/MovementKernel.h"
+#include "systems/SimLodSystem.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 class SteeringSystem : public Engine::ECS::SystemBase
 {
@@ -11,7 +15,7 @@ public:
     {
         // Position + Velocity + MoveTarget + MoveSpeed + Path + Facing required
         setRequiredNames({"Position", "Velocity", "MoveTarget", "MoveSpeed", "Path", "Facing"});
-        setExcludedNames({"Disabled", "Dead"});
+        setExcludedNames({"Disabled", "Dead", "Sleeping"});
     }
 
     const char *name() const override { return "SteeringSystem"; }
@@ -36,12 +40,10 @@ public:
             m_queryId = ecs.queries.createDirtyQuery(required(), excluded(), dirty, ecs.stores);
         }
 
-        auto dist2 = [](float x, float z)
-        { return x * x + z * z; };
-
         // Gameplay uses meters; stop once we're within a small radius.
         const float arrivalRadius2 = 0.25f;   // 0.5^2
         const float waypointRadius2 = 0.0625f; // 0.25^2
+        const float acceleration = 15.0f;
 
         const auto &q = ecs.queries.get(m_queryId);
         for (uint32_t archetypeId : q.matchingArchetypeIds)
@@ -62,20 +64,29 @@ public:
             auto &paths = const_cast<std::vector<Engine::ECS::Path> &>(store.paths());
             auto &facings = const_cast<std::vector<Engine::ECS::Facing> &>(store.facings());
 
+            const Engine::ECS::PathPool &pathPool = ecs.pathPool;
             const uint32_t n = store.size();
+            const Engine::ECS::SimLod *lods = store.hasSimLod() ? store.simLods().data() : nullptr;
 
+            // 1. Gather rows with an active target (waypoint or final) into SoA streams.
+            m_streams.clear();
+            m_rows.clear();
+            m_isFinal.clear();
             for (uint32_t i : dirtyRows)
             {
                 if (i >= n)
                     continue;
 
-                auto &pos = positions[i];
-                auto &vel = velocities[i];
-                auto &tgt = targets[i];
-                const auto &spd = speeds[i];
-                auto &path = paths[i];
-                auto &facing = facings[i];
+                // Sim-LOD: far rows steer every few frames; keep them queued until due.
+                if (SimLodGate::skip(lods, i))
+                {
+                    ecs.queries.markRowDirty(m_queryId, archetypeId, i, n);
+                    continue;
+                }
+                const float rowDt = SimLodGate::dt(lods, i, dt);
 
+                auto &vel = velocities[i];
+                const auto &tgt = targets[i];
                 if (!tgt.active)
                 {
                     // Stop
@@ -88,103 +99,114 @@ public:
                 float tz = tgt.z;
                 bool isFinal = true;
 
-                if (path.valid && path.current < path.count)
+                const auto &path = paths[i];
+                const float *wp = (path.valid && path.current < path.count) ? pathPool.data(path.handle) : nullptr;
+                if (wp)
                 {
-                    tx = path.waypointsX[path.current];
-                    tz = path.waypointsZ[path.current];
+                    tx = wp[2 * path.current + 0];
+                    tz = wp[2 * path.current + 1];
                     isFinal = false;
                 }
 
-                float dx = tx - pos.x;
-                float dz = tz - pos.z;
-                float d2 = dist2(dx, dz);
+                // Arrival radius (squared). Throttled rows travel up to speed * rowDt between
+                // updates, so widen the radius to that or they would step past the point.
+                const float speed = speeds[i].value;
+                const float stepLen = speed * rowDt;
+                const float radius2 = std::max(isFinal ? arrivalRadius2 : waypointRadius2, stepLen * stepLen);
 
-                // Check arrival (squared distance)
-                float radiusToCheck2 = isFinal ? arrivalRadius2 : waypointRadius2;
+                // Clamp the blend so long (throttled) steps settle on the target instead of overshooting.
+                const float blend = std::min(1.0f, acceleration * rowDt);
+
+                const auto &pos = positions[i];
+                m_streams.push(pos.x, pos.z, vel.x, vel.z, tx, tz, speed, radius2, blend);
+                m_rows.push_back(i);
+                m_isFinal.push_back(isFinal ? 1 : 0);
+            }
+
+            // 2. Arrival test + velocity blend, kLanes rows per instruction.
+            MovementKernel::steer(m_streams);
+
+            // 3. Scatter; arrived rows stop or advance their path and re-steer (scalar).
+            m_velocityRows.clear();
+            m_targetRows.clear();
+            m_facingRows.clear();
+            for (uint32_t k = 0; k < m_streams.count; ++k)
+            {
+                const uint32_t i = m_rows[k];
+                const auto &pos = positions[i];
+                auto &vel = velocities[i];
+                auto &tgt = targets[i];
+                auto &path = paths[i];
 
-                if (d2 <= radiusToCheck2)
+                float vx = m_streams.vx[k];
+                float vz = m_streams.vz[k];
+                bool steered = true; // radius2 >= waypointRadius2, so every lane that did not arrive was steered
+
+                if (m_streams.arrived[k])
                 {
-                    if (isFinal)
+                    if (m_isFinal[k])
                     {
                         // Arrived at final destination
                         vel.x = vel.y = vel.z = 0.0f;
                         tgt.active = 0;
                         path.valid = false;
+                        m_velocityRows.push_back(i);
+                        m_targetRows.push_back(i);
+                        continue;
                     }
-                    else
+
+                    // Arrived at waypoint — advance to next, or steer to the final target when the path is done
+                    float tx = tgt.x;
+                    float tz = tgt.z;
+                    path.current++;
+                    const float *next = path.current < path.count ? pathPool.data(path.handle) : nullptr;
+                    if (next)
                     {
-                        // Arrived at waypoint — advance to next
-                        path.current++;
-                        if (path.current < path.count)
-                        {
-                            tx = path.waypointsX[path.current];
-                            tz = path.waypointsZ[path.current];
-                            dx = tx - pos.x;
-                            dz = tz - pos.z;
-                            d2 = dist2(dx, dz);
-                        }
-                        else
-                        {
-                            // Path finished, steer to final target
-                            path.valid = false;
-                            tx = tgt.x;
-                            tz = tgt.z;
-                            dx = tx - pos.x;
-                            dz = tz - pos.z;
-                            d2 = dist2(dx, dz);
-                        }
+                        tx = next[2 * path.current + 0];
+                        tz = next[2 * path.current + 1];
                     }
-
-                    // If we just arrived at the final destination, stop and mark dirty
-                    if (isFinal)
+                    else
                     {
-                        ecs.markDirty(m_velocityId, archetypeId, i);
-                        ecs.markDirty(m_moveTargetId, archetypeId, i);
-                        continue;
+                        path.valid = false;
                     }
+                    steered = MovementKernel::steerLane(pos.x, pos.z, vx, vz, tx, tz,
+                                                        m_streams.speed[k], m_streams.blend[k]);
                 }
 
-                // Steer toward target
-                if (d2 > 1e-8f)
+                if (steered)
                 {
-                    float dist = std::sqrt(d2);
-                    float invDist = 1.0f / dist;
-                    dx *= invDist;
-                    dz *= invDist;
-
-                    float speed = spd.value;
-
-                    // Inertia / Smoothing: accelerate toward desired velocity
-                    float targetVx = dx * speed;
-                    float targetVz = dz * speed;
-
-                    const float acceleration = 15.0f;
-
-                    float diffX = targetVx - vel.x;
-                    float diffZ = targetVz - vel.z;
-
-                    vel.x += diffX * acceleration * dt;
-                    vel.z += diffZ * acceleration * dt;
+                    vel.x = vx;
+                    vel.z = vz;
                     vel.y = 0.0f;
 
                     // Update Facing based on actual velocity (smooth turn)
                     if (std::abs(vel.x) > 0.1f || std::abs(vel.z) > 0.1f)
                     {
-                        facing.yaw = std::atan2(vel.x, vel.z);
-                        ecs.markDirty(m_facingId, archetypeId, i);
+                        facings[i].yaw = std::atan2(vel.x, vel.z);
+                        m_facingRows.push_back(i);
                     }
                 }
 
-                ecs.markDirty(m_velocityId, archetypeId, i);
+                m_velocityRows.push_back(i);
 
                 // Keep active targets updating every frame
-                if (tgt.active)
-                    ecs.markDirty(m_moveTargetId, archetypeId, i);
+                m_targetRows.push_back(i);
             }
+
+            ecs.markDirtyRows(m_velocityId, archetypeId, m_velocityRows);
+            ecs.markDirtyRows(m_moveTargetId, archetypeId, m_targetRows);
+            ecs.markDirtyRows(m_facingId, archetypeId, m_facingRows);
         }
     }
 
 private:
+    MovementKernel::SteerStreams m_streams;
+    std::vector<uint32_t> m_rows;   // stream lane -> store row
+    std::vector<uint8_t> m_isFinal; // lane steers to the final target (not a waypoint)
+    std::vector<uint32_t> m_velocityRows;
+    std::vector<uint32_t> m_targetRows;
+    std::vector<uint32_t> m_facingRows;
+
     Engine::ECS::QueryId m_queryId = Engine::ECS::QueryManager::InvalidQuery;
     uint32_t m_positionId = Engine::ECS::ComponentRegistry::InvalidID;
     uint32_t m_velocityId = Engine::ECS::ComponentRegistry::InvalidID;
@@ -1,34 +1,93 @@
 #pragma once
 
 #include "ECS/ECSContext.h"
+#include "Engine/Camera.h"
+#include "Engine/FixedTimestep.h"
+#include "Engine/JobSystem.h"
+#include "Engine/TimeSlicer.h"
 
 #include "systems/CommandSystem.h"
+#include "systems/ActivitySystem.h"
+#include "systems/SimLodSystem.h"
 #include "systems/SteeringSystem.h"
 #include "systems/NavGrid.h"
 #include "systems/NavGridBuilderSystem.h"
 #include "systems/PathfindingSystem.h"
+#include "systems/FormationSystem.h"
 #include "systems/MovementSystem.h"
 #include "systems/CharacterAnimationSystem.h"
 #include "systems/PoseUpdateSystem.h"
 #include "systems/RenderSystem.h"
 #include "systems/SpatialIndexSystem.h"
+#include "systems/LocalAvoidanceSystem.h"
 #include "systems/CombatSystem.h"
 
 namespace Engine
 {
     class AssetManager;
     class Renderer;
-    class Camera;
 }
 
 namespace Sample
 {
     // Owns and runs Sample gameplay systems in a consistent order.
+    // Gameplay runs at a fixed rate (see SetFixedTimestep); rendering runs every frame and
+    // interpolates unit transforms between the last two simulated states.
+    //
+    // Threading: Simulate() may run on the application's simulation thread (pipelined mode);
+    // Extract() and everything else must run on the main thread while no Simulate() is in flight.
     class SystemRunner
     {
     public:
+        // Values the HUD reads, copied at extraction so OnRender never reads live sim state.
+        struct HudSnapshot
+        {
+            CombatSystem::TeamStats teams[2];
+            bool battleStarted = false;
+        };
+
         void Initialize(Engine::ECS::ECSContext &ecs);
+        // Simulate() then Extract() (single-threaded callers).
         void Update(Engine::ECS::ECSContext &ecs, float dtSeconds);
+        // Runs 0..maxSteps fixed sim steps for dtSeconds of wall time.
+        void Simulate(Engine::ECS::ECSContext &ecs, float dtSeconds);
+        // Hands the latest sim state to rendering (RenderSystem, HUD) and the camera to the sim.
+        void Extract(Engine::ECS::ECSContext &ecs);
+
+        const HudSnapshot &GetHud() const { return m_hud; }
+
+        /// Simulation rate (Hz) and catch-up limit; time beyond the limit is dropped.
+        void SetFixedTimestep(float hz, uint32_t maxStepsPerFrame);
+        /// Draw the latest sim state as is instead of interpolating (debugging).
+        void SetInterpolationEnabled(bool enabled);
+        const Engine::FixedTimestep &GetTimestep() const { return m_timestep; }
+
+        /// Per-frame budget (microseconds) for background maintenance jobs: sliced NavGrid
+        /// rebuilds and team stats rescans. They run after the frame's sim steps.
+        static constexpr uint32_t kDefaultBackgroundBudgetUs = 1000;
+        void SetBackgroundBudget(uint32_t microseconds) { m_backgroundBudgetUs = microseconds; }
+
+        /// Pose sharing between units in the same (model, clip, 1/hz time bucket); 0 = off.
+        void SetPoseSharing(float hz)
+        {
+            m_poseUpdate.setPoseSharing(hz);
+            m_renderModel.setGpuPoseSharing(hz);
+        }
+        float GetPoseSharing() const { return m_poseUpdate.poseSharing(); }
+
+        /// Evaluate poses in the model pass's compute dispatch instead of PoseUpdateSystem
+        /// (the pass falls back to CPU evaluation when the pose shader is unavailable).
+        void SetGpuPoses(bool enabled) { m_renderModel.setGpuPoses(enabled); }
+        bool GetGpuPoses() const { return m_renderModel.gpuPoses(); }
+
+        /// Local avoidance model (overlap separation or ORCA) and, for ORCA, the neighbors
+        /// each unit is constrained against.
+        void SetAvoidance(LocalAvoidanceSystem::Mode mode, uint32_t maxNeighbors)
+        {
+            m_avoidance.setMode(mode);
+            m_avoidance.setMaxNeighbors(maxNeighbors);
+        }
+        const LocalAvoidanceSystem &GetAvoidance() const { return m_avoidance; }
 
         void SetAssetManager(Engine::AssetManager *assets);
         void SetRenderer(Engine::Renderer *renderer);
@@ -41,7 +100,34 @@ namespace Sample
         CombatSystem &GetCombatSystemMut() { return m_combat; }
 
     private:
+        // One fixed simulation step (all gameplay systems except rendering).
+        void Step(Engine::ECS::ECSContext &ecs, float dtSeconds);
+
+        // Push sim rate / steps per frame / dropped steps to the performance overlay.
+        void PublishTimestepStats();
+        // Push cumulative pathfinding counters to the performance overlay.
+        void PublishPathfindingStats();
+        // Push active / sleeping unit counts and sim-LOD level counts to the performance overlay.
+        void PublishActivityStats();
+        // Push pending background jobs and the time they used this frame to the performance overlay.
+        void PublishBackgroundStats();
+        // Push poses served from baked clips vs sampled live (and shared pose reuse), and the CPU time of the last pose update, to the performance overlay.
+        void PublishPoseStats();
+
         bool m_initialized = false;
+        Engine::FixedTimestep m_timestep;
+        float m_lastFrameDt = 0.0f;
+
+        Engine::Camera *m_camera = nullptr; // live camera (main thread), not owned
+        Engine::Camera m_simCamera;         // copy the simulation reads, refreshed in Extract()
+        HudSnapshot m_hud;
+
+        // Worker pool for data-parallel system passes (declared first: systems hold a pointer).
+        Engine::JobSystem m_jobs;
+
+        // Time-sliced maintenance jobs (declared before the systems whose jobs it holds).
+        Engine::TimeSlicer m_background;
+        uint32_t m_backgroundBudgetUs = kDefaultBackgroundBudgetUs;
 
         CommandSystem m_command;
         SteeringSystem m_steering;
@@ -50,13 +136,18 @@ namespace Sample
         NavGrid m_navGrid;
         NavGridBuilderSystem m_navGridBuilder{&m_navGrid};
         PathfindingSystem m_pathfinding{&m_navGrid};
+        FormationSystem m_formation{&m_navGrid};
+        ActivitySystem m_activity;
+        SimLodSystem m_simLod;
 
         SpatialIndexSystem m_spatialIndex{2.0f};
+        LocalAvoidanceSystem m_avoidance{&m_spatialIndex};
         CombatSystem m_combat;
 
         CharacterAnimationSystem m_characterAnim;
 
         PoseUpdateSystem m_poseUpdate;
+        float m_poseUpdateMs = 0.0f;
 
         RenderSystem m_renderModel;
     };